@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSApp.h: interface for the CMOOSApp class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MOOSAPPH)
+#define MOOSAPPH
+
+#include "MOOS/libMOOS/App/ClientDefines.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/ProcessConfigReader.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/ProcInfo.h"
+#include "MOOS/libMOOS/Comms/MOOSCommClient.h"
+#include "MOOS/libMOOS/Comms/MOOSAsyncCommClient.h"
+#include "MOOS/libMOOS/Comms/MOOSVariable.h"
+#include "MOOS/libMOOS/Comms/SuicidalSleeper.h"
+
+#include <iomanip>
+#include <set>
+#include <string>
+#include <vector>
+
+#define DEFAULT_MOOS_APP_COMMS_FREQ 5
+#define DEFAULT_MOOS_APP_FREQ 5
+#define MOOS_MAX_APP_FREQ 100
+#define MOOS_MAX_COMMS_FREQ 200
+#define STATUS_PERIOD 2
+
+namespace MOOS
+{
+    namespace Poco
+    {
+        class Event;
+    }
+}
+
+/** This is a class from which all MOOS component applications can be
+derived. It provides the mission file reading, connection to the MOOSDB,
+mail handling and regular Iterate() calls every application needs. Derive
+from it and overload Iterate(), OnNewMail(), OnStartUp() and
+OnConnectToServer() */
+class CMOOSApp
+{
+public:
+    CMOOSApp();
+    virtual ~CMOOSApp();
+
+    /** called to start the application - never returns */
+    bool Run(const std::string & sName,
+             const std::string & sMissionFile,
+             const std::string & sMOOSName);
+    bool Run(const std::string & sName,
+             const std::string & sMissionFile = "");
+    bool Run(const std::string & sName,int argc, char * argv[]);
+    bool Run(const std::string & sName,const std::string & sMissionFile,int argc, char * argv[]);
+
+    /** pass in the command line so the application can parse it */
+    void SetCommandLineParameters(int argc, char * argv[]);
+
+    /** the three ways an application can be driven */
+    enum IterateMode
+    {
+        REGULAR_ITERATE_AND_MAIL = 0,
+        COMMS_DRIVEN_ITERATE_AND_MAIL,
+        REGULAR_ITERATE_AND_COMMS_DRIVEN_MAIL,
+    };
+
+    /** set the iterate mode */
+    bool SetIterateMode(IterateMode Mode);
+
+    /** ask the application to quit */
+    bool RequestQuit();
+
+    /** called when the application is launched to print help */
+    virtual void OnPrintHelpAndExit();
+    virtual void OnPrintExampleAndExit();
+    virtual void OnPrintInterfaceAndExit();
+    virtual void OnPrintVersionAndExit();
+    void PrintDefaultCommandLineSwitches();
+
+    /** the name the application registers with */
+    void SetMOOSName(const std::string & sMOOSName);
+
+    /** stop the application printing */
+    bool SetQuiet(bool bQ);
+
+    /** which server to connect to */
+    void SetServer(const char * sServerHost = "LOCALHOST", long lPort = 9000);
+
+    /** publish a string */
+    bool Notify(const std::string & sVar,const std::string & sVal, double dfTime=-1);
+    bool Notify(const std::string & sVar,const std::string & sVal, const std::string & sSrcAux, double dfTime=-1);
+    bool Notify(const std::string & sVar,const char * sVal, double dfTime=-1);
+    bool Notify(const std::string & sVar,const char * sVal, const std::string & sSrcAux, double dfTime=-1);
+
+    /** publish a double */
+    bool Notify(const std::string & sVar,double dfVal, double dfTime=-1);
+    bool Notify(const std::string & sVar,double dfVal, const std::string & sSrcAux, double dfTime=-1);
+
+    /** publish binary data */
+    bool Notify(const std::string & sVar,void * pData, unsigned int nDataSize, double dfTime=-1);
+    bool Notify(const std::string & sVar,void * pData, unsigned int nDataSize, const std::string & sSrcAux, double dfTime=-1);
+    bool Notify(const std::string & sVar,const std::vector<unsigned char> & vData, double dfTime=-1);
+    bool Notify(const std::string & sVar,const std::vector<unsigned char> & vData, const std::string & sSrcAux, double dfTime=-1);
+
+    /** subscribe to a variable */
+    bool Register(const std::string & sVar,double dfInterval=0.0);
+
+    /** wildcard subscription */
+    bool Register(const std::string & sVarPattern,const std::string & sAppPattern, double dfInterval);
+
+    /** unsubscribe */
+    bool UnRegister(const std::string & sVar);
+
+    /** active queues - callbacks on their own threads */
+    bool AddActiveQueue(const std::string & sQueueName,
+                        bool (*pfn)(CMOOSMsg & M, void * pYourParam),
+                        void * pYourParam)
+    {
+        return m_Comms.AddActiveQueue(sQueueName,pfn,pYourParam);
+    }
+    template <class T>
+    bool AddActiveQueue(const std::string & sQueueName,
+                        T * Instance,
+                        bool (T::*memfunc)(CMOOSMsg &))
+    {
+        return m_Comms.AddActiveQueue(sQueueName,Instance,memfunc);
+    }
+    bool AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                      const std::string & sMsgName);
+    bool AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                      const std::string & sMsgName,
+                                      bool (*pfn)(CMOOSMsg & M, void * pYourParam),
+                                      void * pYourParam);
+    template <class T>
+    bool AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                      const std::string & sMsgName,
+                                      T * Instance,
+                                      bool (T::*memfunc)(CMOOSMsg &));
+    bool AddActiveMessageQueueCallback(const std::string & sQueueName,
+                                       const std::string & sMsgName,
+                                       bool (*pfn)(CMOOSMsg & M, void * pYourParam),
+                                       void * pYourParam);
+    bool AddMessageRouteToOnMessage(const std::string & sMsgName);
+    bool AddMessageCallback(const std::string & sMsgName);
+
+    /** handler for a message routed to OnMessage */
+    virtual bool OnMessage(CMOOSMsg & M);
+
+    /** some introspection */
+    std::string GetAppName();
+    std::string GetMissionFileName();
+    int GetIterateCount();
+    double GetAppStartTime();
+    double GetAppFreq();
+    unsigned int GetCommsFreq();
+    double GetTimeSinceIterate();
+    double GetLastIterateTime();
+    double GetCPULoad();
+
+    /** called by the file scope callbacks */
+    bool OnMailCallBack();
+    virtual void OnDisconnectToServerPrivate();
+    virtual void OnConnectToServerPrivate();
+    virtual void OnNewMailPrivate(MOOSMSG_LIST & Mail);
+    virtual void IteratePrivate();
+
+    /** overload to be told when the app connects */
+    virtual bool OnConnectToServer();
+
+    /** overload to be told when the app disconnects */
+    virtual bool OnDisconnectFromServer();
+
+protected:
+    /** overload these */
+    virtual bool Iterate();
+    virtual bool OnNewMail(MOOSMSG_LIST & NewMail);
+    virtual bool OnStartUp();
+    virtual bool OnCommandMsg(CMOOSMsg Msg);
+    virtual bool OnProcessCommandLine();
+    virtual std::string MakeStatusString();
+    virtual bool ConfigureComms();
+
+    /** hooks either side of OnStartUp() and Iterate() for derived frameworks */
+    virtual bool OnStartUpPrepare(){return true;}
+    virtual bool OnStartUpComplete(){return true;}
+    virtual bool OnIteratePrepare(){return true;}
+    virtual bool OnIterateComplete(){return true;}
+
+    /** look for a parameter on the command line and then in the
+    configuration block (the command line wins) */
+    template <class T>
+    bool GetParameterFromCommandLineOrConfigurationFile(std::string sOption,T & Result,bool bPrependMinusMinusForCommandLine=true)
+    {
+        bool bF = m_MissionReader.GetConfigurationParam(sOption,Result);
+
+        if(bPrependMinusMinusForCommandLine)
+            sOption = "--"+sOption;
+
+        bool bC = m_CommandLineParser.GetVariable(sOption,Result);
+        return bC || bF;
+    }
+
+    bool UseMailCallBack();
+    bool UseMOOSComms(bool bUse);
+    void SetAppFreq(double dfFreq,double dfMaxFreq=0.0);
+    bool SetCommsFreq(unsigned int nFreq);
+    bool IsSimulateMode();
+    void WaitForEmptyOutbox();
+    void SetAppError(bool bErr, const std::string & sErr);
+    bool MOOSDebugWrite(const std::string & sTxt);
+    bool CanIterateWithoutComms();
+    void EnableIterateWithoutComms(bool bEnable);
+    void EnableCommandMessageFiltering(bool bEnable);
+    std::string GetCommandKey();
+    bool LookForAndHandleAppCommand(MOOSMSG_LIST & NewMail);
+    bool GetFlagFromCommandLineOrConfigurationFile(std::string sOption,bool bPrependMinusMinusForCommandLine=true);
+    void PrintSearchedConfigurationFileParameters();
+    bool IsConfigOK();
+    bool CheckSetUp();
+    bool Configure();
+    void DoBanner();
+    bool DoRunWork();
+    void SleepAsRequired(bool & bIterateShouldRun);
+
+    /** MOOS variables - a handy way of handling simple data */
+    bool AddMOOSVariable(std::string sName,std::string sSubscribeName,std::string sPublishName,double dfCommsTime);
+    CMOOSVariable * GetMOOSVar(std::string sName);
+    bool RegisterMOOSVariables();
+    bool UpdateMOOSVariables(MOOSMSG_LIST & NewMail);
+    bool SetMOOSVar(const std::string & sVarName,const std::string & sVal,double dfTime);
+    bool SetMOOSVar(const std::string & sVarName,double dfVal,double dfTime);
+    bool SetMOOSVar(const CMOOSVariable & Var);
+    bool PublishFreshMOOSVariables();
+
+    /** the comms object */
+#ifdef ASYNCHRONOUS_CLIENT
+    MOOS::MOOSAsyncCommClient m_Comms;
+#else
+    CMOOSCommClient m_Comms;
+#endif
+
+    std::string m_sServerHost;
+    std::string m_sServerPort;
+    int m_lServerPort;
+    bool m_bServerSet;
+    bool m_bUseMOOSComms;
+
+    std::string m_sAppName;
+    std::string m_sMOOSName;
+    std::string m_sMissionFile;
+
+    double m_dfFreq;
+    double m_dfMaxAppTick;
+    unsigned int m_nCommsFreq;
+    IterateMode m_IterationMode;
+    int m_nIterateCount;
+    int m_nMailCount;
+    double m_dfAppStartTime;
+    double m_dfLastRunTime;
+    double m_dfLastStatusTime;
+
+    bool m_bDebug;
+    bool m_bSimMode;
+    bool m_bQuiet;
+    bool m_bCommandMessageFiltering;
+    bool m_bSortMailByTime;
+    bool m_bIterateWithoutComms;
+    bool m_bQuitOnIterateFail;
+    bool m_bQuitRequested;
+    bool m_bAppError;
+    std::string m_sAppError;
+
+    MOOSVARMAP m_MOOSVars;
+    CProcessConfigReader m_MissionReader;
+    MOOS::CommandLineParser m_CommandLineParser;
+    MOOS::SuicidalSleeper m_SuicidalSleeper;
+    MOOS::ProcInfo m_ProcessMonitor;
+    MOOS::Poco::Event * m_pMailEvent;
+};
+
+template <class T>
+bool CMOOSApp::AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                            const std::string & sMsgName,
+                                            T * Instance,
+                                            bool (T::*memfunc)(CMOOSMsg &))
+{
+    if(!m_Comms.HasActiveQueue(sQueueName))
+    {
+        m_Comms.AddActiveQueue(sQueueName,Instance,memfunc);
+    }
+    return m_Comms.AddMessageRouteToActiveQueue(sQueueName,sMsgName);
+}
+
+#endif // !defined(MOOSAPPH)
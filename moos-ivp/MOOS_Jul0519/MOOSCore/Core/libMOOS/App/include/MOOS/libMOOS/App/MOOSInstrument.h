@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSInstrument.h: interface for the CMOOSInstrument class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MOOSINSTRUMENTH)
+#define MOOSINSTRUMENTH
+
+#include "MOOS/libMOOS/App/MOOSApp.h"
+
+#ifdef _WIN32
+    #include "MOOS/libMOOS/Utils/MOOSNTSerialPort.h"
+#else
+    #include "MOOS/libMOOS/Utils/MOOSLinuxSerialPort.h"
+#endif
+
+#include <string>
+
+/** a CMOOSApp which talks to a sensor over a serial port */
+class CMOOSInstrument : public CMOOSApp
+{
+public:
+    CMOOSInstrument();
+    virtual ~CMOOSInstrument();
+
+protected:
+    /** configure the serial port from the mission file */
+    bool SetupPort();
+
+    /** try to initialise the sensor a number of times */
+    bool InitialiseSensorN(int nAttempts, std::string sSensorName);
+
+    /** overload to initialise the sensor */
+    virtual bool InitialiseSensor();
+
+    virtual bool OnStartUp();
+
+    /** the magnetic offset from the mission file */
+    double GetMagneticOffset();
+
+    void SetPrompt(std::string sPrompt);
+    void SetInstrumentErrorMessage(std::string sError);
+
+    /** NMEA helpers */
+    bool DoNMEACheckSum(std::string sNMEA);
+    std::string Message2NMEA(std::string sMsg);
+
+#ifdef _WIN32
+    CMOOSNTSerialPort m_Port;
+#else
+    CMOOSLinuxSerialPort m_Port;
+#endif
+
+    bool m_bPublishRaw;
+    double m_dfMagneticOffset;
+    std::string m_sPrompt;
+    std::string m_sInstrumentErrorMessage;
+    std::string m_sResourceName;
+};
+
+#endif // !defined(MOOSINSTRUMENTH)
@@ -0,0 +1,395 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * CompactWire.cpp
+ *
+ * a message is written as
+ *
+ *   msg type (1 byte), data type (1 byte), flags (1 byte),
+ *   id (zig-zag varint),
+ *   source, source aux, community, key (string references),
+ *   time (8 bytes),
+ *   [double (8 bytes)] [double aux (8 bytes)] [string (varint length + bytes)]
+ *
+ * where the optional fields are present only if flagged. A string
+ * reference is a varint whose bottom two bits are a WireDictionary::Kind
+ * and whose remaining bits are the id (REFERENCE) or the length of the
+ * string which follows (DEFINE and LITERAL).
+ */
+
+#include "MOOS/libMOOS/Comms/CompactWire.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <cstring>
+
+namespace
+{
+
+const unsigned char kHasDouble = 1;
+const unsigned char kHasDoubleAux = 2;
+const unsigned char kHasString = 4;
+
+void WriteVarint(unsigned int n, std::vector<unsigned char> & Out)
+{
+    while(n>=0x80)
+    {
+        Out.push_back(static_cast<unsigned char>(n|0x80));
+        n>>=7;
+    }
+    Out.push_back(static_cast<unsigned char>(n));
+}
+
+void WriteDouble(double dfVal, std::vector<unsigned char> & Out)
+{
+    if(!IsLittleEndian())
+        dfVal = SwapByteOrder<double>(dfVal);
+
+    const unsigned char * p = reinterpret_cast<const unsigned char *>(&dfVal);
+    Out.insert(Out.end(),p,p+sizeof(dfVal));
+}
+
+void WriteBytes(const std::string & s, std::vector<unsigned char> & Out)
+{
+    Out.insert(Out.end(),s.begin(),s.end());
+}
+
+void WriteReference(const std::string & s,
+                    MOOS::WireDictionary & Dictionary,
+                    std::vector<unsigned char> & Out)
+{
+    unsigned int nID = 0;
+    MOOS::WireDictionary::Kind eKind = Dictionary.Intern(s,nID);
+
+    if(eKind==MOOS::WireDictionary::REFERENCE)
+    {
+        WriteVarint((nID<<2)|eKind,Out);
+    }
+    else
+    {
+        WriteVarint((static_cast<unsigned int>(s.size())<<2)|eKind,Out);
+        WriteBytes(s,Out);
+    }
+}
+
+/** the inverse of the writers above. Any read past the end or of a
+reference the dictionary cannot resolve marks the reader as bad */
+class CompactReader
+{
+public:
+    CompactReader(const unsigned char * pBuffer, int nLen)
+    {
+        next_ = pBuffer;
+        start_ = pBuffer;
+        len_ = nLen;
+        good_ = true;
+    }
+
+    void Read(unsigned char & c)
+    {
+        if(!CanRead(1))
+            return;
+        c = *next_++;
+    }
+
+    void Read(char & c)
+    {
+        if(!CanRead(1))
+            return;
+        c = static_cast<char>(*next_++);
+    }
+
+    void Read(double & dfVal)
+    {
+        if(!CanRead(sizeof(dfVal)))
+            return;
+
+        memcpy((void*)(&dfVal),(const void*)(next_),sizeof(dfVal));
+        if(!IsLittleEndian())
+            dfVal = SwapByteOrder<double>(dfVal);
+        next_+=sizeof(dfVal);
+    }
+
+    void ReadVarint(unsigned int & n)
+    {
+        n = 0;
+        for(unsigned int nShift = 0;nShift<32;nShift+=7)
+        {
+            unsigned char c = 0;
+            Read(c);
+            if(!good_)
+                return;
+
+            n |= static_cast<unsigned int>(c&0x7f)<<nShift;
+            if(!(c&0x80))
+                return;
+        }
+
+        //too many continuation bytes
+        good_ = false;
+    }
+
+    void ReadBytes(unsigned int nSize, std::string & s)
+    {
+        if(!CanRead(nSize))
+            return;
+
+        s.assign((const char*)next_,nSize);
+        next_+=nSize;
+    }
+
+    void ReadReference(MOOS::WireDictionary & Dictionary, std::string & s)
+    {
+        unsigned int n = 0;
+        ReadVarint(n);
+        if(!good_)
+            return;
+
+        switch(n&3)
+        {
+        case MOOS::WireDictionary::REFERENCE:
+        {
+            const std::string * pString = Dictionary.Lookup(n>>2);
+            if(pString==NULL)
+                good_ = false;
+            else
+                s = *pString;
+            break;
+        }
+        case MOOS::WireDictionary::DEFINE:
+            ReadBytes(n>>2,s);
+            good_ = good_ && Dictionary.Define(s);
+            break;
+        case MOOS::WireDictionary::LITERAL:
+            ReadBytes(n>>2,s);
+            break;
+        default:
+            good_ = false;
+        }
+    }
+
+    bool good() const
+    {
+        return good_;
+    }
+
+    int used() const
+    {
+        return static_cast<int>(next_-start_);
+    }
+
+private:
+    bool CanRead(unsigned int N)
+    {
+        good_ = good_ && static_cast<unsigned int>(next_-start_)+N<=static_cast<unsigned int>(len_);
+        return good_;
+    }
+
+    const unsigned char * next_;
+    const unsigned char * start_;
+    int len_;
+    bool good_;
+};
+
+}
+
+namespace MOOS
+{
+
+WireDictionary::WireDictionary(unsigned int nMaxEntries, unsigned int nMaxLength)
+{
+    max_entries_ = nMaxEntries;
+    max_length_ = nMaxLength;
+}
+
+void WireDictionary::Clear()
+{
+    ids_.clear();
+    strings_.clear();
+}
+
+WireDictionary::Kind WireDictionary::Intern(const std::string & s, unsigned int & nID)
+{
+    //empty strings are cheaper to send than to reference
+    if(s.empty() || s.size()>max_length_)
+        return LITERAL;
+
+    std::map<std::string,unsigned int>::iterator q = ids_.find(s);
+    if(q!=ids_.end())
+    {
+        nID = q->second;
+        return REFERENCE;
+    }
+
+    if(strings_.size()>=max_entries_)
+        return LITERAL;
+
+    nID = strings_.size();
+    ids_[s] = nID;
+    strings_.push_back(s);
+
+    return DEFINE;
+}
+
+bool WireDictionary::Define(const std::string & s)
+{
+    if(strings_.size()>=max_entries_)
+        return false;
+
+    strings_.push_back(s);
+    return true;
+}
+
+const std::string * WireDictionary::Lookup(unsigned int nID) const
+{
+    return nID<strings_.size() ? &strings_[nID] : NULL;
+}
+
+unsigned int WireDictionary::Size() const
+{
+    return strings_.size();
+}
+
+namespace CompactWire
+{
+
+/** the fields before the string references - they do not depend on the
+dictionary */
+static void EncodeHead(const CMOOSMsg & M, std::vector<unsigned char> & Out)
+{
+    unsigned char cFlags = 0;
+    if(M.m_dfVal!=-1)
+        cFlags|=kHasDouble;
+    if(M.GetDoubleAux()!=-1)
+        cFlags|=kHasDoubleAux;
+    if(!M.m_sVal.empty())
+        cFlags|=kHasString;
+
+    Out.push_back(static_cast<unsigned char>(M.m_cMsgType));
+    Out.push_back(static_cast<unsigned char>(M.m_cDataType));
+    Out.push_back(cFlags);
+
+    //zig-zag so the usual -1 and small ids take one byte
+    unsigned int nID = static_cast<unsigned int>(M.m_nID);
+    WriteVarint((nID<<1)^static_cast<unsigned int>(M.m_nID>>31),Out);
+}
+
+static void EncodeReferences(const CMOOSMsg & M, WireDictionary & Dictionary, std::vector<unsigned char> & Out)
+{
+    WriteReference(M.m_sSrc,Dictionary,Out);
+    WriteReference(M.m_sSrcAux,Dictionary,Out);
+    WriteReference(M.m_sOriginatingCommunity,Dictionary,Out);
+    WriteReference(M.m_sKey,Dictionary,Out);
+}
+
+/** the fields after the string references - they do not depend on the
+dictionary either */
+static void EncodeTail(const CMOOSMsg & M, std::vector<unsigned char> & Out)
+{
+    WriteDouble(M.m_dfTime,Out);
+
+    if(M.m_dfVal!=-1)
+        WriteDouble(M.m_dfVal,Out);
+
+    if(M.GetDoubleAux()!=-1)
+        WriteDouble(M.GetDoubleAux(),Out);
+
+    if(!M.m_sVal.empty())
+    {
+        WriteVarint(M.m_sVal.size(),Out);
+        WriteBytes(M.m_sVal,Out);
+    }
+}
+
+void Encode(const CMOOSMsg & M, WireDictionary & Dictionary, std::vector<unsigned char> & Out)
+{
+    EncodeHead(M,Out);
+    EncodeReferences(M,Dictionary,Out);
+    EncodeTail(M,Out);
+}
+
+unsigned int EncodeFixed(const CMOOSMsg & M, std::vector<unsigned char> & Fixed)
+{
+    Fixed.clear();
+    EncodeHead(M,Fixed);
+    unsigned int nHeadSize = Fixed.size();
+    EncodeTail(M,Fixed);
+    return nHeadSize;
+}
+
+void EncodeWithFixed(const CMOOSMsg & M,
+                     const unsigned char * pFixed,
+                     unsigned int nFixedSize,
+                     unsigned int nHeadSize,
+                     WireDictionary & Dictionary,
+                     std::vector<unsigned char> & Out)
+{
+    Out.insert(Out.end(),pFixed,pFixed+nHeadSize);
+    EncodeReferences(M,Dictionary,Out);
+    Out.insert(Out.end(),pFixed+nHeadSize,pFixed+nFixedSize);
+}
+
+int Decode(const unsigned char * pBuffer, int nLen, WireDictionary & Dictionary, CMOOSMsg & M)
+{
+    CompactReader R(pBuffer,nLen);
+
+    unsigned char cFlags = 0;
+    R.Read(M.m_cMsgType);
+    R.Read(M.m_cDataType);
+    R.Read(cFlags);
+
+    unsigned int nID = 0;
+    R.ReadVarint(nID);
+    M.m_nID = static_cast<int>((nID>>1)^(0u-(nID&1)));
+
+    R.ReadReference(Dictionary,M.m_sSrc);
+    R.ReadReference(Dictionary,M.m_sSrcAux);
+    R.ReadReference(Dictionary,M.m_sOriginatingCommunity);
+    R.ReadReference(Dictionary,M.m_sKey);
+
+    R.Read(M.m_dfTime);
+
+    M.m_dfVal = -1;
+    if(cFlags&kHasDouble)
+        R.Read(M.m_dfVal);
+
+    double dfAux = -1;
+    if(cFlags&kHasDoubleAux)
+        R.Read(dfAux);
+    M.SetDoubleAux(dfAux);
+
+    M.m_sVal.clear();
+    if(cFlags&kHasString)
+    {
+        unsigned int nSize = 0;
+        R.ReadVarint(nSize);
+        R.ReadBytes(nSize,M.m_sVal);
+    }
+
+    return R.good() ? R.used() : -1;
+}
+
+}
+
+}
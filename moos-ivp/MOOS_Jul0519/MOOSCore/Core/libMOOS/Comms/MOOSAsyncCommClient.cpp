@@ -75,6 +75,9 @@ MOOSAsyncCommClient::MOOSAsyncCommClient() {
     m_dfOutGoingDelay = 0.0;
     m_bPostNewestToFront = false;
 
+    //offer the compact wire format - DBs which don't know it ignore us
+    m_bCompactWireRequested = true;
+
 //    SetCommsControlTimeWarpScaleFactor(0.0);
 }
 ///default destructor
@@ -122,7 +125,7 @@ bool MOOSAsyncCommClient::Close(bool) {
     if (!ReadingThread_.Stop())
         return false;
 
-    OutGoingQueue_.Push(CMOOSMsg(MOOS_TERMINATE_CONNECTION,"-quit-", 0));
+    QueueOutGoingMail(CMOOSMsg(MOOS_TERMINATE_CONNECTION,"-quit-", 0));
 
     if (!WritingThread_.Stop())
         return false;
@@ -141,23 +144,109 @@ bool MOOSAsyncCommClient::Post(CMOOSMsg & Msg, bool bKeepMsgSourceName) {
 
     m_OutLock.Lock();
     {
-        if (OutGoingQueue_.Size() > OUTBOX_PENDING_LIMIT) {
-            std::cerr << MOOS::ConsoleColours::red() << "WARNING "
-                    << MOOS::ConsoleColours::reset()
-                    << "MOOSAsyncCommClient::Outbox is very full "
-                        "- ditching half of the unsent mail\n";
-
-            while (OutGoingQueue_.Size() > OUTBOX_PENDING_LIMIT / 2)
-                OutGoingQueue_.Pop();
-        }
-        OutGoingQueue_.AppendToMeInConstantTime(m_OutBox);
-        //std::cerr<<"OutGoingQueue_ : "<<OutGoingQueue_.Size()<<"\n";
+        MoveOutBoxToOutGoingQueue();
     }
     m_OutLock.UnLock();
 
     return true;
 }
 
+/**
+ * queue a message for the writing thread from any thread
+ * @param Msg
+ */
+void MOOSAsyncCommClient::QueueOutGoingMail(const CMOOSMsg & Msg)
+{
+    m_OutLock.Lock();
+    {
+        m_OutBox.push_back(Msg);
+        MoveOutBoxToOutGoingQueue();
+    }
+    m_OutLock.UnLock();
+}
+
+/**
+ * called with m_OutLock held (so however many threads post there is only
+ * ever one producer) to move the outbox to the lock free queue read by the
+ * writing thread. If the queue is full the rest waits in the outbox, which
+ * Post() keeps to a bounded size, until the writing thread collects it.
+ */
+void MOOSAsyncCommClient::MoveOutBoxToOutGoingQueue()
+{
+    while (!m_OutBox.empty() && OutGoingQueue_.Push(m_OutBox.front()))
+        m_OutBox.pop_front();
+
+    if (!m_OutBox.empty() && !OutBoxBacklog_.Acquire())
+    {
+        std::cerr << MOOS::ConsoleColours::red() << "WARNING "
+                << MOOS::ConsoleColours::reset()
+                << "MOOSAsyncCommClient::Outbox is very full "
+                    "- mail is waiting for the writing thread\n";
+    }
+
+    OutBoxBacklog_.Release(m_OutBox.empty() ? 0 : 1);
+}
+
+/**
+ * called with m_InLock held by whoever is reading m_InBox
+ */
+void MOOSAsyncCommClient::GatherInBox()
+{
+    InComingQueue_.AppendToOther(m_InBox);
+}
+
+/**
+ * hand received mail to the application. The lock free queue is used while
+ * it has room. If it fills (the application is not reading its mail) the
+ * rest goes to the inbox under the lock, as it always did, behind whatever
+ * was queued so the order is kept.
+ * @param Mail
+ */
+void MOOSAsyncCommClient::QueueInComingMail(MOOSMSG_LIST & Mail)
+{
+    MOOSMSG_LIST::iterator q = Mail.begin();
+    while (q != Mail.end() && InComingQueue_.Push(*q))
+        ++q;
+
+    if (q == Mail.end())
+        return;
+
+    m_InLock.Lock();
+    {
+        GatherInBox();
+
+        m_InBox.splice(m_InBox.end(), Mail, q, Mail.end());
+
+        if(m_InBox.size()>m_nInPendingLimit)
+        {
+            MOOSTrace("Too many unread incoming messages [%d] : purging\n",m_InBox.size());
+            MOOSTrace("The user must read mail occasionally");
+            m_InBox.clear();
+        }
+    }
+    m_InLock.UnLock();
+}
+
+unsigned int MOOSAsyncCommClient::GetInComingQueueHighWaterMark()
+{
+    return InComingQueue_.HighWaterMark();
+}
+
+unsigned int MOOSAsyncCommClient::GetInComingQueueRejections()
+{
+    return InComingQueue_.Rejections();
+}
+
+unsigned int MOOSAsyncCommClient::GetOutGoingQueueHighWaterMark()
+{
+    return OutGoingQueue_.HighWaterMark();
+}
+
+unsigned int MOOSAsyncCommClient::GetOutGoingQueueRejections()
+{
+    return OutGoingQueue_.Rejections();
+}
+
 bool MOOSAsyncCommClient::OnCloseConnection() {
     return BASE::OnCloseConnection();
 }
@@ -218,7 +307,7 @@ bool MOOSAsyncCommClient::WritingLoop() {
 
             while (!WritingThread_.IsQuitRequested() && IsConnected())
             {
-                if (OutGoingQueue_.Size()==0)
+                if (OutGoingQueue_.IsEmpty())
                 {
                     //this may timeout in which case we DoWriting() which may send
                     //a timing message (heart beat) in Do Writing...
@@ -269,7 +358,21 @@ bool MOOSAsyncCommClient::DoWriting() {
 
         MOOSMSG_LIST StuffToSend;
 
-        OutGoingQueue_.AppendToOtherInConstantTime(StuffToSend);
+        OutGoingQueue_.AppendToOther(StuffToSend);
+
+        //mail which found the queue full is waiting in the outbox. Under
+        //the lock nothing can be added to the queue so taking the queue
+        //then the outbox keeps it in order
+        if (OutBoxBacklog_.Acquire())
+        {
+            m_OutLock.Lock();
+            {
+                OutGoingQueue_.AppendToOther(StuffToSend);
+                StuffToSend.splice(StuffToSend.end(), m_OutBox);
+                OutBoxBacklog_.Release(0);
+            }
+            m_OutLock.UnLock();
+        }
 
         for (MOOSMSG_LIST::iterator q = StuffToSend.begin(); q
                 != StuffToSend.end(); ++q)
@@ -301,7 +404,12 @@ bool MOOSAsyncCommClient::DoWriting() {
 
         try
         {
-            PktTx.Serialize(StuffToSend, true);
+            //only this thread writes so the dictionary sees packets
+            //in the order they go down the socket
+            if (m_bCompactWire)
+                PktTx.SerializeCompact(StuffToSend, true, m_TxDictionary);
+            else
+                PktTx.Serialize(StuffToSend, true);
             m_nBytesSent += PktTx.GetStreamLength();
         }
         catch (const CMOOSException & e) {
@@ -366,7 +474,7 @@ bool MOOSAsyncCommClient::ReadingLoop() {
         {
             if (!DoReading())
             {
-                OutGoingQueue_.Push(
+                QueueOutGoingMail(
                                     CMOOSMsg(MOOS_TERMINATE_CONNECTION,
                                              "-quit-", 0));
 
@@ -408,92 +516,91 @@ bool MOOSAsyncCommClient::DoReading()
 
 		double dfLocalRxTime =MOOSLocalTime();
 
-		m_InLock.Lock();
-		{
-			if(m_InBox.size()>m_nInPendingLimit)
-			{
-				MOOSTrace("Too many unread incoming messages [%d] : purging\n",m_InBox.size());
-				MOOSTrace("The user must read mail occasionally");
-				m_InBox.clear();
-			}
-
-			//how big was inbox before we add new mail?
-			unsigned int nur = m_InBox.size();
-
-			//extract... and please leave NULL messages there
-			PktRx.Serialize(m_InBox,false,false,NULL);
-
-			m_nMsgsReceived+=m_InBox.size()-nur;
+		//everything up to handing the mail over is done without a lock -
+		//the application thread only meets us in the lock free queue
+		MOOSMSG_LIST Rx;
 
+		//extract... and please leave NULL messages there
+		if(PktRx.IsCompact())
+		{
+			if(!PktRx.SerializeCompact(Rx,false,m_RxDictionary))
+				throw CMOOSException("failed to decode compact packet");
+		}
+		else
+		{
+			PktRx.Serialize(Rx,false,false,NULL);
+		}
 
-			//now Serialize simply adds to the front of a list so looking
-			//at the first element allows us to check for timing information
-			//as supported by the threaded server class
+		m_nMsgsReceived+=Rx.size();
 
-            MOOSMSG_LIST::iterator q = m_InBox.begin();
-            std::advance(q,nur);
+		if(Rx.empty())
+			return true;
 
-            switch(q->GetType())
-            {
-                case MOOS_TIMING:
-                {
-                    //timing messages don't count in statisics
-                    m_nMsgsReceived--;
-                    //we have a fancy new DB upstream...
-                    //one that supports Asynchronous Clients
-
-                    if(m_bDoLocalTimeCorrection && GetNumPktsReceived()>1)
-                    {
+		//looking at the first element allows us to check for timing
+		//information as supported by the threaded server class
+		MOOSMSG_LIST::iterator q = Rx.begin();
 
-                        UpdateMOOSSkew(q->GetTime(),
-                                q->GetDouble(),
-                                dfLocalRxTime);
-                    }
+		switch(q->GetType())
+		{
+			case MOOS_TIMING:
+			{
+				//timing messages don't count in statisics
+				m_nMsgsReceived--;
+				//we have a fancy new DB upstream...
+				//one that supports Asynchronous Clients
 
-                    if(m_bDBIsAsynchronous)
-                    {
-                        //and we can update the outgoing thread's speed
-                        //as controlled by the DB.
-                        m_dfOutGoingDelay = q->GetDoubleAux();
+				if(m_bDoLocalTimeCorrection && GetNumPktsReceived()>1)
+				{
 
-                    }
+					UpdateMOOSSkew(q->GetTime(),
+							q->GetDouble(),
+							dfLocalRxTime);
+				}
 
-                    m_InBox.erase(q);
+				if(m_bDBIsAsynchronous)
+				{
+					//and we can update the outgoing thread's speed
+					//as controlled by the DB.
+					m_dfOutGoingDelay = q->GetDoubleAux();
 
-                    break;
-                }
-                case MOOS_NULL_MSG:
-                {
-                    //looks like we have an old fashioned DB which sends timing
-                    //info at the front of every packet in a null message
-                    //we have no corresponding outgoing packet so not much we can
-                    //do other than imagine it tooks as long to send to the
-                    //DB as to receive...
-                    double dfTimeSentFromDB = m_InBox.front().GetDouble();
-                    double dfSkew = dfTimeSentFromDB-dfLocalRxTime;
-                    double dfTimeSentToDBApprox =dfTimeSentFromDB+dfSkew;
-
-                    m_InBox.pop_front();
-
-                    if(m_bDoLocalTimeCorrection)
-                    {
-                        UpdateMOOSSkew(dfTimeSentToDBApprox,
-                                dfTimeSentFromDB,
-                                dfLocalRxTime);
-                    }
-
-                    break;
+				}
 
-                }
-            }
+				Rx.erase(q);
 
-			DispatchInBoxToActiveThreads();
+				break;
+			}
+			case MOOS_NULL_MSG:
+			{
+				//looks like we have an old fashioned DB which sends timing
+				//info at the front of every packet in a null message
+				//we have no corresponding outgoing packet so not much we can
+				//do other than imagine it tooks as long to send to the
+				//DB as to receive...
+				double dfTimeSentFromDB = Rx.front().GetDouble();
+				double dfSkew = dfTimeSentFromDB-dfLocalRxTime;
+				double dfTimeSentToDBApprox =dfTimeSentFromDB+dfSkew;
+
+				Rx.pop_front();
+
+				if(m_bDoLocalTimeCorrection)
+				{
+					UpdateMOOSSkew(dfTimeSentToDBApprox,
+							dfTimeSentFromDB,
+							dfLocalRxTime);
+				}
+
+				break;
 
-			m_bMailPresent = !m_InBox.empty();
+			}
+		}
 
+		DispatchToActiveThreads(Rx);
 
+		if(!Rx.empty())
+		{
+			QueueInComingMail(Rx);
+			m_bMailPresent = true;
 		}
-		m_InLock.UnLock();
 
 		//and here we can optionally give users an indication
 		//that mail has arrived...
@@ -62,6 +62,7 @@
 #include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
 #include "MOOS/libMOOS/Comms/MOOSCommClient.h"
 #include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
 #include "MOOS/libMOOS/Comms/MOOSSkewFilter.h"
 
 
@@ -129,6 +130,8 @@ CMOOSCommClient::CMOOSCommClient()
 
 	//assume an old DB
 	m_bDBIsAsynchronous = false;
+	m_bCompactWireRequested = false;
+	m_bCompactWire = false;
 
 	SetCommsControlTimeWarpScaleFactor(TIME_WARP_AGGLOMERATION_CONSTANT);
     
@@ -263,6 +266,7 @@ unsigned int CMOOSCommClient::GetNumberOfUnreadMessages()
 {
 
 	m_InLock.Lock();
+	GatherInBox();
 	unsigned int n = m_InBox.size();
 	m_InLock.UnLock();
 	return n;
@@ -333,6 +337,18 @@ void CMOOSCommClient::SetOnDisconnectCallBack(bool ( *pfn)( void * pConnectParam
 	m_pDisconnectCallBackParam = pParam;
 }
 
+/** ask to use the compact wire format from the next connection on.
+It is only used if the DB agrees (and only asynchronous clients ask) */
+void CMOOSCommClient::SetCompactWire(bool bCompact)
+{
+	m_bCompactWireRequested = bCompact;
+}
+
+bool CMOOSCommClient::IsCompactWire()
+{
+	return m_bCompactWire;
+}
+
 bool CMOOSCommClient::IsRunning()
 {
 	return m_ClientThread.IsThreadRunning();
@@ -775,6 +791,13 @@ bool CMOOSCommClient::DoClientWork()
 
 
 bool CMOOSCommClient::DispatchInBoxToActiveThreads()
+{
+	return DispatchToActiveThreads(m_InBox);
+}
+
+/** mail in Mail which is handled by an active queue is pushed to that
+queue and removed from Mail */
+bool CMOOSCommClient::DispatchToActiveThreads(MOOSMSG_LIST & Mail)
 {
 
 
@@ -788,10 +811,10 @@ bool CMOOSCommClient::DispatchInBoxToActiveThreads()
 	//before we start we can see if we have a default queue installed...
 	std::map<std::string, std::set<std::string> >::iterator q;
 
-	MOOSMSG_LIST::iterator t = m_InBox.begin();
+	MOOSMSG_LIST::iterator t = Mail.begin();
 
 	//iterate over all pending messages.
-	while(t!=m_InBox.end())
+	while(t!=Mail.end())
 	{
 
 #ifdef ENABLE_DETAILED_TIMING_AUDIT
@@ -895,7 +918,7 @@ bool CMOOSCommClient::DispatchInBoxToActiveThreads()
 	        //we have now handled this message remove it from the Inbox.
 		    MOOSMSG_LIST::iterator to_erase = t;
 		    ++t;
-		    m_InBox.erase(to_erase);
+		    Mail.erase(to_erase);
 		}
 		else
 		{
@@ -1089,6 +1112,11 @@ bool CMOOSCommClient::Fetch(MOOSMSG_LIST &MsgList)
 
 	m_InLock.Lock();
 
+	//cleared before gathering so mail arriving from now on is noticed
+	m_bMailPresent = false;
+
+	GatherInBox();
+
 	MOOSMSG_LIST::iterator p;
 
 	m_InBox.remove_if(IsNullMsg);
@@ -1099,13 +1127,17 @@ bool CMOOSCommClient::Fetch(MOOSMSG_LIST &MsgList)
 	//remove all elements
 	m_InBox.clear();
 
-	m_bMailPresent = false;
-
 	m_InLock.UnLock();
 
 	return !MsgList.empty();
 }
 
+/** called with m_InLock held before m_InBox is looked at. Derived
+classes which queue incoming mail elsewhere move it to m_InBox here */
+void CMOOSCommClient::GatherInBox()
+{
+}
+
 std::string CMOOSCommClient::HandShakeKey()
 {
 	//old MOOS Clients return empty string
@@ -1135,6 +1167,15 @@ bool CMOOSCommClient::HandShake()
 		//a little bit of handshaking..we need to say who we are
 		CMOOSMsg Msg(MOOS_DATA,HandShakeKey(),(char *)m_sMyName.c_str());
 
+		//and offer the compact wire format - old DBs ignore this
+		if(m_bCompactWireRequested)
+			MOOSAddValToString(Msg.m_sSrcAux,MOOS::CompactWire::kHandShakeToken,MOOS::CompactWire::kHandShakeVersion);
+
+		//anything interned on a previous connection is forgotten
+		m_bCompactWire = false;
+		m_TxDictionary.Clear();
+		m_RxDictionary.Clear();
+
 		SendMsg(m_pSocket,Msg);
 
 		CMOOSMsg WelcomeMsg;
@@ -1161,6 +1202,11 @@ bool CMOOSCommClient::HandShake()
             m_bDBIsAsynchronous = MOOSStrCmp(WelcomeMsg.GetString(),"asynchronous");
             MOOSValFromString(m_sDBHostAsSeenByDB,WelcomeMsg.m_sSrcAux,"hostname",true);
 
+            std::string sWire;
+            m_bCompactWire = m_bCompactWireRequested &&
+                    MOOSValFromString(sWire,WelcomeMsg.m_sSrcAux,MOOS::CompactWire::kHandShakeToken,true) &&
+                    sWire==MOOS::CompactWire::kHandShakeVersion;
+
 			if(!m_bQuiet)
 			{
 				std::cout<<MOOS::ConsoleColours::Green()<<"[ok]\n";
@@ -1183,6 +1229,14 @@ bool CMOOSCommClient::HandShake()
 
                 std::cout<<MOOS::ConsoleColours::reset();
 
+                if(m_bCompactWire)
+                {
+                    std::cout<<std::left<<std::setw(40);
+                    std::cout<<"  DB agrees compact wire format ";
+                    std::cout<<MOOS::ConsoleColours::Green()<<"[on]\n";
+                    std::cout<<MOOS::ConsoleColours::reset();
+                }
+
 
             	if(!WelcomeMsg.m_sSrcAux.empty())
             	{
@@ -1371,6 +1425,47 @@ bool CMOOSCommClient::Register(const std::string & sVarPattern,const std::string
 	return Post(MsgR);
 }
 
+bool CMOOSCommClient::RegisterLatestOnly(const std::string & sVar, double dfInterval)
+{
+	if(!IsConnected())
+		return false;
+
+	if(sVar.empty())
+		return MOOSFail("\n ** WARNING ** Cannot register for \"\" (empty string)\n");
+
+	//ask the DB to keep only the most recent unsent value of sVar for us.
+	//A DB which does not understand this treats it as a normal registration
+	CMOOSMsg MsgR(MOOS_REGISTER,sVar.c_str(),dfInterval);
+	MsgR.m_sVal = "LatestOnly=true";
+
+	bool bSuccess =  Post(MsgR);
+	if(bSuccess)
+	{
+		m_Registered.insert(sVar);
+	}
+	return bSuccess;
+}
+
+bool CMOOSCommClient::RegisterLatestOnly(const std::string & sVarPattern,const std::string & sAppPattern, double dfInterval)
+{
+	std::string sMsg;
+
+	if(sVarPattern.empty())
+	    return MOOSFail("empty variable pattern in CMOOSCommClient::RegisterLatestOnly");
+
+    if(sAppPattern.empty())
+        return MOOSFail("empty source pattern in CMOOSCommClient::RegisterLatestOnly");
+
+	MOOSAddValToString(sMsg,"AppPattern",sAppPattern);
+	MOOSAddValToString(sMsg,"VarPattern",sVarPattern);
+	MOOSAddValToString(sMsg,"Interval",dfInterval);
+	MOOSAddValToString(sMsg,"LatestOnly",std::string("true"));
+
+	CMOOSMsg MsgR(MOOS_WILDCARD_REGISTER,m_sMyName,sMsg);
+
+	return Post(MsgR);
+}
+
 
 
 bool CMOOSCommClient::IsRegisteredFor(const std::string & sVariable)
@@ -1531,6 +1626,8 @@ bool CMOOSCommClient::Peek(MOOSMSG_LIST & MsgList, int nIDRequired,bool bClear)
 
 	m_InLock.Lock();
 
+	GatherInBox();
+
 	MOOSMSG_LIST::iterator p,q;
 
 	p=m_InBox.begin();
@@ -1665,6 +1762,7 @@ bool CMOOSCommClient::ClearResources()
 	m_OutLock.UnLock();
 
 	m_InLock.Lock();
+		GatherInBox();
 		m_InBox.clear();
 	m_InLock.UnLock();
 
@@ -33,13 +33,48 @@
 
 #include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
 #include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
+#include "MOOS/libMOOS/Comms/MsgView.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 
 
 using namespace std;
 
+//note +1 is for indicator regarding compressed or not compressed
+static const unsigned int kPktHeaderSize = 2 * sizeof(int) + 1;
+
+/** write the packet header (total byte count, number of messages and the
+format flag) to the start of pStream, swapping byte order if needed */
+static void WritePktHeader(unsigned char * pStream,int nByteCount,int nMessages,unsigned char cFlag = 0)
+{
+    unsigned char * pNext = pStream;
+
+    int nBC = IsLittleEndian() ? nByteCount : SwapByteOrder<int> (nByteCount);
+    memcpy((void*) pNext, (void*) (&nBC), sizeof(nBC));
+    pNext += sizeof(nBC);
+
+    int nM = IsLittleEndian() ? nMessages : SwapByteOrder<int> (nMessages);
+    memcpy((void*) pNext, (void*) (&nM), sizeof(nM));
+    pNext += sizeof(nM);
+
+    //this byte once meant compressed - now it says which wire format follows
+    *pNext = cFlag;
+}
+
+/** read back what WritePktHeader wrote */
+static void ReadPktHeader(const unsigned char * pStream,int & nByteCount,int & nMessages)
+{
+    memcpy((void*) (&nByteCount), (const void*) pStream, sizeof(nByteCount));
+    nByteCount = IsLittleEndian() ? nByteCount : SwapByteOrder<int> (nByteCount);
+
+    memcpy((void*) (&nMessages), (const void*) (pStream + sizeof(int)), sizeof(nMessages));
+    nMessages = IsLittleEndian() ? nMessages : SwapByteOrder<int> (nMessages);
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -140,8 +175,7 @@ bool CMOOSCommPkt::Serialize(MOOSMSG_LIST &List,
                              bool bToStream,
                              bool bNoNULL,
                              double * pdfPktTime) {
-    //note +1 is for indicator regarding compressed or not compressed
-    unsigned int nHeaderSize = 2 * sizeof(int) + 1;
+    unsigned int nHeaderSize = kPktHeaderSize;
 
     if (bToStream) {
 
@@ -180,30 +214,10 @@ bool CMOOSCommPkt::Serialize(MOOSMSG_LIST &List,
 
         }
 
-        unsigned char bCompressed = 0;
-
-        //finally write how many bytes we have written at the start
-        //look for need to swap byte order if required
-        m_pNextData = m_pStream;
-        int nBC = IsLittleEndian()
-                                   ? m_nByteCount
-                                   : SwapByteOrder<int> (m_nByteCount);
-
-        memcpy((void*) m_pNextData, (void*) (&nBC), sizeof(m_nByteCount));
-        m_pNextData += sizeof(m_nByteCount);
-
-        //and then how many messages are included
-        //look for need to swap byte order if required
-        int nMessages = List.size();
-        nMessages = IsLittleEndian()
-                                     ? nMessages
-                                     : SwapByteOrder<int> (nMessages);
-        memcpy((void*) m_pNextData, (void*) (&nMessages), sizeof(nMessages));
-        m_pNextData += sizeof(nMessages);
-
-        //and is this a compressed message or not?
-        *m_pNextData = bCompressed;
-        m_pNextData += 1;
+        //finally write how many bytes and messages we have written
+        //at the start (and whether or not this is compressed)
+        WritePktHeader(m_pStream,m_nByteCount,List.size());
+        m_pNextData = m_pStream + nHeaderSize;
 
     } else {
 
@@ -273,3 +287,194 @@ bool CMOOSCommPkt::Serialize(MOOSMSG_LIST &List,
     return true;
 }
 
+
+/** Decodes the messages in a received packet as views into the packet
+buffer. Unlike Serialize(List,false) no strings are allocated - the views
+are only good while this packet is alive and unchanged */
+bool CMOOSCommPkt::ViewMessages(MOOS::MSG_VIEW_VECTOR & Views,
+                                bool bNoNULL,
+                                double * pdfPktTime) const
+{
+    int nByteCount = 0;
+    int nMessages = 0;
+    ReadPktHeader(m_pStream,nByteCount,nMessages);
+
+    const unsigned char * pNext = m_pStream + kPktHeaderSize;
+    int nSpaceFree = nByteCount - kPktHeaderSize;
+
+    //the count comes off the wire so only reserve as many views as the
+    //bytes actually present could hold
+    if(nMessages>0 && nSpaceFree>0)
+    {
+        int nMostMessages = nSpaceFree/MOOS::MsgView::MinWireSize();
+        Views.reserve(Views.size()+std::min(nMessages,nMostMessages));
+    }
+
+    for (int i = 0; i < nMessages; i++)
+    {
+        MOOS::MsgView View;
+        int nUsed = View.Decode(pNext, nSpaceFree);
+        if (nUsed == -1)
+        {
+            //bad news...
+            return false;
+        }
+
+        if (View.IsType(MOOS_NULL_MSG) && pdfPktTime != NULL && i == 0)
+            *pdfPktTime = View.GetDouble();
+
+        //allows us to not store NULL messages
+        if (!(bNoNULL && View.IsType(MOOS_NULL_MSG)))
+            Views.push_back(View);
+
+        pNext += nUsed;
+        nSpaceFree -= nUsed;
+    }
+
+    return true;
+}
+
+/** Stuffs shared messages into a packet. Each message was serialised when it
+was published so here we only copy ready made wire bytes one after another */
+bool CMOOSCommPkt::Serialize(const MOOS::SHARED_MSG_LIST & List)
+{
+    m_nMsgLen = 0;
+    m_nByteCount = 0;
+    m_nMsgsSerialised = 0;
+
+    unsigned int nBufferSize = kPktHeaderSize;
+    MOOS::SHARED_MSG_LIST::const_iterator p;
+    for (p = List.begin(); p != List.end(); ++p) {
+        nBufferSize += p->WireSize();
+    }
+
+    InflateTo(nBufferSize);
+
+    m_pNextData = m_pStream + kPktHeaderSize;
+    m_nByteCount += kPktHeaderSize;
+
+    for (p = List.begin(); p != List.end(); ++p)
+    {
+        unsigned int nCopied = p->WireSize();
+        memcpy(m_pNextData, p->Wire(), nCopied);
+
+        m_pNextData += nCopied;
+        m_nByteCount += nCopied;
+        m_nMsgsSerialised++;
+    }
+
+    WritePktHeader(m_pStream,m_nByteCount,m_nMsgsSerialised);
+
+    m_nMsgLen = m_nByteCount;
+
+    return true;
+}
+
+/** Stuffs shared messages into a compact (version 2) packet. Only the string
+references are encoded here - the rest of each message was encoded when it
+was published */
+bool CMOOSCommPkt::SerializeCompact(const MOOS::SHARED_MSG_LIST & List,
+                                    MOOS::WireDictionary & Dictionary)
+{
+    std::vector<unsigned char> Body;
+    MOOS::SHARED_MSG_LIST::const_iterator p;
+
+    unsigned int nBodySize = 0;
+    for (p = List.begin(); p != List.end(); ++p)
+        nBodySize += p->CompactFixedSize()+16;
+    Body.reserve(nBodySize);
+
+    for (p = List.begin(); p != List.end(); ++p)
+    {
+        MOOS::CompactWire::EncodeWithFixed(p->Msg(),
+                                           p->CompactFixed(),
+                                           p->CompactFixedSize(),
+                                           p->CompactHeadSize(),
+                                           Dictionary,
+                                           Body);
+    }
+
+    //nothing in the old buffer is kept so InflateTo() need copy nothing
+    m_nByteCount = 0;
+    InflateTo(kPktHeaderSize + Body.size());
+
+    m_nByteCount = kPktHeaderSize + Body.size();
+    m_nMsgsSerialised = List.size();
+
+    if (!Body.empty())
+        memcpy(m_pStream + kPktHeaderSize, &Body[0], Body.size());
+
+    WritePktHeader(m_pStream,m_nByteCount,m_nMsgsSerialised,MOOS::CompactWire::kPktFlag);
+    m_pNextData = m_pStream + kPktHeaderSize;
+
+    m_nMsgLen = m_nByteCount;
+
+    return true;
+}
+
+/** true if this packet holds messages in the compact (version 2) format */
+bool CMOOSCommPkt::IsCompact() const
+{
+    return m_nByteCount >= (int) kPktHeaderSize &&
+            m_pStream[2*sizeof(int)] == MOOS::CompactWire::kPktFlag;
+}
+
+/** Stuffs messages in/from a packet using the compact (version 2) format.
+Dictionary must be the one belonging to this direction of the connection
+and packets must be decoded in the order they were encoded */
+bool CMOOSCommPkt::SerializeCompact(MOOSMSG_LIST & List,
+                                    bool bToStream,
+                                    MOOS::WireDictionary & Dictionary)
+{
+    if (bToStream)
+    {
+        std::vector<unsigned char> Body;
+        Body.reserve(32*List.size());
+
+        MOOSMSG_LIST::iterator p;
+        for (p = List.begin(); p != List.end(); ++p)
+            MOOS::CompactWire::Encode(*p, Dictionary, Body);
+
+        //nothing in the old buffer is kept so InflateTo() need copy nothing
+        m_nByteCount = 0;
+        InflateTo(kPktHeaderSize + Body.size());
+
+        m_nByteCount = kPktHeaderSize + Body.size();
+        m_nMsgsSerialised = List.size();
+
+        if (!Body.empty())
+            memcpy(m_pStream + kPktHeaderSize, &Body[0], Body.size());
+
+        WritePktHeader(m_pStream,m_nByteCount,m_nMsgsSerialised,MOOS::CompactWire::kPktFlag);
+        m_pNextData = m_pStream + kPktHeaderSize;
+    }
+    else
+    {
+        int nByteCount = 0;
+        int nMessages = 0;
+        ReadPktHeader(m_pStream,nByteCount,nMessages);
+
+        const unsigned char * pNext = m_pStream + kPktHeaderSize;
+        int nSpaceFree = std::min(nByteCount,m_nByteCount) - (int) kPktHeaderSize;
+
+        for (int i = 0; i < nMessages; i++)
+        {
+            CMOOSMsg Msg;
+            int nUsed = MOOS::CompactWire::Decode(pNext, nSpaceFree, Dictionary, Msg);
+            if (nUsed == -1)
+            {
+                //the dictionary can no longer be trusted either
+                return false;
+            }
+
+            List.push_back(Msg);
+
+            pNext += nUsed;
+            nSpaceFree -= nUsed;
+        }
+    }
+
+    m_nMsgLen = m_nByteCount;
+
+    return true;
+}
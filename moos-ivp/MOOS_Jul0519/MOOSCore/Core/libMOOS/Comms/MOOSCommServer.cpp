@@ -42,6 +42,8 @@
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
 #include "MOOS/libMOOS/Comms/MOOSCommServer.h"
 #include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
 #include "MOOS/libMOOS/Utils/MOOSException.h"
 #include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
 #include "MOOS/libMOOS/Utils/ThreadPriority.h"
@@ -129,6 +131,11 @@ CMOOSCommServer::CMOOSCommServer()
     m_pfnDisconnectCallBack = NULL;
     m_pfnConnectCallBack = NULL;
 	m_pfnFetchAllMailCallBack = NULL;
+	m_pfnFetchAllSharedMailCallBack = NULL;
+	m_pfnFetchReplySharedMailCallBack = NULL;
+	m_pfnFetchClientsWithMailCallBack = NULL;
+	m_pfnRxViewsCallBack = NULL;
+	m_bCompactWire = true;
     m_sCommunityName = "#1";
     m_bQuiet  = false;
 	m_bDisableNameLookUp = true;
@@ -178,6 +185,7 @@ bool CMOOSCommServer::Stop()
     m_ClientSocketList.clear();
     m_Socket2ClientMap.clear();
     m_AsynchronousClientSet.clear();
+    m_CompactWireClientSet.clear();
     m_ClientTimingVector.clear();
 
     return true;
@@ -193,6 +201,16 @@ void CMOOSCommServer::SetWarningLatencyMS(double dfPeriod)
 	m_dfCommsLatencyConcern = dfPeriod/1000.0;
 }
 
+void CMOOSCommServer::SetCompactWire(bool bCompact)
+{
+	m_bCompactWire = bCompact;
+}
+
+bool CMOOSCommServer::IsCompactWire(const std::string & sClient)
+{
+	return m_CompactWireClientSet.find(sClient)!=m_CompactWireClientSet.end();
+}
+
 
 bool CMOOSCommServer::Run(long lPort, const string & sCommunityName,bool bDisableNameLookUp,unsigned int nAuditPort)
 {
@@ -694,7 +712,11 @@ bool CMOOSCommServer::ProcessClient()
             }
 
             //stuff reply mesage into a packet
-            PktTx.Serialize(MsgLstTx,true);
+            MOOS::SHARED_MSG_LIST SharedTx;
+            if(GatherSharedReply(sWho,MsgLstTx,true,SharedTx))
+                PktTx.Serialize(SharedTx);
+            else
+                PktTx.Serialize(MsgLstTx,true);
 
             //send packet
             SendPkt(m_pFocusSocket,PktTx);
@@ -760,6 +782,11 @@ bool CMOOSCommServer::OnNewClient(XPCTcpSocket * pNewClient,char * sName)
                 std::cout<<"  Type          :  "<<MOOS::ConsoleColours::green()<<"Synchronous"<<MOOS::ConsoleColours::reset()<<"\n";
             }
 
+            if(IsCompactWire(sName))
+            {
+                std::cout<<"  Wire format   :  "<<MOOS::ConsoleColours::Yellow()<<"compact"<<MOOS::ConsoleColours::reset()<<"\n";
+            }
+
             if(m_bBoostIOThreads)
             {
                 std::cout<<"  Priority      :  "<<MOOS::ConsoleColours::Yellow()<<"raised"<<MOOS::ConsoleColours::reset()<<"\n";
@@ -822,6 +849,7 @@ bool CMOOSCommServer::OnClientDisconnect()
 
         m_Socket2ClientMap.erase(p);
         m_AsynchronousClientSet.erase(sWho);
+        m_CompactWireClientSet.erase(sWho);
     }
 
 
@@ -895,6 +923,72 @@ void CMOOSCommServer::SetOnFetchAllMailCallBack(bool (*pfn)(const std::string  &
 
 }
 
+void CMOOSCommServer::SetOnFetchAllSharedMailCallBack(bool (*pfn)(const std::string  & sClient,MOOS::SHARED_MSG_LIST & MsgListTx,void * pParam),void * pParam)
+{
+    //address of function to invoke (static)
+	m_pfnFetchAllSharedMailCallBack = pfn;
+
+	//store the parameter to pass with the invocation
+	m_pFetchAllSharedMailCallBackParam = pParam;
+}
+
+void CMOOSCommServer::SetOnFetchReplySharedMailCallBack(bool (*pfn)(const std::string  & sClient,MOOS::SHARED_MSG_LIST & MsgListTx,void * pParam),void * pParam)
+{
+    //address of function to invoke (static)
+	m_pfnFetchReplySharedMailCallBack = pfn;
+
+	//store the parameter to pass with the invocation
+	m_pFetchReplySharedMailCallBackParam = pParam;
+}
+
+/**
+ * make the reply to a client's packet from the shared mail the owner holds
+ * for it, so that mail is never copied back into a MOOSMSG_LIST
+ * @param sWho the client being replied to
+ * @param MsgLstTx replies made by the owner (emptied). If bHeader its first
+ * message is the null or timing message which must lead the packet
+ * @param bHeader true if MsgLstTx begins with the null or timing message
+ * @param SharedTx the whole reply in the order it is to be sent
+ * @return false if the owner does not share mail (MsgLstTx is untouched)
+ */
+bool CMOOSCommServer::GatherSharedReply(const std::string & sWho,MOOSMSG_LIST & MsgLstTx,bool bHeader,MOOS::SHARED_MSG_LIST & SharedTx)
+{
+    if(m_pfnFetchReplySharedMailCallBack==NULL)
+        return false;
+
+    (*m_pfnFetchReplySharedMailCallBack)(sWho,SharedTx,m_pFetchReplySharedMailCallBackParam);
+
+    //the owner's own replies are few and are serialised once here
+    MOOSMSG_LIST::iterator p = MsgLstTx.begin();
+    if(bHeader && p!=MsgLstTx.end())
+        SharedTx.push_front(MOOS::SharedMsg(*p++));
+
+    for(;p!=MsgLstTx.end();++p)
+        SharedTx.push_back(MOOS::SharedMsg(*p));
+
+    MsgLstTx.clear();
+
+    return true;
+}
+
+void CMOOSCommServer::SetOnRxViewsCallBack(bool (*pfn)(const std::string & sClient,MOOS::MSG_VIEW_VECTOR & ViewsRx,MOOSMSG_LIST & MsgListTx, void * pParam),void * pParam)
+{
+    //address of function to invoke (static)
+	m_pfnRxViewsCallBack = pfn;
+
+	//store the parameter to pass with the invocation
+	m_pRxViewsCallBackParam = pParam;
+}
+
+void CMOOSCommServer::SetOnFetchClientsWithMailCallBack(bool (*pfn)(std::set<std::string> & Clients,void * pParam),void * pParam)
+{
+    //address of function to invoke (static)
+	m_pfnFetchClientsWithMailCallBack = pfn;
+
+	//store the parameter to pass with the invocation
+	m_pFetchClientsWithMailCallBackParam = pParam;
+}
+
 bool CMOOSCommServer::IsUniqueName(string &sClientName)
 {
     SOCKETFD_2_CLIENT_NAME_MAP::iterator p;
@@ -968,6 +1062,16 @@ bool CMOOSCommServer::HandShake(XPCTcpSocket *pNewClient)
                 if(MOOSStrCmp(Msg.m_sKey,"asynchronous"))
                 {
                 	m_AsynchronousClientSet.insert(Msg.m_sVal);
+
+                	//does it want to talk the compact wire format? old
+                	//clients say nothing and so talk the original
+                	std::string sWire;
+                	if(m_bCompactWire && SupportsCompactWire() &&
+                			MOOSValFromString(sWire,Msg.m_sSrcAux,MOOS::CompactWire::kHandShakeToken,true) &&
+                			sWire==MOOS::CompactWire::kHandShakeVersion)
+                	{
+                		m_CompactWireClientSet.insert(Msg.m_sVal);
+                	}
                 }
 
             }
@@ -994,6 +1098,8 @@ bool CMOOSCommServer::HandShake(XPCTcpSocket *pNewClient)
         MsgW.m_sVal = "asynchronous";
         std::string sAux;
         MOOSAddValToString(sAux,"hostname",GetLocalIPAddress());
+        if(IsCompactWire(Msg.m_sVal))
+        	MOOSAddValToString(sAux,MOOS::CompactWire::kHandShakeToken,MOOS::CompactWire::kHandShakeVersion);
 
         MsgW.m_sSrcAux = sAux;
         MsgW.m_sOriginatingCommunity = m_sCommunityName;
@@ -1039,6 +1145,24 @@ bool CMOOSCommServer::SupportsAsynchronousClients()
 	return false;
 }
 
+/** the compact wire format is only spoken by the per client threads of
+ * the threaded server - this server always replies in the classic format */
+bool CMOOSCommServer::SupportsCompactWire()
+{
+	return false;
+}
+
+/**
+ * tell the server the owner has mail waiting which it made while no packet
+ * was being processed. Safe to call from any thread. Clients here only get
+ * mail when they call in so there is nothing to do
+ * @return true if the mail will be pushed to clients
+ */
+bool CMOOSCommServer::PostMailWaiting()
+{
+	return false;
+}
+
 void CMOOSCommServer::DoBanner()
 {
     if(m_bQuiet)
@@ -0,0 +1,301 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MsgView.cpp
+ */
+
+#include "MOOS/libMOOS/Comms/MsgView.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <cstring>
+
+namespace
+{
+
+/** walks a buffer reading values in the order and byte order used by
+CMOOSMsg::Serialize. Any read past the end marks the reader as bad */
+class WireReader
+{
+public:
+    WireReader(const unsigned char * pBuffer, int nLen)
+    {
+        next_ = pBuffer;
+        start_ = pBuffer;
+        len_ = nLen;
+        good_ = true;
+    }
+
+    template<class T> void Read(T & Val)
+    {
+        if(!CanRead(sizeof(T)))
+            return;
+
+        memcpy((void*)(&Val),(const void*)(next_),sizeof(T));
+        if(!IsLittleEndian())
+            Val = SwapByteOrder<T>(Val);
+        next_+=sizeof(T);
+    }
+
+    void Read(char & cVal)
+    {
+        if(!CanRead(sizeof(cVal)))
+            return;
+
+        cVal = static_cast<char>(*next_);
+        next_+=sizeof(cVal);
+    }
+
+    void Read(MOOS::StringRef & sVal)
+    {
+        int nSize = 0;
+        Read(nSize);
+        if(nSize<0 || !CanRead(nSize))
+        {
+            good_ = false;
+            return;
+        }
+
+        sVal = MOOS::StringRef((const char*)next_,nSize);
+        next_+=nSize;
+    }
+
+    bool good() const
+    {
+        return good_;
+    }
+
+private:
+    bool CanRead(int N)
+    {
+        good_ = good_ && (next_-start_)+N<=len_;
+        return good_;
+    }
+
+    const unsigned char * next_;
+    const unsigned char * start_;
+    int len_;
+    bool good_;
+};
+
+}
+
+namespace MOOS
+{
+
+StringRef::StringRef() : data_(""), size_(0)
+{
+}
+
+StringRef::StringRef(const char * pData, unsigned int nSize) : data_(pData), size_(nSize)
+{
+}
+
+const char * StringRef::data() const
+{
+    return data_;
+}
+
+unsigned int StringRef::size() const
+{
+    return size_;
+}
+
+bool StringRef::empty() const
+{
+    return size_==0;
+}
+
+std::string StringRef::str() const
+{
+    return std::string(data_,size_);
+}
+
+void StringRef::AssignTo(std::string & s) const
+{
+    s.assign(data_,size_);
+}
+
+bool StringRef::operator == (const std::string & s) const
+{
+    return s.size()==size_ && memcmp(s.data(),data_,size_)==0;
+}
+
+bool StringRef::operator != (const std::string & s) const
+{
+    return !(*this==s);
+}
+
+std::ostream & operator << (std::ostream & os, const StringRef & s)
+{
+    return os.write(s.data(),s.size());
+}
+
+MsgView::MsgView()
+{
+    wire_ = NULL;
+    wire_size_ = 0;
+    id_ = -1;
+    msg_type_ = MOOS_NULL_MSG;
+    data_type_ = MOOS_DOUBLE;
+    time_ = -1;
+    double_ = -1;
+    double_aux_ = -1;
+}
+
+int MsgView::Decode(const unsigned char * pBuffer, int nLen)
+{
+    WireReader R(pBuffer,nLen);
+
+    //the same fields in the same order as CMOOSMsg::Serialize
+    int nLength = 0;
+    R.Read(nLength);
+    R.Read(id_);
+    R.Read(msg_type_);
+    R.Read(data_type_);
+    R.Read(source_);
+    R.Read(source_aux_);
+    R.Read(community_);
+    R.Read(key_);
+    R.Read(time_);
+    R.Read(double_);
+    R.Read(double_aux_);
+    R.Read(string_);
+
+    if(!R.good() || nLength<=0 || nLength>nLen)
+        return -1;
+
+    wire_ = pBuffer;
+    wire_size_ = nLength;
+
+    return nLength;
+}
+
+int MsgView::MinWireSize()
+{
+    //length, id, two type chars, five string lengths and three doubles
+    return 2*sizeof(int)+2*sizeof(char)+5*sizeof(int)+3*sizeof(double);
+}
+
+int MsgView::GetID() const
+{
+    return id_;
+}
+
+char MsgView::GetType() const
+{
+    return msg_type_;
+}
+
+bool MsgView::IsType(char cType) const
+{
+    return msg_type_==cType;
+}
+
+char MsgView::GetDataType() const
+{
+    return data_type_;
+}
+
+bool MsgView::IsDouble() const
+{
+    return data_type_==MOOS_DOUBLE;
+}
+
+bool MsgView::IsString() const
+{
+    return data_type_==MOOS_STRING || data_type_==MOOS_BINARY_STRING;
+}
+
+bool MsgView::IsBinary() const
+{
+    return data_type_==MOOS_BINARY_STRING;
+}
+
+const StringRef & MsgView::GetSource() const
+{
+    return source_;
+}
+
+const StringRef & MsgView::GetSourceAux() const
+{
+    return source_aux_;
+}
+
+const StringRef & MsgView::GetCommunity() const
+{
+    return community_;
+}
+
+const StringRef & MsgView::GetKey() const
+{
+    return key_;
+}
+
+const StringRef & MsgView::GetString() const
+{
+    return string_;
+}
+
+double MsgView::GetTime() const
+{
+    return time_;
+}
+
+double MsgView::GetDouble() const
+{
+    return double_;
+}
+
+double MsgView::GetDoubleAux() const
+{
+    return double_aux_;
+}
+
+const unsigned char * MsgView::Wire() const
+{
+    return wire_;
+}
+
+unsigned int MsgView::WireSize() const
+{
+    return wire_size_;
+}
+
+void MsgView::ToMsg(CMOOSMsg & M) const
+{
+    M.m_nID = id_;
+    M.m_cMsgType = msg_type_;
+    M.m_cDataType = data_type_;
+    source_.AssignTo(M.m_sSrc);
+    source_aux_.AssignTo(M.m_sSrcAux);
+    community_.AssignTo(M.m_sOriginatingCommunity);
+    key_.AssignTo(M.m_sKey);
+    M.m_dfTime = time_;
+    M.m_dfVal = double_;
+    M.SetDoubleAux(double_aux_);
+    string_.AssignTo(M.m_sVal);
+}
+
+}
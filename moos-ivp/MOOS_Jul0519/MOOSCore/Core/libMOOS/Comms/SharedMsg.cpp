@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * SharedMsg.cpp
+ */
+
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
+#include "MOOS/libMOOS/Utils/MOOSException.h"
+
+namespace MOOS
+{
+
+SharedMsg::SharedMsg()
+{
+}
+
+SharedMsg::SharedMsg(const CMOOSMsg & M) : _pPayload(new Payload)
+{
+    _pPayload->_Msg = M;
+
+    //serialise now, while we are the only owner, so that the payload
+    //is never written to again once it is shared between mailboxes
+    unsigned int nSize = _pPayload->_Msg.GetSizeInBytesWhenSerialised();
+    _pPayload->_Wire.resize(nSize);
+
+    int nWritten = _pPayload->_Msg.Serialize(&_pPayload->_Wire[0],nSize);
+    if(nWritten<0)
+        throw CMOOSException("SharedMsg::SharedMsg() failed to serialise message");
+
+    _pPayload->_Wire.resize(nWritten);
+
+    //and the compact form, less the per connection string references
+    _pPayload->_nCompactHead = MOOS::CompactWire::EncodeFixed(_pPayload->_Msg,
+                                                             _pPayload->_CompactFixed);
+}
+
+bool SharedMsg::IsNull() const
+{
+    return _pPayload.isNull();
+}
+
+const CMOOSMsg & SharedMsg::Msg() const
+{
+    return _pPayload->_Msg;
+}
+
+const unsigned char * SharedMsg::Wire() const
+{
+    return &(_pPayload->_Wire[0]);
+}
+
+unsigned int SharedMsg::WireSize() const
+{
+    return _pPayload->_Wire.size();
+}
+
+const unsigned char * SharedMsg::CompactFixed() const
+{
+    return &(_pPayload->_CompactFixed[0]);
+}
+
+unsigned int SharedMsg::CompactFixedSize() const
+{
+    return _pPayload->_CompactFixed.size();
+}
+
+unsigned int SharedMsg::CompactHeadSize() const
+{
+    return _pPayload->_nCompactHead;
+}
+
+int SharedMsg::ReferenceCount() const
+{
+    return _pPayload.referenceCount();
+}
+
+}
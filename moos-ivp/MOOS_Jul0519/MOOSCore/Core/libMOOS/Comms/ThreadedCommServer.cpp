@@ -41,11 +41,15 @@
 #include "MOOS/libMOOS/Utils/MOOSException.h"
 #include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
 #include "MOOS/libMOOS/Comms/ThreadedCommServer.h"
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
+#include "MOOS/libMOOS/Comms/MsgView.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
 #include "MOOS/libMOOS/Utils/ThreadPrint.h"
 #include "MOOS/libMOOS/Utils/ThreadPriority.h"
 #include <iomanip>
 #include <iterator>
+#include <set>
 #include <algorithm>
 
 
@@ -171,6 +175,7 @@ bool ThreadedCommServer::AddAndStartClientThread(XPCTcpSocket & NewClientSocket,
     		NewClientSocket,
     		m_SharedDataListFromClient,
     		bAsync,
+    		IsCompactWire(sName),
     		dfConsolidationTime,
     		m_dfClientTimeout,
     		m_bBoostIOThreads);
@@ -232,6 +237,10 @@ bool ThreadedCommServer::ServerLoop()
                 m_Auditor.Remove(SDFromClient._sClientName);
                 break;
 
+            case ClientThreadSharedData::MAIL_WAITING:
+                PushMailToClients(SDFromClient._sClientName,m_Auditor);
+                break;
+
             default:
                 break;
         }
@@ -243,6 +252,31 @@ bool ThreadedCommServer::ServerLoop()
 
 
 
+/**
+ * is there a notification in Rx? (and complain about any which arrived late)
+ * @param Rx messages or views of messages
+ * @param dfTNow
+ * @param dfLargeDelay
+ * @return true if Rx holds a notification
+ */
+template <class T>
+bool FindNotification(const T & Rx,double dfTNow,double dfLargeDelay)
+{
+    typename T::const_iterator q;
+    for(q = Rx.begin();q!=Rx.end();++q)
+    {
+    	if(q->IsType(MOOS_NOTIFY))
+    	{
+    		if(dfTNow-q->GetTime()>dfLargeDelay)
+    		{
+    			std::cout<<"WARNING : Message "<<q->GetKey()<<" from "<<q->GetSource()<<" is "<<(dfTNow-q->GetTime())*1000<<" ms delayed\n";
+    		}
+    		return true;
+    	}
+    }
+    return false;
+}
+
 /**
  * the main handler  - a Pkt has been fetch off the work list (and is in SD)
  * we now invoke a callback and then place the return packet in the
@@ -278,46 +312,60 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             double dfTNow = MOOS::Time();
 
             MOOSMSG_LIST MsgLstRx,MsgLstTx;
+            MOOS::MSG_VIEW_VECTOR ViewsRx;
+
+            //if the owner can work with views of the messages in the packet
+            //there is no need to make a CMOOSMsg for each of them. Compact
+            //packets have no CMOOSMsg wire bytes to view so are decoded
+            bool bCompact = SDFromClient._pPkt->IsCompact();
+            bool bViews = m_pfnRxViewsCallBack!=NULL && !bCompact;
+            if(bViews)
+            	SDFromClient._pPkt->ViewMessages(ViewsRx);
+            else if(bCompact)
+            {
+            	if(!SDFromClient._pPkt->SerializeCompact(MsgLstRx,false,pClient->RxDictionary()))
+            		return MOOSFail("failed to decode compact packet from %s",sWho.c_str());
+            }
+            else
+            	SDFromClient._pPkt->Serialize(MsgLstRx,false);
 
-            //convert to list of messages
-            SDFromClient._pPkt->Serialize(MsgLstRx,false);
+            unsigned int nRx = bViews ? ViewsRx.size() : MsgLstRx.size();
 
-            Auditor.AddStatistic(sWho,SDFromClient._pPkt->GetStreamLength(),MsgLstRx.size(),dfTNow,true);
+            Auditor.AddStatistic(sWho,SDFromClient._pPkt->GetStreamLength(),nRx,dfTNow,true);
 
-			if(MsgLstRx.empty())
+			if(nRx==0)
 			{
 				std::cerr<<"very strange there is no content in the Pkt\n";
 				return false;
 			}
 
             //is there any sort of notification going on here?
-            bool bIsNotification = false;
             double dfLargeDelay = m_dfCommsLatencyConcern*GetMOOSTimeWarp();
-            for(MOOSMSG_LIST::iterator q = MsgLstRx.begin();q!=MsgLstRx.end();++q)
-            {
-            	if(q->IsType(MOOS_NOTIFY))
-            	{
-            		if(dfTNow-q->GetTime()>dfLargeDelay)
-            		{
-            			std::cout<<"WARNING : Message "<<q->GetKey()<<" from "<<q->GetSource()<<" is "<<(dfTNow-q->GetTime())*1000<<" ms delayed\n";
-            		}
-            		bIsNotification= true;
-            		break;
-            	}
-            }
+            bool bIsNotification = bViews ?
+            		FindNotification(ViewsRx,dfTNow,dfLargeDelay) :
+            		FindNotification(MsgLstRx,dfTNow,dfLargeDelay);
 
 
             //is this a timing message from V10 client?
             bool bTimingPresent = false;
             CMOOSMsg TimingMsg;
-            if(MsgLstRx.front().IsType(MOOS_TIMING))
+            if(bViews && ViewsRx.front().IsType(MOOS_TIMING))
+            {
+            	bTimingPresent = true;
+            	ViewsRx.front().ToMsg(TimingMsg);
+
+            	ViewsRx.erase(ViewsRx.begin());
+            }
+            else if(!bViews && MsgLstRx.front().IsType(MOOS_TIMING))
             {
             	bTimingPresent = true;
             	TimingMsg =MsgLstRx.front();
 
             	MsgLstRx.pop_front();
+            }
 
-
+            if(bTimingPresent)
+            {
             	TimingMsg.SetDouble( MOOSLocalTime());
 
                 Auditor.AddTimingStatistic(sWho,
@@ -330,7 +378,10 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
 
             //let owner figure out what to do !
 			//this is a user supplied call back
-			if(!(*m_pfnRxCallBack)(sWho,MsgLstRx,MsgLstTx,m_pRxCallBackParam))
+			bool bOK = bViews ?
+					(*m_pfnRxViewsCallBack)(sWho,ViewsRx,MsgLstTx,m_pRxViewsCallBackParam) :
+					(*m_pfnRxCallBack)(sWho,MsgLstRx,MsgLstTx,m_pRxCallBackParam);
+			if(!bOK)
 			{
 				//client call back failed!!
 				MOOSTrace(" CMOOSCommServer::ProcessClient()  pfnCallback failed\n");
@@ -360,12 +411,25 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             //send packet back to client...
             ClientThreadSharedData SDDownStream(sWho,ClientThreadSharedData::PKT_WRITE);
 
-            if(!MsgLstTx.empty())
+            //shared mail goes straight into the packet without being
+            //copied into MsgLstTx
+            unsigned int nMessages = 0;
+            MOOS::SHARED_MSG_LIST SharedTx;
+            if(GatherSharedReply(sWho,MsgLstTx,pClient->IsSynchronous() || bTimingPresent,SharedTx))
             {
-            	unsigned int nMessages = MsgLstTx.size();
+            	nMessages = SharedTx.size();
+            	if(nMessages>0)
+            		SerializeForClient(*pClient,SharedTx,*SDDownStream._pPkt);
+            }
+            else if(!MsgLstTx.empty())
+            {
+            	nMessages = MsgLstTx.size();
 				//stuff reply message into a packet
-				SDDownStream._pPkt->Serialize(MsgLstTx,true);
+				SerializeForClient(*pClient,MsgLstTx,*SDDownStream._pPkt);
+            }
 
+            if(nMessages>0)
+            {
 				Auditor.AddStatistic(sWho,
 									SDDownStream._pPkt->GetStreamLength(),
 									nMessages,
@@ -381,42 +445,8 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             	return true;
 
             //and here if we have any new fancy asynchronous clients
-            //w can send them mail as well...
-            for(q=m_ClientThreads.begin();q!=m_ClientThreads.end();++q)
-            {
-            	ClientThread* pClient = q->second;
-            	if(m_pfnFetchAllMailCallBack!=NULL && pClient->IsAsynchronous())
-            	{
-            		//OK this client can handle unsolicited pushes of data
-            		MsgLstTx.clear();
-            		if((*m_pfnFetchAllMailCallBack)(q->first,MsgLstTx,m_pFetchAllMailCallBackParam))
-                    {
-                    	//any pending mail?
-                    	if(MsgLstTx.size()==0)
-                    		continue;
-
-                    	ClientThreadSharedData SDAdditionalDownStream(sWho,
-                    			ClientThreadSharedData::PKT_WRITE);
-
-                    	//stuff all notifications into a packet
-                    	unsigned int nMessages = MsgLstTx.size();
-                    	SDAdditionalDownStream._pPkt->Serialize(MsgLstTx,true);
-
-
-                        Auditor.AddStatistic(q->first,
-                        		SDAdditionalDownStream._pPkt->GetStreamLength(),
-                        		nMessages,
-                        		MOOS::Time(),
-                        		false);
-
-                        //add it to the work load of this client
-                        pClient->SendToClient(SDAdditionalDownStream);
-
-                    }
-            	}
-            }
-
-
+            //w can send them mail as well
+            PushMailToClients(sWho,Auditor);
         }
     }
     catch(CMOOSException & e)
@@ -429,6 +459,153 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
 
 }
 
+/**
+ * push mail waiting for asynchronous clients down their sockets. If the
+ * owner can tell us which clients have mail waiting we only visit those
+ * @param sWho the client whose packet triggered this
+ * @param Auditor
+ * @return true
+ */
+bool ThreadedCommServer::PushMailToClients(const std::string & sWho,MOOS::ServerAudit & Auditor)
+{
+    ClientThreadsMap::iterator q;
+    std::set<std::string> ClientsWithMail;
+    if(m_pfnFetchClientsWithMailCallBack!=NULL &&
+    		(*m_pfnFetchClientsWithMailCallBack)(ClientsWithMail,m_pFetchClientsWithMailCallBackParam))
+    {
+    	std::set<std::string>::iterator w;
+    	for(w = ClientsWithMail.begin();w!=ClientsWithMail.end();++w)
+    	{
+    		q = m_ClientThreads.find(*w);
+    		if(q!=m_ClientThreads.end())
+    			PushMailToClient(sWho,q,Auditor);
+    	}
+    }
+    else
+    {
+    	for(q=m_ClientThreads.begin();q!=m_ClientThreads.end();++q)
+    		PushMailToClient(sWho,q,Auditor);
+    }
+
+    return true;
+}
+
+/**
+ * the owner made mail outside ProcessClient (on a thread of its own say).
+ * The server thread is woken to push it as if a packet had arrived
+ * @return true
+ */
+bool ThreadedCommServer::PostMailWaiting()
+{
+    ClientThreadSharedData SD("",ClientThreadSharedData::MAIL_WAITING);
+    m_SharedDataListFromClient.Push(SD);
+    return true;
+}
+
+/**
+ * push any mail waiting for an asynchronous client down its socket
+ * @param sWho the client whose packet triggered this
+ * @param q the client to push mail to
+ * @param Auditor
+ * @return true if the client was asked for mail
+ */
+bool ThreadedCommServer::PushMailToClient(const std::string & sWho,ClientThreadsMap::iterator q,MOOS::ServerAudit & Auditor)
+{
+    ClientThread* pClient = q->second;
+    if(m_pfnFetchAllSharedMailCallBack!=NULL && pClient->IsAsynchronous())
+    {
+    	//the mail is already serialised so making the packet
+    	//is no more than a copy of each message's bytes
+    	MOOS::SHARED_MSG_LIST SharedTx;
+    	if((*m_pfnFetchAllSharedMailCallBack)(q->first,SharedTx,m_pFetchAllSharedMailCallBackParam))
+    	{
+    		if(SharedTx.empty())
+    			return true;
+
+    		ClientThreadSharedData SDAdditionalDownStream(sWho,
+    				ClientThreadSharedData::PKT_WRITE);
+
+    		SerializeForClient(*pClient,SharedTx,*SDAdditionalDownStream._pPkt);
+
+    		Auditor.AddStatistic(q->first,
+    				SDAdditionalDownStream._pPkt->GetStreamLength(),
+    				SharedTx.size(),
+    				MOOS::Time(),
+    				false);
+
+    		pClient->SendToClient(SDAdditionalDownStream);
+    	}
+    }
+    else if(m_pfnFetchAllMailCallBack!=NULL && pClient->IsAsynchronous())
+    {
+    	//OK this client can handle unsolicited pushes of data
+    	MOOSMSG_LIST MsgLstTx;
+    	if((*m_pfnFetchAllMailCallBack)(q->first,MsgLstTx,m_pFetchAllMailCallBackParam))
+        {
+        	//any pending mail?
+        	if(MsgLstTx.size()==0)
+        		return true;
+
+        	ClientThreadSharedData SDAdditionalDownStream(sWho,
+        			ClientThreadSharedData::PKT_WRITE);
+
+        	//stuff all notifications into a packet
+        	unsigned int nMessages = MsgLstTx.size();
+        	SerializeForClient(*pClient,MsgLstTx,*SDAdditionalDownStream._pPkt);
+
+
+            Auditor.AddStatistic(q->first,
+            		SDAdditionalDownStream._pPkt->GetStreamLength(),
+            		nMessages,
+            		MOOS::Time(),
+            		false);
+
+            //add it to the work load of this client
+            pClient->SendToClient(SDAdditionalDownStream);
+
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * make a packet for a client in whichever wire format it negotiated
+ * @param Client the client the packet is for
+ * @param MsgLstTx the messages to send
+ * @param Pkt the packet to fill
+ * @return true on success
+ */
+bool ThreadedCommServer::SerializeForClient(ClientThread & Client,MOOSMSG_LIST & MsgLstTx,CMOOSCommPkt & Pkt)
+{
+    //every packet for a client is made on this thread so its
+    //dictionary sees them in the order they are sent
+    if(Client.IsCompactWire())
+        return Pkt.SerializeCompact(MsgLstTx,true,Client.TxDictionary());
+
+    return Pkt.Serialize(MsgLstTx,true);
+}
+
+/**
+ * make a packet of shared mail for a client in whichever wire format it
+ * negotiated. Neither format copies or re-encodes the messages themselves
+ * @param Client the client the packet is for
+ * @param SharedTx the shared messages to send
+ * @param Pkt the packet to fill
+ * @return true on success
+ */
+bool ThreadedCommServer::SerializeForClient(ClientThread & Client,const MOOS::SHARED_MSG_LIST & SharedTx,CMOOSCommPkt & Pkt)
+{
+    if(Client.IsCompactWire())
+        return Pkt.SerializeCompact(SharedTx,Client.TxDictionary());
+
+    return Pkt.Serialize(SharedTx);
+}
+
 bool ThreadedCommServer::ProcessClient()
 {
 	return BASE::ProcessClient();
@@ -537,6 +714,11 @@ bool ThreadedCommServer::SupportsAsynchronousClients()
 	return true;
 }
 
+bool ThreadedCommServer::SupportsCompactWire()
+{
+	return true;
+}
+
 bool ThreadedCommServer::TimerLoop()
 {
     //we don't run absent client checks in the threaded version
@@ -553,11 +735,12 @@ ThreadedCommServer::ClientThread::~ClientThread()
 }
 
 
-ThreadedCommServer::ClientThread::ClientThread(const std::string & sName, XPCTcpSocket & ClientSocket,SHARED_PKT_LIST & SharedDataIncoming, bool bAsync, double dfConsolidationPeriodMS,double dfClientTimeout, bool bBoost ):
+ThreadedCommServer::ClientThread::ClientThread(const std::string & sName, XPCTcpSocket & ClientSocket,SHARED_PKT_LIST & SharedDataIncoming, bool bAsync, bool bCompactWire, double dfConsolidationPeriodMS,double dfClientTimeout, bool bBoost ):
             m_sClientName(sName),
             m_ClientSocket(ClientSocket),
             m_SharedDataIncoming(SharedDataIncoming),
             m_bAsynchronous(bAsync),
+            m_bCompactWire(bCompactWire),
             m_dfConsolidationPeriod(dfConsolidationPeriodMS/1000.0),
             m_dfClientTimeout(dfClientTimeout),
             m_bBoostThread(bBoost)
@@ -748,6 +931,21 @@ double ThreadedCommServer::ClientThread::GetConsolidationTime()
     return m_dfConsolidationPeriod;
 }
 
+bool ThreadedCommServer::ClientThread::IsCompactWire()
+{
+    return m_bCompactWire;
+}
+
+MOOS::WireDictionary & ThreadedCommServer::ClientThread::TxDictionary()
+{
+    return m_TxDictionary;
+}
+
+MOOS::WireDictionary & ThreadedCommServer::ClientThread::RxDictionary()
+{
+    return m_RxDictionary;
+}
+
 bool ThreadedCommServer::ClientThread::SendToClient(ClientThreadSharedData & OutGoing)
 {
     m_SharedDataOutgoing.Push(OutGoing);
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ActiveMailQueue.h
+ *
+ *  A queue of mail with its own thread which invokes a callback for
+ *  every message pushed onto it.
+ */
+
+#ifndef ACTIVEMAILQUEUE_H_
+#define ACTIVEMAILQUEUE_H_
+
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Comms/MessageFunction.h"
+
+#include <string>
+
+namespace MOOS {
+
+class ActiveMailQueue {
+public:
+	ActiveMailQueue(const std::string & Name);
+	virtual ~ActiveMailQueue();
+
+	/** start the worker thread */
+	bool Start();
+
+	/** stop the worker thread */
+	bool Stop();
+
+	/** push a message onto the queue */
+	bool Push(const CMOOSMsg & M);
+
+	/** the thread's work loop */
+	bool DoWork();
+
+	/** is the worker thread running? */
+	bool IsRunning();
+
+	/** the name of this queue */
+	std::string GetName();
+
+	/** install an old style C function callback */
+	void SetCallback(bool (*pfn)(CMOOSMsg &M, void * pParam), void * pCallerParam);
+
+	/** install a member function of an instance of T as the callback */
+	template <class T>
+	void SetCallback(bool (T::*pMethod)(CMOOSMsg &), T * pInstance)
+	{
+		pfn_ = NULL;
+		delete pClassMemberFunctionCallback_;
+		pClassMemberFunctionCallback_ = BindMsgFunctor<T>(pInstance, pMethod);
+	}
+
+protected:
+	CMOOSThread thread_;
+	SafeList<CMOOSMsg> queue_;
+	std::string Name_;
+	MsgFunctor * pClassMemberFunctionCallback_;
+	bool (*pfn_)(CMOOSMsg &M, void * pParam);
+	void * caller_param_;
+};
+
+}
+
+#endif /* ACTIVEMAILQUEUE_H_ */
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ClientCommsStatus.h
+ *
+ *  A summary of how well a client is communicating with the DB.
+ */
+
+#ifndef CLIENTCOMMSSTATUS_H_
+#define CLIENTCOMMSSTATUS_H_
+
+#include <list>
+#include <ostream>
+#include <string>
+
+namespace MOOS {
+
+class ClientCommsStatus {
+public:
+    enum Quality
+    {
+        Excellent,
+        Good,
+        Fair,
+        Poor,
+    };
+
+    ClientCommsStatus();
+    virtual ~ClientCommsStatus();
+
+    /** how good are the client's comms? */
+    Quality Appraise();
+
+    /** print a summary */
+    void Write(std::ostream & out);
+
+    /** equality operator */
+    bool operator==(const ClientCommsStatus & M) const;
+
+    double recent_latency_;
+    double max_latency_;
+    double min_latency_;
+    double avg_latency_;
+    std::string name_;
+    std::list<std::string> subscribes_;
+    std::list<std::string> publishes_;
+};
+
+}
+
+#endif /* CLIENTCOMMSSTATUS_H_ */
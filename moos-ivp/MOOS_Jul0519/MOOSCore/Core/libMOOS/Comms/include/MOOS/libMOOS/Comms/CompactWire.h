@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * CompactWire.h
+ *
+ *  Version 2 of the wire format. Clients and DB agree to use it at
+ *  handshake (the client offers "wire=2" in the aux field of its
+ *  handshake message and a DB which understands replies with the same
+ *  in its welcome) so old clients and old DBs keep talking version 1.
+ *
+ *  Each direction of a connection owns a WireDictionary. The first time
+ *  a key, source, source aux or community string is sent it is defined
+ *  in-line and given the next small integer ID; afterwards only the ID
+ *  is sent. Integers are sent as varints and only the doubles a message
+ *  actually uses are sent, so a typical double notification shrinks
+ *  from ~80 bytes to ~25.
+ *
+ *  Packets in this format carry kPktFlag in the byte of the packet
+ *  header which used to indicate compression.
+ */
+
+#ifndef COMPACTWIRE_H_
+#define COMPACTWIRE_H_
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MOOS
+{
+
+class WireDictionary
+{
+public:
+    /** how Intern() says a string should be sent */
+    enum Kind
+    {
+        REFERENCE = 0,  //already known to the other end - send the id
+        DEFINE = 1,     //new - send the string, both ends give it the next id
+        LITERAL = 2     //not worth interning (or no room) - send the string
+    };
+
+    /** at most nMaxEntries strings no longer than nMaxLength are interned */
+    WireDictionary(unsigned int nMaxEntries = 4096, unsigned int nMaxLength = 128);
+
+    /** forget everything - call whenever the connection is remade */
+    void Clear();
+
+    /** sending side: decide how s is sent, nID is filled in for REFERENCE */
+    Kind Intern(const std::string & s, unsigned int & nID);
+
+    /** receiving side: the other end defined s - it gets the next id */
+    bool Define(const std::string & s);
+
+    /** receiving side: the string with id nID or NULL if there is none */
+    const std::string * Lookup(unsigned int nID) const;
+
+    /** number of strings interned */
+    unsigned int Size() const;
+
+private:
+    std::map<std::string,unsigned int> ids_;
+    std::vector<std::string> strings_;
+    unsigned int max_entries_;
+    unsigned int max_length_;
+};
+
+namespace CompactWire
+{
+
+/** value of the packet header flag byte for version 2 packets */
+const unsigned char kPktFlag = 2;
+
+/** the version offered and accepted at handshake */
+const char * const kHandShakeToken = "wire";
+const char * const kHandShakeVersion = "2";
+
+/** append M to Out interning its strings in Dictionary */
+void Encode(const CMOOSMsg & M, WireDictionary & Dictionary, std::vector<unsigned char> & Out);
+
+/** write the parts of M's encoding which do not depend on a dictionary
+ * (everything but the string references) to Fixed. Returns how many of
+ * those bytes go before the references. Lets a message sent to many
+ * clients be encoded once */
+unsigned int EncodeFixed(const CMOOSMsg & M, std::vector<unsigned char> & Fixed);
+
+/** append M to Out as Encode() would, copying the parts EncodeFixed()
+ * made and writing only the string references */
+void EncodeWithFixed(const CMOOSMsg & M,
+                     const unsigned char * pFixed,
+                     unsigned int nFixedSize,
+                     unsigned int nHeadSize,
+                     WireDictionary & Dictionary,
+                     std::vector<unsigned char> & Out);
+
+/** decode a message from the nLen bytes at pBuffer. Returns the number
+ * of bytes used or -1 if the bytes are not a valid message */
+int Decode(const unsigned char * pBuffer, int nLen, WireDictionary & Dictionary, CMOOSMsg & M);
+
+}
+
+}
+
+#endif /* COMPACTWIRE_H_ */
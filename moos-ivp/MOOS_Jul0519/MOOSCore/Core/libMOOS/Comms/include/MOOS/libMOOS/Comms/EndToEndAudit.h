@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * EndToEndAudit.h
+ *
+ *  Multicasts a record of every message a client receives so that
+ *  end to end latencies can be watched from outside.
+ */
+
+#ifndef ENDTOENDAUDIT_H_
+#define ENDTOENDAUDIT_H_
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Comms/MulticastNode.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedLock.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/ProcInfo.h"
+
+#include <list>
+#include <fstream>
+#include <string>
+
+namespace MOOS{
+
+class EndToEndAudit {
+public:
+    struct MessageStatistic{
+        std::string source_client;
+        std::string destination_client;
+        std::string message_name;
+        int message_size;
+        int64_t source_time;
+        int64_t receive_time;
+        double cpu_load;
+        void ToString(std::string & out);
+        void FromString(const std::string & in);
+    };
+    typedef std::list<MessageStatistic> MessageStatistics;
+
+    EndToEndAudit();
+
+    /** start multicasting statistics */
+    void Start();
+
+    /** record the arrival of msg at client_name */
+    void AddForAudit(const CMOOSMsg & msg,
+                     const std::string & client_name,
+                     double time_now);
+
+    bool TransmitWorker();
+
+    static bool ThreadDispatch(void * pParam){
+        EndToEndAudit* pMe = static_cast<EndToEndAudit*>(pParam);
+        return pMe->TransmitWorker();
+    }
+
+private:
+    MulticastNode multicaster_;
+    CMOOSThread transmit_thread_;
+    CMOOSLock audit_lock_;
+    MessageStatistics message_statistics_;
+    ProcInfo proc_info_;
+};
+
+}
+
+#endif /* ENDTOENDAUDIT_H_ */
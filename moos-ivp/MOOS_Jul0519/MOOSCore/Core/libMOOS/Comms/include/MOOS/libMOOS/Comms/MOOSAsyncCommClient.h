@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MOOSAsyncCommClient.h
+ *
+ *  A comms client with separate reading and writing threads which talks
+ *  to an asynchronous DB. Mail is sent as soon as it is posted and
+ *  received as soon as it is sent rather than on a fixed tick.
+ */
+
+#ifndef MOOSASYNCCOMMCLIENT_H_
+#define MOOSASYNCCOMMCLIENT_H_
+
+#include "MOOS/libMOOS/Comms/MOOSCommClient.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/SPSCQueue.h"
+
+#include <string>
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+namespace MOOS {
+
+class MOOSAsyncCommClient : public CMOOSCommClient {
+public:
+    typedef CMOOSCommClient BASE;
+
+    MOOSAsyncCommClient();
+    virtual ~MOOSAsyncCommClient();
+
+    /** the reading and writing threads' loops */
+    bool WritingLoop();
+    bool ReadingLoop();
+
+    /** stop the client */
+    virtual bool Close(bool bNice = true);
+
+    /** send everything now */
+    virtual bool Flush();
+
+    /** post a message to the DB */
+    virtual bool Post(CMOOSMsg & Msg, bool bKeepMsgSourceName = false);
+
+    /** this is an asynchronous client */
+    virtual bool IsAsynchronous();
+
+    /** are both threads running? */
+    virtual bool IsRunning();
+
+    /** back pressure on the queues between the threads */
+    unsigned int GetInComingQueueHighWaterMark();
+    unsigned int GetInComingQueueRejections();
+    unsigned int GetOutGoingQueueHighWaterMark();
+    unsigned int GetOutGoingQueueRejections();
+
+protected:
+    virtual bool StartThreads();
+    virtual bool OnCloseConnection();
+    virtual std::string HandShakeKey();
+    virtual void DoBanner();
+
+    /** move mail queued by the reading thread to m_InBox (m_InLock held) */
+    virtual void GatherInBox();
+
+    bool DoWriting();
+    bool DoReading();
+    bool MonitorAndLimitWriteSpeed();
+
+    /** queue a message for the writing thread from any thread */
+    void QueueOutGoingMail(const CMOOSMsg & Msg);
+
+    /** move the outbox to the writing thread's queue (m_OutLock held) */
+    void MoveOutBoxToOutGoingQueue();
+
+    /** hand received mail to the application */
+    void QueueInComingMail(MOOSMSG_LIST & Mail);
+
+    CMOOSThread WritingThread_;
+    CMOOSThread ReadingThread_;
+
+    /** lock free queues between the application and the IO threads */
+    SPSCQueue<CMOOSMsg> OutGoingQueue_;
+    SPSCQueue<CMOOSMsg> InComingQueue_;
+
+    /** non zero when mail is waiting in the outbox for the writing thread */
+    SPSCIndex OutBoxBacklog_;
+
+    double m_dfLastTimingMessage;
+    double m_dfOutGoingDelay;
+};
+
+}
+
+#endif /* MOOSASYNCCOMMCLIENT_H_ */
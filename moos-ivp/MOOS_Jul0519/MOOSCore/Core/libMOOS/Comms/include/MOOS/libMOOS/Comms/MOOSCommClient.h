@@ -0,0 +1,456 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSCommClient.h: interface for the CMOOSCommClient class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSCOMMCLIENTH
+#define MOOSCOMMCLIENTH
+
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedPtr.h"
+#include "MOOS/libMOOS/Comms/MOOSCommObject.h"
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Comms/ActiveMailQueue.h"
+#include "MOOS/libMOOS/Comms/ClientCommsStatus.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
+
+#ifdef ENABLE_DETAILED_TIMING_AUDIT
+#include "MOOS/libMOOS/Comms/EndToEndAudit.h"
+#endif
+
+#include <string>
+#include <set>
+#include <map>
+#include <list>
+#include <iomanip>
+#include <stdint.h>
+
+#define OUTBOX_PENDING_LIMIT 1000
+#define INBOX_PENDING_LIMIT 1000
+#define CLIENT_DEFAULT_FUNDAMENTAL_FREQ 5
+#define CLIENT_MAX_FUNDAMENTAL_FREQ 200
+
+class XPCTcpSocket;
+
+namespace MOOS
+{
+    class CMOOSSkewFilter;
+}
+
+/** This class is the most important component of MOOS as seen from the
+user's perspective. Every MOOS process has one. It sends mail (messages)
+to the MOOSDB and receives mail for the variables it has registered for.
+All the work happens on a thread of its own. */
+class CMOOSCommClient : public CMOOSCommObject
+{
+public:
+    /** default constructor */
+    CMOOSCommClient();
+
+    /** default destructor */
+    virtual ~CMOOSCommClient();
+
+    /** the thread's work loop */
+    bool ClientLoop();
+
+    /** start the client - connect to sServer:Port calling yourself sMyName
+    and talk to the DB nFundamentalFrequency times a second */
+    virtual bool Run(const std::string & sServer,
+                     int Port,
+                     const std::string & sMyName,
+                     unsigned int nFundamentalFrequency = CLIENT_DEFAULT_FUNDAMENTAL_FREQ);
+
+    /** set the callback invoked when the client connects */
+    void SetOnConnectCallBack(bool (*pfn)(void * pConnectParam), void * pConnectParam);
+
+    /** set the callback invoked when the client disconnects */
+    void SetOnDisconnectCallBack(bool (*pfn)(void * pConnectParam), void * pConnectParam);
+
+    /** set the callback invoked when mail arrives */
+    void SetOnMailCallBack(bool (*pfn)(void * pMailParam), void * pMailParam);
+
+    /** is a mail callback installed? */
+    bool HasMailCallBack();
+
+    /** ask to use the compact wire format (only used if the DB agrees) */
+    void SetCompactWire(bool bCompact);
+
+    /** is the compact wire format in use on this connection? */
+    bool IsCompactWire();
+
+    /** is this an asynchronous client? */
+    virtual bool IsAsynchronous();
+
+    /** is the client running? */
+    virtual bool IsRunning();
+
+    /** block until connected or nMilliseconds have passed */
+    bool WaitUntilConnected(const unsigned int nMilliseconds);
+
+    /** how many messages are waiting to be read */
+    unsigned int GetNumberOfUnreadMessages();
+
+    /** how many messages are waiting to be sent */
+    unsigned int GetNumberOfUnsentMessages();
+
+    /** traffic statistics */
+    uint64_t GetNumBytesSent();
+    uint64_t GetNumBytesReceived();
+    uint64_t GetNumPktsReceived();
+    uint64_t GetNumMsgsReceived();
+    uint64_t GetNumMsgsSent();
+
+    /** post a message to the DB */
+    virtual bool Post(CMOOSMsg & Msg, bool bKeepMsgSourceName = false);
+
+    /** publish a double */
+    bool Notify(const std::string & sVar, double dfVal, double dfTime = -1);
+    bool Notify(const std::string & sVar, double dfVal, const std::string & sSrcAux, double dfTime = -1);
+
+    /** publish a string */
+    bool Notify(const std::string & sVar, const std::string & sVal, double dfTime = -1);
+    bool Notify(const std::string & sVar, const std::string & sVal, const std::string & sSrcAux, double dfTime = -1);
+    bool Notify(const std::string & sVar, const char * sVal, double dfTime = -1);
+    bool Notify(const std::string & sVar, const char * sVal, const std::string & sSrcAux, double dfTime = -1);
+
+    /** publish binary data */
+    bool Notify(const std::string & sVar, void * pData, unsigned int nSize, double dfTime = -1);
+    bool Notify(const std::string & sVar, void * pData, unsigned int nSize, const std::string & sSrcAux, double dfTime = -1);
+    bool Notify(const std::string & sVar, const std::vector<unsigned char> & vData, double dfTime = -1);
+    bool Notify(const std::string & sVar, const std::vector<unsigned char> & vData, const std::string & sSrcAux, double dfTime = -1);
+
+    /** register for notifications of sVar no more often than dfInterval */
+    bool Register(const std::string & sVar, double dfInterval = 0.0);
+
+    /** wildcard registration */
+    bool Register(const std::string & sVarPattern, const std::string & sAppPattern, double dfInterval);
+
+    /** register for sVar asking the DB to keep only the newest unsent value */
+    bool RegisterLatestOnly(const std::string & sVar, double dfInterval = 0.0);
+
+    /** wildcard registration keeping only the newest unsent value of each variable */
+    bool RegisterLatestOnly(const std::string & sVarPattern, const std::string & sAppPattern, double dfInterval);
+
+    /** unregister for sVar */
+    bool UnRegister(const std::string & sVar);
+
+    /** wildcard unregistration */
+    bool UnRegister(const std::string & sVarPattern, const std::string & sAppPattern);
+
+    /** are we registered for sVariable? */
+    bool IsRegisteredFor(const std::string & sVariable);
+
+    /** subscriptions which are remade every time the client connects */
+    bool AddRecurrentSubscription(const std::string & sVar, double dfPeriod);
+    bool RemoveRecurrentSubscription(const std::string & sVar);
+
+    /** collect all the mail */
+    virtual bool Fetch(MOOSMSG_LIST & MsgList);
+
+    /** send everything now */
+    virtual bool Flush();
+
+    /** is the client connected to a DB? */
+    bool IsConnected();
+
+    /** make a request of the server and wait for the reply */
+    bool ServerRequest(const std::string & sWhat, MOOSMSG_LIST & MsgList, double dfTimeOut = 2.0, bool bClear = true);
+
+    /** look for a message with ID nIDRequired */
+    bool Peek(MOOSMSG_LIST & List, int nIDRequired, bool bClear = false);
+
+    /** look for a message called sKey in Mail */
+    static bool PeekMail(MOOSMSG_LIST & Mail, const std::string & sKey, CMOOSMsg & Msg, bool bErase = false, bool bFindYoungest = false);
+
+    /** look for a message called sKey in Mail and check it is not skewed */
+    static bool PeekAndCheckMail(MOOSMSG_LIST & Mail, const std::string & sKey, CMOOSMsg & Msg, bool bErase = false, bool bFindYoungest = false);
+
+    /** stop the client */
+    virtual bool Close(bool bNice = true);
+
+    /** let messages keep the source they were given */
+    bool FakeSource(bool bFake);
+
+    /** a description of this client */
+    std::string GetDescription();
+
+    /** the name this client goes by */
+    std::string GetMOOSName();
+
+    /** the community of the DB we are connected to */
+    std::string GetCommunityName();
+
+    /** the name of the DB's host as the DB sees it */
+    std::string GetDBHostNameAsSeenByDB() const;
+
+    /** where we are connecting */
+    std::string GetDBHostname();
+    int GetDBHostPort();
+    std::string GetClientName();
+
+    /** set how many times a second we talk to the DB */
+    bool SetCommsTick(int nCommTick);
+
+    /** let the outbox overflow quietly, dropping mail beyond outbox_pending_size */
+    bool ExpectOutboxOverflow(unsigned int outbox_pending_size);
+
+    /** set how outgoing mail is agglomerated under time warp */
+    bool SetCommsControlTimeWarpScaleFactor(double dfSF);
+    double GetCommsControlTimeWarpScaleFactor();
+
+    /** be quiet */
+    void SetQuiet(bool bQuiet) { m_bQuiet = bQuiet; }
+
+    /** print debugging information */
+    void SetVerboseDebug(bool bT) { m_bVerboseDebug = bT; }
+
+    /** do or don't correct the local clock using time from the DB */
+    void DoLocalTimeCorrection(bool b) { m_bDoLocalTimeCorrection = b; }
+
+    /** put newly posted mail at the front of the outbox */
+    void SetPostNewestToFront(bool bT) { m_bPostNewestToFront = bT; }
+
+    /** what have we registered for and published? */
+    std::set<std::string> GetRegistered() { return m_Registered; }
+    std::set<std::string> GetPublished() { return m_Published; }
+
+    /** client comms status monitoring */
+    bool GetClientCommsStatus(const std::string & sClient, MOOS::ClientCommsStatus & TheStatus);
+    void GetClientCommsStatuses(std::list<MOOS::ClientCommsStatus> & Statuses);
+    void EnableCommsStatusMonitoring(bool bEnable);
+
+    /** active queues - each has a thread which calls a callback for every
+    message routed to it */
+    bool AddActiveQueue(const std::string & sQueueName,
+                        bool (*pfn)(CMOOSMsg &M, void * pYourParam),
+                        void * pYourParam);
+
+    template <class T>
+    bool AddActiveQueue(const std::string & sQueueName,
+                        T * Instance,
+                        bool (T::*memfunc)(CMOOSMsg &));
+
+    bool AddWildcardActiveQueue(const std::string & sQueueName,
+                                const std::string & sPattern,
+                                bool (*pfn)(CMOOSMsg &M, void * pYourParam),
+                                void * pYourParam);
+
+    template <class T>
+    bool AddWildcardActiveQueue(const std::string & sQueueName,
+                                const std::string & sPattern,
+                                T * Instance,
+                                bool (T::*memfunc)(CMOOSMsg &));
+
+    bool AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                      const std::string & sMsgName,
+                                      bool (*pfn)(CMOOSMsg &M, void * pYourParam),
+                                      void * pYourParam);
+
+    template <class T>
+    bool AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                      const std::string & sMsgName,
+                                      T * Instance,
+                                      bool (T::*memfunc)(CMOOSMsg &));
+
+    bool AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                      const std::string & sMsgName);
+
+    bool RemoveMessageRouteToActiveQueue(const std::string & sQueueName,
+                                         const std::string & sMsgName);
+
+    bool RemoveActiveQueue(const std::string & sQueueName);
+
+    bool HasActiveQueue(const std::string & sQueueName);
+
+    void PrintMessageToActiveQueueRouting();
+
+    /** deprecated */
+    bool AddMessageCallBack(const std::string & sQueueName,
+                            const std::string & sMsgName,
+                            bool (*pfn)(CMOOSMsg &M, void * pYourParam),
+                            void * pYourParam);
+
+protected:
+    bool ClearResources();
+    virtual bool StartThreads();
+    virtual bool ConnectToServer();
+    virtual bool HandShake();
+    virtual std::string HandShakeKey();
+    virtual bool DoClientWork();
+    virtual bool OnCloseConnection();
+    virtual void DoBanner();
+
+    /** called with m_InLock held before m_InBox is looked at */
+    virtual void GatherInBox();
+
+    bool DispatchInBoxToActiveThreads();
+    bool DispatchToActiveThreads(MOOSMSG_LIST & Mail);
+
+    bool UpdateMOOSSkew(double dfRqTime, double dfTxTime, double dfRxTime);
+
+    bool ControlClientCommsStatusMonitoring(bool bEnable);
+    bool ProcessClientCommsStatusSummary(CMOOSMsg & M);
+    bool ApplyRecurrentSubscriptions();
+
+    XPCTcpSocket * m_pSocket;
+
+    bool (*m_pfnConnectCallBack)(void * pParam);
+    void * m_pConnectCallBackParam;
+
+    bool (*m_pfnDisconnectCallBack)(void * pParam);
+    void * m_pDisconnectCallBackParam;
+
+    bool (*m_pfnMailCallBack)(void * pParam);
+    void * m_pMailCallBackParam;
+
+    std::string m_sDBHost;
+    std::string m_sDBHostAsSeenByDB;
+    long m_lPort;
+    std::string m_sMyName;
+    std::string m_sCommunityName;
+
+    CMOOSThread m_ClientThread;
+
+    CMOOSLock m_OutLock;
+    CMOOSLock m_InLock;
+    CMOOSLock m_WorkLock;
+    CMOOSLock m_ClientStatusLock;
+
+    MOOSMSG_LIST m_OutBox;
+    MOOSMSG_LIST m_InBox;
+
+    unsigned int m_nOutPendingLimit;
+    unsigned int m_nInPendingLimit;
+
+    bool m_bConnected;
+    bool m_bQuit;
+    bool m_bFakeSource;
+    bool m_bQuiet;
+    bool m_bVerboseDebug;
+    bool m_bMailPresent;
+    bool m_bPostNewestToFront;
+    bool m_bExpectMailBoxOverFlow;
+    bool m_bDoLocalTimeCorrection;
+    bool m_bDBIsAsynchronous;
+    bool m_bMonitorClientCommsStatus;
+
+    /** the compact wire format was asked for / agreed with the DB */
+    bool m_bCompactWireRequested;
+    bool m_bCompactWire;
+
+    /** the string dictionaries of each direction of a compact connection */
+    MOOS::WireDictionary m_TxDictionary;
+    MOOS::WireDictionary m_RxDictionary;
+
+    unsigned int m_nFundamentalFreq;
+    int m_nNextMsgID;
+
+    uint64_t m_nBytesSent;
+    uint64_t m_nBytesReceived;
+    uint64_t m_nPktsReceived;
+    uint64_t m_nMsgsReceived;
+    uint64_t m_nMsgsSent;
+
+    double m_dfOutGoingDelayTimeWarpScaleFactor;
+
+    std::set<std::string> m_Registered;
+    std::set<std::string> m_Published;
+    std::map<std::string,double> m_RecurrentSubscriptions;
+    CMOOSLock RecurrentSubscriptionLock;
+
+    std::map<std::string, MOOS::ClientCommsStatus> m_ClientStatuses;
+
+    MOOS::ScopedPtr<MOOS::CMOOSSkewFilter> m_pSkewFilter;
+
+    /** active queues */
+    CMOOSLock ActiveQueuesLock_;
+    std::map<std::string,MOOS::ActiveMailQueue*> ActiveQueueMap_;
+    std::map<std::string,std::set<std::string> > Msg2ActiveQueueName_;
+    std::map<std::string,std::string> WildcardQueuePatterns_;
+    std::set<std::string> WildcardCheckSet_;
+
+#ifdef ENABLE_DETAILED_TIMING_AUDIT
+    MOOS::EndToEndAudit end_to_end_auditor_;
+#endif
+};
+
+template <class T>
+bool CMOOSCommClient::AddActiveQueue(const std::string & sQueueName,
+                                     T * Instance,
+                                     bool (T::*memfunc)(CMOOSMsg &))
+{
+    MOOS::ScopedLock L(ActiveQueuesLock_);
+
+    if(ActiveQueueMap_.find(sQueueName)!=ActiveQueueMap_.end())
+        return false;
+
+    MOOS::ActiveMailQueue* pQ = new MOOS::ActiveMailQueue(sQueueName);
+    ActiveQueueMap_[sQueueName] = pQ;
+
+    pQ->SetCallback<T>(memfunc,Instance);
+    pQ->Start();
+    return true;
+}
+
+template <class T>
+bool CMOOSCommClient::AddWildcardActiveQueue(const std::string & sQueueName,
+                                             const std::string & sPattern,
+                                             T * Instance,
+                                             bool (T::*memfunc)(CMOOSMsg &))
+{
+    if(!AddActiveQueue<T>(sQueueName,Instance,memfunc))
+        return false;
+
+    MOOS::ScopedLock L(ActiveQueuesLock_);
+
+    WildcardQueuePatterns_[sQueueName]=sPattern;
+
+    std::set< std::string>::iterator q;
+    for(q=WildcardCheckSet_.begin();q!=WildcardCheckSet_.end();++q)
+    {
+        if(MOOSWildCmp(sPattern,*q))
+            Msg2ActiveQueueName_[*q].insert(sQueueName);
+    }
+
+    return true;
+}
+
+template <class T>
+bool CMOOSCommClient::AddMessageRouteToActiveQueue(const std::string & sQueueName,
+                                                   const std::string & sMsgName,
+                                                   T * Instance,
+                                                   bool (T::*memfunc)(CMOOSMsg &))
+{
+    if(!HasActiveQueue(sQueueName))
+        AddActiveQueue<T>(sQueueName,Instance,memfunc);
+
+    return AddMessageRouteToActiveQueue(sQueueName,sMsgName);
+}
+
+#endif // !defined(MOOSCOMMCLIENTH)
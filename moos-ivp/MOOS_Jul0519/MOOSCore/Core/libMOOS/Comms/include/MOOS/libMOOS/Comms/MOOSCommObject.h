@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSCommObject.h: interface for the CMOOSCommObject class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSCOMMOBJECTH
+#define MOOSCOMMOBJECTH
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+#include <string>
+
+#define MOOS_PROTOCOL_STRING "ELKS CAN'T DANCE 2/8/10"
+#define MOOS_PROTOCOL_STRING_BUFFER_SIZE 32
+
+class XPCTcpSocket;
+class CMOOSCommPkt;
+
+/** The base class of anything in MOOS that talks over a socket. It knows
+how to read and write packets and messages */
+class CMOOSCommObject
+{
+public:
+    CMOOSCommObject();
+    virtual ~CMOOSCommObject();
+
+    /** initialise the socket layer (only does anything on windows) */
+    static bool SocketsInit();
+
+    /** returns the IP address of this machine */
+    static std::string GetLocalIPAddress();
+
+    /** make the comms misbehave on purpose - for testing only */
+    bool ConfigureCommsTesting(double dfDodgeyCommsProbability,
+                               double dfDodgeyCommsDelay,
+                               double dfTerminateProbability = 0.0);
+
+    /** set the size of the receive buffer of the underlying socket in KB */
+    bool SetReceiveBufferSizeInKB(unsigned int KBytes);
+
+    /** set the size of the send buffer of the underlying socket in KB */
+    bool SetSendBufferSizeInKB(unsigned int KBytes);
+
+    /** turn Nagle's algorithm on or off */
+    void SetTCPNoDelay(bool bTCPNoDelay);
+
+    /** boost the priority of IO threads */
+    void BoostIOPriority(bool bBoost);
+
+protected:
+    bool SendPkt(XPCTcpSocket *pSocket, CMOOSCommPkt &PktTx);
+    bool ReadPkt(XPCTcpSocket *pSocket, CMOOSCommPkt &PktRx, int nSecondsTimeout = -1);
+    bool SendMsg(XPCTcpSocket *pSocket, CMOOSMsg &Msg);
+    bool ReadMsg(XPCTcpSocket *pSocket, CMOOSMsg &Msg, int nSecondsTimeout = -1);
+
+    void SimulateCommsError();
+
+    bool m_bFakeDodgyComms;
+    double m_dfDodgeyCommsProbability;
+    double m_dfDodgeyCommsDelay;
+    double m_dfTerminateProbability;
+
+    bool m_bDisableNagle;
+    bool m_bBoostIOThreads;
+
+    unsigned int m_nReceiveBufferSizeKB;
+    unsigned int m_nSendBufferSizeKB;
+};
+
+#endif // !defined(MOOSCOMMOBJECTH)
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSCommPkt.h: interface for the CMOOSCommPkt class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSCOMMPKTH
+#define MOOSCOMMPKTH
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+#include <list>
+#include <vector>
+
+namespace MOOS
+{
+    class SharedMsg;
+    typedef std::list<SharedMsg> SHARED_MSG_LIST;
+    class MsgView;
+    typedef std::vector<MsgView> MSG_VIEW_VECTOR;
+    class WireDictionary;
+}
+
+/** This class is used by MOOS to pack (serialise) lists of messages into
+a single stream of bytes which can be sent over a socket, and to unpack
+them at the other end */
+class CMOOSCommPkt
+{
+public:
+    CMOOSCommPkt();
+    virtual ~CMOOSCommPkt();
+
+    /** pack (bToStream==true) or unpack a list of messages */
+    bool Serialize(MOOSMSG_LIST & List,
+                   bool bToStream = true,
+                   bool bNoNULL = false,
+                   double * pdfPktTime = NULL);
+
+    /** pack a list of shared, already serialised, messages */
+    bool Serialize(const MOOS::SHARED_MSG_LIST & List);
+
+    /** decode the messages in this packet as views into its buffer */
+    bool ViewMessages(MOOS::MSG_VIEW_VECTOR & Views,
+                      bool bNoNULL = false,
+                      double * pdfPktTime = NULL) const;
+
+    /** pack or unpack a list of messages in the compact (version 2) format */
+    bool SerializeCompact(MOOSMSG_LIST & List,
+                          bool bToStream,
+                          MOOS::WireDictionary & Dictionary);
+
+    /** pack a list of shared messages in the compact (version 2) format */
+    bool SerializeCompact(const MOOS::SHARED_MSG_LIST & List,
+                          MOOS::WireDictionary & Dictionary);
+
+    /** true if this packet holds messages in the compact format */
+    bool IsCompact() const;
+
+    /** how many bytes are still needed to complete this packet */
+    int GetBytesRequired();
+
+    /** how many bytes are in the packet */
+    int GetStreamLength();
+
+    /** called when nData bytes have been written to the packet */
+    bool OnBytesWritten(unsigned char * PositionWrittenTo, int nData);
+
+    /** how many messages were serialised */
+    int GetNumMessagesSerialised();
+
+    /** pointer to the start of the stream */
+    unsigned char * Stream();
+
+    /** pointer to where the next byte should be written */
+    unsigned char * NextWrite();
+
+protected:
+    bool InflateTo(int nNewStreamSize);
+
+    unsigned char * m_pStream;
+    unsigned char * m_pNextData;
+    int m_nMsgLen;
+    int m_nByteCount;
+    int m_nStreamSpace;
+    int m_nMsgsSerialised;
+};
+
+#endif // !defined(MOOSCOMMPKTH)
@@ -0,0 +1,240 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSCommServer.h: interface for the CMOOSCommServer class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MOOSCOMMSERVERH)
+#define MOOSCOMMSERVERH
+
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Comms/MOOSCommObject.h"
+#include "MOOS/libMOOS/Comms/ServerAudit.h"
+
+#include <string>
+#include <list>
+#include <map>
+#include <set>
+
+class XPCTcpSocket;
+
+namespace MOOS
+{
+    class SharedMsg;
+    typedef std::list<SharedMsg> SHARED_MSG_LIST;
+    class MsgView;
+    typedef std::vector<MsgView> MSG_VIEW_VECTOR;
+}
+
+typedef std::list<XPCTcpSocket*> SOCKETLIST;
+
+/** This class is the MOOS Server - the heart of a MOOSDB. It accepts
+connections from clients, reads their packets and hands the contents to
+its owner through a set of callbacks. This version services all clients
+from a single thread. */
+class CMOOSCommServer : public CMOOSCommObject
+{
+public:
+    typedef std::map<int,std::string> SOCKETFD_2_CLIENT_NAME_MAP;
+
+    CMOOSCommServer();
+    virtual ~CMOOSCommServer();
+
+    /** pass in the command line so the server can look for its own flags */
+    void SetCommandLineParameters(int argc, char * argv[]);
+
+    /** called to start the server on a given port */
+    virtual bool Run(long lPort,
+                     const std::string & sCommunityName,
+                     bool bDisableNameLookUp = false,
+                     unsigned int nAuditPort = 9020);
+
+    /** stop the server */
+    virtual bool Stop();
+
+    /** the listen thread runs this */
+    virtual bool ListenLoop();
+
+    /** the server thread runs this */
+    virtual bool ServerLoop();
+
+    /** the timer thread runs this (looks for clients which have gone quiet) */
+    virtual bool TimerLoop();
+
+    /** set the callback invoked when a packet arrives from a client */
+    void SetOnRxCallBack(bool (*pfn)(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx, void * pParam),void * pParam);
+
+    /** set the callback invoked with views of the messages in a packet
+    rather than decoded copies of them */
+    void SetOnRxViewsCallBack(bool (*pfn)(const std::string & sClient,MOOS::MSG_VIEW_VECTOR & ViewsRx,MOOSMSG_LIST & MsgListTx, void * pParam),void * pParam);
+
+    /** set the callback invoked when a client disconnects */
+    void SetOnDisconnectCallBack(bool (*pfn)(std::string & sClient, void * pParam),void * pParam);
+
+    /** set the callback invoked when a client connects */
+    void SetOnConnectCallBack(bool (*pfn)(std::string & sClient, void * pParam),void * pParam);
+
+    /** set the callback which fetches all mail waiting for a client */
+    void SetOnFetchAllMailCallBack(bool (*pfn)(const std::string & sClient,MOOSMSG_LIST & MsgListTx,void * pParam),void * pParam);
+
+    /** set the callback which fetches all mail waiting for a client as
+    shared (serialise once) messages */
+    void SetOnFetchAllSharedMailCallBack(bool (*pfn)(const std::string & sClient,MOOS::SHARED_MSG_LIST & MsgListTx,void * pParam),void * pParam);
+
+    /** set the callback which fetches the shared mail that makes up the
+    reply to a client's packet */
+    void SetOnFetchReplySharedMailCallBack(bool (*pfn)(const std::string & sClient,MOOS::SHARED_MSG_LIST & MsgListTx,void * pParam),void * pParam);
+
+    /** set the callback which names the clients with mail waiting */
+    void SetOnFetchClientsWithMailCallBack(bool (*pfn)(std::set<std::string> & Clients,void * pParam),void * pParam);
+
+    /** fill in a list of the names of connected clients */
+    bool GetClientNames(STRING_LIST & sList);
+
+    /** how long a client may be silent before it is disconnected */
+    bool SetClientTimeout(double dfTimeoutPeriod);
+
+    /** set the latency above which the server complains */
+    void SetWarningLatencyMS(double dfPeriod);
+
+    /** allow or forbid clients to talk the compact wire format */
+    void SetCompactWire(bool bCompact);
+
+    /** is this client talking the compact wire format? */
+    bool IsCompactWire(const std::string & sClient);
+
+    /** can this server talk the compact wire format at all? */
+    virtual bool SupportsCompactWire();
+
+    /** can this server support asynchronous clients? */
+    virtual bool SupportsAsynchronousClients();
+
+    /** tell the server the owner has mail waiting for clients */
+    virtual bool PostMailWaiting();
+
+    /** is the server running? */
+    bool IsRunning(){return m_ServerThread.IsThreadRunning();}
+
+    /** stop the server printing */
+    void SetQuiet(bool bQuiet){m_bQuiet = bQuiet;}
+
+    /** fill in a summary of client timing */
+    virtual bool GetTimingStatisticSummary(std::string & sSummary);
+
+    /** the name of the community this server hosts */
+    std::string m_sCommunityName;
+
+    /** be quiet? */
+    bool m_bQuiet;
+
+protected:
+    bool StartThreads();
+    void DoBanner();
+
+    virtual bool ProcessClient();
+    virtual bool OnNewClient(XPCTcpSocket * pNewClient,char * sName);
+    virtual bool OnClientDisconnect();
+    virtual bool OnAbsentClient(XPCTcpSocket * pClient);
+
+    bool GatherSharedReply(const std::string & sWho,MOOSMSG_LIST & MsgLstTx,bool bHeader,MOOS::SHARED_MSG_LIST & SharedTx);
+
+    bool HandShake(XPCTcpSocket * pNewClient);
+    void PoisonClient(XPCTcpSocket * pSocket, const std::string & sReason);
+    bool IsUniqueName(std::string & sClientName);
+    std::string GetClientName(XPCTcpSocket * pSocket);
+    int GetMaxSocketFD();
+
+    /** callbacks and the parameters passed with them */
+    bool (*m_pfnRxCallBack)(const std::string &,MOOSMSG_LIST &,MOOSMSG_LIST &,void *);
+    void * m_pRxCallBackParam;
+
+    bool (*m_pfnRxViewsCallBack)(const std::string &,MOOS::MSG_VIEW_VECTOR &,MOOSMSG_LIST &,void *);
+    void * m_pRxViewsCallBackParam;
+
+    bool (*m_pfnConnectCallBack)(std::string &,void *);
+    void * m_pConnectCallBackParam;
+
+    bool (*m_pfnDisconnectCallBack)(std::string &,void *);
+    void * m_pDisconnectCallBackParam;
+
+    bool (*m_pfnFetchAllMailCallBack)(const std::string &,MOOSMSG_LIST &,void *);
+    void * m_pFetchAllMailCallBackParam;
+
+    bool (*m_pfnFetchAllSharedMailCallBack)(const std::string &,MOOS::SHARED_MSG_LIST &,void *);
+    void * m_pFetchAllSharedMailCallBackParam;
+
+    bool (*m_pfnFetchReplySharedMailCallBack)(const std::string &,MOOS::SHARED_MSG_LIST &,void *);
+    void * m_pFetchReplySharedMailCallBackParam;
+
+    bool (*m_pfnFetchClientsWithMailCallBack)(std::set<std::string> &,void *);
+    void * m_pFetchClientsWithMailCallBackParam;
+
+    /** the socket we listen on */
+    XPCTcpSocket * m_pListenSocket;
+
+    /** the socket being serviced */
+    XPCTcpSocket * m_pFocusSocket;
+
+    /** the connected client sockets */
+    SOCKETLIST m_ClientSocketList;
+    CMOOSLock m_SocketListLock;
+
+    /** map of socket file descriptor to client name */
+    SOCKETFD_2_CLIENT_NAME_MAP m_Socket2ClientMap;
+
+    /** names of clients which are asynchronous */
+    std::set<std::string> m_AsynchronousClientSet;
+
+    /** names of clients which talk the compact wire format */
+    std::set<std::string> m_CompactWireClientSet;
+
+    /** per client consolidation times (wildcard client names) */
+    std::list< std::pair< std::string, double > > m_ClientTimingVector;
+
+    CMOOSThread m_ListenThread;
+    CMOOSThread m_ServerThread;
+    CMOOSThread m_TimerThread;
+
+    MOOS::CommandLineParser m_CommandLineParser;
+    MOOS::ServerAudit m_Auditor;
+
+    long m_lListenPort;
+    unsigned int m_nAuditPort;
+    int m_nMaxSocketFD;
+    unsigned int m_nTotalActions;
+
+    double m_dfClientTimeout;
+    double m_dfCommsLatencyConcern;
+
+    bool m_bCompactWire;
+    bool m_bDisableNameLookUp;
+    bool m_bPrintHeartBeat;
+    bool m_bQuit;
+};
+
+#endif // !defined(MOOSCOMMSERVERH)
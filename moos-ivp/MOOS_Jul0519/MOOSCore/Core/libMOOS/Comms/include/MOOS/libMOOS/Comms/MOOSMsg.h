@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSMsg.h: interface for the CMOOSMsg class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSMSGH
+#define MOOSMSGH
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <cstdint>
+
+//MESSAGE TYPES
+#define MOOS_NOTIFY 'N'
+#define MOOS_REGISTER 'R'
+#define MOOS_UNREGISTER 'U'
+#define MOOS_WILDCARD_REGISTER '*'
+#define MOOS_WILDCARD_UNREGISTER '/'
+#define MOOS_NOT_SET '~'
+#define MOOS_COMMAND 'C'
+#define MOOS_ANONYMOUS 'A'
+#define MOOS_NULL_MSG '.'
+#define MOOS_DATA 'i'
+#define MOOS_POISON 'K'
+#define MOOS_WELCOME 'W'
+#define MOOS_SERVER_REQUEST 'Q'
+#define MOOS_SERVER_REQUEST_ID  -2
+#define MOOS_TIMING 'T'
+#define MOOS_TERMINATE_CONNECTION '^'
+
+//MESSAGE DATA TYPES
+#define MOOS_DOUBLE 'D'
+#define MOOS_STRING 'S'
+#define MOOS_BINARY_STRING 'B'
+
+#define SKEW_TOLERANCE 5
+
+/** This class is the container of information in MOOS. It is what is sent
+ * between client and DB. Messages have a name (key), a type, a value which
+ * is either a double or a string (which may hold binary data), a time
+ * stamp and the name of the process which published them. */
+class CMOOSMsg
+{
+public:
+    /** standard construction destruction*/
+    CMOOSMsg();
+    virtual ~CMOOSMsg();
+
+    /** specialised construction*/
+    CMOOSMsg(char cMsgType, const std::string &sKey, double dfVal, double dfTime = -1);
+
+    /** specialised construction*/
+    CMOOSMsg(char cMsgType, const std::string &sKey, const std::string &sVal, double dfTime = -1);
+
+    /** specialised binary construction*/
+    CMOOSMsg(char cMsgType, const std::string &sKey, unsigned int nDataSize, const void* Data, double dfTime = -1);
+
+    /** check data type (MOOS_STRING or MOOS_DOUBLE) */
+    bool IsDataType(char cDataType) const;
+
+    /** check data type is double*/
+    bool IsDouble() const { return IsDataType(MOOS_DOUBLE); }
+
+    /** check data type is string*/
+    bool IsString() const { return IsDataType(MOOS_STRING) || IsDataType(MOOS_BINARY_STRING); }
+
+    /** return true if message contains binary data */
+    bool IsBinary() const { return IsDataType(MOOS_BINARY_STRING); }
+
+    /** return true if message was made by another community */
+    bool IsSkewed(double dfTimeNow, double * pdfSkew = NULL);
+
+    /** return true if message is younger than dfAge*/
+    bool IsYoungerThan(double dfAge) const;
+
+    /** check message type MOOS_NOTIFY, REGISTER etc*/
+    bool IsType(char cType) const;
+
+    /** return message type*/
+    char GetType() const;
+
+    /** return data type */
+    char GetDataType() const { return m_cDataType; }
+
+    /** mark the message as containing binary data */
+    void MarkAsBinary();
+
+    /** return time stamp of message*/
+    double GetTime() const { return m_dfTime; }
+
+    /** return the double val of message*/
+    double GetDouble() const { return m_dfVal; }
+
+    /** return the auxilliary double val of message*/
+    double GetDoubleAux() const { return m_dfVal2; }
+
+    /** set the double val */
+    void SetDouble(double dfD) { m_dfVal = dfD; }
+
+    /** set the auxilliary double val */
+    void SetDoubleAux(double dfD) { m_dfVal2 = dfD; }
+
+    /** return string value of message*/
+    std::string GetString() const { return m_sVal; }
+
+    /** return a pointer to the binary data held in the message */
+    unsigned char * GetBinaryData();
+
+    /** return the size of the binary data held in the message */
+    unsigned int GetBinaryDataSize();
+
+    /** copy the binary data to a vector */
+    bool GetBinaryData(std::vector<unsigned char > &v);
+
+    /** return the binary data as a vector */
+    std::vector<unsigned char > GetBinaryDataAsVector();
+
+    /** return the name of message*/
+    std::string GetKey() const { return m_sKey; }
+    std::string GetName() const { return GetKey(); }
+    bool IsName(const std::string & sName);
+
+    /** return the name of the process (as registered with the DB) which posted this notification*/
+    std::string GetSource() const { return m_sSrc; }
+    std::string GetSourceAux() const { return m_sSrcAux; }
+    void SetSourceAux(const std::string & sSrcAux) { m_sSrcAux = sSrcAux; }
+
+    /** return the name of the MOOS community in which the orginator lives*/
+    std::string GetCommunity() const { return m_sOriginatingCommunity; }
+
+    /** format the message as string regardless of type*/
+    std::string GetAsString(int nFieldWidth = 12, int nNumDP = 5);
+
+    /** print a summary of the message*/
+    void Trace();
+
+    /** set the Double value */
+    void SetTime(double dfTime) { m_dfTime = dfTime; }
+
+    /** what type of message is this? Notification,Command,Register etc*/
+    char m_cMsgType;
+
+    /** what kind of data is contained? MOOS_DOUBLE,MOOS_STRING,MOOS_BINARY_STRING*/
+    char m_cDataType;
+
+    /** what is the variable name?*/
+    std::string m_sKey;
+
+    /** ID of message*/
+    int m_nID;
+
+    /** double precision time stamp (UNIX time)*/
+    double m_dfTime;
+
+    //DATA VARIABLES
+
+    //a) numeric
+    double m_dfVal;
+    double m_dfVal2;
+
+    //b) string
+    std::string m_sVal;
+
+    //who sent this message?
+    std::string m_sSrc;
+
+    //extra source info
+    std::string m_sSrcAux;
+
+    //what community did it originate in?
+    std::string m_sOriginatingCommunity;
+
+    //serialise this message into/out of a character buffer
+    int Serialize(unsigned char* pBuffer, int nLen, bool bToStream = true);
+
+    /** how many bytes will this message occupy when serialised */
+    unsigned int GetSizeInBytesWhenSerialised() const;
+
+    /** equality operator */
+    bool operator==(const CMOOSMsg &M) const;
+
+private:
+    unsigned char * m_pSerializeBufferStart;
+    unsigned char * m_pSerializeBuffer;
+    int m_nSerializeBufferLen;
+    int m_nLength;
+
+    bool CanSerialiseN(int N);
+    int GetLength();
+
+    void operator << (double & dfVal);
+    void operator << (std::string & sVal);
+    void operator << (int & nVal);
+    void operator << (char & cVal);
+    void operator >> (double & dfVal);
+    void operator >> (std::string & sVal);
+    void operator >> (int & nVal);
+    void operator >> (char & cVal);
+};
+
+typedef std::list<CMOOSMsg> MOOSMSG_LIST;
+typedef std::map<std::string,MOOSMSG_LIST> MOOSMSG_LIST_STRING_MAP;
+
+#endif // !defined(MOOSMSGH)
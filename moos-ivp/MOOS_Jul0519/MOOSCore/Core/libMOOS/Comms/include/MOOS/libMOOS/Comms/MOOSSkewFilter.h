@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSSkewFilter.h: a filter which estimates the clock skew between a
+// client and the MOOSDB from timing messages.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSSKEWFILTERH
+#define MOOSSKEWFILTERH
+
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include <deque>
+
+namespace MOOS
+{
+
+/** the upper or lower convex hull of a set of points, stored as a list
+of segments */
+class CConvexEnvelope
+{
+public:
+    enum eDirection
+    {
+        envelopeAbove,
+        envelopeBelow
+    };
+
+    struct tPt
+    {
+        tPt() : x(0), y(0) {}
+        tPt(double _x, double _y) : x(_x), y(_y) {}
+        double x;
+        double y;
+        void DumpState() const { MOOSTrace("(%f, %f)", x, y); }
+    };
+
+    struct tSeg
+    {
+        tSeg() : dfM(0), dfC(0), dfPeriod(0) {}
+        tPt p1;
+        tPt p2;
+        double dfM;
+        double dfC;
+        double dfPeriod;
+        void DumpState() const
+        {
+            p1.DumpState();
+            MOOSTrace(" -> ");
+            p2.DumpState();
+            MOOSTrace(" m=%f c=%f period=%f\n", dfM, dfC, dfPeriod);
+        }
+    };
+
+    CConvexEnvelope(eDirection aboveOrBelow);
+
+    void DumpState() const;
+    bool IsStable() const;
+    void Reset();
+    void GetLineEstimate(double &m, double &c) const;
+    bool AddPoint(double x, double y);
+    void CropFrontBefore(double x_min);
+    unsigned int GetNumSegs() const { return m_segs.size(); }
+
+private:
+    bool GetLongestSeg(tSeg &seg) const;
+    void AppendSeg(const tSeg & seg);
+    bool MakeSeg(tSeg &seg, const tPt &p1, const tPt &p2) const;
+    bool GetLineParams(const tPt &p1, const tPt &p2, double &M, double &C) const;
+    bool MergeLastSeg();
+
+    eDirection m_aboveOrBelow;
+    std::deque<tSeg> m_segs;
+    bool m_bHaveInitPt;
+    tPt m_InitPt;
+    unsigned int m_uiLongestSegID;
+    double m_dfLongestSegLen;
+    int m_nMeas;
+};
+
+/** estimates the skew between the local clock and the DB's clock */
+class CMOOSSkewFilter
+{
+public:
+    struct tSkewInfo
+    {
+        double m;
+        double c;
+        double LB;
+        double UB;
+        double envLB;
+        double envUB;
+        double envEst;
+        double filtEst;
+    };
+
+    CMOOSSkewFilter();
+    virtual ~CMOOSSkewFilter() {}
+
+    /** update the filter with a request time, the DB's transmit time and
+    the receive time - returns the new skew estimate */
+    double Update(double dfRQtime, double dfTXtime, double dfRXtime, tSkewInfo *skewinfo = NULL);
+
+    void Reset();
+    void DumpState() const;
+
+    bool GetSkewAtServerTime(double dfTime, double &dfSkew) const;
+    bool GetSkewAtLocalTime(double dfTime, double &dfSkew) const;
+
+private:
+    double GetLBSkewAtServerTime(double dfTime) const;
+    double GetUBSkewAtServerTime(double dfTime) const;
+    void GetMidLine(double &m, double &c) const;
+    double SmoothingFilter(double dfDT, double dfOldFilterVal, double dfNewMeas, double dfGradient) const;
+    void UpdateEnvelopes(double dfTXtime, double dfSkewLB, double dfSkewUB);
+
+    double m_dfLastVal;
+    double m_dfLastTime;
+    int m_nMeas;
+    CConvexEnvelope m_LowerBound;
+    CConvexEnvelope m_UpperBound;
+};
+
+}
+
+#endif // !defined(MOOSSKEWFILTERH)
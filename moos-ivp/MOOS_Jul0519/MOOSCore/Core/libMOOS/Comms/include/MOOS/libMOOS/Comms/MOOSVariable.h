@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSVariable.h: interface for the CMOOSVariable class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSVARIABLEH
+#define MOOSVARIABLEH
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+#include <string>
+#include <map>
+
+#define DEFAULT_MOOS_VAR_COMMS_TIME 0.2
+
+/** A class which holds the most recent value of a MOOS variable along with
+the names under which it is subscribed to and published */
+class CMOOSVariable
+{
+public:
+    CMOOSVariable();
+    CMOOSVariable(std::string sName, std::string sSubscribe, std::string sPublish, double dfCommsTime = DEFAULT_MOOS_VAR_COMMS_TIME);
+    virtual ~CMOOSVariable();
+
+    bool Set(double dfVal, double dfTime);
+    bool Set(const std::string & sVal, double dfTime);
+    bool Set(const CMOOSMsg & Msg);
+
+    bool SetFresh(bool bFresh);
+    bool IsFresh() const;
+    bool IsDouble() const;
+
+    std::string GetName() const;
+    std::string GetSubscribeName() const;
+    std::string GetPublishName() const;
+    std::string GetWriter() const;
+
+    double GetDoubleVal() const;
+    std::string GetStringVal() const;
+    std::string GetAsString(int nFieldWidth = 20) const;
+
+    double GetTime() const;
+    double GetAge(double dfTimeNow) const;
+    double GetCommsTime() const {return m_dfCommsTime;}
+
+protected:
+    bool m_bFresh;
+    bool m_bDouble;
+    double m_dfVal;
+    std::string m_sVal;
+    std::string m_sName;
+    std::string m_sSrc;
+    std::string m_sSubscribeName;
+    std::string m_sPublishName;
+    double m_dfTimeWritten;
+    double m_dfCommsTime;
+};
+
+typedef std::map<std::string,CMOOSVariable> MOOSVARMAP;
+
+#endif // !defined(MOOSVARIABLEH)
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MessageFunction.h
+ *
+ *  Functors which let a member function of any class be installed as a
+ *  callback for mail.
+ */
+
+#ifndef MESSAGEFUNCTION_H_
+#define MESSAGEFUNCTION_H_
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include <vector>
+
+namespace MOOS
+{
+
+/** the interface of something which can be called with a message */
+class MsgFunctor
+{
+public:
+    virtual ~MsgFunctor() {}
+    virtual bool operator()(CMOOSMsg & M) = 0;
+};
+
+/** binds a member function of an instance of T to a MsgFunctor */
+template <class T>
+class MsgFunctorImpl : public MsgFunctor
+{
+public:
+    typedef bool (T::*Method)(CMOOSMsg &);
+
+    MsgFunctorImpl(T * pInstance, Method pMethod)
+        : pInstance_(pInstance), pMethod_(pMethod) {}
+
+    virtual bool operator()(CMOOSMsg & M)
+    {
+        return (pInstance_->*pMethod_)(M);
+    }
+
+private:
+    T * pInstance_;
+    Method pMethod_;
+};
+
+/** makes a new functor which calls Instance->Method(Msg) - the caller owns it */
+template <class T>
+MsgFunctor * BindMsgFunctor(T * pInstance, bool (T::*pMethod)(CMOOSMsg &))
+{
+    return new MsgFunctorImpl<T>(pInstance, pMethod);
+}
+
+/** the interface of something which can be called with a vector of messages */
+class MsgVectorFunctor
+{
+public:
+    virtual ~MsgVectorFunctor() {}
+    virtual bool operator()(std::vector<CMOOSMsg> & M) = 0;
+};
+
+/** binds a member function of an instance of T to a MsgVectorFunctor */
+template <class T>
+class MsgVectorFunctorImpl : public MsgVectorFunctor
+{
+public:
+    typedef bool (T::*Method)(std::vector<CMOOSMsg> &);
+
+    MsgVectorFunctorImpl(T * pInstance, Method pMethod)
+        : pInstance_(pInstance), pMethod_(pMethod) {}
+
+    virtual bool operator()(std::vector<CMOOSMsg> & M)
+    {
+        return (pInstance_->*pMethod_)(M);
+    }
+
+private:
+    T * pInstance_;
+    Method pMethod_;
+};
+
+/** makes a new functor which calls Instance->Method(Msgs) - the caller owns it */
+template <class T>
+MsgVectorFunctor * BindMsgVectorFunctor(T * pInstance, bool (T::*pMethod)(std::vector<CMOOSMsg> &))
+{
+    return new MsgVectorFunctorImpl<T>(pInstance, pMethod);
+}
+
+}
+
+#endif /* MESSAGEFUNCTION_H_ */
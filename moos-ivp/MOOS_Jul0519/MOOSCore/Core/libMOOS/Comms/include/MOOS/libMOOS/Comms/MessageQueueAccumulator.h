@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MessageQueueAccumulator.h
+ *
+ *  Collects messages of a set of names and fires a callback once one of
+ *  each has arrived.
+ */
+
+#ifndef MESSAGEQUEUEACCUMULATOR_H_
+#define MESSAGEQUEUEACCUMULATOR_H_
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Comms/MessageFunction.h"
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MOOS {
+
+class MessageQueueAccumulator {
+public:
+	MessageQueueAccumulator();
+	virtual ~MessageQueueAccumulator();
+
+	/** the names of the messages to collect */
+	void Configure(std::vector<std::string > MsgNames);
+
+	/** add a message - may fire the callback */
+	bool AddMessage(CMOOSMsg & M);
+
+	/** install a member function of an instance of T as the callback */
+	template <class T>
+	void SetCallback(T * pInstance, bool (T::*pMethod)(std::vector<CMOOSMsg> &))
+	{
+		delete pClassMemberFunctionCallback_;
+		pClassMemberFunctionCallback_ = BindMsgVectorFunctor<T>(pInstance, pMethod);
+	}
+
+protected:
+	unsigned int max_stored_messages_;
+	std::map<std::string, unsigned int> msg2queue_;
+	std::vector<std::deque<CMOOSMsg> > store_;
+	MsgVectorFunctor * pClassMemberFunctionCallback_;
+};
+
+}
+
+#endif /* MESSAGEQUEUEACCUMULATOR_H_ */
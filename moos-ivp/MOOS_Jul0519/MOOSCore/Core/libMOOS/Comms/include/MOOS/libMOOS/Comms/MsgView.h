@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MsgView.h
+ *
+ *  A read only view of a message as it sits in a received packet. Nothing
+ *  is copied when a view is decoded - the strings are (pointer, length)
+ *  pairs into the packet buffer - so a view is only valid for as long as
+ *  the packet it came from. Use ToMsg() to make an owned CMOOSMsg when the
+ *  message has to outlive the packet.
+ */
+
+#ifndef MSGVIEW_H_
+#define MSGVIEW_H_
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace MOOS
+{
+
+/** a (pointer, length) pair referring to characters owned by someone else */
+class StringRef
+{
+public:
+    StringRef();
+    StringRef(const char * pData, unsigned int nSize);
+
+    const char * data() const;
+    unsigned int size() const;
+    bool empty() const;
+
+    /** make an owned copy */
+    std::string str() const;
+
+    /** copy into s, reusing its storage if it is big enough */
+    void AssignTo(std::string & s) const;
+
+    bool operator == (const std::string & s) const;
+    bool operator != (const std::string & s) const;
+
+private:
+    const char * data_;
+    unsigned int size_;
+};
+
+std::ostream & operator << (std::ostream & os, const StringRef & s);
+
+class MsgView
+{
+public:
+    MsgView();
+
+    /** decode a message serialised by CMOOSMsg::Serialize from pBuffer
+     * @return number of bytes used or -1 on failure */
+    int Decode(const unsigned char * pBuffer, int nLen);
+
+    /** fewest bytes any serialised message can take - every field
+     * present and every string empty */
+    static int MinWireSize();
+
+    int GetID() const;
+    char GetType() const;
+    bool IsType(char cType) const;
+    char GetDataType() const;
+    bool IsDouble() const;
+    bool IsString() const;
+    bool IsBinary() const;
+
+    const StringRef & GetSource() const;
+    const StringRef & GetSourceAux() const;
+    const StringRef & GetCommunity() const;
+    const StringRef & GetKey() const;
+    const StringRef & GetString() const;
+
+    double GetTime() const;
+    double GetDouble() const;
+    double GetDoubleAux() const;
+
+    /** the bytes this message occupied in the packet */
+    const unsigned char * Wire() const;
+    unsigned int WireSize() const;
+
+    /** fill in an owned copy of this message */
+    void ToMsg(CMOOSMsg & M) const;
+
+private:
+    const unsigned char * wire_;
+    unsigned int wire_size_;
+
+    int id_;
+    char msg_type_;
+    char data_type_;
+    StringRef source_;
+    StringRef source_aux_;
+    StringRef community_;
+    StringRef key_;
+    StringRef string_;
+    double time_;
+    double double_;
+    double double_aux_;
+};
+
+typedef std::vector<MsgView> MSG_VIEW_VECTOR;
+
+}
+
+#endif /* MSGVIEW_H_ */
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MulticastNode.h
+ *
+ *  Reads and writes datagrams on a multicast channel, each on its own
+ *  thread.
+ */
+
+#ifndef MULTICASTNODE_H_
+#define MULTICASTNODE_H_
+
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Utils/IPV4Address.h"
+
+#include <string>
+#include <vector>
+
+namespace MOOS {
+
+class MulticastNode {
+public:
+    MulticastNode();
+    virtual ~MulticastNode();
+
+    /** set the address and port of the channel and the number of hops */
+    bool Configure(const std::string & address, int port, int hops = 1);
+
+    /** the most datagrams held waiting to be read */
+    bool SetUnreadLimit(unsigned int limit);
+
+    /** start the reading and/or writing threads */
+    bool Run(bool run_write, bool run_read);
+
+    bool Read(std::string & data, int timeout_ms);
+    bool Write(const std::string & data);
+
+    bool Read(std::vector<unsigned char > & data, int timeout_ms);
+    bool Write(std::vector<unsigned char > & data);
+
+    bool ReadLoop();
+    bool WriteLoop();
+
+protected:
+    CMOOSThread write_thread_;
+    CMOOSThread read_thread_;
+    MOOS::IPV4Address ipv4_address_;
+    int hops_;
+    unsigned int unread_limit_;
+    SafeList<std::vector<unsigned char> > inbox_;
+    SafeList<std::vector<unsigned char> > outbox_;
+};
+
+}
+
+#endif /* MULTICASTNODE_H_ */
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ServerAudit.h
+ *
+ *  Keeps statistics of the traffic to and from each client of a server
+ *  and broadcasts them.
+ */
+
+#ifndef SERVERAUDIT_H_
+#define SERVERAUDIT_H_
+
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <sstream>
+#include <string>
+
+namespace MOOS {
+
+class ServerAudit {
+public:
+	ServerAudit();
+	virtual ~ServerAudit();
+
+	/** start broadcasting statistics */
+	bool Run(const std::string & destination_host = "localhost", unsigned int port = 9020);
+
+	/** forget about a client */
+	bool Remove(const std::string & sClient);
+
+	/** be quiet */
+	bool SetQuiet(bool bQuiet);
+
+	/** record a transfer of nBytes and nMessages to or from a client */
+	bool AddStatistic(const std::string & sClient,
+                      unsigned int nBytes,
+                      unsigned int nMessages,
+                      double dfTime,
+                      bool bIncoming);
+
+	/** get a summary of the latencies of all clients */
+	bool GetTimingStatisticSummary(std::string & sSummary);
+
+	/** record the transmit and receive time of a message from a client */
+	bool AddTimingStatistic(const std::string & sClient,
+                            double dfTransmitTime,
+                            double dfReceiveTime);
+
+	class Impl;
+
+private:
+	Impl * Impl_;
+};
+
+}
+
+#endif /* SERVERAUDIT_H_ */
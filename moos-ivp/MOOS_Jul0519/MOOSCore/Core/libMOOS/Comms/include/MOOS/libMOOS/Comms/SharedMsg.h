@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * SharedMsg.h
+ *
+ *  A handle to an immutable, reference counted notification. The DB
+ *  builds one of these per publication and every subscriber's mailbox
+ *  holds a copy of the handle rather than a copy of the message. The
+ *  message is serialised exactly once, when the payload is made, so the
+ *  wire bytes can be reused for every recipient. So is everything in
+ *  its compact encoding but the strings, which each connection's
+ *  dictionary decides how to send.
+ */
+
+#ifndef SHAREDMSG_H_
+#define SHAREDMSG_H_
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/SharedPtr.h"
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MOOS
+{
+
+class SharedMsg
+{
+public:
+    /** makes a null handle */
+    SharedMsg();
+
+    /** copies M (once) into a new payload and serialises it */
+    explicit SharedMsg(const CMOOSMsg & M);
+
+    /** true if this handle does not refer to a payload */
+    bool IsNull() const;
+
+    /** the message held by the payload - it must not be changed */
+    const CMOOSMsg & Msg() const;
+
+    /** the message as it appears on the wire (see CMOOSMsg::Serialize) */
+    const unsigned char * Wire() const;
+
+    /** number of bytes returned by Wire() */
+    unsigned int WireSize() const;
+
+    /** the parts of the compact (version 2) encoding which are the same
+     * for every client (see CompactWire::EncodeFixed) */
+    const unsigned char * CompactFixed() const;
+    unsigned int CompactFixedSize() const;
+    unsigned int CompactHeadSize() const;
+
+    /** how many handles currently share this payload */
+    int ReferenceCount() const;
+
+private:
+    struct Payload
+    {
+        CMOOSMsg _Msg;
+        std::vector<unsigned char> _Wire;
+        std::vector<unsigned char> _CompactFixed;
+        unsigned int _nCompactHead;
+    };
+
+    MOOS::Poco::SharedPtr<Payload> _pPayload;
+};
+
+typedef std::list<SharedMsg> SHARED_MSG_LIST;
+typedef std::map<std::string,SHARED_MSG_LIST> SHARED_MSG_LIST_STRING_MAP;
+
+}
+
+#endif /* SHAREDMSG_H_ */
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * SuicidalSleeper.h
+ *
+ *  Listens on a multicast channel for a pass phrase instructing the
+ *  process to exit.
+ */
+
+#ifndef SUICIDALSLEEPER_H_
+#define SUICIDALSLEEPER_H_
+
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include <string>
+
+namespace MOOS
+{
+
+class SuicidalSleeper
+{
+public:
+    SuicidalSleeper();
+    virtual ~SuicidalSleeper();
+
+    bool Run();
+
+    bool SetPassPhrase(const std::string & sPassPhrase);
+    bool SetChannel(const std::string & sAddress);
+    bool SetPort(int nPort);
+    bool SetName(const std::string & name);
+
+    std::string GetPassPhrase();
+    std::string GetChannel();
+    int GetPort();
+
+    static std::string GetDefaultPassPhrase();
+    static std::string GetDefaultMulticastAddress();
+    static int GetDefaultMulticastPort();
+
+    /** install a member function which is given a chance to say
+    something before the process exits */
+    template <class T>
+    void SetLastRightsCallback(T * pInstance, bool (T::*pMethod)(std::string &))
+    {
+        delete last_rights_callback_;
+        last_rights_callback_ = new LastRightsImpl<T>(pInstance, pMethod);
+    }
+
+protected:
+    bool Work();
+    static bool _dispatch_(void * pParam);
+
+    class LastRights
+    {
+    public:
+        virtual ~LastRights() {}
+        virtual bool operator()(std::string & sMessage) = 0;
+    };
+
+    template <class T>
+    class LastRightsImpl : public LastRights
+    {
+    public:
+        LastRightsImpl(T * pInstance, bool (T::*pMethod)(std::string &))
+            : pInstance_(pInstance), pMethod_(pMethod) {}
+        virtual bool operator()(std::string & sMessage)
+        {
+            return (pInstance_->*pMethod_)(sMessage);
+        }
+    private:
+        T * pInstance_;
+        bool (T::*pMethod_)(std::string &);
+    };
+
+    CMOOSThread thread_;
+    std::string multicast_group_IP_address_;
+    int multicast_port_;
+    std::string pass_phrase_;
+    std::string name_;
+    LastRights * last_rights_callback_;
+    unsigned int count_down_seconds_;
+};
+
+}
+
+#endif /* SUICIDALSLEEPER_H_ */
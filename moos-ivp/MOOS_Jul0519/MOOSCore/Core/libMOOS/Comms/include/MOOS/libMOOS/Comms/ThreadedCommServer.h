@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ThreadedCommServer.h
+ *
+ *  Created on: Aug 29, 2011
+ *      Author: pnewman
+ */
+
+#ifndef THREADEDCOMMSERVER_H_
+#define THREADEDCOMMSERVER_H_
+
+#include "MOOS/libMOOS/Comms/MOOSCommServer.h"
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
+#include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/SharedPtr.h"
+
+#include <map>
+#include <string>
+
+namespace MOOS
+{
+
+/** A MOOS server which gives every client a thread of its own to read
+(and, for asynchronous clients, write) its socket. Packets from all clients
+are processed in turn on a single server thread */
+class ThreadedCommServer : public CMOOSCommServer
+{
+    typedef CMOOSCommServer BASE;
+
+public:
+    ThreadedCommServer();
+    virtual ~ThreadedCommServer();
+
+    /** the data passed between a client's thread and the server thread */
+    class ClientThreadSharedData
+    {
+    public:
+        enum Status
+        {
+            NOT_INITIALISED,
+            PKT_READ,
+            PKT_WRITE,
+            CONNECTION_CLOSED,
+            STOP_THREAD,
+            MAIL_WAITING,
+        };
+
+        ClientThreadSharedData(const std::string & sName="",Status eStatus = NOT_INITIALISED) :
+            _sClientName(sName),
+            _Status(eStatus)
+        {
+            _pPkt = new CMOOSCommPkt;
+        }
+
+        std::string _sClientName;
+        Status _Status;
+        MOOS::Poco::SharedPtr<CMOOSCommPkt> _pPkt;
+    };
+
+    typedef MOOS::SafeList<ClientThreadSharedData> SHARED_PKT_LIST;
+
+    /** the thread(s) which talk to one client */
+    class ClientThread : public CMOOSCommObject
+    {
+    public:
+        ClientThread(const std::string & sName,
+                     XPCTcpSocket & ClientSocket,
+                     SHARED_PKT_LIST & SharedDataIncoming,
+                     bool bAsync,
+                     bool bCompactWire,
+                     double dfConsolidationPeriodMS,
+                     double dfClientTimeout,
+                     bool bBoost);
+        virtual ~ClientThread();
+
+        /** start the reader (and writer) threads */
+        bool Start();
+
+        /** stop the threads */
+        bool Kill();
+
+        /** queue a packet to be written to the client */
+        bool SendToClient(ClientThreadSharedData & OutGoing);
+
+        /** how long the client should consolidate mail for */
+        double GetConsolidationTime();
+
+        /** did the client negotiate the compact wire format? */
+        bool IsCompactWire();
+
+        /** dictionary of packets sent to this client */
+        MOOS::WireDictionary & TxDictionary();
+
+        /** dictionary of packets read from this client */
+        MOOS::WireDictionary & RxDictionary();
+
+        bool IsAsynchronous(){return m_bAsynchronous;}
+        bool IsSynchronous(){return !m_bAsynchronous;}
+        std::string GetClientName(){return m_sClientName;}
+        XPCTcpSocket & GetSocket(){return m_ClientSocket;}
+
+    protected:
+        static bool ReadEntry(void * pParam)
+        {
+            ClientThread* pMe = static_cast<ClientThread*>(pParam);
+            return pMe->AsynchronousReadLoop();
+        }
+        static bool WriteEntry(void * pParam)
+        {
+            ClientThread* pMe = static_cast<ClientThread*>(pParam);
+            return pMe->AsynchronousWriteLoop();
+        }
+
+        bool AsynchronousReadLoop();
+        bool AsynchronousWriteLoop();
+        bool HandleClientWrite();
+        bool OnClientDisconnect();
+
+        std::string m_sClientName;
+        XPCTcpSocket & m_ClientSocket;
+        SHARED_PKT_LIST & m_SharedDataIncoming;
+        SHARED_PKT_LIST m_SharedDataOutgoing;
+        bool m_bAsynchronous;
+        bool m_bCompactWire;
+        double m_dfConsolidationPeriod;
+        double m_dfClientTimeout;
+        bool m_bBoostThread;
+        MOOS::WireDictionary m_TxDictionary;
+        MOOS::WireDictionary m_RxDictionary;
+        CMOOSThread m_Reader;
+        CMOOSThread m_Writer;
+    };
+
+    typedef MOOS::Poco::SharedPtr<ClientThread> SharedClientThread;
+    typedef std::map<std::string,SharedClientThread> ClientThreadsMap;
+
+    virtual bool Stop();
+    virtual bool TimerLoop();
+    virtual bool ServerLoop();
+
+    virtual bool SupportsAsynchronousClients();
+    virtual bool SupportsCompactWire();
+    virtual bool PostMailWaiting();
+
+protected:
+    virtual bool ProcessClient();
+    virtual bool ProcessClient(ClientThreadSharedData & SD,MOOS::ServerAudit & Auditor);
+    virtual bool OnNewClient(XPCTcpSocket * pNewClient,char * sName);
+    virtual bool OnClientDisconnect();
+    virtual bool OnClientDisconnect(ClientThreadSharedData & SD);
+
+    bool AddAndStartClientThread(XPCTcpSocket & NewClientSocket,const std::string & sName);
+    bool StopAndCleanUpClientThread(std::string sName);
+
+    bool PushMailToClients(const std::string & sWho,MOOS::ServerAudit & Auditor);
+    bool PushMailToClient(const std::string & sWho,ClientThreadsMap::iterator q,MOOS::ServerAudit & Auditor);
+
+    bool SerializeForClient(ClientThread & Client,MOOSMSG_LIST & MsgLstTx,CMOOSCommPkt & Pkt);
+    bool SerializeForClient(ClientThread & Client,const MOOS::SHARED_MSG_LIST & SharedTx,CMOOSCommPkt & Pkt);
+
+    static bool WasteDisposalEntry(void * pParam)
+    {
+        ThreadedCommServer* pMe = static_cast<ThreadedCommServer*>(pParam);
+        return pMe->WasteDisposalLoop();
+    }
+    bool WasteDisposalLoop();
+
+    /** packets (and news) from client threads */
+    SHARED_PKT_LIST m_SharedDataListFromClient;
+
+    /** one entry per connected client */
+    ClientThreadsMap m_ClientThreads;
+
+    /** threads of clients which have gone, waiting to be deleted */
+    MOOS::SafeList<SharedClientThread> m_OldClientThreadsToDestroy;
+    CMOOSThread m_WasteDisposal;
+};
+
+}
+
+#endif /* THREADEDCOMMSERVER_H_ */
@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _XPCException
+#define _XPCException
+
+#include <string.h>
+
+class XPCException
+{
+    char sExceptMsg[255];    // Stores the exception message
+public:
+    // Constructor.  Stores the application defined exception message
+    XPCException(const char *sMsg)
+    {
+        strncpy(sExceptMsg, sMsg, sizeof(sExceptMsg)-1);
+        sExceptMsg[sizeof(sExceptMsg)-1] = '\0';
+    }
+
+    // Returns the exception message
+    char *sGetException() { return sExceptMsg; }
+};
+
+#endif
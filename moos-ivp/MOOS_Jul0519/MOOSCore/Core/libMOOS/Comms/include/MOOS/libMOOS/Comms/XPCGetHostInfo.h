@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _XPCGetHostInfo
+#define _XPCGetHostInfo
+
+#ifdef UNIX
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <sys/socket.h>
+#else
+    #include <winsock2.h>
+    typedef unsigned long in_addr_t;
+#endif
+
+#include "MOOS/libMOOS/Comms/XPCException.h"
+
+enum hostType {NAME, ADDRESS};
+
+class XPCGetHostInfo
+{
+#ifdef UNIX
+    char cIteratorFlag;     // Host database iteration flag
+#endif
+    struct hostent *hostPtr;    // Entry within the host address database
+public:
+    // Retrieves the host entry based on the host name or address
+    XPCGetHostInfo(const char *_sHost, hostType _type);
+    XPCGetHostInfo(in_addr_t *_netAddr);
+
+    // Destructor.  Closes the host entry database.
+    ~XPCGetHostInfo()
+    {
+#ifdef UNIX
+        endhostent();
+#endif
+    }
+
+#ifdef UNIX
+    // Retrieves the next host entry in the database
+    char cGetNextHost();
+
+    // Opens the host entry database
+    void vOpenHostDb()
+    {
+        endhostent();
+        cIteratorFlag = 1;
+        sethostent(1);
+    }
+#endif
+
+    // Retrieves the hosts IP address
+    char *sGetHostAddress()
+    {
+        struct in_addr *addr_ptr;
+        addr_ptr = (struct in_addr *)*hostPtr->h_addr_list;
+        return inet_ntoa(*addr_ptr);
+    }
+
+    // Retrieves the hosts name
+    char *sGetHostName()
+    {
+        return hostPtr->h_name;
+    }
+};
+
+#endif
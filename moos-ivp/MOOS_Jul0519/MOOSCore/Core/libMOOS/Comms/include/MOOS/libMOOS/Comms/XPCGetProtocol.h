@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _XPCGetProtocol
+#define _XPCGetProtocol
+
+#ifdef UNIX
+    #include <netdb.h>
+    #include <netinet/in.h>
+#else
+    #include <winsock2.h>
+#endif
+
+#include "MOOS/libMOOS/Comms/XPCException.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedLock.h"
+
+#include <string>
+#include <vector>
+
+class XPCGetProtocol
+{
+public:
+    // Retrieves the protocol by name or number
+    XPCGetProtocol(const char *_sName);
+    XPCGetProtocol(int _iProtocol);
+    ~XPCGetProtocol();
+
+#ifdef UNIX
+    // Opens the protocol database and iterates through it
+    void vOpenProtocolDb();
+    char cGetNextProtocol();
+#endif
+
+    // Returns the protocol name and number
+    const char *sGetProtocolName() { return _protocols[_index].name().c_str(); }
+    int iGetProtocolNumber() { return _protocols[_index].number(); }
+
+private:
+    class ProtoEnt
+    {
+    public:
+        ProtoEnt(struct protoent const* ent);
+        ~ProtoEnt();
+        std::string const& name() const;
+        int number() const;
+    private:
+        std::string _name;
+        std::vector<std::string> _aliases;
+        int _number;
+    };
+
+    static CMOOSLock _ProtocolLock;
+    std::vector<ProtoEnt> _protocols;
+    int _index;
+};
+
+#endif
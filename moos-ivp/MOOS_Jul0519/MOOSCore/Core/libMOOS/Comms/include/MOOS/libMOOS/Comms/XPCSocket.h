@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _XPCSocket
+#define _XPCSocket
+
+#ifdef UNIX
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <unistd.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/ioctl.h>
+    #define XPCSOCKET_ERROR -1
+#else
+    #include <winsock2.h>
+    typedef int socklen_t;
+    #define XPCSOCKET_ERROR SOCKET_ERROR
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "MOOS/libMOOS/Comms/XPCGetProtocol.h"
+#include "MOOS/libMOOS/Comms/XPCGetHostInfo.h"
+#include "MOOS/libMOOS/Comms/XPCException.h"
+
+class XPCSocket
+{
+protected:
+    int iPort;          // Socket port number
+    int iSocket;        // Socket file descriptor
+    int iBlocking;      // Blocking flag
+    char cBind;         // Binding flag
+    char cAccept;       // Accept flag
+    struct sockaddr_in clientAddress;   // Address of the client that sent data
+
+public:
+    // Constructor.  Creates a socket given a protocol (UDP / TCP) and a port number
+    XPCSocket(const char *_sProtocol, int _iPort);
+
+    // Constructor.  Wraps an existing socket descriptor
+    XPCSocket(int _iSocket) : iSocket(_iSocket) {}
+
+    // Destructor.  Closes the socket
+    virtual ~XPCSocket()
+    {
+        vCloseSocket();
+    }
+
+    // The socket is closed and the descriptor invalidated
+    void vCloseSocket()
+    {
+        if (iSocket == -1)
+            return;
+#ifdef UNIX
+        close(iSocket);
+#else
+        closesocket(iSocket);
+#endif
+        iSocket = -1;
+    }
+
+    // Returns the socket file descriptor
+    int iGetSocketFd() { return iSocket; }
+
+    // Socket option set and get methods
+    void vSetDebug(int _iToggle);
+    void vSetBroadcast(int _iToggle);
+    void vSetReuseAddr(int _iToggle);
+    void vSetKeepAlive(int _iToggle);
+    void vSetLinger(struct linger _lingerOption);
+    void vSetSendBuf(int _iSendBufSize);
+    void vSetRecieveBuf(int _iRecieveBufSize);
+    void vSetSocketBlocking(int _iToggle);
+    void vSetRecieveTimeOut(int nTimeOut);
+
+    int iGetDebug();
+    int iGetBroadcast();
+    int iGetReuseAddr();
+    int iGetKeepAlive();
+    void vGetLinger(struct linger &_lingerOption);
+    int iGetSendBuf();
+    int iGetRecieveBuf();
+    int iGetSocketBlocking() { return iBlocking; }
+
+    // Returns the last socket error
+    static int iGetLastError();
+
+    // Returns a description of the last socket error
+    static char * sGetError()
+    {
+#ifdef UNIX
+        return strerror(errno);
+#else
+        static char sMsg[64];
+        sprintf(sMsg, "WSA error %d", WSAGetLastError());
+        return sMsg;
+#endif
+    }
+};
+
+#endif
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _XPCTcpSocket
+#define _XPCTcpSocket
+
+#include "MOOS/libMOOS/Comms/XPCSocket.h"
+
+class XPCTcpSocket : public XPCSocket
+{
+private:
+    // Constructor.  Used internally to create a new object for an accepted connection
+    XPCTcpSocket(int _iSocket) : XPCSocket(_iSocket), m_dfLastRead(0) { }
+
+public:
+    // Constructor.  Creates a TCP socket on the given port
+    XPCTcpSocket(long int _iPort) : XPCSocket("tcp", _iPort), m_dfLastRead(0) { }
+
+    // Connects to a host
+    void vConnect(const char *_sHost);
+
+    // Sends a message over the socket
+    int iSendMessage(const void *_vMessage, int _iMessageSize);
+
+    // Receives a message, waiting for all of it
+    int iRecieveMessageAll(void *_vMessage, int _iMessageSize);
+
+    // Receives whatever is available
+    int iRecieveMessage(void *_vMessage, int _iMessageSize, int _iOption = 0);
+
+    // Reads with a timeout
+    int iReadMessageWithTimeOut(void *_vMessage, int _iMessageSize, double dfTimeOut, int _iOption = 0);
+
+    // Binds the socket to the local address and port
+    void vBindSocket();
+
+    // Listens for connections
+    void vListen(int _iNumPorts = 5);
+
+    // Accepts a connection, optionally returning the client host name
+    XPCTcpSocket *Accept(char *_sHost = NULL);
+
+    // Sets the TCP_NODELAY option
+    void vSetNoDelay(int _iToggle);
+
+    // Records and returns the time of the last read
+    void SetReadTime(double dfTime){m_dfLastRead = dfTime;}
+    double GetReadTime(){return m_dfLastRead;}
+
+private:
+    double m_dfLastRead;
+};
+
+#endif
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _XPCUdpSocket
+#define _XPCUdpSocket
+
+#include "MOOS/libMOOS/Comms/XPCSocket.h"
+
+#include <map>
+#include <string>
+
+class XPCUdpSocket : public XPCSocket
+{
+public:
+    // Constructor.  Creates a UDP socket on the given port
+    XPCUdpSocket(long int _iPort);
+
+    // Broadcasts a message on the given port
+    int iBroadCastMessage(void *_vMessage, int _iMessageSize, long int nPort);
+
+    // Sends a message to the given host and port
+    int iSendMessageTo(void *_vMessage, int _iMessageSize, long int nPort, const std::string & sHost);
+
+    // Receives a message
+    int iRecieveMessage(void *_vMessage, int _iMessageSize, int _iOption = 0);
+
+    // Reads with a timeout
+    int iReadMessageWithTimeOut(void *_vMessage, int _iMessageSize, double dfTimeOut, int _iOption = 0);
+
+    // Binds the socket to the local address and port
+    void vBindSocket();
+
+protected:
+    bool GetAddress(long int nPort, const std::string & sHost, sockaddr_in & Address);
+    std::map< std::pair< long int , std::string >, sockaddr_in > m_KnownAdresses;
+};
+
+#endif
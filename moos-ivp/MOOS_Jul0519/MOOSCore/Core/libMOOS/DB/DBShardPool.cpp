@@ -0,0 +1,406 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Public License
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/gpl.txt
+//   distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * DBShardPool.cpp
+ */
+
+#include "MOOS/libMOOS/DB/DBShardPool.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <deque>
+#include <stdint.h>
+
+namespace
+{
+
+//a notification's place in the order the pool was given them
+typedef uint64_t SEQUENCE;
+
+typedef std::list<std::pair<SEQUENCE,MOOS::DBShardPool::Result*> > SEQUENCED_RESULTS;
+
+void DeleteResults(SEQUENCED_RESULTS & Results)
+{
+    SEQUENCED_RESULTS::iterator q;
+    for(q = Results.begin();q!=Results.end();++q)
+        delete q->second;
+    Results.clear();
+}
+
+/** one shard's share of a run of notifications with their places in it */
+struct ShardJob
+{
+    MOOSMSG_LIST msgs_;
+    std::vector<SEQUENCE> seqs_;
+};
+
+/** a worker owns one shard. It waits for jobs to be pushed onto its job
+ * list and processes them in order. The results of a job appear in outbox_
+ * at the moment the job is taken off pending_ */
+struct ShardWorker
+{
+    unsigned int index_;
+    MOOS::DBShardPool::ShardWorkFn pfn_;
+    MOOS::DBShardPool::ResultsReadyFn ready_;
+    void * param_;
+    CMOOSThread thread_;
+    MOOS::SafeList<ShardJob*> jobs_;
+    MOOS::SafeList<unsigned int> * done_;
+
+    //pending_ and outbox_ are shared with the dispatching thread
+    CMOOSLock lock_;
+    //where each job handed over and not yet finished starts
+    std::deque<SEQUENCE> pending_;
+    //results of finished jobs not yet collected
+    SEQUENCED_RESULTS outbox_;
+
+    ~ShardWorker()
+    {
+        while(!jobs_.IsEmpty())
+        {
+            ShardJob * pJob = NULL;
+            jobs_.Pull(pJob);
+            delete pJob;
+        }
+        DeleteResults(outbox_);
+    }
+
+    bool Work()
+    {
+        while(!thread_.IsQuitRequested())
+        {
+            if(jobs_.IsEmpty() && !jobs_.WaitForPush(1000))
+                continue;
+
+            ShardJob * pJob = NULL;
+            jobs_.Pull(pJob);
+
+            //a NULL job is the signal to quit
+            if(pJob==NULL)
+                return true;
+
+            SEQUENCED_RESULTS Results;
+            MOOSMSG_LIST::iterator p = pJob->msgs_.begin();
+            for(unsigned int i = 0;p!=pJob->msgs_.end();++p,++i)
+            {
+                MOOS::DBShardPool::Result * pResult = (*pfn_)(index_,*p,param_);
+                if(pResult!=NULL)
+                    Results.push_back(std::make_pair(pJob->seqs_[i],pResult));
+            }
+            delete pJob;
+
+            lock_.Lock();
+            outbox_.splice(outbox_.end(),Results);
+            pending_.pop_front();
+            lock_.UnLock();
+
+            done_->Push(index_);
+
+            if(ready_!=NULL)
+                (*ready_)(param_);
+        }
+        return true;
+    }
+};
+
+bool ShardWorkerDispatch(void * pParam)
+{
+    ShardWorker* pMe = static_cast<ShardWorker*> (pParam);
+    return pMe->Work();
+}
+
+}
+
+namespace MOOS
+{
+
+class DBShardPool::Impl
+{
+public:
+    Impl()
+    {
+        running_ = false;
+        next_seq_ = 0;
+        outstanding_ = 0;
+    }
+
+    ~Impl()
+    {
+        Stop();
+    }
+
+    bool Start(unsigned int nShards, ShardWorkFn pfn, void * pParam, ResultsReadyFn pfnReady)
+    {
+        if(running_ || nShards==0 || pfn==NULL)
+            return false;
+
+        for(unsigned int i = 0;i<nShards;i++)
+        {
+            ShardWorker * pWorker = new ShardWorker;
+            pWorker->index_ = i;
+            pWorker->pfn_ = pfn;
+            pWorker->ready_ = pfnReady;
+            pWorker->param_ = pParam;
+            pWorker->done_ = &done_;
+            pWorker->thread_.Initialise(ShardWorkerDispatch,pWorker);
+            pWorker->thread_.Name(MOOSFormat("MOOSDB::shard_%d",i));
+            workers_.push_back(pWorker);
+        }
+        held_.resize(nShards);
+
+        for(unsigned int i = 0;i<workers_.size();i++)
+        {
+            if(!workers_[i]->thread_.Start())
+                return false;
+        }
+
+        running_ = true;
+        return true;
+    }
+
+    bool Stop()
+    {
+        for(unsigned int i = 0;i<workers_.size();i++)
+        {
+            ShardJob * pQuit = NULL;
+            workers_[i]->jobs_.Push(pQuit);
+            workers_[i]->thread_.Stop();
+            delete workers_[i];
+        }
+        workers_.clear();
+
+        for(unsigned int i = 0;i<held_.size();i++)
+            DeleteResults(held_[i]);
+        held_.clear();
+
+        while(!done_.IsEmpty())
+        {
+            unsigned int nShard;
+            done_.Pull(nShard);
+        }
+        outstanding_ = 0;
+
+        running_ = false;
+        return true;
+    }
+
+    unsigned int ShardOf(const std::string & sKey) const
+    {
+        if(workers_.empty())
+            return 0;
+
+        //FNV-1a - cheap and spreads similar names (NAV_X, NAV_Y) well
+        unsigned int h = 2166136261u;
+        for(std::string::const_iterator q = sKey.begin();q!=sKey.end();++q)
+        {
+            h ^= static_cast<unsigned char>(*q);
+            h *= 16777619u;
+        }
+        return h%workers_.size();
+    }
+
+    bool Dispatch(MOOSMSG_LIST & Run)
+    {
+        if(workers_.empty())
+            return false;
+
+        //forget jobs finished since we last looked
+        Reap();
+
+        std::vector<ShardJob*> Jobs(workers_.size(),static_cast<ShardJob*>(NULL));
+        MOOSMSG_LIST::iterator p = Run.begin();
+        while(p!=Run.end())
+        {
+            unsigned int nShard = ShardOf(p->GetKey());
+            if(Jobs[nShard]==NULL)
+                Jobs[nShard] = new ShardJob;
+
+            ShardJob & rJob = *Jobs[nShard];
+            rJob.seqs_.push_back(next_seq_++);
+            rJob.msgs_.splice(rJob.msgs_.end(),Run,p++);
+        }
+
+        for(unsigned int i = 0;i<Jobs.size();i++)
+        {
+            if(Jobs[i]==NULL)
+                continue;
+
+            //the job must be pending before the worker can finish it
+            ShardWorker & rWorker = *workers_[i];
+            rWorker.lock_.Lock();
+            rWorker.pending_.push_back(Jobs[i]->seqs_.front());
+            rWorker.lock_.UnLock();
+
+            rWorker.jobs_.Push(Jobs[i]);
+            outstanding_++;
+        }
+
+        return true;
+    }
+
+    bool Drain()
+    {
+        while(outstanding_>0)
+        {
+            if(done_.IsEmpty() && !done_.WaitForPush(1000))
+                continue;
+
+            unsigned int nShard;
+            done_.Pull(nShard);
+            outstanding_--;
+        }
+        return true;
+    }
+
+    bool IsIdle()
+    {
+        Reap();
+        return outstanding_==0;
+    }
+
+    bool Collect(std::list<Result*> & Results)
+    {
+        //take whatever the workers have finished and find the earliest
+        //notification any of them is still to finish
+        bool bBusy = false;
+        SEQUENCE nEarliest = 0;
+        for(unsigned int i = 0;i<workers_.size();i++)
+        {
+            ShardWorker & rWorker = *workers_[i];
+            rWorker.lock_.Lock();
+            held_[i].splice(held_[i].end(),rWorker.outbox_);
+            if(!rWorker.pending_.empty() && (!bBusy || rWorker.pending_.front()<nEarliest))
+            {
+                nEarliest = rWorker.pending_.front();
+                bBusy = true;
+            }
+            rWorker.lock_.UnLock();
+        }
+
+        //every result from before that is final. Each shard's results are
+        //in order so hand them over by repeatedly taking the earliest
+        while(true)
+        {
+            SEQUENCED_RESULTS * pNext = NULL;
+            for(unsigned int i = 0;i<held_.size();i++)
+            {
+                if(held_[i].empty())
+                    continue;
+
+                SEQUENCE nSeq = held_[i].front().first;
+                if(bBusy && nSeq>=nEarliest)
+                    continue;
+
+                if(pNext==NULL || nSeq<pNext->front().first)
+                    pNext = &held_[i];
+            }
+
+            if(pNext==NULL)
+                break;
+
+            Results.push_back(pNext->front().second);
+            pNext->pop_front();
+        }
+
+        return true;
+    }
+
+    bool running_;
+    std::vector<ShardWorker*> workers_;
+    MOOS::SafeList<unsigned int> done_;
+
+    //only touched by the dispatching thread
+    SEQUENCE next_seq_;
+    unsigned int outstanding_;
+    std::vector<SEQUENCED_RESULTS> held_;
+
+private:
+    void Reap()
+    {
+        while(!done_.IsEmpty())
+        {
+            unsigned int nShard;
+            done_.Pull(nShard);
+            outstanding_--;
+        }
+    }
+};
+
+DBShardPool::DBShardPool() : impl_(new Impl)
+{
+}
+
+DBShardPool::~DBShardPool()
+{
+    delete impl_;
+}
+
+bool DBShardPool::Start(unsigned int nShards, ShardWorkFn pfn, void * pParam, ResultsReadyFn pfnReady)
+{
+    return impl_->Start(nShards,pfn,pParam,pfnReady);
+}
+
+bool DBShardPool::Stop()
+{
+    return impl_->Stop();
+}
+
+bool DBShardPool::IsRunning() const
+{
+    return impl_->running_;
+}
+
+unsigned int DBShardPool::GetNumShards() const
+{
+    return impl_->workers_.size();
+}
+
+unsigned int DBShardPool::ShardOf(const std::string & sKey) const
+{
+    return impl_->ShardOf(sKey);
+}
+
+bool DBShardPool::Dispatch(MOOSMSG_LIST & Run)
+{
+    return impl_->Dispatch(Run);
+}
+
+bool DBShardPool::Drain()
+{
+    return impl_->Drain();
+}
+
+bool DBShardPool::IsIdle()
+{
+    return impl_->IsIdle();
+}
+
+bool DBShardPool::Collect(std::list<Result*> & Results)
+{
+    return impl_->Collect(Results);
+}
+
+}
@@ -41,6 +41,10 @@
 #include "MOOS/libMOOS/GitVersion.h"
 #include "MOOS/libMOOS/DB/MOOSDBLogger.h"
 #include "MOOS/libMOOS/Utils/MOOSScopedPtr.h"
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
+#include "MOOS/libMOOS/Comms/MsgView.h"
+#include "MOOS/libMOOS/DB/DBShardPool.h"
+#include "MOOS/libMOOS/DB/WildcardIndex.h"
 
 
 
@@ -66,6 +70,13 @@ bool CMOOSDB::OnRxPktCallBack(const std::string & sWho,MOOSMSG_LIST & MsgListRx,
     return pMe->OnRxPkt(sWho,MsgListRx,MsgListTx);
 }
 
+bool CMOOSDB::OnRxPktViewsCallBack(const std::string & sWho,MOOS::MSG_VIEW_VECTOR & ViewsRx,MOOSMSG_LIST & MsgListTx, void * pParam)
+{
+    CMOOSDB* pMe = (CMOOSDB*)(pParam);
+
+    return pMe->OnRxPktViews(sWho,ViewsRx,MsgListTx);
+}
+
 bool CMOOSDB::OnFetchAllMailCallBack(const std::string & sWho,MOOSMSG_LIST & MsgListTx, void * pParam)
 {
     CMOOSDB* pMe = (CMOOSDB*)(pParam);
@@ -73,6 +84,41 @@ bool CMOOSDB::OnFetchAllMailCallBack(const std::string & sWho,MOOSMSG_LIST & Msg
     return pMe->OnFetchAllMail(sWho,MsgListTx);
 }
 
+bool CMOOSDB::OnFetchAllSharedMailCallBack(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx, void * pParam)
+{
+    CMOOSDB* pMe = (CMOOSDB*)(pParam);
+
+    return pMe->OnFetchAllSharedMail(sWho,MsgListTx);
+}
+
+bool CMOOSDB::OnFetchReplySharedMailCallBack(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx, void * pParam)
+{
+    CMOOSDB* pMe = (CMOOSDB*)(pParam);
+
+    return pMe->FetchSharedMail(sWho,MsgListTx);
+}
+
+bool CMOOSDB::OnFetchClientsWithMailCallBack(std::set<std::string> & Clients, void * pParam)
+{
+    CMOOSDB* pMe = (CMOOSDB*)(pParam);
+
+    return pMe->OnFetchClientsWithMail(Clients);
+}
+
+MOOS::DBShardPool::Result * CMOOSDB::OnShardWorkCallBack(unsigned int nShard,CMOOSMsg & Msg, void * pParam)
+{
+    CMOOSDB* pMe = (CMOOSDB*)(pParam);
+
+    return pMe->OnShardWork(nShard,Msg);
+}
+
+void CMOOSDB::OnShardResultsReadyCallBack(void * pParam)
+{
+    CMOOSDB* pMe = (CMOOSDB*)(pParam);
+
+    pMe->OnShardResultsReady();
+}
+
 bool CMOOSDB::OnDisconnectCallBack(string & sClient, void * pParam)
 {
     CMOOSDB* pMe = (CMOOSDB*)(pParam);
@@ -100,6 +146,16 @@ CMOOSDB::CMOOSDB()
     
     m_bQuiet = false;
 
+    //by default every mailbox gets its own copy of a notification
+    m_bShareNotifications = false;
+
+    //by default all notifications are processed by the server thread
+    m_nDBThreads = 1;
+    m_bShardMailSignalled = false;
+
+    m_nMailFetches = 0;
+    m_nWastedMailFetches = 0;
+
     //make our own variable called DB_TIME
     {
         CMOOSDBVar NewVar("DB_TIME");
@@ -178,6 +234,17 @@ CMOOSDB::CMOOSDB()
         m_VarMap["DB_RWSUMMARY"] = NewVar;
     }
 
+    //make our own variable called DB_MAIL_FETCHES
+    {
+        CMOOSDBVar NewVar("DB_MAIL_FETCHES");
+        NewVar.m_cDataType = MOOS_STRING;
+        NewVar.m_dfVal= MOOSTime();
+        NewVar.m_sWhoChangedMe = m_sDBName;
+        NewVar.m_sOriginatingCommunity = m_sCommunityName;
+        NewVar.m_dfWrittenTime = MOOSTime();
+        m_VarMap["DB_MAIL_FETCHES"] = NewVar;
+    }
+
 
 
 
@@ -196,6 +263,8 @@ CMOOSDB::~CMOOSDB()
 {
     if(m_pCommServer.get()!=NULL)
         m_pCommServer->Stop();
+
+    m_ShardPool.Stop();
 }
 
 
@@ -227,6 +296,7 @@ void PrintHelpAndExit()
 
 	std::cout<<"-d    (--dns)                      run with dns lookup\n";
 	std::cout<<"-s    (--single_threaded)          run as a single thread (legacy mode)\n";
+	std::cout<<"--db_threads=<positive_integer>    process notifications on this many shards/threads\n";
 	std::cout<<"-b    (--moos_boost)               boost priority of communications\n";
 	std::cout<<"--moos_timeout=<positive_float>    specify client timeout\n";
 	std::cout<<"--response=<string-list>           specify tolerable client latencies in ms\n";
@@ -235,6 +305,8 @@ void PrintHelpAndExit()
 	std::cout<<"--audit_port=<unsigned int>        specify port on which to transmit statistics\n";
     std::cout<<"--event_log=<file name>            specify file in which to record events\n";
     std::cout<<"--print_heart_beat                 indicate DB heartbeat every second\n";
+    std::cout<<"--shared_mail                      share one copy of a notification between all subscribers\n";
+    std::cout<<"--no_compact_wire                  talk only the original wire format to clients\n";
 
 
 
@@ -359,6 +431,25 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     if(P.GetFlag("--tcpnodelay"))
     	bTCPNoDelay = true;
 
+    ///////////////////////////////////////////////////////////
+    //should mailboxes hold handles to a single shared notification?
+    m_MissionReader.GetValue("SharedMail",m_bShareNotifications);
+    if(P.GetFlag("--shared_mail"))
+        m_bShareNotifications = true;
+
+    ///////////////////////////////////////////////////////////
+    //how many threads should process notifications? Variables are
+    //sharded across them by name
+    m_MissionReader.GetValue("DBThreads",m_nDBThreads);
+    P.GetVariable("--db_threads",m_nDBThreads);
+
+    ///////////////////////////////////////////////////////////
+    //may clients which offer it use the compact wire format?
+    bool bCompactWire = true;
+    m_MissionReader.GetValue("CompactWire",bCompactWire);
+    if(P.GetFlag("--no_compact_wire"))
+        bCompactWire = false;
+
 
 
     ///////////////////////////////////////////////////////////
@@ -374,6 +465,10 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     //are we being asked to be old skool and use a single thread?
     bool bSingleThreaded = P.GetFlag("-s","--single_threaded");
 
+    //the single threaded server only speaks the original wire format
+    if(bSingleThreaded)
+        bCompactWire = false;
+
 
     //is the community name being specified on the cli?
 	unsigned int nAuditPort=9020;
@@ -436,13 +531,38 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
 
     m_pCommServer->SetQuiet(m_bQuiet);
 
+    if(m_nDBThreads>1)
+    {
+        if(!m_ShardPool.Start(m_nDBThreads,OnShardWorkCallBack,this,OnShardResultsReadyCallBack))
+            return MOOSFail("failed to start %d DB worker threads",m_nDBThreads);
+    }
+
     m_pCommServer->SetOnRxCallBack(OnRxPktCallBack,this);
 
+    //decode packets in place rather than into a CMOOSMsg per message. The
+    //shard workers want lists of messages so this is for one thread only
+    if(!m_ShardPool.IsRunning())
+        m_pCommServer->SetOnRxViewsCallBack(OnRxPktViewsCallBack,this);
+
     m_pCommServer->SetOnDisconnectCallBack(OnDisconnectCallBack,this);
 
     m_pCommServer->SetOnConnectCallBack(OnConnectCallBack,this);
 
-    m_pCommServer->SetOnFetchAllMailCallBack(OnFetchAllMailCallBack,this);
+    //clients can be sent shared mail without it being turned back into
+    //messages and serialised again for each of them - whether it is pushed
+    //to them or goes in the reply to their own packet
+    if(m_bShareNotifications)
+    {
+        m_pCommServer->SetOnFetchAllSharedMailCallBack(OnFetchAllSharedMailCallBack,this);
+        m_pCommServer->SetOnFetchReplySharedMailCallBack(OnFetchReplySharedMailCallBack,this);
+    }
+    else
+    {
+        m_pCommServer->SetOnFetchAllMailCallBack(OnFetchAllMailCallBack,this);
+    }
+
+    //we keep track of who has mail so the server need not ask everyone
+    m_pCommServer->SetOnFetchClientsWithMailCallBack(OnFetchClientsWithMailCallBack,this);
 
     m_pCommServer->SetClientTimeout(dfClientTimeout);
 
@@ -450,6 +570,8 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
 
     m_pCommServer->SetTCPNoDelay(bTCPNoDelay);
 
+    m_pCommServer->SetCompactWire(bCompactWire);
+
     m_pCommServer->BoostIOPriority(bBoost);
 
     m_pCommServer->SetCommandLineParameters(argc,argv);
@@ -567,6 +689,17 @@ void CMOOSDB::UpdateReadWriteSummaryVar()
 
 }
 
+void CMOOSDB::UpdateMailFetchVar()
+{
+    std::ostringstream ss;
+    ss<<"fetches="<<m_nMailFetches<<",wasted="<<m_nWastedMailFetches;
+
+    CMOOSMsg DBF(MOOS_NOTIFY,"DB_MAIL_FETCHES",ss.str());
+    DBF.m_sSrc = m_sDBName;
+    DBF.m_sOriginatingCommunity = m_sCommunityName;
+    OnNotify(DBF);
+}
+
 void CMOOSDB::UpdateDBTimeVars()
 {
     CMOOSMsg DBT(MOOS_NOTIFY,"DB_TIME",MOOSTime());
@@ -585,19 +718,60 @@ void CMOOSDB::UpdateDBTimeVars()
 bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx)
 {
 
-    MOOSMSG_LIST::iterator p;
-    
-    for(p = MsgListRx.begin();p!=MsgListRx.end();++p)
+    //sharded processing removes messages from MsgListRx so remember now
+    //whether this client sent anything
+    bool bRxd = !MsgListRx.empty();
+
+    if(m_ShardPool.IsRunning())
     {
-        ProcessMsg(*p,MsgListTx);
+        ProcessMsgsInShards(MsgListRx,MsgListTx);
+    }
+    else
+    {
+        MOOSMSG_LIST::iterator p;
+
+        for(p = MsgListRx.begin();p!=MsgListRx.end();++p)
+        {
+            ProcessMsg(*p,MsgListTx);
+        }
+    }
+
+    return OnRxPktDone(sClient,bRxd,MsgListTx);
+}
+
+/** as OnRxPkt but the messages are views into the received packet. Writes
+to variables nobody subscribes to are applied straight from the packet,
+everything else is turned into a CMOOSMsg first */
+bool CMOOSDB::OnRxPktViews(const std::string & sClient,MOOS::MSG_VIEW_VECTOR & ViewsRx,MOOSMSG_LIST & MsgListTx)
+{
+    MOOS::MSG_VIEW_VECTOR::iterator p;
+    for(p = ViewsRx.begin();p!=ViewsRx.end();++p)
+    {
+        if(p->IsType(MOOS_NOTIFY) && OnNotifyInPlace(*p))
+            continue;
+
+        CMOOSMsg Msg;
+        p->ToMsg(Msg);
+        ProcessMsg(Msg,MsgListTx);
     }
-    
+
+    return OnRxPktDone(sClient,!ViewsRx.empty(),MsgListTx);
+}
+
+/** housekeeping and replies common to all ways of receiving a packet */
+bool CMOOSDB::OnRxPktDone(const std::string & sClient,bool bRxd,MOOSMSG_LIST & MsgListTx)
+{
+    //mail the shard workers have finished goes in this reply
+    CollectShardMail();
 
     double dfNow = MOOS::Time();
     if(dfNow-m_dfSummaryTime>2.0)
     {
         m_dfSummaryTime = dfNow;
 
+        //the summaries read every variable
+        WaitForShards();
+
         //good spot to update our internal time
         UpdateDBTimeVars();
 
@@ -612,9 +786,21 @@ bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSM
 
         //update variable which publishes who is reading and writing what
         UpdateReadWriteSummaryVar();
+
+        //and how often asynchronous clients were asked for mail they did not have
+        UpdateMailFetchVar();
     }
 
-    if(!MsgListRx.empty())
+    //shared mail is picked up by the comm server as it makes the reply
+    //(see FetchSharedMail) so none of it is copied in here
+    bool bHeldMail = bRxd && !m_bShareNotifications;
+
+    //latest value only mail goes after anything queued (which is put at
+    //the front of MsgListTx below)
+    if(bHeldMail)
+        FetchLatestMail(sClient,MsgListTx);
+
+    if(bHeldMail)
     {
         
         //now we fill in the packet with our replies to THIS CLIENT
@@ -651,26 +837,265 @@ bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSM
             }
         }
     }
+
+    //whatever was waiting for this client is on its way
+    if(bRxd)
+        m_ClientsWithMail.erase(sClient);
     
     return true;
 }
 
 bool CMOOSDB::OnFetchAllMail(const std::string & sWho,MOOSMSG_LIST & MsgListTx)
 {
+	m_nMailFetches++;
+	m_ClientsWithMail.erase(sWho);
+
+	unsigned int nBefore = MsgListTx.size();
+
+	FetchLatestMail(sWho,MsgListTx);
+
+	//only used without shared mail (see OnFetchAllSharedMail)
 	MOOSMSG_LIST_STRING_MAP::iterator q = m_HeldMailMap.find(sWho);
-	if(q!=m_HeldMailMap.end())
+	if(q!=m_HeldMailMap.end() && !q->second.empty())
 	{
-		if(!q->second.empty())
-		{
-            MsgListTx.splice(MsgListTx.begin(),
-            		q->second,
-            		q->second.begin(),
-            		q->second.end());
-		}
+		MsgListTx.splice(MsgListTx.begin(),
+				q->second,
+				q->second.begin(),
+				q->second.end());
 	}
+
+	//asked for mail there was none of?
+	if(MsgListTx.size()==nBefore)
+		m_nWastedMailFetches++;
+
 	return true;
 }
 
+/** put the latest value only notifications waiting for sWho at the front
+of MsgListTx. There is at most one per variable */
+bool CMOOSDB::FetchLatestMail(const std::string & sWho,MOOSMSG_LIST & MsgListTx)
+{
+    LATEST_MAIL_MAP::iterator q = m_LatestMailMap.find(sWho);
+    if(q==m_LatestMailMap.end() || q->second.empty())
+        return false;
+
+    MOOSMSG_LIST::iterator w = MsgListTx.begin();
+    MOOSMSG_STRING_MAP::iterator p;
+    for(p = q->second.begin();p!=q->second.end();++p)
+    {
+        MsgListTx.insert(w,p->second);
+    }
+    q->second.clear();
+
+    return true;
+}
+
+/** hand the comm server the names of clients who have been sent mail since
+it last asked, so only their boxes need be looked at */
+bool CMOOSDB::OnFetchClientsWithMail(std::set<std::string> & Clients)
+{
+    //including whoever the shard workers have made mail for since
+    CollectShardMail();
+
+    Clients.clear();
+    Clients.swap(m_ClientsWithMail);
+    return true;
+}
+
+/** hand over (without copying the payloads) the shared notifications waiting
+for sWho, followed by its latest value only mail, at the front of MsgListTx.
+The comm server calls this directly when it replies to a packet from sWho */
+bool CMOOSDB::FetchSharedMail(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx)
+{
+    //latest value only mail was never shared - it is serialised here once
+    //it is certain to be sent
+    MOOSMSG_LIST Latest;
+    FetchLatestMail(sWho,Latest);
+    MOOS::SHARED_MSG_LIST::iterator w = MsgListTx.begin();
+    MOOSMSG_LIST::iterator l;
+    for(l = Latest.begin();l!=Latest.end();++l)
+        MsgListTx.insert(w,MOOS::SharedMsg(*l));
+
+    MOOS::SHARED_MSG_LIST_STRING_MAP::iterator q = m_SharedMailMap.find(sWho);
+    if(q!=m_SharedMailMap.end() && !q->second.empty())
+    {
+        MsgListTx.splice(MsgListTx.begin(),
+                q->second,
+                q->second.begin(),
+                q->second.end());
+    }
+
+    return true;
+}
+
+/** the mail a shard worker made from one notification. CollectShardMail()
+puts it in the client boxes in the order the notifications arrived */
+class ShardMail : public MOOS::DBShardPool::Result
+{
+public:
+    MOOSMSG_LIST_STRING_MAP m_HeldMail;
+    MOOS::SHARED_MSG_LIST_STRING_MAP m_SharedMail;
+    LATEST_MAIL_MAP m_LatestMail;
+    STRING_SET m_ClientsWithMail;
+};
+
+/** process a packet using the shard workers. Runs of notifications are
+handed to the workers without waiting for them. Everything else
+(registrations, server requests...) is processed here, in order, once the
+workers have caught up */
+bool CMOOSDB::ProcessMsgsInShards(MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx)
+{
+    MOOSMSG_LIST Run;
+
+    MOOSMSG_LIST::iterator p = MsgListRx.begin();
+    while(p!=MsgListRx.end())
+    {
+        if(p->IsType(MOOS_NOTIFY))
+        {
+            //new variables are made here with the workers idle so that
+            //they never see m_VarMap change shape
+            if(m_VarMap.find(p->GetKey())==m_VarMap.end())
+            {
+                WaitForShards();
+                GetOrMakeVar(*p);
+            }
+            Run.splice(Run.end(),MsgListRx,p++);
+            continue;
+        }
+
+        if(!Run.empty())
+            m_ShardPool.Dispatch(Run);
+
+        //a null message changes nothing so need not wait
+        if(!p->IsType(MOOS_NULL_MSG))
+            WaitForShards();
+
+        ProcessMsg(*p,MsgListTx);
+        ++p;
+    }
+
+    if(!Run.empty())
+        m_ShardPool.Dispatch(Run);
+
+    return true;
+}
+
+/** wait for the shard workers to finish all they have been given and
+deliver their mail. The server thread must call this before it touches
+variables itself or makes mail of its own */
+void CMOOSDB::WaitForShards()
+{
+    if(!m_ShardPool.IsRunning())
+        return;
+
+    m_ShardPool.Drain();
+    CollectShardMail();
+}
+
+/** called on a shard worker thread. The mail made goes back to the server
+thread (see CollectShardMail) so the worker touches no client boxes */
+MOOS::DBShardPool::Result * CMOOSDB::OnShardWork(unsigned int nShard,CMOOSMsg & Msg)
+{
+    MOOS::DeliberatelyNotUsed(nShard);
+
+    ShardMail * pMail = new ShardMail;
+    OnNotify(Msg,
+             pMail->m_HeldMail,
+             pMail->m_SharedMail,
+             pMail->m_LatestMail,
+             pMail->m_ClientsWithMail);
+
+    if(pMail->m_ClientsWithMail.empty())
+    {
+        delete pMail;
+        return NULL;
+    }
+    return pMail;
+}
+
+/** called on a shard worker thread when it has finished a batch. Asks the
+comm server (once until the mail is collected) to come and push it */
+void CMOOSDB::OnShardResultsReady()
+{
+    m_ShardSignalLock.Lock();
+    bool bSignal = !m_bShardMailSignalled;
+    m_bShardMailSignalled = true;
+    m_ShardSignalLock.UnLock();
+
+    if(bSignal)
+        m_pCommServer->PostMailWaiting();
+}
+
+/** move mail made by the shard workers to the client boxes. It comes back
+in the order the notifications arrived so every client sees the same order
+as it would from a single threaded DB */
+void CMOOSDB::CollectShardMail()
+{
+    if(!m_ShardPool.IsRunning())
+        return;
+
+    //anything finished from here on asks for another collection
+    m_ShardSignalLock.Lock();
+    m_bShardMailSignalled = false;
+    m_ShardSignalLock.UnLock();
+
+    std::list<MOOS::DBShardPool::Result*> Results;
+    m_ShardPool.Collect(Results);
+
+    std::list<MOOS::DBShardPool::Result*>::iterator r;
+    for(r = Results.begin();r!=Results.end();++r)
+    {
+        ShardMail * pMail = static_cast<ShardMail*>(*r);
+
+        MOOSMSG_LIST_STRING_MAP::iterator q;
+        for(q = pMail->m_HeldMail.begin();q!=pMail->m_HeldMail.end();++q)
+        {
+            MOOSMSG_LIST & rBox = m_HeldMailMap[q->first];
+            rBox.splice(rBox.end(),q->second);
+        }
+
+        MOOS::SHARED_MSG_LIST_STRING_MAP::iterator w;
+        for(w = pMail->m_SharedMail.begin();w!=pMail->m_SharedMail.end();++w)
+        {
+            MOOS::SHARED_MSG_LIST & rBox = m_SharedMailMap[w->first];
+            rBox.splice(rBox.end(),w->second);
+        }
+
+        //later notifications replace earlier ones
+        LATEST_MAIL_MAP::iterator l;
+        for(l = pMail->m_LatestMail.begin();l!=pMail->m_LatestMail.end();++l)
+        {
+            MOOSMSG_STRING_MAP & rBox = m_LatestMailMap[l->first];
+            MOOSMSG_STRING_MAP::iterator m;
+            for(m = l->second.begin();m!=l->second.end();++m)
+                rBox[m->first] = m->second;
+        }
+
+        m_ClientsWithMail.insert(pMail->m_ClientsWithMail.begin(),
+                                 pMail->m_ClientsWithMail.end());
+
+        delete pMail;
+    }
+}
+
+/** hand over all the shared notifications waiting for sWho so they can be
+pushed to it. Unlike replies these fetches are counted in DB_MAIL_FETCHES */
+bool CMOOSDB::OnFetchAllSharedMail(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx)
+{
+    m_nMailFetches++;
+    m_ClientsWithMail.erase(sWho);
+
+    unsigned int nBefore = MsgListTx.size();
+
+    FetchSharedMail(sWho,MsgListTx);
+
+    //asked for mail there was none of?
+    if(MsgListTx.size()==nBefore)
+        m_nWastedMailFetches++;
+
+    return true;
+}
+
 /** This functions decides what needs to be done on a message by message basis */
 bool CMOOSDB::ProcessMsg(CMOOSMsg &MsgRx,MOOSMSG_LIST & MsgListTx)
 {
@@ -702,9 +1127,104 @@ bool CMOOSDB::ProcessMsg(CMOOSMsg &MsgRx,MOOSMSG_LIST & MsgListTx)
 }
 
 
+/** count a write to rVar and update its write frequency */
+void CMOOSDB::UpdateWriteStatistics(CMOOSDBVar & rVar,double dfTimeNow)
+{
+    rVar.m_nWrittenTo++;
+
+    double dfDT = (dfTimeNow-rVar.m_Stats.m_dfLastStatsTime);
+    int nWrites  = rVar.m_nWrittenTo-rVar.m_Stats.m_nLastStatsWrites;
+    if(dfDT>0.5)
+    {
+        //this looks a little hookey - the numbers are arbitrary to give sensible
+        //looking frequencies when timing is coarse
+        if(dfDT>10.0)
+        {
+            //MIN
+            rVar.m_dfWriteFreq = 0.0;
+        }
+        else
+        {
+            //IIR FILTER COOEFFICENT
+            double dfAlpha = 0.5;
+            double df = dfDT/nWrites;
+
+            rVar.m_dfWriteFreq = dfAlpha*rVar.m_dfWriteFreq + (1.0-dfAlpha)/(df);
+        }
+        rVar.m_Stats.m_nLastStatsWrites = rVar.m_nWrittenTo;
+        rVar.m_Stats.m_dfLastStatsTime = dfTimeNow;
+    }
+}
+
+/** apply a notification straight from the received packet. This only
+handles the common case of a write to an existing variable of the same
+type which nobody subscribes to - then the only owned copies made are the
+ones in the variable itself (and assign() reuses their storage). Returns
+false if the notification needs the full OnNotify treatment */
+bool CMOOSDB::OnNotifyInPlace(const MOOS::MsgView & View)
+{
+    std::string sKey(View.GetKey().data(),View.GetKey().size());
+
+    DBVAR_MAP::iterator q = m_VarMap.find(sKey);
+    if(q==m_VarMap.end())
+        return false;
+
+    CMOOSDBVar & rVar = q->second;
+    if(rVar.m_nWrittenTo==0 ||
+            rVar.m_cDataType!=View.GetDataType() ||
+            !rVar.m_Subscribers.empty())
+    {
+        return false;
+    }
+
+    double dfTimeNow = HPMOOSTime();
+
+    rVar.m_dfWrittenTime = dfTimeNow;
+    rVar.m_dfTime = View.GetTime();
+    View.GetSource().AssignTo(rVar.m_sWhoChangedMe);
+    View.GetSourceAux().AssignTo(rVar.m_sSrcAux);
+
+    if(View.GetCommunity().empty())
+        rVar.m_sOriginatingCommunity = m_sCommunityName;
+    else
+        View.GetCommunity().AssignTo(rVar.m_sOriginatingCommunity);
+
+    switch(rVar.m_cDataType)
+    {
+    case MOOS_DOUBLE:
+        rVar.m_dfVal = View.GetDouble();
+        break;
+    case MOOS_STRING:
+    case MOOS_BINARY_STRING:
+        View.GetString().AssignTo(rVar.m_sVal);
+        break;
+    }
+
+    //record the writer - usually already known so nothing is allocated
+    rVar.m_Writers.insert(rVar.m_sWhoChangedMe);
+
+    UpdateWriteStatistics(rVar,dfTimeNow);
+
+    return true;
+}
+
 /** called when the in focus client is telling us something
 has changed. Ie this is a notify packet */
 bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
+{
+    //anything the workers are doing comes first
+    WaitForShards();
+
+    return OnNotify(Msg,m_HeldMailMap,m_SharedMailMap,m_LatestMailMap,m_ClientsWithMail);
+}
+
+/** as above but mail for subscribers is put in the boxes given and their
+names in ClientsWithMail (when the DB is sharded each notification has its own) */
+bool CMOOSDB::OnNotify(CMOOSMsg &Msg,
+                       MOOSMSG_LIST_STRING_MAP & HeldMail,
+                       MOOS::SHARED_MSG_LIST_STRING_MAP & SharedMail,
+                       LATEST_MAIL_MAP & LatestMail,
+                       STRING_SET & ClientsWithMail)
 {
     double dfTimeNow = HPMOOSTime();
     
@@ -716,26 +1236,22 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
 
 
         //look to see if any existing wildcards make us want to subscribe
-		//to this new message
-		HASH_MAP_TYPE<std::string, std::set<MOOS::MsgFilter> >::const_iterator g;
-		for (g = m_ClientFilters.begin(); g != m_ClientFilters.end(); ++g)
+		//to this new message. The index only tests filters whose literal
+		//prefix agrees with the variable name
+		MOOS::WildcardIndex::MATCHES Matches;
+		m_WildcardIndex.Match(Msg.GetKey(),Msg.GetSource(),Matches);
+
+		MOOS::WildcardIndex::MATCHES::const_iterator h;
+		for (h = Matches.begin(); h != Matches.end(); ++h)
 		{
-			//for every client
-			std::set<MOOS::MsgFilter>::const_iterator h;
-			for (h = g->second.begin(); h != g->second.end(); ++h)
+			//add the filter owner as a subscriber
+			const MOOS::WildcardIndex::Entry & rEntry = **h;
+			rVar.AddSubscriber(rEntry.client_, rEntry.filter_.period(), rEntry.latest_only_);
+			if(!m_bQuiet)
 			{
-				//for every filter
-				if (h->Matches(Msg))
-				{
-					//add the filter owner (client *g) as a subscriber
-					rVar.AddSubscriber(g->first, h->period());
-					if(!m_bQuiet)
-					{
-                        std::cout<<"+ subs of \""<<g->first<<"\" to \""
-                                <<Msg.GetKey()<<"\" via wildcard \""<<h->as_string()
-                                <<"\""<<std::endl;
-					}
-				}
+                std::cout<<"+ subs of \""<<rEntry.client_<<"\" to \""
+                        <<Msg.GetKey()<<"\" via wildcard \""<<rEntry.filter_.as_string()
+                        <<"\""<<std::endl;
 			}
 		}
 
@@ -779,38 +1295,18 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
         rVar.m_Writers.insert(Msg.m_sSrc);
         
         //increment the number of times we have written to this variable
-        rVar.m_nWrittenTo++;
-        
-        //how often is it being written?
-        double dfDT = (dfTimeNow-rVar.m_Stats.m_dfLastStatsTime);
-        int nWrites  = rVar.m_nWrittenTo-rVar.m_Stats.m_nLastStatsWrites;
-        if(dfDT>0.5)
-        {
-            //this looks a little hookey - the numbers are arbitrary to give sensible
-            //looking frequencies when timing is coarse
-            if(dfDT>10.0)
-            {
-                //MIN
-                rVar.m_dfWriteFreq = 0.0;
-            }
-            else
-            {
-                //IIR FILTER COOEFFICENT
-                double dfAlpha = 0.5;
-                double df = dfDT/nWrites;
-
-                rVar.m_dfWriteFreq = dfAlpha*rVar.m_dfWriteFreq + (1.0-dfAlpha)/(df);
-            }
-            rVar.m_Stats.m_nLastStatsWrites = rVar.m_nWrittenTo;
-            rVar.m_Stats.m_dfLastStatsTime = dfTimeNow;
-        }
+        //and how often it is being written
+        UpdateWriteStatistics(rVar,dfTimeNow);
         
         //now comes the intersting part...
         //which clients have asked to be informed
         //of changes in this variable?
         REGISTER_INFO_MAP::iterator p;
         
-        
+        //in shared mode the message is copied (and serialised) once
+        //no matter how many clients want to see it
+        MOOS::SharedMsg Shared;
+
         for(p = rVar.m_Subscribers.begin();p!=rVar.m_Subscribers.end();++p)
         {
             
@@ -825,8 +1321,24 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
                 //the Msg we were passed has all the information we require already
                 Msg.m_cMsgType = MOOS_NOTIFY;
                 
-                
-                AddMessageToClientBox(sClient,Msg);
+                if(rInfo.m_bLatestOnly)
+                {
+                    //this client only wants the most recent value so any
+                    //unsent notification of this variable is replaced
+                    LatestMail[sClient][Msg.m_sKey] = Msg;
+                }
+                else if(m_bShareNotifications)
+                {
+                    if(Shared.IsNull())
+                        Shared = MOOS::SharedMsg(Msg);
+
+                    SharedMail[sClient].push_back(Shared);
+                }
+                else
+                {
+                    HeldMail[sClient].push_back(Msg);
+                }
+                ClientsWithMail.insert(sClient);
                 
 
                 //finally we remember when we sent this to the client in question
@@ -855,6 +1367,9 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
 in they shall be informed of the change by stuffing this msg into a return packet */
 bool    CMOOSDB::AddMessageToClientBox(const string &sClient,CMOOSMsg & Msg)
 {
+    if(m_bShareNotifications)
+        return AddMessageToClientBox(sClient,MOOS::SharedMsg(Msg));
+
     MOOSMSG_LIST_STRING_MAP::iterator q = m_HeldMailMap.find(sClient);
     
     if(q==m_HeldMailMap.end())
@@ -872,10 +1387,23 @@ bool    CMOOSDB::AddMessageToClientBox(const string &sClient,CMOOSMsg & Msg)
     //q->second is now a reference to a list of messages that will be
     //sent to sClient the next time it calls into the database...   
     q->second.push_back(Msg);
+
+    m_ClientsWithMail.insert(sClient);
     
     return true;
 }
 
+/** as above but the client box only receives a handle to a message which may
+also be sitting in many other boxes */
+bool    CMOOSDB::AddMessageToClientBox(const string &sClient,const MOOS::SharedMsg & Msg)
+{
+    m_SharedMailMap[sClient].push_back(Msg);
+
+    m_ClientsWithMail.insert(sClient);
+
+    return true;
+}
+
 
 /** Called when a msg containing a unregistration (desubscribe) 
 request is received */
@@ -896,25 +1424,24 @@ bool CMOOSDB::OnUnRegister(CMOOSMsg &Msg)
 		//here we parse out the filter
 		std::string app_pattern = "";
 		std::string var_pattern = "";
-		double period = 0.0;
-
 
 		MOOSValFromString(app_pattern,Msg.GetString(),"AppPattern");
 		MOOSValFromString(var_pattern,Msg.GetString(),"VarPattern");
-		MOOS::MsgFilter F(app_pattern,var_pattern,period);
+
+		//only variables starting with the literal part of the pattern
+		//can match so there is no need to look at any others
+		std::string sPrefix = MOOS::WildcardIndex::LiteralPrefix(var_pattern);
 
 		DBVAR_MAP::iterator q;
-		for(q = m_VarMap.begin();q!=m_VarMap.end();++q)
+		for(q = m_VarMap.lower_bound(sPrefix);q!=m_VarMap.end();++q)
 		{
-			CMOOSMsg M;
-			Var2Msg(q->second,M);
-			if(F.Matches(M))
+			if(q->first.compare(0,sPrefix.size(),sPrefix)!=0)
+				break;
+
+			if(MOOSWildCmp(var_pattern,q->first) &&
+					MOOSWildCmp(app_pattern,q->second.m_sWhoChangedMe))
 			{
-				M.m_cMsgType = MOOS_UNREGISTER;
-				M.m_cDataType = MOOS_STRING;
-				M.m_sSrc = Msg.GetSource();
-				M.m_sKey = q->first;
-				OnUnRegister(M);//smart...
+				q->second.RemoveSubscriber(Msg.m_sSrc);
 			}
 		}
 	}
@@ -943,7 +1470,12 @@ bool CMOOSDB::OnRegister(CMOOSMsg &Msg)
 //		if(rVar.HasSubscriber(Msg.m_sSrc))
 //			return true;
 
-		if(!rVar.AddSubscriber(Msg.m_sSrc,Msg.m_dfVal))
+		//does the client only want the most recent value of this variable
+		//to be waiting for it?
+		bool bLatestOnly = false;
+		MOOSValFromString(bLatestOnly,Msg.GetString(),"LatestOnly");
+
+		if(!rVar.AddSubscriber(Msg.m_sSrc,Msg.m_dfVal,bLatestOnly))
 			return false;
 
         double dfActualPeriod;
@@ -983,27 +1515,41 @@ bool CMOOSDB::OnRegister(CMOOSMsg &Msg)
 		MOOSValFromString(period,Msg.GetString(),"Interval");
 		MOOS::MsgFilter F(app_pattern,var_pattern,period);
 
+		bool bLatestOnly = false;
+		MOOSValFromString(bLatestOnly,Msg.GetString(),"LatestOnly");
+
 		//store this filter we will need it later when new
 		//as yet undiscovered variables are written
-		m_ClientFilters[Msg.GetSource()].insert(F);
+		//a set won't overwrite an equal element so a re-registration
+		//has to replace the old filter to take the new period
+		std::set<MOOS::MsgFilter> & rFilters = m_ClientFilters[Msg.GetSource()];
+		rFilters.erase(F);
+		rFilters.insert(F);
+		m_WildcardIndex.Add(Msg.GetSource(),F,bLatestOnly);
 
 
         m_EventLogger.AddEvent("wildcard",Msg.m_sSrc,Msg.GetString());
 
 
 		//now iterate over all existing variables and see if they match
-		//if the do simply register for them...
+		//if the do simply register for them. m_VarMap is sorted so only
+		//the run of names starting with the pattern's literal prefix
+		//need be looked at
+		std::string sPrefix = MOOS::WildcardIndex::LiteralPrefix(var_pattern);
+
 		DBVAR_MAP::iterator q;
-		for(q = m_VarMap.begin();q!=m_VarMap.end();++q)
+		for(q = m_VarMap.lower_bound(sPrefix);q!=m_VarMap.end();++q)
 		{
-			CMOOSMsg M;
-			Var2Msg(q->second,M);
-			if(F.Matches(M))
+			if(q->first.compare(0,sPrefix.size(),sPrefix)!=0)
+				break;
+
+			if(MOOSWildCmp(var_pattern,q->first) &&
+					MOOSWildCmp(app_pattern,q->second.m_sWhoChangedMe))
 			{
-				M.m_cMsgType = MOOS_REGISTER;
-				M.m_cDataType = MOOS_DOUBLE;
-				M.m_dfVal = period;
+				CMOOSMsg M(MOOS_REGISTER,q->first,period);
 				M.m_sSrc = Msg.GetSource();
+				if(bLatestOnly)
+					M.m_sVal = "LatestOnly=true";
 
 				if(!m_bQuiet)
 				{
@@ -1109,6 +1655,8 @@ bool CMOOSDB::OnConnect(string &sClient)
 
 bool CMOOSDB::OnDisconnect(string &sClient)
 {
+    WaitForShards();
+
     //for all variables remove subscriptions to sClient
     if(!m_bQuiet)
     {
@@ -1127,8 +1675,12 @@ bool CMOOSDB::OnDisconnect(string &sClient)
     {
     	m_ClientFilters[sClient].clear();
     }
+    m_WildcardIndex.RemoveClient(sClient);
     
     m_HeldMailMap.erase(sClient);
+    m_SharedMailMap.erase(sClient);
+    m_LatestMailMap.erase(sClient);
+    m_ClientsWithMail.erase(sClient);
     
     if(!m_bQuiet)
         std::cout<<MOOS::ConsoleColours::Green()<<"[OK]\n"<<MOOS::ConsoleColours::reset();
@@ -1404,6 +1956,9 @@ bool CMOOSDB::OnClearRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList)
         MOOSMSG_LIST & rList = q->second;
         rList.clear();
     }
+    m_SharedMailMap.clear();
+    m_LatestMailMap.clear();
+    m_ClientsWithMail.clear();
     MOOSTrace("done\n");
     
     //MOOSTrace("    resetting DB start Time...done\n");
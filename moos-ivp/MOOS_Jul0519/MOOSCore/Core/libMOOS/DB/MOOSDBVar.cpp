@@ -84,7 +84,7 @@ bool CMOOSDBVar::GetUpdatePeriod(const string & sClient, double & dfPeriod){
     return true;
 }
 
-bool CMOOSDBVar::AddSubscriber(const string &sClient, double dfPeriod)
+bool CMOOSDBVar::AddSubscriber(const string &sClient, double dfPeriod, bool bLatestOnly)
 {
 
     if(sClient.empty())
@@ -96,6 +96,7 @@ bool CMOOSDBVar::AddSubscriber(const string &sClient, double dfPeriod)
     CMOOSRegisterInfo Info;
     Info.m_sClientName = sClient;
     Info.m_dfPeriod = dfPeriod;
+    Info.m_bLatestOnly = bLatestOnly;
     m_Subscribers[sClient] = Info;
 
     return true;
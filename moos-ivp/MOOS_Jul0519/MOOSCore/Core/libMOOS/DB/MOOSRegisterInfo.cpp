@@ -34,6 +34,7 @@ CMOOSRegisterInfo::CMOOSRegisterInfo()
 {
     m_dfLastTimeSent = 0;
     m_dfPeriod = 0.5;
+    m_bLatestOnly = false;
 }
 
 CMOOSRegisterInfo::~CMOOSRegisterInfo()
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Public License
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/gpl.txt
+//   distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * WildcardIndex.cpp
+ */
+
+#include "MOOS/libMOOS/DB/WildcardIndex.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+namespace MOOS
+{
+
+WildcardIndex::WildcardIndex()
+{
+    Clear();
+}
+
+void WildcardIndex::Clear()
+{
+    //node 0 is the root - filters with no literal prefix live there
+    nodes_.clear();
+    nodes_.push_back(Node());
+    size_ = 0;
+}
+
+unsigned int WildcardIndex::Size() const
+{
+    return size_;
+}
+
+std::string WildcardIndex::LiteralPrefix(const std::string & sPattern)
+{
+    std::string::size_type n = sPattern.find_first_of("*?");
+    return n==std::string::npos ? sPattern : sPattern.substr(0,n);
+}
+
+bool WildcardIndex::Add(const std::string & sClient, const MsgFilter & F, bool bLatestOnly)
+{
+    std::string sPrefix = LiteralPrefix(F.var_filter());
+
+    unsigned int nNode = 0;
+    for(std::string::const_iterator q = sPrefix.begin();q!=sPrefix.end();++q)
+    {
+        std::map<char,unsigned int>::iterator w = nodes_[nNode].next_.find(*q);
+        if(w==nodes_[nNode].next_.end())
+        {
+            //careful - push_back may move the node we are looking at
+            unsigned int nChild = nodes_.size();
+            nodes_.push_back(Node());
+            nodes_[nNode].next_[*q] = nChild;
+            nNode = nChild;
+        }
+        else
+        {
+            nNode = w->second;
+        }
+    }
+
+    std::vector<Entry> & rEntries = nodes_[nNode].entries_;
+    std::vector<Entry>::iterator e;
+    for(e = rEntries.begin();e!=rEntries.end();++e)
+    {
+        //same semantics as a std::set<MsgFilter> per client except that
+        //registering the same patterns again takes the new period and
+        //latest only flag. The entry stays where it is so the order in
+        //which Match finds filters does not change
+        if(e->client_==sClient && !(e->filter_<F) && !(F<e->filter_))
+        {
+            e->filter_ = F;
+            e->latest_only_ = bLatestOnly;
+            return false;
+        }
+    }
+
+    Entry NewEntry;
+    NewEntry.client_ = sClient;
+    NewEntry.filter_ = F;
+    NewEntry.latest_only_ = bLatestOnly;
+    rEntries.push_back(NewEntry);
+    size_++;
+
+    return true;
+}
+
+void WildcardIndex::RemoveClient(const std::string & sClient)
+{
+    std::vector<Node>::iterator n;
+    for(n = nodes_.begin();n!=nodes_.end();++n)
+    {
+        std::vector<Entry> & rEntries = n->entries_;
+        std::vector<Entry>::iterator e = rEntries.begin();
+        while(e!=rEntries.end())
+        {
+            if(e->client_==sClient)
+            {
+                e = rEntries.erase(e);
+                size_--;
+            }
+            else
+            {
+                ++e;
+            }
+        }
+    }
+}
+
+void WildcardIndex::TestNode(const Node & N,
+                             const std::string & sVar,
+                             const std::string & sApp,
+                             MATCHES & Matches) const
+{
+    std::vector<Entry>::const_iterator e;
+    for(e = N.entries_.begin();e!=N.entries_.end();++e)
+    {
+        if(MOOSWildCmp(e->filter_.var_filter(),sVar) &&
+                MOOSWildCmp(e->filter_.app_filter(),sApp))
+        {
+            Matches.push_back(&(*e));
+        }
+    }
+}
+
+bool WildcardIndex::Match(const std::string & sVar,
+                          const std::string & sApp,
+                          MATCHES & Matches) const
+{
+    Matches.clear();
+
+    //every node on the path spelled out by sVar holds filters whose
+    //literal prefix is a prefix of sVar - nothing else can match
+    unsigned int nNode = 0;
+    TestNode(nodes_[nNode],sVar,sApp,Matches);
+
+    for(std::string::const_iterator q = sVar.begin();q!=sVar.end();++q)
+    {
+        std::map<char,unsigned int>::const_iterator w = nodes_[nNode].next_.find(*q);
+        if(w==nodes_[nNode].next_.end())
+            break;
+
+        nNode = w->second;
+        TestNode(nodes_[nNode],sVar,sApp,Matches);
+    }
+
+    return !Matches.empty();
+}
+
+}
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Public License
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/gpl.txt
+//   distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * DBShardPool.h
+ *
+ *  A pool of worker threads, one per shard of the DB's variables. A
+ *  variable always lives in the same shard (chosen by a hash of its
+ *  name) so handing each shard's notifications to its own worker, in the
+ *  order they arrived, keeps the per-variable ordering of the single
+ *  threaded DB while different variables are processed in parallel.
+ *
+ *  Notifications are handed over without waiting for them to be processed.
+ *  Each is numbered as it arrives and what the workers make of them is
+ *  collected in that order, so mail from different shards reaches a client
+ *  in the order the DB received it, just as it would with one thread.
+ */
+
+#ifndef DBSHARDPOOL_H_
+#define DBSHARDPOOL_H_
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace MOOS
+{
+
+class DBShardPool
+{
+public:
+    /** what a worker made of one notification. The owner derives its own
+     * type from this (mail for clients, say) and gets it back from
+     * Collect() */
+    class Result
+    {
+    public:
+        virtual ~Result(){}
+    };
+
+    /** signature of the work done on each notification. Return a new Result
+     * (which Collect() hands back) or NULL if there is nothing to collect */
+    typedef Result* (*ShardWorkFn)(unsigned int nShard, CMOOSMsg & Msg, void * pParam);
+
+    /** signature of the function a worker calls when it has finished a batch
+     * and there may be results to collect */
+    typedef void (*ResultsReadyFn)(void * pParam);
+
+    DBShardPool();
+    virtual ~DBShardPool();
+
+    /** launch nShards workers each of which will call pfn on its notifications
+     * and pfnReady (if not NULL) each time it finishes a batch of them */
+    bool Start(unsigned int nShards, ShardWorkFn pfn, void * pParam, ResultsReadyFn pfnReady = NULL);
+
+    /** stop all workers (results not collected are discarded) */
+    bool Stop();
+
+    /** true if workers are running */
+    bool IsRunning() const;
+
+    /** number of shards (and workers) */
+    unsigned int GetNumShards() const;
+
+    /** which shard does the variable sKey belong to? */
+    unsigned int ShardOf(const std::string & sKey) const;
+
+    /** hand a run of notifications, in the order they arrived, to the
+     * workers and return without waiting for them. Run is emptied */
+    bool Dispatch(MOOSMSG_LIST & Run);
+
+    /** block until every notification dispatched so far has been processed */
+    bool Drain();
+
+    /** true if nothing dispatched is still being processed */
+    bool IsIdle();
+
+    /** append to Results, in arrival order, the results of every notification
+     * which has been processed along with all those that arrived before it.
+     * The caller owns (and must delete) what it is given */
+    bool Collect(std::list<Result*> & Results);
+
+private:
+    DBShardPool(const DBShardPool &);
+    DBShardPool & operator=(const DBShardPool &);
+
+    class Impl;
+    Impl* impl_;
+};
+
+}
+
+#endif /* DBSHARDPOOL_H_ */
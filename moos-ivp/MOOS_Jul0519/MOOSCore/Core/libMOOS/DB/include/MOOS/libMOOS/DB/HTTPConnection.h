@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// HTTPConnection.h: interface for the CHTTPConnection class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(HTTPCONNECTIONH)
+#define HTTPCONNECTIONH
+
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+#include <algorithm>
+#include <list>
+#include <sstream>
+#include <string>
+
+class XPCTcpSocket;
+class CMOOSCommClient;
+
+/** serves a single web page request about the contents of the MOOSDB on
+a thread of its own */
+class CHTTPConnection
+{
+public:
+    CHTTPConnection(XPCTcpSocket * pSocket,
+                    CMOOSCommClient * pMOOSComms,
+                    CMOOSLock * pMOOSCommsLock);
+
+    /** start serving */
+    bool Run();
+
+    /** has the page been served? */
+    bool HasCompleted();
+
+protected:
+    /** the headers of the request being served */
+    class CHTTPRequest
+    {
+    public:
+        void Clean(){m_Headers.clear();}
+        void AddHeader(const std::string & sLine){m_Headers.push_back(sLine);}
+        std::list<std::string> m_Headers;
+    };
+
+    static bool _CB(void * pParam)
+    {
+        CHTTPConnection * pMe = (CHTTPConnection*)pParam;
+        return pMe->Serve();
+    }
+
+    bool Serve();
+    bool ReadRequest();
+    bool ReadLine(std::string & sLine);
+    void SendLine(std::string sLine);
+    void SendString(std::string sLine);
+    bool SendWebPage();
+    bool SendHeader();
+    bool SendFailureHeader();
+    bool MakeWebPage();
+    bool HandlePoke(std::string sPokeURL);
+    bool BuildSingleVariableWebPageContents(std::ostringstream & wp,MOOSMSG_LIST & MsgList);
+    bool BuildFullDBWebPageContents(std::ostringstream & wp,MOOSMSG_LIST & MsgList);
+
+    XPCTcpSocket * m_pSocket;
+    CMOOSCommClient * m_pMOOSComms;
+    CMOOSLock * m_pMOOSCommsLock;
+    CMOOSThread m_ServeThread;
+    CHTTPRequest m_Request;
+    std::string m_sFocusVariable;
+    std::string m_sWebPage;
+};
+
+#endif // !defined(HTTPCONNECTIONH)
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSDB.h: interface for the CMOOSDB class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MOOSDBH)
+#define MOOSDBH
+
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedPtr.h"
+#include "MOOS/libMOOS/Utils/ProcessConfigReader.h"
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Comms/MOOSCommServer.h"
+#include "MOOS/libMOOS/Comms/ThreadedCommServer.h"
+#include "MOOS/libMOOS/Comms/SuicidalSleeper.h"
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
+#include "MOOS/libMOOS/DB/MOOSDBVar.h"
+#include "MOOS/libMOOS/DB/MsgFilter.h"
+#include "MOOS/libMOOS/DB/MOOSDBHTTPServer.h"
+#include "MOOS/libMOOS/DB/MOOSDBLogger.h"
+#include "MOOS/libMOOS/DB/DBShardPool.h"
+#include "MOOS/libMOOS/DB/WildcardIndex.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#define DEFAULT_MOOS_SERVER_PORT 9000
+
+typedef std::map<std::string,CMOOSDBVar> DBVAR_MAP;
+
+namespace MOOS
+{
+    class MsgView;
+    typedef std::vector<MsgView> MSG_VIEW_VECTOR;
+}
+
+/** latest value only mail for a client - one message per variable */
+typedef std::map<std::string,CMOOSMsg> MOOSMSG_STRING_MAP;
+typedef std::map<std::string,MOOSMSG_STRING_MAP> LATEST_MAIL_MAP;
+
+/** This class is the MOOS database. It holds the current value of every
+variable, who writes and subscribes to them and the mail waiting for each
+client. A CMOOSCommServer does the talking to clients */
+class CMOOSDB
+{
+public:
+    CMOOSDB();
+    virtual ~CMOOSDB();
+
+    /** run the DB - configured from the command line and mission file */
+    virtual bool Run(int argc, char * argv[]);
+
+    /** is the DB running? */
+    bool IsRunning();
+
+    /** stop the DB printing */
+    bool SetQuiet(bool bQuiet);
+
+    /** the port the DB listens on */
+    int GetDBPort(){return m_nPort;}
+
+    /** the name of the community the DB hosts */
+    std::string GetCommunityName(){return m_sCommunityName;}
+
+    /** callbacks invoked by the comm server - pParam is the DB */
+    static bool OnRxPktCallBack(const std::string & sWho,MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx, void * pParam);
+    static bool OnRxPktViewsCallBack(const std::string & sWho,MOOS::MSG_VIEW_VECTOR & ViewsRx,MOOSMSG_LIST & MsgListTx, void * pParam);
+    static bool OnFetchAllMailCallBack(const std::string & sWho,MOOSMSG_LIST & MsgListTx, void * pParam);
+    static bool OnFetchAllSharedMailCallBack(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx, void * pParam);
+    static bool OnFetchReplySharedMailCallBack(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx, void * pParam);
+    static bool OnFetchClientsWithMailCallBack(std::set<std::string> & Clients, void * pParam);
+    static bool OnDisconnectCallBack(std::string & sClient, void * pParam);
+    static bool OnConnectCallBack(std::string & sClient, void * pParam);
+
+    /** callbacks invoked by the shard workers - pParam is the DB */
+    static MOOS::DBShardPool::Result * OnShardWorkCallBack(unsigned int nShard,CMOOSMsg & Msg, void * pParam);
+    static void OnShardResultsReadyCallBack(void * pParam);
+
+protected:
+    bool OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx);
+    bool OnRxPktViews(const std::string & sClient,MOOS::MSG_VIEW_VECTOR & ViewsRx,MOOSMSG_LIST & MsgListTx);
+    bool OnRxPktDone(const std::string & sClient,bool bRxd,MOOSMSG_LIST & MsgListTx);
+    bool OnFetchAllMail(const std::string & sWho,MOOSMSG_LIST & MsgListTx);
+    bool OnFetchAllSharedMail(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx);
+    bool FetchSharedMail(const std::string & sWho,MOOS::SHARED_MSG_LIST & MsgListTx);
+    bool FetchLatestMail(const std::string & sWho,MOOSMSG_LIST & MsgListTx);
+    bool OnFetchClientsWithMail(std::set<std::string> & Clients);
+    bool OnDisconnect(std::string & sClient);
+    bool OnConnect(std::string & sClient);
+
+    bool ProcessMsgsInShards(MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx);
+    void WaitForShards();
+    MOOS::DBShardPool::Result * OnShardWork(unsigned int nShard,CMOOSMsg & Msg);
+    void OnShardResultsReady();
+    void CollectShardMail();
+
+    bool ProcessMsg(CMOOSMsg & MsgRx,MOOSMSG_LIST & MsgListTx);
+    bool OnNotify(CMOOSMsg & Msg);
+    bool OnNotify(CMOOSMsg & Msg,
+                  MOOSMSG_LIST_STRING_MAP & HeldMail,
+                  MOOS::SHARED_MSG_LIST_STRING_MAP & SharedMail,
+                  LATEST_MAIL_MAP & LatestMail,
+                  STRING_SET & ClientsWithMail);
+    bool OnNotifyInPlace(const MOOS::MsgView & View);
+    bool OnRegister(CMOOSMsg & Msg);
+    bool OnUnRegister(CMOOSMsg & Msg);
+    bool DoServerRequest(CMOOSMsg & Msg, MOOSMSG_LIST & MsgTxList);
+
+    bool OnServerAllRequested(CMOOSMsg & Msg, MOOSMSG_LIST & MsgTxList);
+    bool OnProcessSummaryRequested(CMOOSMsg & Msg, MOOSMSG_LIST & MsgTxList);
+    bool OnVarSummaryRequested(CMOOSMsg & Msg, MOOSMSG_LIST & MsgTxList);
+    bool OnClearRequested(CMOOSMsg & Msg, MOOSMSG_LIST & MsgTxList);
+
+    bool AddMessageToClientBox(const std::string & sClient,CMOOSMsg & Msg);
+    bool AddMessageToClientBox(const std::string & sClient,const MOOS::SharedMsg & Msg);
+
+    CMOOSDBVar & GetOrMakeVar(CMOOSMsg & Msg);
+    bool VariableExists(const std::string & sVar);
+    void Var2Msg(CMOOSDBVar & Var, CMOOSMsg & Msg);
+    void UpdateWriteStatistics(CMOOSDBVar & rVar,double dfTimeNow);
+
+    void UpdateDBTimeVars();
+    void UpdateDBClientsVar();
+    void UpdateSummaryVar();
+    void UpdateQoSVar();
+    void UpdateReadWriteSummaryVar();
+    void UpdateMailFetchVar();
+
+    void LogStartTime();
+    double GetStartTime(){return m_dfStartTime;}
+    void OnPrintVersionAndExit();
+
+    /** every variable in the DB */
+    DBVAR_MAP m_VarMap;
+
+    /** mail waiting for each client */
+    MOOSMSG_LIST_STRING_MAP m_HeldMailMap;
+
+    /** shared mail waiting for each client (when notifications are shared) */
+    MOOS::SHARED_MSG_LIST_STRING_MAP m_SharedMailMap;
+
+    /** latest value only mail waiting for each client */
+    LATEST_MAIL_MAP m_LatestMailMap;
+
+    /** clients sent mail since the comm server last asked */
+    STRING_SET m_ClientsWithMail;
+
+    /** wildcard subscriptions of each client */
+    std::map<std::string,std::set<MOOS::MsgFilter> > m_ClientFilters;
+
+    /** the same subscriptions indexed by the literal prefix of their patterns */
+    MOOS::WildcardIndex m_WildcardIndex;
+
+    /** workers which process notifications when there is more than one thread */
+    MOOS::DBShardPool m_ShardPool;
+    unsigned int m_nDBThreads;
+    CMOOSLock m_ShardSignalLock;
+    bool m_bShardMailSignalled;
+
+    /** how often clients were asked for mail (and how often there was none) */
+    unsigned int m_nMailFetches;
+    unsigned int m_nWastedMailFetches;
+
+    MOOS::ScopedPtr<CMOOSCommServer> m_pCommServer;
+    MOOS::ScopedPtr<CMOOSDBHTTPServer> m_pWebServer;
+    CProcessConfigReader m_MissionReader;
+    MOOS::SuicidalSleeper m_SuicidalSleeper;
+    MOOS::MOOSDBLogger m_EventLogger;
+
+    std::string m_sDBName;
+    std::string m_sCommunityName;
+    int m_nPort;
+    double m_dfStartTime;
+    double m_dfSummaryTime;
+    bool m_bQuiet;
+
+    /** do all subscribers share one copy of a notification? */
+    bool m_bShareNotifications;
+};
+
+#endif // !defined(MOOSDBH)
@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSDBHTTPServer.h: interface for the CMOOSDBHTTPServer class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MOOSDBHTTPSERVERH)
+#define MOOSDBHTTPSERVERH
+
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+
+#include <list>
+
+class XPCTcpSocket;
+class CMOOSCommClient;
+class CHTTPConnection;
+
+/** a tiny web server which shows (and lets you poke) the contents of a
+MOOSDB. It talks to the DB as an ordinary client */
+class CMOOSDBHTTPServer
+{
+public:
+    CMOOSDBHTTPServer(long lDBPort);
+    CMOOSDBHTTPServer(long lDBPort, long lWebServerPort);
+    virtual ~CMOOSDBHTTPServer(void);
+
+protected:
+    static bool _CB(void * pParam)
+    {
+        CMOOSDBHTTPServer * pMe = (CMOOSDBHTTPServer*)pParam;
+        return pMe->Listen();
+    }
+
+    void Initialise(long lDBPort, long lWebServerPort);
+    void DoBanner();
+    bool Listen();
+
+    long m_lWebServerPort;
+    XPCTcpSocket * m_pListenSocket;
+    CMOOSCommClient * m_pMOOSComms;
+    CMOOSLock * m_pMOOSCommsLock;
+    CMOOSThread m_ListenThread;
+    std::list<CHTTPConnection*> m_Connections;
+};
+
+#endif // !defined(MOOSDBHTTPSERVERH)
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MOOSDBLogger.h
+ *
+ *  Created on: Sep 19, 2014
+ *      Author: pnewman
+ */
+
+#ifndef MOOSDBLOGGER_H_
+#define MOOSDBLOGGER_H_
+
+#include <string>
+
+namespace MOOS
+{
+
+/** records DB events (connections, registrations...) to a file on a
+thread of its own */
+class MOOSDBLogger
+{
+public:
+    MOOSDBLogger();
+    virtual ~MOOSDBLogger();
+
+    /** start logging to a file */
+    bool Run(const std::string & sLogFileName);
+
+    /** record an event */
+    bool AddEvent(const std::string & sEvent,
+                  const std::string & sClient,
+                  const std::string & sDetails);
+
+    class Impl;
+
+private:
+    Impl * Impl_;
+};
+
+}
+
+#endif /* MOOSDBLOGGER_H_ */
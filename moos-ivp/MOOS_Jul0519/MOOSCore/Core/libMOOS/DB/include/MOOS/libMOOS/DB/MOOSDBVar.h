@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSDBVar.h: interface for the CMOOSDBVar class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MOOSDBVARH)
+#define MOOSDBVARH
+
+#include "MOOS/libMOOS/DB/MOOSRegisterInfo.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+using namespace std;
+
+typedef std::map<std::string,CMOOSRegisterInfo> REGISTER_INFO_MAP;
+typedef std::set<std::string> STRING_SET;
+
+/** a variable held by the MOOSDB - its current value, who writes it and
+who subscribes to it */
+class CMOOSDBVar
+{
+public:
+    CMOOSDBVar();
+    CMOOSDBVar(const std::string & sName);
+    virtual ~CMOOSDBVar();
+
+    /** forget the value and writers of the variable */
+    bool Reset();
+
+    /** add (or replace) a client's subscription */
+    bool AddSubscriber(const std::string & sClient, double dfPeriod, bool bLatestOnly = false);
+
+    /** remove a client's subscription */
+    void RemoveSubscriber(std::string & sWho);
+
+    /** does a client subscribe to this variable? */
+    bool HasSubscriber(const std::string & sClient);
+
+    /** the period of a client's subscription */
+    bool GetUpdatePeriod(const std::string & sClient, double & dfPeriod);
+
+    /** statistics used to estimate write frequency */
+    class CStats
+    {
+    public:
+        CStats() : m_dfLastStatsTime(-1), m_nLastStatsWrites(0) {}
+        double m_dfLastStatsTime;
+        int m_nLastStatsWrites;
+    };
+
+    char m_cDataType;
+    std::string m_sName;
+    double m_dfTime;
+    double m_dfVal;
+    double m_dfWriteFreq;
+    double m_dfWrittenTime;
+    std::string m_sVal;
+    std::string m_sWhoChangedMe;
+    std::string m_sSrcAux;
+    std::string m_sOriginatingCommunity;
+    CStats m_Stats;
+    int m_nWrittenTo;
+    REGISTER_INFO_MAP m_Subscribers;
+    STRING_SET m_Writers;
+};
+
+#endif // !defined(MOOSDBVARH)
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSRegisterInfo.h: interface for the CMOOSRegisterInfo class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MOOSREGISTERINFOH)
+#define MOOSREGISTERINFOH
+
+#include <string>
+
+/** a class to store information about a client's subscription to a
+variable held by the MOOSDB */
+class CMOOSRegisterInfo
+{
+public:
+    CMOOSRegisterInfo();
+    virtual ~CMOOSRegisterInfo();
+
+    /** time mail about the variable was last sent to the client */
+    double GetLastTimeSent();
+    void SetLastTimeSent(double dfTimeSent);
+
+    /** has enough time passed that the client may be sent more mail? */
+    bool Expired(double dfTimeNow);
+
+    /** the subscribing client */
+    std::string m_sClientName;
+
+    /** minimum period between mail sent to the client */
+    double m_dfPeriod;
+
+    /** does the client want only the latest value when it is sent mail? */
+    bool m_bLatestOnly;
+
+protected:
+    double m_dfLastTimeSent;
+};
+
+#endif // !defined(MOOSREGISTERINFOH)
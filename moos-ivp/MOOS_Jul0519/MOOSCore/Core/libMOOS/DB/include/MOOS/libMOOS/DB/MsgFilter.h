@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MsgFilter.h
+ *
+ *  Created on: Nov 10, 2012
+ *      Author: pnewman
+ */
+
+#ifndef MSGFILTER_H_
+#define MSGFILTER_H_
+
+#include <string>
+#include <utility>
+
+class CMOOSMsg;
+
+namespace MOOS
+{
+
+/** a filter on the source (app) and key (var) of messages. Either may
+contain wildcards */
+class MsgFilter
+{
+public:
+    MsgFilter();
+    MsgFilter(const std::string & app_filter, const std::string & var_filter, double period);
+
+    /** does a message pass the filter? */
+    bool Matches(const CMOOSMsg & M) const;
+
+    std::string app_filter() const;
+    std::string var_filter() const;
+    std::string as_string() const;
+    double period() const;
+
+    bool operator < (const MsgFilter & F) const;
+
+protected:
+    std::pair<std::string,std::string> filters_;
+    double period_;
+};
+
+}
+
+#endif /* MSGFILTER_H_ */
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Public License
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/gpl.txt
+//   distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * WildcardIndex.h
+ *
+ *  An index of the wildcard subscriptions (MsgFilters) held by the DB.
+ *  Filters are stored in a trie keyed on the literal prefix of their
+ *  variable pattern (everything before the first '*' or '?'). Finding
+ *  the filters which match a variable walks the trie along the
+ *  variable's name so only filters whose prefix agrees are ever tested
+ *  - the cost no longer grows with the number of unrelated filters.
+ */
+
+#ifndef WILDCARDINDEX_H_
+#define WILDCARDINDEX_H_
+
+#include "MOOS/libMOOS/DB/MsgFilter.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MOOS
+{
+
+class WildcardIndex
+{
+public:
+    /** a filter and the client who asked for it */
+    struct Entry
+    {
+        std::string client_;
+        MsgFilter filter_;
+        bool latest_only_;
+    };
+
+    typedef std::vector<const Entry*> MATCHES;
+
+    WildcardIndex();
+
+    /** add filter F for sClient. bLatestOnly is remembered for
+     * subscriptions the filter makes later. Returns false if sClient
+     * already has a filter with the same patterns - that filter then
+     * takes F's period and bLatestOnly but keeps its place */
+    bool Add(const std::string & sClient, const MsgFilter & F, bool bLatestOnly = false);
+
+    /** forget every filter belonging to sClient */
+    void RemoveClient(const std::string & sClient);
+
+    /** forget everything */
+    void Clear();
+
+    /** number of filters held */
+    unsigned int Size() const;
+
+    /** fill Matches with every filter matching variable sVar written by
+     * sApp. Pointers are valid until the index is next changed */
+    bool Match(const std::string & sVar,
+               const std::string & sApp,
+               MATCHES & Matches) const;
+
+    /** the literal part of a pattern before its first wildcard */
+    static std::string LiteralPrefix(const std::string & sPattern);
+
+private:
+    struct Node
+    {
+        std::map<char,unsigned int> next_;
+        std::vector<Entry> entries_;
+    };
+
+    void TestNode(const Node & N,
+                  const std::string & sVar,
+                  const std::string & sApp,
+                  MATCHES & Matches) const;
+
+    std::vector<Node> nodes_;
+    unsigned int size_;
+};
+
+}
+
+#endif /* WILDCARDINDEX_H_ */
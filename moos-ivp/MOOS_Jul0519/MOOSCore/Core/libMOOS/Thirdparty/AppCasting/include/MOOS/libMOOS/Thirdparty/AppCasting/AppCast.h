@@ -0,0 +1,72 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin, Henrik Schmidt, and John Leonard   */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: AppCast.h                                            */
+/*    DATE: June 3rd 2012                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*****************************************************************/
+
+#ifndef APPCAST_HEADER
+#define APPCAST_HEADER
+
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+
+class AppCast
+{
+public:
+  AppCast();
+  virtual ~AppCast() {}
+
+  void event(std::string str, double timestamp=-1);
+  void cfgWarning(const std::string& str);
+  void runWarning(const std::string& str);
+  bool retractRunWarning(const std::string& str);
+  void msg(const std::string& str)          {m_messages = str;}
+
+  void setProcName(const std::string& s)    {m_proc_name = s;}
+  void setNodeName(const std::string& s)    {m_node_name = s;}
+  void setIteration(unsigned int v)         {m_iteration = v;}
+  void setMaxEvents(unsigned int v)         {m_max_events = v;}
+  void setMaxRunWarnings(unsigned int v)    {m_max_run_warnings = v;}
+  void setRunWarningCount(unsigned int v)   {m_cnt_run_warnings = v;}
+  void setRunWarnings(const std::string& warning, unsigned int count);
+
+  std::string  getProcName() const         {return(m_proc_name);}
+  std::string  getNodeName() const         {return(m_node_name);}
+  unsigned int getIteration() const        {return(m_iteration);}
+  unsigned int getMaxEvents() const        {return(m_max_events);}
+  unsigned int getCfgWarningCount() const  {return(m_config_warnings.size());}
+  unsigned int getRunWarningCount() const  {return(m_cnt_run_warnings);}
+
+  std::string  getAppCastString() const;
+  std::string  getFormattedString(bool with_header=true) const;
+
+protected:
+  std::string  m_proc_name;
+  std::string  m_node_name;
+  unsigned int m_iteration;
+  std::string  m_messages;
+
+  std::list<std::string>   m_events;
+  unsigned int             m_max_events;
+
+  std::map<std::string, unsigned int> m_map_run_warnings;
+  unsigned int             m_max_run_warnings;
+  unsigned int             m_cnt_run_warnings;
+
+  std::vector<std::string> m_config_warnings;
+  unsigned int             m_max_config_warnings;
+};
+
+AppCast string2AppCast(const std::string&);
+
+#endif
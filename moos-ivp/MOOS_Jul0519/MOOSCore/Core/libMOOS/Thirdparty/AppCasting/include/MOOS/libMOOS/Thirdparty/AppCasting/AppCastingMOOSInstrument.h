@@ -0,0 +1,73 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin, Henrik Schmidt, and John Leonard   */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: AppCastingMOOSInstrument.h                           */
+/*    DATE: June 3rd 2012                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*****************************************************************/
+
+#ifndef APPCASTING_MOOS_INSTRUMENT_HEADER
+#define APPCASTING_MOOS_INSTRUMENT_HEADER
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <map>
+#include "MOOS/libMOOS/App/MOOSInstrument.h"
+#include "MOOS/libMOOS/Thirdparty/AppCasting/AppCast.h"
+
+class AppCastingMOOSInstrument : public CMOOSInstrument
+{
+public:
+  AppCastingMOOSInstrument();
+  virtual ~AppCastingMOOSInstrument() {}
+
+  virtual bool Iterate();
+  virtual bool OnNewMail(MOOSMSG_LIST&);
+  virtual bool OnStartUp();
+  virtual bool buildReport() {return(false);}
+
+protected:
+  void         RegisterVariables();
+  void         PostReport(const std::string& directive="");
+  void         reportEvent(const std::string&);
+  void         reportConfigWarning(const std::string&);
+  void         reportUnhandledConfigWarning(const std::string&);
+  bool         reportRunWarning(const std::string&);
+  void         retractRunWarning(const std::string&);
+  unsigned int getWarningCount(const std::string&) const;
+
+private:
+  bool OnStartUpDirectives(std::string directives="");
+  void handleMailAppCastRequest(const std::string&);
+  bool appcastRequested();
+
+protected:
+  AppCast            m_ac;
+  unsigned int       m_iteration;
+  double             m_curr_time;
+  double             m_start_time;
+  double             m_time_warp;
+  double             m_last_iterate_time;
+  double             m_last_report_time;
+  double             m_last_report_time_appcast;
+  double             m_iterate_start_time;
+  double             m_term_report_interval;
+  bool               m_term_reporting;
+  bool               m_new_run_warning;
+  bool               m_new_cfg_warning;
+  std::string        m_host_community;
+  std::stringstream  m_msgs;
+
+  std::map<std::string, double>      m_map_bcast_duration;
+  std::map<std::string, double>      m_map_bcast_tstart;
+  std::map<std::string, std::string> m_map_bcast_thresh;
+};
+
+#endif
@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_ATOMICCOUNTER_H
+#define MOOS_POCO_ATOMICCOUNTER_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Platform.h"
+#if MOOS_POCO_OS == MOOS_POCO_OS_WINDOWS_NT
+#include "MOOS/libMOOS/Thirdparty/PocoBits/UnWindows.h"
+#elif MOOS_POCO_OS == MOOS_POCO_OS_MAC_OS_X
+#include <libkern/OSAtomic.h>
+#else
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Mutex.h"
+#endif
+
+namespace MOOS {
+namespace Poco {
+
+/** a thread safe counter */
+class AtomicCounter
+{
+public:
+	typedef int ValueType;
+
+	AtomicCounter();
+	explicit AtomicCounter(ValueType initialValue);
+	AtomicCounter(const AtomicCounter& counter);
+	~AtomicCounter();
+	AtomicCounter& operator = (const AtomicCounter& counter);
+	AtomicCounter& operator = (ValueType value);
+	operator ValueType () const;
+	ValueType value() const;
+	ValueType operator ++ ();
+	ValueType operator ++ (int);
+	ValueType operator -- ();
+	ValueType operator -- (int);
+	bool operator ! () const;
+
+private:
+#if MOOS_POCO_OS == MOOS_POCO_OS_WINDOWS_NT
+	typedef volatile LONG ImplType;
+#elif MOOS_POCO_OS == MOOS_POCO_OS_MAC_OS_X
+	typedef int32_t ImplType;
+#else
+	struct ImplType
+	{
+		mutable FastMutex mutex;
+		volatile int      value;
+	};
+#endif
+	ImplType _counter;
+};
+
+#if MOOS_POCO_OS == MOOS_POCO_OS_WINDOWS_NT
+inline AtomicCounter::operator AtomicCounter::ValueType () const { return _counter; }
+inline AtomicCounter::ValueType AtomicCounter::value() const { return _counter; }
+inline AtomicCounter::ValueType AtomicCounter::operator ++ () { return InterlockedIncrement(&_counter); }
+inline AtomicCounter::ValueType AtomicCounter::operator ++ (int) { ValueType result = InterlockedIncrement(&_counter); return --result; }
+inline AtomicCounter::ValueType AtomicCounter::operator -- () { return InterlockedDecrement(&_counter); }
+inline AtomicCounter::ValueType AtomicCounter::operator -- (int) { ValueType result = InterlockedDecrement(&_counter); return ++result; }
+inline bool AtomicCounter::operator ! () const { return _counter == 0; }
+#elif MOOS_POCO_OS == MOOS_POCO_OS_MAC_OS_X
+inline AtomicCounter::operator AtomicCounter::ValueType () const { return _counter; }
+inline AtomicCounter::ValueType AtomicCounter::value() const { return _counter; }
+inline AtomicCounter::ValueType AtomicCounter::operator ++ () { return OSAtomicIncrement32(&_counter); }
+inline AtomicCounter::ValueType AtomicCounter::operator ++ (int) { ValueType result = OSAtomicIncrement32(&_counter); return --result; }
+inline AtomicCounter::ValueType AtomicCounter::operator -- () { return OSAtomicDecrement32(&_counter); }
+inline AtomicCounter::ValueType AtomicCounter::operator -- (int) { ValueType result = OSAtomicDecrement32(&_counter); return ++result; }
+inline bool AtomicCounter::operator ! () const { return _counter == 0; }
+#else
+inline AtomicCounter::operator AtomicCounter::ValueType () const
+{
+	ValueType result;
+	{
+		FastMutex::ScopedLock lock(_counter.mutex);
+		result = _counter.value;
+	}
+	return result;
+}
+inline AtomicCounter::ValueType AtomicCounter::value() const
+{
+	ValueType result;
+	{
+		FastMutex::ScopedLock lock(_counter.mutex);
+		result = _counter.value;
+	}
+	return result;
+}
+inline AtomicCounter::ValueType AtomicCounter::operator ++ ()
+{
+	ValueType result;
+	{
+		FastMutex::ScopedLock lock(_counter.mutex);
+		result = ++_counter.value;
+	}
+	return result;
+}
+inline AtomicCounter::ValueType AtomicCounter::operator ++ (int)
+{
+	ValueType result;
+	{
+		FastMutex::ScopedLock lock(_counter.mutex);
+		result = _counter.value++;
+	}
+	return result;
+}
+inline AtomicCounter::ValueType AtomicCounter::operator -- ()
+{
+	ValueType result;
+	{
+		FastMutex::ScopedLock lock(_counter.mutex);
+		result = --_counter.value;
+	}
+	return result;
+}
+inline AtomicCounter::ValueType AtomicCounter::operator -- (int)
+{
+	ValueType result;
+	{
+		FastMutex::ScopedLock lock(_counter.mutex);
+		result = _counter.value--;
+	}
+	return result;
+}
+inline bool AtomicCounter::operator ! () const
+{
+	bool result;
+	{
+		FastMutex::ScopedLock lock(_counter.mutex);
+		result = _counter.value == 0;
+	}
+	return result;
+}
+#endif
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_BUGCHECK_H
+#define MOOS_POCO_BUGCHECK_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Platform.h"
+#include <string>
+
+namespace MOOS {
+namespace Poco {
+
+class Bugcheck
+{
+public:
+	static void assertion(const char* cond, const char* file, int line);
+	static void nullPointer(const char* ptr, const char* file, int line);
+	static void bugcheck(const char* file, int line);
+	static void bugcheck(const char* msg, const char* file, int line);
+	static void debugger(const char* file, int line);
+	static void debugger(const char* msg, const char* file, int line);
+
+protected:
+	static std::string what(const char* msg, const char* file, int line);
+};
+
+} // namespace Poco
+} // namespace MOOS
+
+#if defined(_DEBUG)
+	#define moos_poco_assert(cond) \
+		if (!(cond)) MOOS::Poco::Bugcheck::assertion(#cond, __FILE__, __LINE__); else (void) 0
+#else
+	#define moos_poco_assert(cond)
+#endif
+
+#define moos_poco_check_ptr(ptr) \
+	if (!(ptr)) MOOS::Poco::Bugcheck::nullPointer(#ptr, __FILE__, __LINE__); else (void) 0
+
+#define moos_poco_bugcheck() \
+	MOOS::Poco::Bugcheck::bugcheck(__FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_EVENT_H
+#define MOOS_POCO_EVENT_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Platform.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Exception.h"
+
+#if defined(MOOS_POCO_OS_FAMILY_WINDOWS)
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Event_WIN32.h"
+#else
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Event_POSIX.h"
+#endif
+
+namespace MOOS {
+namespace Poco {
+
+/** a synchronisation object that lets one thread signal others */
+class Event: private EventImpl
+{
+public:
+	Event(bool autoReset = true);
+	~Event();
+
+	/** signals the event */
+	void set() { setImpl(); }
+
+	/** waits for the event to become signalled */
+	void wait() { waitImpl(); }
+
+	/** waits for at most milliseconds, throws TimeoutException on timeout */
+	void wait(long milliseconds)
+	{
+		if (!waitImpl(milliseconds))
+			throw TimeoutException();
+	}
+
+	/** waits for at most milliseconds, returns true if signalled */
+	bool tryWait(long milliseconds) { return waitImpl(milliseconds); }
+
+	/** resets the event to unsignalled state */
+	void reset() { resetImpl(); }
+
+private:
+	Event(const Event&);
+	Event& operator = (const Event&);
+};
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_EVENT_WIN32_H
+#define MOOS_POCO_EVENT_WIN32_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Exception.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/UnWindows.h"
+
+namespace MOOS {
+namespace Poco {
+
+class EventImpl
+{
+protected:
+	EventImpl(bool autoReset);
+	~EventImpl();
+	void setImpl()
+	{
+		if (!SetEvent(_event))
+			throw SystemException("cannot signal event");
+	}
+	void waitImpl();
+	bool waitImpl(long milliseconds);
+	void resetImpl()
+	{
+		if (!ResetEvent(_event))
+			throw SystemException("cannot reset event");
+	}
+
+private:
+	HANDLE _event;
+};
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
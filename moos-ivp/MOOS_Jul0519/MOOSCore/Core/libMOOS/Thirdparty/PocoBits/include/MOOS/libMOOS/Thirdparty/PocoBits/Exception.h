@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_EXCEPTION_H
+#define MOOS_POCO_EXCEPTION_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Platform.h"
+#include <stdexcept>
+#include <string>
+
+namespace MOOS {
+namespace Poco {
+
+class Exception: public std::exception
+{
+public:
+	Exception(const std::string& msg, int code = 0);
+	Exception(const std::string& msg, const std::string& arg, int code = 0);
+	Exception(const std::string& msg, const Exception& nested, int code = 0);
+	Exception(const Exception& exc);
+	~Exception() throw();
+	Exception& operator = (const Exception& exc);
+	virtual const char* name() const throw();
+	virtual const char* className() const throw();
+	virtual const char* what() const throw();
+	const Exception* nested() const { return _pNested; }
+	const std::string& message() const { return _msg; }
+	int code() const { return _code; }
+	std::string displayText() const;
+	virtual Exception* clone() const;
+	virtual void rethrow() const;
+
+protected:
+	Exception(int code = 0);
+	void message(const std::string& msg) { _msg = msg; }
+	void extendedMessage(const std::string& arg);
+
+private:
+	std::string _msg;
+	Exception*  _pNested;
+	int			_code;
+};
+
+#define MOOS_POCO_DECLARE_EXCEPTION(API, CLS, BASE) \
+	class CLS: public BASE \
+	{ \
+	public: \
+		CLS(int code = 0); \
+		CLS(const std::string& msg, int code = 0); \
+		CLS(const std::string& msg, const std::string& arg, int code = 0); \
+		CLS(const std::string& msg, const MOOS::Poco::Exception& exc, int code = 0); \
+		CLS(const CLS& exc); \
+		~CLS() throw(); \
+		CLS& operator = (const CLS& exc); \
+		const char* name() const throw(); \
+		const char* className() const throw(); \
+		MOOS::Poco::Exception* clone() const; \
+		void rethrow() const; \
+	};
+
+#define MOOS_POCO_IMPLEMENT_EXCEPTION(CLS, BASE, NAME) \
+	CLS::CLS(int code): BASE(code) {} \
+	CLS::CLS(const std::string& msg, int code): BASE(msg, code) {} \
+	CLS::CLS(const std::string& msg, const std::string& arg, int code): BASE(msg, arg, code) {} \
+	CLS::CLS(const std::string& msg, const MOOS::Poco::Exception& exc, int code): BASE(msg, exc, code) {} \
+	CLS::CLS(const CLS& exc): BASE(exc) {} \
+	CLS::~CLS() throw() {} \
+	CLS& CLS::operator = (const CLS& exc) { BASE::operator = (exc); return *this; } \
+	const char* CLS::name() const throw() { return NAME; } \
+	const char* CLS::className() const throw() { return typeid(*this).name(); } \
+	MOOS::Poco::Exception* CLS::clone() const { return new CLS(*this); } \
+	void CLS::rethrow() const { throw *this; }
+
+MOOS_POCO_DECLARE_EXCEPTION(, LogicException, Exception)
+MOOS_POCO_DECLARE_EXCEPTION(, AssertionViolationException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, NullPointerException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, BugcheckException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, InvalidArgumentException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, NotImplementedException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, RangeException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, IllegalStateException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, InvalidAccessException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, SignalException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, UnhandledException, LogicException)
+MOOS_POCO_DECLARE_EXCEPTION(, RuntimeException, Exception)
+MOOS_POCO_DECLARE_EXCEPTION(, NotFoundException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, ExistsException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, TimeoutException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, SystemException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, RegularExpressionException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, LibraryLoadException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, LibraryAlreadyLoadedException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, NoThreadAvailableException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, PropertyNotSupportedException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, PoolOverflowException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, NoPermissionException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, OutOfMemoryException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, DataException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, DataFormatException, DataException)
+MOOS_POCO_DECLARE_EXCEPTION(, SyntaxException, DataException)
+MOOS_POCO_DECLARE_EXCEPTION(, CircularReferenceException, DataException)
+MOOS_POCO_DECLARE_EXCEPTION(, PathSyntaxException, SyntaxException)
+MOOS_POCO_DECLARE_EXCEPTION(, IOException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, FileException, IOException)
+MOOS_POCO_DECLARE_EXCEPTION(, FileExistsException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, FileNotFoundException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, PathNotFoundException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, FileReadOnlyException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, FileAccessDeniedException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, CreateFileException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, OpenFileException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, WriteFileException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, ReadFileException, FileException)
+MOOS_POCO_DECLARE_EXCEPTION(, UnknownURISchemeException, RuntimeException)
+MOOS_POCO_DECLARE_EXCEPTION(, ApplicationException, Exception)
+MOOS_POCO_DECLARE_EXCEPTION(, BadCastException, RuntimeException)
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_MUTEX_H
+#define MOOS_POCO_MUTEX_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Platform.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Exception.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/ScopedLock.h"
+
+#if defined(MOOS_POCO_OS_FAMILY_WINDOWS)
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Mutex_WIN32.h"
+#else
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Mutex_POSIX.h"
+#endif
+
+namespace MOOS {
+namespace Poco {
+
+/** a recursive mutex */
+class Mutex: private MutexImpl
+{
+public:
+	typedef MOOS::Poco::ScopedLock<Mutex> ScopedLock;
+
+	Mutex();
+	~Mutex();
+	void lock() { lockImpl(); }
+	void lock(long milliseconds)
+	{
+		if (!tryLockImpl(milliseconds))
+			throw TimeoutException();
+	}
+	bool tryLock() { return tryLockImpl(); }
+	bool tryLock(long milliseconds) { return tryLockImpl(milliseconds); }
+	void unlock() { unlockImpl(); }
+
+private:
+	Mutex(const Mutex&);
+	Mutex& operator = (const Mutex&);
+};
+
+/** a non-recursive mutex */
+class FastMutex: private FastMutexImpl
+{
+public:
+	typedef MOOS::Poco::ScopedLock<FastMutex> ScopedLock;
+
+	FastMutex();
+	~FastMutex();
+	void lock() { lockImpl(); }
+	void lock(long milliseconds)
+	{
+		if (!tryLockImpl(milliseconds))
+			throw TimeoutException();
+	}
+	bool tryLock() { return tryLockImpl(); }
+	bool tryLock(long milliseconds) { return tryLockImpl(milliseconds); }
+	void unlock() { unlockImpl(); }
+
+private:
+	FastMutex(const FastMutex&);
+	FastMutex& operator = (const FastMutex&);
+};
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
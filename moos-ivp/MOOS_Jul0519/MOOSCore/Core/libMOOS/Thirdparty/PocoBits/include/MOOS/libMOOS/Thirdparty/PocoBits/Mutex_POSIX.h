@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_MUTEX_POSIX_H
+#define MOOS_POCO_MUTEX_POSIX_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Exception.h"
+#include <pthread.h>
+#include <errno.h>
+
+namespace MOOS {
+namespace Poco {
+
+class MutexImpl
+{
+protected:
+	MutexImpl();
+	MutexImpl(bool fast);
+	~MutexImpl();
+	void lockImpl();
+	bool tryLockImpl();
+	bool tryLockImpl(long milliseconds);
+	void unlockImpl();
+
+private:
+	pthread_mutex_t _mutex;
+};
+
+class FastMutexImpl: public MutexImpl
+{
+protected:
+	FastMutexImpl();
+	~FastMutexImpl();
+};
+
+inline void MutexImpl::lockImpl()
+{
+	if (pthread_mutex_lock(&_mutex))
+		throw SystemException("cannot lock mutex");
+}
+
+inline bool MutexImpl::tryLockImpl()
+{
+	int rc = pthread_mutex_trylock(&_mutex);
+	if (rc == 0)
+		return true;
+	else if (rc == EBUSY)
+		return false;
+	else
+		throw SystemException("cannot lock mutex");
+}
+
+inline void MutexImpl::unlockImpl()
+{
+	if (pthread_mutex_unlock(&_mutex))
+		throw SystemException("cannot unlock mutex");
+}
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
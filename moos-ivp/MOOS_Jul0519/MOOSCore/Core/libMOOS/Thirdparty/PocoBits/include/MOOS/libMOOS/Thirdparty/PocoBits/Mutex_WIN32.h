@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_MUTEX_WIN32_H
+#define MOOS_POCO_MUTEX_WIN32_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Exception.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/UnWindows.h"
+
+namespace MOOS {
+namespace Poco {
+
+class MutexImpl
+{
+protected:
+	MutexImpl();
+	~MutexImpl();
+	void lockImpl() { EnterCriticalSection(&_cs); }
+	bool tryLockImpl() { return TryEnterCriticalSection(&_cs) != 0; }
+	bool tryLockImpl(long milliseconds);
+	void unlockImpl() { LeaveCriticalSection(&_cs); }
+
+private:
+	CRITICAL_SECTION _cs;
+};
+
+typedef MutexImpl FastMutexImpl;
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_PLATFORM_H
+#define MOOS_POCO_PLATFORM_H
+
+#define MOOS_POCO_OS_WINDOWS_NT 0x1001
+#define MOOS_POCO_OS_MAC_OS_X   0x0005
+#define MOOS_POCO_OS_LINUX      0x0002
+
+#if defined(_WIN32)
+    #define MOOS_POCO_OS_FAMILY_WINDOWS 1
+    #define MOOS_POCO_OS MOOS_POCO_OS_WINDOWS_NT
+#else
+    #define MOOS_POCO_OS_FAMILY_UNIX 1
+    #if defined(__APPLE__)
+        #define MOOS_POCO_OS MOOS_POCO_OS_MAC_OS_X
+    #else
+        #define MOOS_POCO_OS MOOS_POCO_OS_LINUX
+    #endif
+#endif
+
+#define MOOS_POCO_UNUSED
+
+namespace MOOS {
+namespace Poco {
+    typedef signed char        Int8;
+    typedef unsigned char      UInt8;
+    typedef signed short       Int16;
+    typedef unsigned short     UInt16;
+    typedef signed int         Int32;
+    typedef unsigned int       UInt32;
+    typedef signed long long   Int64;
+    typedef unsigned long long UInt64;
+}
+}
+
+#endif
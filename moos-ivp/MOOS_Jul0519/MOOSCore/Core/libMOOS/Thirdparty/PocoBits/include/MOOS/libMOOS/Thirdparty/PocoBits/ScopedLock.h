@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_SCOPEDLOCK_H
+#define MOOS_POCO_SCOPEDLOCK_H
+
+namespace MOOS {
+namespace Poco {
+
+template <class M>
+class ScopedLock
+{
+public:
+	inline ScopedLock(M& mutex): _mutex(mutex)
+	{
+		_mutex.lock();
+	}
+	inline ~ScopedLock()
+	{
+		_mutex.unlock();
+	}
+
+private:
+	M& _mutex;
+
+	ScopedLock();
+	ScopedLock(const ScopedLock&);
+	ScopedLock& operator = (const ScopedLock&);
+};
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
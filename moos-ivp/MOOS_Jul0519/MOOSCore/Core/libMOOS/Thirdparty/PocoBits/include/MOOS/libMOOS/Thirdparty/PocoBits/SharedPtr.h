@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_SHAREDPTR_H
+#define MOOS_POCO_SHAREDPTR_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Exception.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/AtomicCounter.h"
+#include <algorithm>
+
+namespace MOOS {
+namespace Poco {
+
+/** simple reference counter for SharedPtr */
+class ReferenceCounter
+{
+public:
+	ReferenceCounter(): _cnt(1) {}
+	void duplicate() { ++_cnt; }
+	int release() { return --_cnt; }
+	int referenceCount() const { return _cnt.value(); }
+
+private:
+	AtomicCounter _cnt;
+};
+
+template <class C>
+class ReleasePolicy
+{
+public:
+	static void release(C* pObj) { delete pObj; }
+};
+
+template <class C>
+class ReleaseArrayPolicy
+{
+public:
+	static void release(C* pObj) { delete [] pObj; }
+};
+
+/** a reference counted smart pointer */
+template <class C, class RC = ReferenceCounter, class RP = ReleasePolicy<C> >
+class SharedPtr
+{
+public:
+	SharedPtr(): _pCounter(new RC), _ptr(0) {}
+
+	SharedPtr(C* ptr): _pCounter(new RC), _ptr(ptr) {}
+
+	template <class Other, class OtherRP>
+	SharedPtr(const SharedPtr<Other, RC, OtherRP>& ptr): _pCounter(ptr._pCounter), _ptr(const_cast<Other*>(ptr.get()))
+	{
+		_pCounter->duplicate();
+	}
+
+	SharedPtr(const SharedPtr& ptr): _pCounter(ptr._pCounter), _ptr(ptr._ptr)
+	{
+		_pCounter->duplicate();
+	}
+
+	~SharedPtr()
+	{
+		release();
+	}
+
+	SharedPtr& assign(C* ptr)
+	{
+		if (get() != ptr)
+		{
+			RC* pTmp = new RC;
+			release();
+			_pCounter = pTmp;
+			_ptr = ptr;
+		}
+		return *this;
+	}
+
+	SharedPtr& assign(const SharedPtr& ptr)
+	{
+		if (&ptr != this)
+		{
+			SharedPtr tmp(ptr);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	SharedPtr& operator = (C* ptr) { return assign(ptr); }
+	SharedPtr& operator = (const SharedPtr& ptr) { return assign(ptr); }
+
+	void swap(SharedPtr& ptr)
+	{
+		std::swap(_ptr, ptr._ptr);
+		std::swap(_pCounter, ptr._pCounter);
+	}
+
+	C* operator -> () { return deref(); }
+	const C* operator -> () const { return deref(); }
+	C& operator * () { return *deref(); }
+	const C& operator * () const { return *deref(); }
+	C* get() { return _ptr; }
+	const C* get() const { return _ptr; }
+	operator C* () { return _ptr; }
+	operator const C* () const { return _ptr; }
+	bool operator ! () const { return _ptr == 0; }
+	bool isNull() const { return _ptr == 0; }
+
+	bool operator == (const SharedPtr& ptr) const { return get() == ptr.get(); }
+	bool operator != (const SharedPtr& ptr) const { return get() != ptr.get(); }
+	bool operator < (const SharedPtr& ptr) const { return get() < ptr.get(); }
+
+	int referenceCount() const { return _pCounter->referenceCount(); }
+
+private:
+	C* deref() const
+	{
+		if (!_ptr)
+			throw NullPointerException();
+		return _ptr;
+	}
+
+	void release()
+	{
+		moos_poco_check_ptr_impl();
+		int i = _pCounter->release();
+		if (i == 0)
+		{
+			RP::release(_ptr);
+			_ptr = 0;
+			delete _pCounter;
+			_pCounter = 0;
+		}
+	}
+
+	void moos_poco_check_ptr_impl() const {}
+
+	RC* _pCounter;
+	C*  _ptr;
+
+	template <class OtherC, class OtherRC, class OtherRP> friend class SharedPtr;
+};
+
+template <class C, class RC, class RP>
+inline void swap(SharedPtr<C, RC, RP>& p1, SharedPtr<C, RC, RP>& p2)
+{
+	p1.swap(p2);
+}
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
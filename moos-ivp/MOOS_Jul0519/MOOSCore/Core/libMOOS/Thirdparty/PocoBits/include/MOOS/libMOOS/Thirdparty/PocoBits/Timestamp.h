@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOOS_POCO_TIMESTAMP_H
+#define MOOS_POCO_TIMESTAMP_H
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Platform.h"
+#include <ctime>
+
+namespace MOOS {
+namespace Poco {
+
+/** a monotonic-ish point in time with microsecond resolution */
+class Timestamp
+{
+public:
+	typedef Int64 TimeVal;
+	typedef Int64 UtcTimeVal;
+	typedef Int64 TimeDiff;
+
+	Timestamp();
+	Timestamp(TimeVal tv);
+	Timestamp(const Timestamp& other);
+	~Timestamp();
+	Timestamp& operator = (const Timestamp& other);
+	Timestamp& operator = (TimeVal tv);
+	void swap(Timestamp& timestamp);
+	void update();
+
+	bool operator == (const Timestamp& ts) const { return _ts == ts._ts; }
+	bool operator != (const Timestamp& ts) const { return _ts != ts._ts; }
+	bool operator >  (const Timestamp& ts) const { return _ts > ts._ts; }
+	bool operator >= (const Timestamp& ts) const { return _ts >= ts._ts; }
+	bool operator <  (const Timestamp& ts) const { return _ts < ts._ts; }
+	bool operator <= (const Timestamp& ts) const { return _ts <= ts._ts; }
+
+	Timestamp  operator +  (TimeDiff d) const { return Timestamp(_ts + d); }
+	Timestamp  operator -  (TimeDiff d) const { return Timestamp(_ts - d); }
+	TimeDiff   operator -  (const Timestamp& ts) const { return _ts - ts._ts; }
+	Timestamp& operator += (TimeDiff d) { _ts += d; return *this; }
+	Timestamp& operator -= (TimeDiff d) { _ts -= d; return *this; }
+
+	std::time_t epochTime() const { return std::time_t(_ts/resolution()); }
+	UtcTimeVal utcTime() const { return _ts*10 + (TimeDiff(0x01b21dd2) << 32) + 0x13814000; }
+	TimeVal epochMicroseconds() const { return _ts; }
+	TimeDiff elapsed() const { Timestamp now; return now - *this; }
+	bool isElapsed(TimeDiff interval) const
+	{
+		Timestamp now;
+		TimeDiff diff = now - *this;
+		return diff >= interval;
+	}
+
+	static Timestamp fromEpochTime(std::time_t t);
+	static Timestamp fromUtcTime(UtcTimeVal val);
+	static TimeVal resolution() { return 1000000; }
+
+#if defined(_WIN32)
+	static Timestamp fromFileTimeNP(UInt32 fileTimeLow, UInt32 fileTimeHigh);
+	void toFileTimeNP(UInt32& fileTimeLow, UInt32& fileTimeHigh) const;
+#endif
+
+private:
+	TimeVal _ts;
+};
+
+} // namespace Poco
+} // namespace MOOS
+
+#endif
@@ -0,0 +1,129 @@
+// A small subset of the GetPot command line parser (MIT license).
+#ifndef MOOS_GETPOT_HPP
+#define MOOS_GETPOT_HPP
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+class GetPot
+{
+public:
+    GetPot(): cursor_(0) {}
+
+    GetPot(int argc, char ** argv): cursor_(0)
+    {
+        for(int i = 0; i < argc; i++)
+            argv_.push_back(argv[i] ? std::string(argv[i]) : std::string());
+
+        for(unsigned int i = 1; i < argv_.size(); i++)
+        {
+            const std::string & a = argv_[i];
+            if(!a.empty() && a[0] != '-')
+                nominus_.push_back(a);
+            std::string::size_type n = a.find('=');
+            if(n != std::string::npos && n > 0)
+            {
+                names_.push_back(a.substr(0, n));
+                values_.push_back(a.substr(n + 1));
+            }
+        }
+    }
+
+    /** true if option appears verbatim, moves the cursor to it */
+    bool search(const char * option)
+    {
+        for(unsigned int i = 1; i < argv_.size(); i++)
+        {
+            if(argv_[i] == option)
+            {
+                cursor_ = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char * follow(const char * def, unsigned int n, const char * option)
+    {
+        const std::string * p = after(n, option);
+        return p ? p->c_str() : def;
+    }
+
+    double follow(double def, unsigned int n, const char * option)
+    {
+        const std::string * p = after(n, option);
+        return p ? to_double(*p, def) : def;
+    }
+
+    int follow(int def, unsigned int n, const char * option)
+    {
+        const std::string * p = after(n, option);
+        return p ? to_int(*p, def) : def;
+    }
+
+    double operator()(const char * name, double def) const
+    {
+        const std::string * p = value(name);
+        return p ? to_double(*p, def) : def;
+    }
+
+    int operator()(const char * name, int def) const
+    {
+        const std::string * p = value(name);
+        return p ? to_int(*p, def) : def;
+    }
+
+    const char * operator()(const char * name, const char * def) const
+    {
+        const std::string * p = value(name);
+        return p ? p->c_str() : def;
+    }
+
+    std::vector<std::string> get_variable_names() const { return names_; }
+
+    std::vector<std::string> nominus_vector() const { return nominus_; }
+
+    unsigned int size() const { return argv_.size(); }
+
+private:
+    const std::string * after(unsigned int n, const char * option)
+    {
+        if(!search(option))
+            return NULL;
+        if(cursor_ + n >= argv_.size())
+            return NULL;
+        return &argv_[cursor_ + n];
+    }
+
+    const std::string * value(const char * name) const
+    {
+        for(unsigned int i = 0; i < names_.size(); i++)
+            if(names_[i] == name)
+                return &values_[i];
+        return NULL;
+    }
+
+    static double to_double(const std::string & s, double def)
+    {
+        char * end = NULL;
+        double d = strtod(s.c_str(), &end);
+        return (end == s.c_str()) ? def : d;
+    }
+
+    static int to_int(const std::string & s, int def)
+    {
+        char * end = NULL;
+        long l = strtol(s.c_str(), &end, 10);
+        return (end == s.c_str()) ? def : (int)l;
+    }
+
+    std::vector<std::string> argv_;
+    std::vector<std::string> nominus_;
+    std::vector<std::string> names_;
+    std::vector<std::string> values_;
+    unsigned int cursor_;
+};
+
+#endif
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * CommandLineParser.h
+ *
+ *  Created on: Aug 29, 2012
+ *      Author: pnewman
+ */
+
+#ifndef COMMANDLINEPARSER_H_
+#define COMMANDLINEPARSER_H_
+
+#include "MOOS/libMOOS/Utils/MOOSScopedPtr.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+class GetPot;
+
+namespace MOOS {
+
+/** parses options (-x value), variables (--x=value) and flags */
+class CommandLineParser {
+public:
+	CommandLineParser();
+	CommandLineParser(int argc,  char * argv[]);
+	virtual ~CommandLineParser();
+
+	bool Open(int argc,  char * argv[]);
+
+	bool GetOption(const std::string & option,  double & result);
+	bool GetOption(const std::string & option,  std::string  & result);
+	bool GetOption(const std::string & option,  int & result);
+	bool GetOption(const std::string & option,  unsigned int & result);
+
+	bool GetVariable(const std::string& var,  bool & result);
+	bool GetVariable(const std::string& var,  double & result);
+	bool GetVariable(const std::string& var,  std::string  & result);
+	bool GetVariable(const std::string& var,  int & result);
+	bool GetVariable(const std::string& var,  unsigned int & result);
+
+	bool GetFlag(const std::string & flag, const std::string & alternative="");
+
+	bool VariableExists(const std::string & sVar);
+
+	std::string GetFreeParameter(unsigned int ndx, const std::string & default_value="");
+	bool GetFreeParameters(std::vector<std::string> & result);
+
+	bool IsAvailable();
+
+private:
+	MOOS::ScopedPtr<GetPot> pcl_;
+};
+
+}
+
+#endif /* COMMANDLINEPARSER_H_ */
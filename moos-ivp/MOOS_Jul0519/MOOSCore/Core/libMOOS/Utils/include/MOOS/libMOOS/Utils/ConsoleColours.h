@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ConsoleColours.h
+ *
+ *  Created on: Apr 7, 2013
+ *      Author: pnewman
+ */
+
+#ifndef CONSOLECOLOURS_H_
+#define CONSOLECOLOURS_H_
+
+namespace MOOS
+{
+/** ANSI escape sequences for coloured terminal output */
+class ConsoleColours
+{
+public:
+	static const char * reset(){ return disable_color_ ? "" : "\033[0m"; }
+	static const char * red(){ return disable_color_ ? "" : "\033[31m"; }
+	static const char * green(){ return disable_color_ ? "" : "\033[32m"; }
+	static const char * yellow(){ return disable_color_ ? "" : "\033[33m"; }
+	static const char * blue(){ return disable_color_ ? "" : "\033[34m"; }
+	static const char * magenta(){ return disable_color_ ? "" : "\033[35m"; }
+	static const char * cyan(){ return disable_color_ ? "" : "\033[36m"; }
+
+	static const char * Red(){ return disable_color_ ? "" : "\033[1;31m"; }
+	static const char * Green(){ return disable_color_ ? "" : "\033[1;32m"; }
+	static const char * Yellow(){ return disable_color_ ? "" : "\033[1;33m"; }
+	static const char * Blue(){ return disable_color_ ? "" : "\033[1;34m"; }
+	static const char * Magenta(){ return disable_color_ ? "" : "\033[1;35m"; }
+	static const char * Cyan(){ return disable_color_ ? "" : "\033[1;36m"; }
+
+	static void Enable(bool bEnable){ disable_color_ = !bEnable; }
+
+	static bool disable_color_;
+};
+}
+
+#endif /* CONSOLECOLOURS_H_ */
@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef KEYBOARDCAPTURE_H_
+#define KEYBOARDCAPTURE_H_
+
+#include "MOOS/libMOOS/Utils/MOOSScopedPtr.h"
+
+namespace MOOS
+{
+/** captures key presses on a worker thread */
+class KeyboardCapture
+{
+public:
+	KeyboardCapture();
+	bool Start();
+	bool GetKeyboardInput(char & input);
+	static bool CanCapture();
+
+protected:
+	static bool dispatch(void * param);
+	bool Capture();
+
+	class Impl;
+	MOOS::ScopedPtr<Impl> impl_;
+};
+}
+
+#endif
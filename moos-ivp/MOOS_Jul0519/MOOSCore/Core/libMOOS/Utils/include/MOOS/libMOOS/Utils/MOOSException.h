@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSException.h: interface for the CMOOSException class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSEXCEPTIONH
+#define MOOSEXCEPTIONH
+
+#include <string>
+
+/** the simple exception type thrown by MOOS classes */
+class CMOOSException
+{
+public:
+    CMOOSException();
+    CMOOSException(const char * sStr);
+    CMOOSException(const std::string & s);
+    virtual ~CMOOSException();
+
+    char * c_str(){ return m_sReason; }
+
+    char m_sReason[100];
+};
+
+#endif
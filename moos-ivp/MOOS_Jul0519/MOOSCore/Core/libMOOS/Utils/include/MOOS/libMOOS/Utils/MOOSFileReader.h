@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSFileReader.h: interface for the CMOOSFileReader class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSFILEREADERH
+#define MOOSFILEREADERH
+
+#include <string>
+#include <fstream>
+#include <map>
+
+#ifdef _WIN32
+    #include "windows.h"
+#else
+    #include <pthread.h>
+#endif
+
+class CMOOSLock;
+
+/** reads token=value pairs from a MOOS mission file */
+class CMOOSFileReader
+{
+public:
+    CMOOSFileReader();
+    virtual ~CMOOSFileReader();
+
+    bool IsOpen();
+    bool Reset();
+    bool SetFile(const std::string & sFile);
+    std::string GetFileName(){ return m_sFileName; }
+    void EnableVerbatimQuoting(bool bEnable){ m_bEnableVerbatimQuoting = bEnable; }
+
+    bool GetValue(std::string sName,std::string & sResult);
+    bool GetValue(std::string sName,double & dfResult);
+    bool GetValue(std::string sName,float & fResult);
+    bool GetValue(std::string sName,int & nResult);
+    bool GetValue(std::string sName,unsigned int & nResult);
+    bool GetValue(std::string sName,bool & bResult);
+
+    bool MakeOverloadedCopy(const std::string & sCopyName,std::map<std::string, std::string> & OverLoads);
+
+protected:
+    std::string GetNextValidLine(bool bDoSubstitution = true);
+    bool IsComment(std::string & sLine);
+    bool GetTokenValPair(std::string sLine,std::string & sTok,std::string & sVal,bool bPreserveWhiteSpace = false);
+    bool eof();
+    bool GoTo(std::string sLine);
+    std::ifstream * GetFile();
+    bool BuildLocalShellVars();
+    bool DoVariableExpansion(std::string & sVal);
+    void ClearFileMap()
+    {
+        THREAD2FILE_MAP::iterator q;
+        for(q=m_FileMap.begin();q!=m_FileMap.end();++q)
+            delete q->second;
+        m_FileMap.clear();
+    }
+
+#ifdef _WIN32
+    typedef std::map<DWORD, std::ifstream *> THREAD2FILE_MAP;
+#else
+    typedef std::map<pthread_t, std::ifstream *> THREAD2FILE_MAP;
+#endif
+
+    THREAD2FILE_MAP m_FileMap;
+    std::map<std::string, std::string> m_LocalShellVariables;
+    std::string m_sFileName;
+    CMOOSLock * m_pLock;
+    bool m_bEnableVerbatimQuoting;
+};
+
+#endif
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSLinuxSerialPort.h: interface for the CMOOSLinuxSerialPort class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSLINUXSERIALPORTH
+#define MOOSLINUXSERIALPORTH
+
+#include "MOOS/libMOOS/Utils/MOOSSerialPort.h"
+
+#include <termios.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+class CMOOSLinuxSerialPort : public CMOOSSerialPort
+{
+public:
+    CMOOSLinuxSerialPort();
+    virtual ~CMOOSLinuxSerialPort();
+
+    virtual bool Create(const char * pPortNum=DEFAULT_PORT, int nBaudRate=DEFAULT_BAUDRATE);
+    virtual bool Close();
+    virtual int GrabN(char * pBuffer,int nRequired);
+    virtual int Write(const char* Str,int nLen,double* pTime=NULL);
+    virtual int Flush();
+    virtual void Break();
+    int GetFD();
+
+protected:
+    int m_nPortFD;
+    termios m_OldPortOptions;
+    termios m_PortOptions;
+    CMOOSLock m_PortLock;
+};
+
+#endif
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSLock.h: interface for the CMOOSLock class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSLOCKH
+#define MOOSLOCKH
+
+#ifdef _WIN32
+    #include "windows.h"
+#else
+    #include <pthread.h>
+#endif
+
+/** A simple mutual exclusion lock */
+class CMOOSLock
+{
+public:
+    void UnLock();
+    void Lock();
+    CMOOSLock(bool bInitial = true);
+    virtual ~CMOOSLock();
+
+protected:
+#ifdef _WIN32
+    HANDLE m_hLock;
+#else
+    pthread_mutex_t m_hLock;
+#endif
+
+private:
+    CMOOSLock(const CMOOSLock &);
+    CMOOSLock & operator=(const CMOOSLock &);
+};
+
+#endif
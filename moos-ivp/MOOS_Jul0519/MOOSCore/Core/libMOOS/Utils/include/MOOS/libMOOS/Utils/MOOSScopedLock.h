@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MOOSScopedLock.h
+ *
+ *  Created on: Sep 19, 2011
+ *      Author: pnewman
+ */
+
+#ifndef MOOSSCOPEDLOCK_H_
+#define MOOSSCOPEDLOCK_H_
+
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+
+namespace MOOS
+{
+/** locks a CMOOSLock for the lifetime of this object */
+class ScopedLock
+{
+public:
+    explicit ScopedLock(CMOOSLock & Lock) : m_Lock(Lock)
+    {
+        m_Lock.Lock();
+    }
+    ~ScopedLock()
+    {
+        m_Lock.UnLock();
+    }
+private:
+    CMOOSLock & m_Lock;
+    ScopedLock(const ScopedLock &);
+    ScopedLock & operator=(const ScopedLock &);
+};
+}
+
+#endif /* MOOSSCOPEDLOCK_H_ */
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MOOSScopedPtr.h
+ *
+ *  Created on: Jan 6, 2012
+ *      Author: pnewman
+ */
+
+#ifndef MOOSSCOPEDPTR_H_
+#define MOOSSCOPEDPTR_H_
+
+#include <cstddef>
+
+namespace MOOS
+{
+/** owns a single heap object and deletes it when it goes out of scope.
+Copying or assigning passes ownership on (like std::auto_ptr) */
+template <class T>
+class ScopedPtr
+{
+public:
+    explicit ScopedPtr(T * p = NULL) : p_(p) {}
+    ScopedPtr(const ScopedPtr & Other) : p_(Other.release()) {}
+    ~ScopedPtr() { delete p_; }
+
+    ScopedPtr & operator=(const ScopedPtr & Other)
+    {
+        reset(Other.release());
+        return *this;
+    }
+
+    /** give up ownership without deleting */
+    T * release() const
+    {
+        T * p = p_;
+        p_ = NULL;
+        return p;
+    }
+
+    void reset(T * p = NULL)
+    {
+        if(p != p_)
+        {
+            delete p_;
+            p_ = p;
+        }
+    }
+
+    T & operator*() const { return *p_; }
+    T * operator->() const { return p_; }
+    T * get() const { return p_; }
+
+private:
+    mutable T * p_;
+};
+}
+
+#endif /* MOOSSCOPEDPTR_H_ */
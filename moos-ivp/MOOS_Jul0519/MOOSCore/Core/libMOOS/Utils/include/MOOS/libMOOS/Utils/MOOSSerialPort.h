@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// MOOSSerialPort.h: interface for the CMOOSSerialPort class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MOOSSERIALPORTH
+#define MOOSSERIALPORTH
+
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <list>
+#include <string>
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #define DEFAULT_PORT "/dev/ttyS0"
+#else
+    #define DEFAULT_PORT "COM1"
+#endif
+
+#define DEFAULT_BAUDRATE 9600
+#define MAX_TELEGRAM_LEN 1024
+#define TELEGRAM_LEN 1024
+
+class CMOOSSerialTelegram
+{
+public:
+    CMOOSSerialTelegram(std::string sTelegram,double dfTime)
+    {
+        m_sTelegram = sTelegram;
+        m_dfTime = dfTime;
+    }
+    std::string m_sTelegram;
+    double m_dfTime;
+};
+
+typedef std::list<CMOOSSerialTelegram> TELEGRAM_LIST;
+
+/** a serial port with optional streaming on a listen thread */
+class CMOOSSerialPort
+{
+public:
+    CMOOSSerialPort();
+    virtual ~CMOOSSerialPort();
+
+    virtual bool Create(const char * pPortNum=DEFAULT_PORT, int nBaudRate=DEFAULT_BAUDRATE) = 0;
+    virtual bool Configure(STRING_LIST sParams);
+    virtual bool Close();
+    virtual int GrabN(char * pBuffer,int nRequired) = 0;
+    virtual int Write(const char* Str,int nLen,double* pTime=NULL) = 0;
+    virtual int Flush() = 0;
+    virtual void Break();
+
+    bool IsStreaming();
+    bool IsVerbose(){ return m_bVerbose; }
+    void SetTermCharacter(char cTermChar);
+    char GetTermCharacter();
+    std::string GetPortName();
+
+    bool GetLatest(std::string & sWhat,double & dfWhen);
+    bool GetEarliest(std::string & sWhat,double & dfWhen);
+    bool GetTelegram(std::string & sTelegram,double dfTimeOut,double *pTime=NULL);
+    bool GetTelegramOrAccumulate(std::string & sTelegram,double dfTimeOut,double *pTime=NULL);
+
+    int ReadNWithTimeOut(char * pData,int nLen,double dfTimeOut=0.5,double * pTime=NULL);
+    int ReadNWithTimeOut2(char * pData,int nLen,double dfTimeOut=0.5,double * pTime=NULL);
+
+    void SetIsCompleteReplyCallBack(bool (*pfn)(char *pData, int nLen, int nRead));
+
+    bool CommsLoop();
+
+protected:
+    bool StartThreads();
+    virtual bool IsCompleteReply(char *pData, int nLen, int nRead);
+
+    bool (*m_pfnUserIsCompleteReplyCallBack)(char *pData, int nLen, int nRead);
+
+    std::string m_sPort;
+    int m_nBaudRate;
+    bool m_bHandShaking;
+    bool m_bStreaming;
+    bool m_bVerbose;
+    bool m_bQuit;
+    bool m_bUseCsmExt;
+    char m_cTermCharacter;
+    std::string m_sTelegram;
+    double m_dfTime;
+
+    CMOOSLock m_InBoxLock;
+    TELEGRAM_LIST m_InBox;
+
+#ifdef _WIN32
+    HANDLE m_hCommsThread;
+    DWORD m_nCommsThreadID;
+#else
+    pthread_t m_nCommsThreadID;
+#endif
+};
+
+#endif
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MOOSThread.h
+ *
+ *  A thin wrapper around a platform thread which runs a user supplied
+ *  function. The worker should poll IsQuitRequested() and return when
+ *  it becomes true so that Stop() can join it.
+ */
+
+#ifndef MOOSTHREAD_H_
+#define MOOSTHREAD_H_
+
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedLock.h"
+
+#include <string>
+#include <iostream>
+
+#ifdef _WIN32
+    #include "windows.h"
+#else
+    #include <pthread.h>
+#endif
+
+class CMOOSThread
+{
+public:
+    CMOOSThread(bool (*pfnThreadFunc)(void *), void * pThreadData)
+    {
+        Clear();
+        Initialise(pfnThreadFunc, pThreadData);
+    }
+
+    CMOOSThread()
+    {
+        Clear();
+    }
+
+    ~CMOOSThread()
+    {
+        Stop();
+    }
+
+    /** set the function the thread will run and its argument */
+    bool Initialise(bool (*pfnThreadFunc)(void *), void * pThreadData)
+    {
+        if(IsThreadRunning())
+            return false;
+        m_pfnThreadFunc = pfnThreadFunc;
+        m_pThreadData = pThreadData;
+        return true;
+    }
+
+    /** start the thread */
+    bool Start()
+    {
+        if(m_pfnThreadFunc == NULL)
+            return false;
+
+        {
+            MOOS::ScopedLock L(m_RunLock);
+            if(m_bRunning)
+                return false;
+            m_bRunning = true;
+            m_bQuitRequested = false;
+        }
+
+#ifdef _WIN32
+        m_hThread = ::CreateThread(NULL, 0,
+            (LPTHREAD_START_ROUTINE)CallbackProc, this, 0, &m_nThreadID);
+        if(m_hThread == NULL)
+#else
+        if(pthread_create(&m_nThreadID, NULL, CallbackProc, this) != 0)
+#endif
+        {
+            MOOS::ScopedLock L(m_RunLock);
+            m_bRunning = false;
+            return false;
+        }
+        m_bJoinable = true;
+        return true;
+    }
+
+    /** ask the thread to quit and wait for it to do so */
+    bool Stop()
+    {
+        if(!m_bJoinable)
+            return true;
+
+        {
+            MOOS::ScopedLock L(m_RunLock);
+            m_bQuitRequested = true;
+        }
+
+#ifdef _WIN32
+        WaitForSingleObject(m_hThread, INFINITE);
+        CloseHandle(m_hThread);
+#else
+        if(!pthread_equal(pthread_self(), m_nThreadID))
+            pthread_join(m_nThreadID, NULL);
+        else
+            pthread_detach(m_nThreadID);
+#endif
+        m_bJoinable = false;
+
+        MOOS::ScopedLock L(m_RunLock);
+        m_bRunning = false;
+        m_bQuitRequested = false;
+        return true;
+    }
+
+    /** true between a successful Start() and the worker returning */
+    bool IsThreadRunning()
+    {
+        MOOS::ScopedLock L(m_RunLock);
+        return m_bRunning;
+    }
+
+    /** true once Stop() has been called */
+    bool IsQuitRequested()
+    {
+        MOOS::ScopedLock L(m_RunLock);
+        return m_bQuitRequested;
+    }
+
+    /** a name used in diagnostics */
+    void Name(const std::string & sName){ m_sName = sName; }
+    std::string Name(){ return m_sName; }
+
+    void SetVerbose(bool bVerbose){ m_bVerbose = bVerbose; }
+
+private:
+    void Clear()
+    {
+        m_pfnThreadFunc = NULL;
+        m_pThreadData = NULL;
+        m_bRunning = false;
+        m_bQuitRequested = false;
+        m_bJoinable = false;
+        m_bVerbose = false;
+    }
+
+    bool Work()
+    {
+        bool bResult = (*m_pfnThreadFunc)(m_pThreadData);
+        MOOS::ScopedLock L(m_RunLock);
+        m_bRunning = false;
+        return bResult;
+    }
+
+#ifdef _WIN32
+    static DWORD WINAPI CallbackProc(void * pThreadData)
+    {
+        CMOOSThread * pMe = static_cast<CMOOSThread *>(pThreadData);
+        return pMe->Work() ? 0 : 1;
+    }
+    HANDLE m_hThread;
+    DWORD m_nThreadID;
+#else
+    static void * CallbackProc(void * pThreadData)
+    {
+        CMOOSThread * pMe = static_cast<CMOOSThread *>(pThreadData);
+        pMe->Work();
+        return NULL;
+    }
+    pthread_t m_nThreadID;
+#endif
+
+    bool (*m_pfnThreadFunc)(void *);
+    void * m_pThreadData;
+    CMOOSLock m_RunLock;
+    bool m_bRunning;
+    bool m_bQuitRequested;
+    bool m_bJoinable;
+    bool m_bVerbose;
+    std::string m_sName;
+
+    CMOOSThread(const CMOOSThread &);
+    CMOOSThread & operator=(const CMOOSThread &);
+};
+
+#endif /* MOOSTHREAD_H_ */
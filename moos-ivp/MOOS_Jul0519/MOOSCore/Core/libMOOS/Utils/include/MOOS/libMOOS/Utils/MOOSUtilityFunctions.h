@@ -0,0 +1,253 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*! \file MOOSUtilityFunctions.h
+ \brief Utility functions and macros used throughout MOOS
+*/
+
+#ifndef MOOSUTILITYFUNCTIONSH
+#define MOOSUTILITYFUNCTIONSH
+
+#ifdef _WIN32
+    #pragma warning(disable : 4786)
+    #pragma warning(disable : 4503)
+#endif
+
+#include <string>
+#include <list>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <cmath>
+#include <stdint.h>
+
+#ifndef PI
+#define PI 3.141592653589793
+#endif
+
+#define MOOSMax(a,b) (((a)>(b))?(a):(b))
+#define MOOSMin(a,b) (((a)<(b))?(a):(b))
+
+#define UNUSED_PARAMETER(a) (void)(a)
+
+/** a string saying where in the source we are */
+#define MOOSHERE MOOSFormat("File %s Line %d",__FILE__,__LINE__).c_str()
+
+/** a list of strings */
+typedef std::list<std::string> STRING_LIST;
+
+namespace MOOS
+{
+    /** returns time in seconds since 1970 (with time warping applied) */
+    double Time();
+
+    /** formats a time as a date and/or time of day string */
+    std::string TimeToDate(double dfTime,bool bDate=true,bool bTime=true);
+
+    /** sleep for a number of milliseconds */
+    void Pause(int milliseconds,bool bApplyTimeWarp=true);
+
+    /** remove and return everything up to (but excluding) sTk */
+    std::string Chomp(std::string &sStr, const std::string &sTk=",",bool bInsensitive=false);
+
+    /** split a token separated list into a vector of strings */
+    std::vector<std::string > StringListToVector(std::string L, const std::string & tok=",");
+
+    /** convert a string to a double, throwing if it is not numeric */
+    double StringToDouble(const std::string & sNum);
+
+    /** portable test for not-a-number */
+    template <class T> bool isnan(T x)
+    {
+        return x!=x;
+    }
+    
+    /** used to silence unused variable warnings */
+    template <class T> void DeliberatelyNotUsed(const T &){}
+};
+
+/** returns true if this machine is little endian */
+bool IsLittleEndian();
+
+/** swaps the byte order of a plain old data type */
+template <class T> T SwapByteOrder(const T &Val)
+{
+    T Result;
+    const unsigned char *pIn = (const unsigned char *)&Val;
+    unsigned char *pOut = (unsigned char *)&Result;
+    for(unsigned int i = 0; i < sizeof(T); i++)
+        pOut[i] = pIn[sizeof(T)-1-i];
+    return Result;
+}
+
+/** sets the skew between this machine and the MOOSDB */
+void SetMOOSSkew(double dfSkew);
+
+/** returns the skew between this machine and the MOOSDB */
+double GetMOOSSkew();
+
+/** Win32 only - enable high precision timing*/
+bool SetWin32HighPrecisionTiming(bool bEnable);
+
+/** returns time in seconds since 1970 as seen on this machine */
+double MOOSLocalTime(bool bApplyTimeWarping=true);
+
+/** returns high precision time in seconds since 1970*/
+double HPMOOSTime(bool bApplyTimeWarping=true);
+
+/** returns time in seconds since 1970 (MOOS time)*/
+double MOOSTime(bool bApplyTimeWarping=true);
+
+/** returns the time warp currently in use */
+double GetMOOSTimeWarp();
+
+/** sets the time warp applied by MOOSTime() */
+bool SetMOOSTimeWarp(double dfWarp);
+
+/** sleep for nMS milliseconds */
+void MOOSPause(int nMS,bool bApplyTimeWarping=true);
+
+/** remove and return everything up to (but excluding) sTk from sStr */
+std::string MOOSChomp(std::string &sStr, const std::string &sTk=",",bool bInsensitive=false);
+
+/** find sToken in sSource, optionally ignoring case */
+size_t MOOSStrFind(const std::string & sSource,const std::string & sToken,bool bInsensitive=false);
+
+/** extract the value of sTk=... from sStr */
+bool MOOSValFromString(std::string & sVal,const std::string & sStr,const std::string & sTk,bool bInsensitive=false);
+bool MOOSValFromString(unsigned int & nVal,const std::string & sStr,const std::string & sTk,bool bInsensitive=false);
+bool MOOSValFromString(int & nVal,const std::string & sStr,const std::string & sTk,bool bInsensitive=false);
+bool MOOSValFromString(int64_t & nVal,const std::string & sStr,const std::string & sTk,bool bInsensitive=false);
+bool MOOSValFromString(bool & bVal,const std::string & sStr,const std::string & sTk,bool bInsensitive=false);
+bool MOOSValFromString(double & dfVal,const std::string & sStr,const std::string & sTk,bool bInsensitive=false);
+bool MOOSValFromString(float & fVal,const std::string & sStr,const std::string & sTk,bool bInsensitive=false);
+bool MOOSValFromString(std::vector<double> &dfValVec,int &nRows,int &nCols,const std::string & sStr,const std::string & sToken,bool bInsensitive=false);
+bool MOOSValFromString(std::vector<unsigned int> &nValVec,int &nRows,int &nCols,const std::string & sStr,const std::string & sToken,bool bInsensitive=false);
+
+/** parse a vector of the form [RxC]{a,b,c...} */
+bool MOOSVectorFromString(const std::string & sStr,std::vector<double> & dfValVec,int & nRows, int & nCols);
+bool MOOSVectorFromString(const std::string & sStr,std::vector<float> & fValVec,int & nRows, int & nCols);
+bool MOOSVectorFromString(const std::string & sStr,std::vector<unsigned int> & nValVec,int & nRows, int & nCols);
+
+/** append sTk=Val to sStr, comma separated */
+template <class T> bool MOOSAddValToString(std::string & sStr,const std::string & sTk,const T & Val)
+{
+    std::stringstream ss;
+    if(!sStr.empty())
+        ss<<",";
+    ss<<sTk<<"="<<Val;
+    sStr+=ss.str();
+    return true;
+}
+
+/** read the next line of an alog file carrying sMessageName */
+bool GetNextAlogLineByMessageName(std::istream & Input,const std::string & sMessageName,double & dfTime,std::string & sSource,std::string & sPayload);
+
+/** wrap an angle to +/- PI */
+double MOOS_ANGLE_WRAP(double dfAng);
+
+/** clamp dfVal to +/- dfLimit, returns true if it was clamped */
+bool MOOSAbsLimit(double & dfVal,double dfLimit);
+
+/** case insensitive string comparison */
+bool MOOSStrCmp(std::string s1,std::string s2);
+
+/** returns true if sString starts with sPrefix */
+inline bool MOOSStartsWith(const std::string & sString,const std::string & sPrefix)
+{
+    return sString.compare(0,sPrefix.size(),sPrefix)==0;
+}
+
+/** returns the date as a string */
+std::string MOOSGetDate(double t=-1);
+
+/** wildcard (* and ?) comparison */
+bool MOOSWildCmp(const std::string & sPattern, const std::string & sString);
+
+/** returns a time stamp string suitable for file names */
+std::string MOOSGetTimeStampString(double t=-1);
+
+void MOOSToUpper(std::string &str);
+void MOOSToLower(std::string &str);
+std::string MOOSToLower(const std::string & str);
+std::string MOOSToUpper(const std::string & str);
+
+/** returns true if str is a number */
+bool MOOSIsNumeric(std::string str);
+
+/** remove leading and trailing white space */
+void MOOSTrimWhiteSpace(std::string &str);
+
+/** remove all the characters in sTok from sStr */
+void MOOSRemoveChars(std::string & sStr,const std::string & sTok);
+
+/** read a key press without echo */
+int MOOSGetch();
+
+/** printf style formatting into a std::string */
+std::string MOOSFormat(const char * FmtStr,...);
+
+/** printf to the terminal and return false */
+bool MOOSFail(const char * FmtStr,...);
+
+/** stop MOOSTrace printing in the calling thread */
+void InhibitMOOSTraceInThisThread(bool bInhibit=true);
+
+/** print to the terminal (thread safe) */
+void MOOSTrace(std::string sStr);
+void MOOSTrace(const char *FmtStr,...);
+
+double MOOSDeg2Rad(double dfDeg);
+double MOOSRad2Deg(double dfRad);
+
+/** find sToken=... in a list of parameters */
+bool MOOSGetValueFromToken(STRING_LIST & sParams,const std::string & sToken,std::string & sVal);
+
+std::string MOOSThirdPartyStatusString(std::string sStatusCommand);
+std::string MOOSThirdPartyActuationString(double * pdfRudder,double * pdfElevator,double * pdfThrust);
+
+/** random numbers */
+double MOOSNormalInv(double dfArea);
+double MOOSUniformRandom(double dfMin, double dfMax);
+int MOOSDiscreteUniform(int nMin, int nMax);
+double MOOSWhiteNoise(double Sigma);
+
+/** prints a "progress bar" */
+void Progress(double dfPC);
+
+/** formats a vector of doubles into standard MOOS format*/
+std::string DoubleVector2String(const std::vector<double> & V);
+std::stringstream & Write(std::stringstream & os,const std::vector<double> & Vec);
+std::stringstream & Write(std::stringstream & os,const std::vector<int> & Vec);
+
+/** returns a list of directories or files in a specified location */
+bool GetDirectoryContents(const std::string & sPath,std::list<std::string> &sContents, bool bFiles=true);
+
+/** split a path into directory, file and extension */
+bool MOOSFileParts(std::string sFullPath, std::string & sPath,std::string &sFile,std::string & sExtension);
+
+/** make a directory */
+bool MOOSCreateDirectory(const std::string & sDirectory);
+
+#endif
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * PeriodicEvent.h
+ *
+ *  Created on: Feb 7, 2013
+ *      Author: pnewman
+ */
+
+#ifndef PERIODICEVENT_H_
+#define PERIODICEVENT_H_
+
+#include "MOOS/libMOOS/Utils/MOOSScopedPtr.h"
+
+namespace MOOS {
+
+/** calls a user function at a fixed period on its own thread */
+class PeriodicEvent {
+public:
+	PeriodicEvent();
+	void SetCallback(bool (*pfn)(double Now,double LastRun,double Scheduled, void * pParamCaller), void * pCallerParam);
+	bool SetPeriod(double PeriodSeconds);
+	bool Start();
+	bool Stop();
+
+private:
+	class Impl;
+	MOOS::ScopedPtr<Impl> Impl_;
+};
+
+}
+
+#endif /* PERIODICEVENT_H_ */
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+// ProcessConfigReader.h: interface for the CProcessConfigReader class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef PROCESSCONFIGREADERH
+#define PROCESSCONFIGREADERH
+
+#include "MOOS/libMOOS/Utils/MOOSFileReader.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/** reads the ProcessConfig block for a named application */
+class CProcessConfigReader : public CMOOSFileReader
+{
+public:
+    CProcessConfigReader();
+    virtual ~CProcessConfigReader();
+
+    void SetAppName(std::string sAppName);
+    std::string GetAppName();
+    std::string GetFileName();
+
+    bool GetConfiguration(std::string sAppName, STRING_LIST & Params);
+    bool GetConfigurationAndPreserveSpace(std::string sAppName, STRING_LIST & Params);
+
+    bool GetConfigurationParam(std::string sParam, std::string & sVal);
+    bool GetConfigurationParam(std::string sParam, bool & bVal);
+    bool GetConfigurationParam(std::string sParam, double & dfVal);
+    bool GetConfigurationParam(std::string sParam, float & fVal);
+    bool GetConfigurationParam(std::string sParam, int & nVal);
+    bool GetConfigurationParam(std::string sParam, unsigned int & nVal);
+    bool GetConfigurationParam(std::string sParam, unsigned short & nVal);
+    bool GetConfigurationParam(std::string sParam, std::vector<double> & Vec, int & nRows, int & nCols);
+
+    bool GetConfigurationParam(std::string sAppName, std::string sParam, std::string & sVal);
+    bool GetConfigurationParam(std::string sAppName, std::string sParam, bool & bVal);
+    bool GetConfigurationParam(std::string sAppName, std::string sParam, double & dfVal);
+    bool GetConfigurationParam(std::string sAppName, std::string sParam, float & fVal);
+    bool GetConfigurationParam(std::string sAppName, std::string sParam, int & nVal);
+    bool GetConfigurationParam(std::string sAppName, std::string sParam, unsigned int & nVal);
+    bool GetConfigurationParam(std::string sAppName, std::string sParam, unsigned short & nVal);
+
+    std::list<std::string> GetSearchedParameters(const std::string & sAppName);
+
+protected:
+    std::string m_sAppName;
+    std::map<std::string, std::set<std::string> > m_Audit;
+};
+
+#endif
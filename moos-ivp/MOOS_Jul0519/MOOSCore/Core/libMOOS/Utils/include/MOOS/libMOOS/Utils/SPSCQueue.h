@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * SPSCQueue.h
+ *
+ *  A bounded, lock free queue for exactly one producing thread and one
+ *  consuming thread (or several, if each side serialises its own
+ *  callers). Push and Pop never block or take a lock so a busy
+ *  producer cannot be held up by, or hold up, the consumer. A full queue
+ *  refuses new elements - the caller decides what back pressure means -
+ *  and the queue remembers how often that happened and how full it has
+ *  ever been.
+ *
+ *  WaitForPush only sleeps when the queue is empty and the producer only
+ *  signals when the consumer says it is asleep, so in the busy case no
+ *  system call is made at all.
+ */
+
+#ifndef SPSCQUEUE_H_
+#define SPSCQUEUE_H_
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Event.h"
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1700)
+#define MOOS_SPSC_STD_ATOMIC
+#define MOOS_SPSC_MOVE
+#include <atomic>
+#endif
+
+namespace MOOS
+{
+
+/** an index shared between the two threads of a SPSCQueue */
+class SPSCIndex
+{
+public:
+    SPSCIndex() : value_(0) {}
+
+#ifdef MOOS_SPSC_STD_ATOMIC
+    unsigned int Acquire() const { return value_.load(std::memory_order_acquire); }
+    void Release(unsigned int n) { value_.store(n, std::memory_order_release); }
+    unsigned int Relaxed() const { return value_.load(std::memory_order_relaxed); }
+    unsigned int Sequential() const { return value_.load(std::memory_order_seq_cst); }
+    void Sequential(unsigned int n) { value_.store(n, std::memory_order_seq_cst); }
+private:
+    std::atomic<unsigned int> value_;
+#else
+    unsigned int Acquire() const { return __atomic_load_n(&value_, __ATOMIC_ACQUIRE); }
+    void Release(unsigned int n) { __atomic_store_n(&value_, n, __ATOMIC_RELEASE); }
+    unsigned int Relaxed() const { return __atomic_load_n(&value_, __ATOMIC_RELAXED); }
+    unsigned int Sequential() const { return __atomic_load_n(&value_, __ATOMIC_SEQ_CST); }
+    void Sequential(unsigned int n) { __atomic_store_n(&value_, n, __ATOMIC_SEQ_CST); }
+private:
+    unsigned int value_;
+#endif
+
+    //not copyable
+    SPSCIndex(const SPSCIndex &);
+    SPSCIndex & operator = (const SPSCIndex &);
+};
+
+template<class T>
+class SPSCQueue
+{
+public:
+    /** the queue holds nCapacity elements rounded up to a power of two */
+    explicit SPSCQueue(unsigned int nCapacity = 1024) : event_(true)
+    {
+        unsigned int n = 2;
+        while(n<nCapacity && n<(1u<<30))
+            n<<=1;
+
+        elements_.resize(n);
+        mask_ = n-1;
+    }
+
+    /** producer: add Element. Returns false (and counts a rejection) if full */
+    bool Push(const T & Element)
+    {
+        unsigned int nHead = head_.Relaxed();
+        unsigned int nSize = nHead-tail_.Acquire();
+
+        if(nSize>mask_)
+        {
+            rejected_.Release(rejected_.Relaxed()+1);
+            return false;
+        }
+
+        elements_[nHead&mask_] = Element;
+
+        //sequential so the consumer cannot decide to sleep having
+        //missed this element (and we cannot miss it sleeping)
+        head_.Sequential(nHead+1);
+
+        if(nSize+1>high_water_.Relaxed())
+            high_water_.Release(nSize+1);
+
+        if(waiting_.Sequential())
+            event_.set();
+
+        return true;
+    }
+
+    /** consumer: take the oldest element. Returns false if empty */
+    bool Pop(T & Element)
+    {
+        unsigned int nTail = tail_.Relaxed();
+        if(nTail==head_.Acquire())
+            return false;
+
+        TakeFrom(elements_[nTail&mask_],Element);
+        tail_.Release(nTail+1);
+
+        return true;
+    }
+
+    /** consumer: move everything queued to the back of Container (a
+     * std::list or similar). Returns the number of elements moved */
+    template<class C>
+    unsigned int AppendToOther(C & Container)
+    {
+        unsigned int nTail = tail_.Relaxed();
+        unsigned int nHead = head_.Acquire();
+
+        for(unsigned int n = nTail;n!=nHead;n++)
+        {
+            Container.push_back(T());
+            TakeFrom(elements_[n&mask_],Container.back());
+        }
+
+        tail_.Release(nHead);
+
+        return nHead-nTail;
+    }
+
+    /** consumer: wait up to nMS milliseconds for something to be queued.
+     * Returns true if there is something to Pop */
+    bool WaitForPush(unsigned int nMS)
+    {
+        if(!IsEmpty())
+            return true;
+
+        waiting_.Sequential(1);
+
+        if(head_.Sequential()==tail_.Relaxed())
+            event_.tryWait(nMS);
+
+        waiting_.Sequential(0);
+
+        return !IsEmpty();
+    }
+
+    bool IsEmpty() const
+    {
+        return head_.Acquire()==tail_.Acquire();
+    }
+
+    /** number of elements queued (exact only when called by one of the two sides) */
+    unsigned int Size() const
+    {
+        return head_.Acquire()-tail_.Acquire();
+    }
+
+    unsigned int Capacity() const
+    {
+        return mask_+1;
+    }
+
+    /** the most elements ever queued at once */
+    unsigned int HighWaterMark() const
+    {
+        return high_water_.Acquire();
+    }
+
+    /** how many pushes have been refused because the queue was full */
+    unsigned int Rejections() const
+    {
+        return rejected_.Acquire();
+    }
+
+private:
+    /** consumer: hand the contents of Slot to Element and leave Slot empty
+     * so the queue does not keep what it handed over (a message's strings,
+     * say) alive until the slot is next written */
+    static void TakeFrom(T & Slot, T & Element)
+    {
+#ifdef MOOS_SPSC_MOVE
+        Element = std::move(Slot);
+#else
+        std::swap(Element,Slot);
+#endif
+        Slot = T();
+    }
+
+    std::vector<T> elements_;
+    unsigned int mask_;
+
+    //written by the producer
+    SPSCIndex head_;
+    SPSCIndex high_water_;
+    SPSCIndex rejected_;
+    char pad_[64];
+
+    //written by the consumer
+    SPSCIndex tail_;
+    SPSCIndex waiting_;
+
+    MOOS::Poco::Event event_;
+
+    //not copyable
+    SPSCQueue(const SPSCQueue &);
+    SPSCQueue & operator = (const SPSCQueue &);
+};
+
+}
+
+#endif /* SPSCQUEUE_H_ */
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * SafeList.h
+ *
+ *  A thread safe list which a consumer can block on, waiting for a
+ *  producer to push.
+ */
+
+#ifndef SAFELIST_H_
+#define SAFELIST_H_
+
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Mutex.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/Event.h"
+
+#include <list>
+
+namespace MOOS
+{
+
+template<class T>
+class SafeList
+{
+public:
+    SafeList() : _PushEvent(false) {}
+
+    /** add an element to the back of the list and wake any waiters */
+    bool Push(const T & element)
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        _List.push_back(element);
+        _PushEvent.set();
+        return true;
+    }
+
+    /** remove the element at the front of the list */
+    bool Pull(T & element)
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        if(_List.empty())
+            return false;
+        element = _List.front();
+        _List.pop_front();
+        if(_List.empty())
+            _PushEvent.reset();
+        return true;
+    }
+
+    /** throw away the element at the front of the list */
+    bool Pop()
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        if(_List.empty())
+            return false;
+        _List.pop_front();
+        if(_List.empty())
+            _PushEvent.reset();
+        return true;
+    }
+
+    /** copy the element at the front of the list without removing it */
+    bool Peek(T & element)
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        if(_List.empty())
+            return false;
+        element = _List.front();
+        return true;
+    }
+
+    /** copy the most recently pushed element */
+    bool PeekLatest(T & element)
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        if(_List.empty())
+            return false;
+        element = _List.back();
+        return true;
+    }
+
+    /** wait up to TimeoutMS milliseconds for the list to be non-empty */
+    bool WaitForPush(long TimeoutMS = 1000000)
+    {
+        {
+            Poco::FastMutex::ScopedLock Lock(_mutex);
+            if(!_List.empty())
+                return true;
+        }
+        return _PushEvent.tryWait(TimeoutMS);
+    }
+
+    /** move everything in this list onto the back of Other */
+    bool AppendToOther(std::list<T> & Other)
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        Other.splice(Other.end(), _List);
+        _PushEvent.reset();
+        return true;
+    }
+
+    bool IsEmpty()
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        return _List.empty();
+    }
+
+    unsigned int Size()
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        return _List.size();
+    }
+
+    void Clear()
+    {
+        Poco::FastMutex::ScopedLock Lock(_mutex);
+        _List.clear();
+        _PushEvent.reset();
+    }
+
+    void Lock(){ _mutex.lock(); }
+    void UnLock(){ _mutex.unlock(); }
+
+private:
+    Poco::FastMutex _mutex;
+    Poco::Event _PushEvent;
+    std::list<T> _List;
+};
+
+}
+
+#endif /* SAFELIST_H_ */
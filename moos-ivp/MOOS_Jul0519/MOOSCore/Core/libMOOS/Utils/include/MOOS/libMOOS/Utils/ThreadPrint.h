@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//
+//   This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ThreadPrint.h
+ *
+ *  Created on: Sep 19, 2011
+ *      Author: pnewman
+ */
+
+#ifndef THREADPRINT_H_
+#define THREADPRINT_H_
+
+#include <string>
+#include <iostream>
+
+namespace MOOS {
+
+/** thread safe, optionally coloured, printing */
+class ThreadPrint {
+public:
+	enum color_t
+	{
+		RED,
+		YELLOW,
+		GREEN,
+		MAGENTA,
+		CYAN,
+		NONE,
+	};
+
+	ThreadPrint(std::ostream & os);
+	virtual ~ThreadPrint();
+
+	void Print(const std::string & sMessage, const std::string & sPrompt="", color_t color=NONE, bool bAppendNewLine=true);
+	void SimplyPrintTimeAndMessage(const std::string & sMessage,color_t color=NONE);
+	void PrintStatus(bool bStatus,const std::string & sMessage);
+	void Enable();
+	void Disable();
+
+private:
+	class Impl;
+	Impl * _Impl;
+	ThreadPrint(const ThreadPrint &);
+	ThreadPrint & operator=(const ThreadPrint &);
+};
+
+}
+
+#endif /* THREADPRINT_H_ */
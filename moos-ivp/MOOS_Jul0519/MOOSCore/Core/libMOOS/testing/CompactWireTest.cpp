@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * CompactWireTest.cpp
+ *
+ * sends a stream of packets through the original and the compact wire
+ * formats, checks what comes out of the compact one is what went in
+ * and reports the bytes each format needed per message.
+ */
+
+#include "MOOS/libMOOS/Comms/CompactWire.h"
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+void PrintHelpAndExit()
+{
+    std::cerr<<"measures bytes per message with the original and compact wire formats\n\n";
+    std::cerr<<"  --messages=<int>    messages per packet (default 20)\n";
+    std::cerr<<"  --variables=<int>   distinct variable names (default 50)\n";
+    std::cerr<<"  --payload=<int>     size of string payloads in bytes (default 16)\n";
+    std::cerr<<"  --packets=<int>     packets to send (default 10000)\n";
+    exit(0);
+}
+
+bool Same(const CMOOSMsg & A, const CMOOSMsg & B)
+{
+    return A.GetKey()==B.GetKey() &&
+            A.GetSource()==B.GetSource() &&
+            A.GetSourceAux()==B.GetSourceAux() &&
+            A.GetCommunity()==B.GetCommunity() &&
+            A.GetString()==B.GetString() &&
+            A.GetDouble()==B.GetDouble() &&
+            A.GetDoubleAux()==B.GetDoubleAux() &&
+            A.GetTime()==B.GetTime() &&
+            A.GetType()==B.GetType() &&
+            A.m_cDataType==B.m_cDataType &&
+            A.m_nID==B.m_nID;
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintHelpAndExit();
+
+    unsigned int nMessages = 20;
+    P.GetVariable("--messages",nMessages);
+
+    unsigned int nVariables = 50;
+    P.GetVariable("--variables",nVariables);
+
+    unsigned int nPayload = 16;
+    P.GetVariable("--payload",nPayload);
+
+    unsigned int nPackets = 10000;
+    P.GetVariable("--packets",nPackets);
+
+    //each end of the connection has its own dictionary
+    MOOS::WireDictionary TxDictionary,RxDictionary;
+
+    //shared mail keeps its own dictionary as it goes to its own client
+    MOOS::WireDictionary SharedDictionary;
+
+    double dfV1Bytes = 0;
+    double dfV2Bytes = 0;
+    double dfV1Time = 0;
+    double dfV2Time = 0;
+    int nID = 0;
+
+    for(unsigned int n = 0;n<nPackets;n++)
+    {
+        //mostly doubles with the odd string - like a typical vehicle
+        MOOSMSG_LIST Out;
+        for(unsigned int i = 0;i<nMessages;i++)
+        {
+            unsigned int nVar = (n*nMessages+i)%nVariables;
+            std::string sKey = MOOSFormat("VARIABLE_%d",nVar);
+            if(nVar%4==0)
+                Out.push_back(CMOOSMsg(MOOS_NOTIFY,sKey,std::string(nPayload,'x')));
+            else
+                Out.push_back(CMOOSMsg(MOOS_NOTIFY,sKey,n*1.5+i));
+
+            Out.back().m_nID = nID++;
+            Out.back().m_sSrc = MOOSFormat("pApp%d",nVar%5);
+            Out.back().m_sSrcAux = "aux";
+            Out.back().m_sOriginatingCommunity = "alpha";
+        }
+
+        //the odd message which is not a notification
+        if(n%10==0)
+            Out.push_front(CMOOSMsg(MOOS_TIMING,"_async_timing",0.0,MOOSLocalTime()));
+
+        double dfStart = MOOS::Time();
+        CMOOSCommPkt V1;
+        V1.Serialize(Out,true);
+        MOOSMSG_LIST In1;
+        V1.Serialize(In1,false);
+        dfV1Time+=MOOS::Time()-dfStart;
+        dfV1Bytes+=V1.GetStreamLength();
+
+        dfStart = MOOS::Time();
+        CMOOSCommPkt V2;
+        V2.SerializeCompact(Out,true,TxDictionary);
+        if(!V2.IsCompact())
+        {
+            std::cerr<<"FAIL: packet "<<n<<" is not flagged as compact\n";
+            return -1;
+        }
+
+        MOOSMSG_LIST In2;
+        if(!V2.SerializeCompact(In2,false,RxDictionary))
+        {
+            std::cerr<<"FAIL: packet "<<n<<" could not be decoded\n";
+            return -1;
+        }
+        dfV2Time+=MOOS::Time()-dfStart;
+        dfV2Bytes+=V2.GetStreamLength();
+
+        //shared mail uses the parts encoded at publication but must
+        //put exactly the same bytes on the wire
+        MOOS::SHARED_MSG_LIST Shared;
+        for(MOOSMSG_LIST::iterator s = Out.begin();s!=Out.end();++s)
+            Shared.push_back(MOOS::SharedMsg(*s));
+
+        CMOOSCommPkt V3;
+        V3.SerializeCompact(Shared,SharedDictionary);
+        if(V3.GetStreamLength()!=V2.GetStreamLength() ||
+                memcmp(V3.Stream(),V2.Stream(),V2.GetStreamLength())!=0)
+        {
+            std::cerr<<"FAIL: packet "<<n<<" differs when made from shared mail\n";
+            return -1;
+        }
+
+        if(In2.size()!=Out.size())
+        {
+            std::cerr<<"FAIL: sent "<<Out.size()<<" messages but received "<<In2.size()<<"\n";
+            return -1;
+        }
+
+        MOOSMSG_LIST::iterator p,q;
+        for(p = Out.begin(),q = In2.begin();p!=Out.end();++p,++q)
+        {
+            if(!Same(*p,*q))
+            {
+                std::cerr<<"FAIL: "<<p->GetKey()<<" in packet "<<n<<" was changed in transit\n";
+                return -1;
+            }
+        }
+    }
+
+    if(TxDictionary.Size()!=RxDictionary.Size())
+    {
+        std::cerr<<"FAIL: dictionaries disagree\n";
+        return -1;
+    }
+
+    double dfTotal = double(nPackets)*nMessages;
+    std::cout<<std::left<<std::setw(16)<<"format"<<std::setw(16)<<"bytes/msg"<<std::setw(16)<<"msgs/s"<<"\n";
+    std::cout<<std::left<<std::setw(16)<<"original"<<std::setw(16)<<std::fixed<<std::setprecision(1)<<dfV1Bytes/dfTotal
+            <<std::setw(16)<<std::setprecision(0)<<dfTotal/dfV1Time<<"\n";
+    std::cout<<std::left<<std::setw(16)<<"compact"<<std::setw(16)<<std::setprecision(1)<<dfV2Bytes/dfTotal
+            <<std::setw(16)<<std::setprecision(0)<<dfTotal/dfV2Time<<"\n";
+    std::cout<<"compact wire uses "<<std::setprecision(1)<<100.0*dfV2Bytes/dfV1Bytes<<"% of the bandwidth\n";
+
+    std::cout<<"PASS\n";
+    return 0;
+}
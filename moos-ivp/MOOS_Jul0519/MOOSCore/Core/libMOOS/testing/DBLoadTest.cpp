@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * DBLoadTest.cpp
+ *
+ * a load generator for the MOOSDB. A number of publishing clients hammer
+ * the DB with notifications of distinct variables while a set of
+ * subscribers count what they receive. Run it against
+ *
+ *    MOOSDB --db_threads=N
+ *
+ * for increasing N to see how publish throughput scales with cores.
+ * Each publisher posts increasing values whatever the variable so the
+ * subscribers also check that the DB delivers every publisher's mail in
+ * the order it was posted, however many threads it uses.
+ */
+
+#include "MOOS/libMOOS/Comms/MOOSAsyncCommClient.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/ConsoleColours.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+
+void PrintHelpAndExit()
+{
+    std::cerr<<"MOOSDB load generator\n\n";
+    std::cerr<<"  --moos_host=<string>      DB host (default localhost)\n";
+    std::cerr<<"  --moos_port=<int>         DB port (default 9000)\n";
+    std::cerr<<"  --publishers=<int>        number of publishing clients (default 8)\n";
+    std::cerr<<"  --subscribers=<int>       number of subscribing clients (default 4)\n";
+    std::cerr<<"  --vars=<int>              variables per publisher (default 16)\n";
+    std::cerr<<"  --burst=<int>             posts per variable per millisecond (default 1)\n";
+    std::cerr<<"  --duration=<float>        seconds to run for (default 10)\n";
+    exit(0);
+}
+
+struct Subscriber
+{
+    MOOS::MOOSAsyncCommClient Comms;
+    unsigned int nReceived;
+    unsigned int nOutOfOrder;
+    std::map<std::string,double> LastValue;
+};
+
+bool OnSubscriberConnect(void * pParam)
+{
+    CMOOSCommClient* pC = static_cast<CMOOSCommClient*> (pParam);
+    return pC->Register("LOAD_*","*",0.0);
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintHelpAndExit();
+
+    std::string sHost = "localhost";
+    P.GetVariable("--moos_host",sHost);
+
+    int nPort = 9000;
+    P.GetVariable("--moos_port",nPort);
+
+    unsigned int nPublishers = 8;
+    P.GetVariable("--publishers",nPublishers);
+
+    unsigned int nSubscribers = 4;
+    P.GetVariable("--subscribers",nSubscribers);
+
+    unsigned int nVars = 16;
+    P.GetVariable("--vars",nVars);
+
+    unsigned int nBurst = 1;
+    P.GetVariable("--burst",nBurst);
+
+    double dfDuration = 10.0;
+    P.GetVariable("--duration",dfDuration);
+
+    std::vector<Subscriber*> Subscribers;
+    for(unsigned int i = 0;i<nSubscribers;i++)
+    {
+        Subscriber* pS = new Subscriber;
+        pS->nReceived = 0;
+        pS->nOutOfOrder = 0;
+        pS->Comms.SetQuiet(true);
+        pS->Comms.SetOnConnectCallBack(OnSubscriberConnect,&pS->Comms);
+        pS->Comms.Run(sHost,nPort,MOOSFormat("load_sub_%d",i));
+        Subscribers.push_back(pS);
+    }
+
+    std::vector<MOOS::MOOSAsyncCommClient*> Publishers;
+    std::vector<std::vector<std::string> > VarNames(nPublishers);
+    for(unsigned int i = 0;i<nPublishers;i++)
+    {
+        MOOS::MOOSAsyncCommClient* pC = new MOOS::MOOSAsyncCommClient;
+        pC->SetQuiet(true);
+        pC->Run(sHost,nPort,MOOSFormat("load_pub_%d",i));
+        Publishers.push_back(pC);
+
+        for(unsigned int j = 0;j<nVars;j++)
+            VarNames[i].push_back(MOOSFormat("LOAD_%d_%d",i,j));
+    }
+
+    //let everyone connect and register
+    MOOSPause(2000);
+
+    std::cout<<std::left<<std::setw(10)<<"time"
+            <<std::setw(16)<<"published/s"
+            <<std::setw(16)<<"delivered/s"<<"\n";
+
+    double dfStart = MOOS::Time();
+    double dfLastReport = dfStart;
+    unsigned int nPublished = 0;
+    unsigned int nLastPublished = 0;
+    unsigned int nLastDelivered = 0;
+    double dfValue = 0;
+
+    while(MOOS::Time()-dfStart<dfDuration)
+    {
+        for(unsigned int b = 0;b<nBurst;b++)
+        {
+            for(unsigned int i = 0;i<nPublishers;i++)
+            {
+                for(unsigned int j = 0;j<nVars;j++)
+                {
+                    Publishers[i]->Notify(VarNames[i][j],dfValue++);
+                    nPublished++;
+                }
+            }
+        }
+
+        unsigned int nDelivered = 0;
+        for(unsigned int i = 0;i<nSubscribers;i++)
+        {
+            MOOSMSG_LIST Mail;
+            Subscribers[i]->Comms.Fetch(Mail);
+            Subscribers[i]->nReceived+=Mail.size();
+
+            MOOSMSG_LIST::iterator m;
+            for(m = Mail.begin();m!=Mail.end();++m)
+            {
+                std::map<std::string,double>::iterator v = Subscribers[i]->LastValue.find(m->GetSource());
+                if(v!=Subscribers[i]->LastValue.end() && m->GetDouble()<=v->second)
+                    Subscribers[i]->nOutOfOrder++;
+                Subscribers[i]->LastValue[m->GetSource()] = m->GetDouble();
+            }
+            nDelivered+=Subscribers[i]->nReceived;
+        }
+
+        double dfNow = MOOS::Time();
+        if(dfNow-dfLastReport>=1.0)
+        {
+            double dfDT = dfNow-dfLastReport;
+            std::cout<<std::left<<std::setw(10)<<std::fixed<<std::setprecision(1)<<dfNow-dfStart
+                    <<std::setw(16)<<std::setprecision(0)<<(nPublished-nLastPublished)/dfDT
+                    <<std::setw(16)<<(nDelivered-nLastDelivered)/dfDT<<"\n";
+
+            nLastPublished = nPublished;
+            nLastDelivered = nDelivered;
+            dfLastReport = dfNow;
+        }
+
+        MOOSPause(1);
+    }
+
+    unsigned int nTotalDelivered = 0;
+    unsigned int nOutOfOrder = 0;
+    for(unsigned int i = 0;i<nSubscribers;i++)
+    {
+        nTotalDelivered+=Subscribers[i]->nReceived;
+        nOutOfOrder+=Subscribers[i]->nOutOfOrder;
+    }
+
+    double dfElapsed = MOOS::Time()-dfStart;
+    std::cout<<MOOS::ConsoleColours::Green();
+    std::cout<<"published "<<nPublished<<" ("<<nPublished/dfElapsed<<"/s) ";
+    std::cout<<"delivered "<<nTotalDelivered<<" ("<<nTotalDelivered/dfElapsed<<"/s)\n";
+    std::cout<<MOOS::ConsoleColours::reset();
+
+    if(nOutOfOrder>0)
+    {
+        std::cout<<MOOS::ConsoleColours::Red();
+        std::cout<<"FAIL: "<<nOutOfOrder<<" notifications arrived out of the order they were posted\n";
+        std::cout<<MOOS::ConsoleColours::reset();
+    }
+
+    for(unsigned int i = 0;i<nPublishers;i++)
+    {
+        Publishers[i]->Close();
+        delete Publishers[i];
+    }
+    for(unsigned int i = 0;i<nSubscribers;i++)
+    {
+        Subscribers[i]->Comms.Close();
+        delete Subscribers[i];
+    }
+
+    return nOutOfOrder>0 ? -1 : 0;
+}
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * DBWireTest.cpp
+ *
+ * runs a MOOSDB in this process and connects two asynchronous clients to
+ * it, both of which ask for the compact wire format. A single threaded DB
+ * (-s) must refuse it and a threaded DB must agree to it. Either way the
+ * mail one client publishes must reach the other unchanged.
+ */
+
+#include "MOOS/libMOOS/DB/MOOSDB.h"
+#include "MOOS/libMOOS/Comms/MOOSAsyncCommClient.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+void PrintUsageAndExit()
+{
+    std::cerr<<"checks which wire format asynchronous clients get from a MOOSDB\n\n";
+    std::cerr<<"  --moos_port=<int>    first port to run a DB on (default 9700)\n";
+    std::cerr<<"  --messages=<int>     messages to send through each DB (default 200)\n";
+    exit(0);
+}
+
+/** start a DB on nPort, connect a publisher and a subscriber to it and
+check the wire format they end up talking and the mail they exchange */
+bool TestDB(int nPort, bool bSingleThreaded, int nMessages)
+{
+    std::string sMode = bSingleThreaded ? "single threaded" : "threaded";
+
+    std::vector<std::string> Args;
+    Args.push_back("MOOSDB");
+    Args.push_back(MOOSFormat("--moos_port=%d",nPort));
+    Args.push_back(MOOSFormat("--moos_community=wire_test_%d",nPort));
+    if(bSingleThreaded)
+        Args.push_back("-s");
+
+    std::vector<char*> argv;
+    for(unsigned int i = 0;i<Args.size();i++)
+        argv.push_back(const_cast<char*>(Args[i].c_str()));
+
+    //the DB runs on threads of its own and lives until the process ends
+    CMOOSDB * pDB = new CMOOSDB;
+    pDB->SetQuiet(true);
+    if(!pDB->Run(static_cast<int>(argv.size()),&argv[0]))
+    {
+        std::cerr<<"FAIL: could not start a "<<sMode<<" DB\n";
+        return false;
+    }
+
+    MOOS::MOOSAsyncCommClient Publisher;
+    MOOS::MOOSAsyncCommClient Subscriber;
+    Publisher.SetQuiet(true);
+    Subscriber.SetQuiet(true);
+    Publisher.Run("localhost",nPort,"wire_pub");
+    Subscriber.Run("localhost",nPort,"wire_sub");
+
+    if(!Publisher.WaitUntilConnected(5000) || !Subscriber.WaitUntilConnected(5000))
+    {
+        std::cerr<<"FAIL: clients did not connect to the "<<sMode<<" DB\n";
+        return false;
+    }
+
+    if(Publisher.IsCompactWire()==bSingleThreaded ||
+            Subscriber.IsCompactWire()==bSingleThreaded)
+    {
+        std::cerr<<"FAIL: clients of the "<<sMode<<" DB "
+                <<(bSingleThreaded ? "talk" : "do not talk")<<" the compact wire format\n";
+        return false;
+    }
+
+    Subscriber.Register("WIRE_STRING",0.0);
+    Subscriber.Register("WIRE_DOUBLE",0.0);
+    MOOSPause(500);
+
+    for(int i = 0;i<nMessages;i++)
+    {
+        Publisher.Notify("WIRE_STRING",MOOSFormat("value_%d",i));
+        Publisher.Notify("WIRE_DOUBLE",static_cast<double>(i));
+    }
+
+    int nStrings = 0;
+    int nDoubles = 0;
+    double dfStart = MOOS::Time();
+    while((nStrings<nMessages || nDoubles<nMessages) && MOOS::Time()-dfStart<10.0)
+    {
+        MOOSMSG_LIST Mail;
+        Subscriber.Fetch(Mail);
+        MOOSMSG_LIST::iterator q;
+        for(q = Mail.begin();q!=Mail.end();++q)
+        {
+            if(q->GetKey()=="WIRE_STRING")
+            {
+                if(q->GetString()!=MOOSFormat("value_%d",nStrings))
+                {
+                    std::cerr<<"FAIL: "<<sMode<<" DB delivered \""<<q->GetString()
+                            <<"\" when \"value_"<<nStrings<<"\" was due\n";
+                    return false;
+                }
+                nStrings++;
+            }
+            else if(q->GetKey()=="WIRE_DOUBLE")
+            {
+                if(q->GetDouble()!=nDoubles)
+                {
+                    std::cerr<<"FAIL: "<<sMode<<" DB delivered "<<q->GetDouble()
+                            <<" when "<<nDoubles<<" was due\n";
+                    return false;
+                }
+                nDoubles++;
+            }
+        }
+        MOOSPause(10);
+    }
+
+    if(nStrings!=nMessages || nDoubles!=nMessages)
+    {
+        std::cerr<<"FAIL: "<<sMode<<" DB delivered "<<nStrings<<" strings and "
+                <<nDoubles<<" doubles of "<<nMessages<<"\n";
+        return false;
+    }
+
+    std::cout<<sMode<<" DB: compact wire "<<(Subscriber.IsCompactWire() ? "on" : "off")
+            <<", "<<nMessages<<" strings and doubles delivered\n";
+
+    Publisher.Close();
+    Subscriber.Close();
+    return true;
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintUsageAndExit();
+
+    int nPort = 9700;
+    int nMessages = 200;
+    P.GetVariable("--moos_port",nPort);
+    P.GetVariable("--messages",nMessages);
+
+    if(!TestDB(nPort,true,nMessages))
+        return -1;
+
+    if(!TestDB(nPort+1,false,nMessages))
+        return -1;
+
+    std::cout<<"PASS\n";
+    return 0;
+}
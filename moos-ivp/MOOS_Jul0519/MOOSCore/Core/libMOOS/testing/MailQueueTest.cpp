@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MailQueueTest.cpp
+ *
+ * hands mail from one thread to another through the locked list the
+ * async client used to use (MOOS::SafeList) and through the lock free
+ * MOOS::SPSCQueue, and prints percentiles of the time each message
+ * spent in the queue. A third thread can be made to hammer the lock to
+ * mimic an application thread fetching mail.
+ */
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Utils/SPSCQueue.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+void PrintHelpAndExit()
+{
+    std::cerr<<"compares latency through a locked list and a lock free queue\n\n";
+    std::cerr<<"  --messages=<int>    messages to send (default 50000)\n";
+    std::cerr<<"  --rate=<float>      messages per second, 0 for flat out (default 5000)\n";
+    std::cerr<<"  --contend           run a thread which keeps taking the lock\n";
+    exit(0);
+}
+
+/** the two queues being compared, behind the same interface */
+class LockedQueue
+{
+public:
+    bool Push(const CMOOSMsg & M)
+    {
+        queue_.Push(M);
+        return true;
+    }
+    bool Pop(CMOOSMsg & M)
+    {
+        if(queue_.IsEmpty())
+            return false;
+        queue_.Pull(M);
+        return true;
+    }
+    bool WaitForPush(unsigned int nMS)
+    {
+        return !queue_.IsEmpty() || queue_.WaitForPush(nMS);
+    }
+private:
+    MOOS::SafeList<CMOOSMsg> queue_;
+};
+
+class LockFreeQueue
+{
+public:
+    LockFreeQueue() : queue_(1024) {}
+    bool Push(const CMOOSMsg & M)
+    {
+        return queue_.Push(M);
+    }
+    bool Pop(CMOOSMsg & M)
+    {
+        return queue_.Pop(M);
+    }
+    bool WaitForPush(unsigned int nMS)
+    {
+        return queue_.WaitForPush(nMS);
+    }
+private:
+    MOOS::SPSCQueue<CMOOSMsg> queue_;
+};
+
+template<class Q>
+struct Producer
+{
+    Q * queue_;
+    unsigned int messages_;
+    double rate_;
+    CMOOSThread thread_;
+
+    bool Work()
+    {
+        double dfPeriod = rate_>0 ? 1.0/rate_ : 0.0;
+        double dfNext = MOOSLocalTime();
+        for(unsigned int n = 0;n<messages_;n++)
+        {
+            //a sensor does not sleep politely - spin until the next sample is due
+            while(dfPeriod>0 && MOOSLocalTime()<dfNext)
+                ;
+            dfNext+=dfPeriod;
+
+            CMOOSMsg M(MOOS_NOTIFY,"SENSOR",n*1.0,MOOSLocalTime());
+            while(!queue_->Push(M))
+                M.m_dfTime = MOOSLocalTime();
+        }
+        return true;
+    }
+};
+
+template<class Q> bool ProducerDispatch(void * pParam)
+{
+    return static_cast<Producer<Q>*>(pParam)->Work();
+}
+
+/** an application thread taking the client's lock over and over */
+struct Contender
+{
+    CMOOSLock * lock_;
+    CMOOSThread thread_;
+
+    bool Work()
+    {
+        while(!thread_.IsQuitRequested())
+        {
+            lock_->Lock();
+            MOOSPause(1,false);
+            lock_->UnLock();
+        }
+        return true;
+    }
+};
+
+bool ContenderDispatch(void * pParam)
+{
+    return static_cast<Contender*>(pParam)->Work();
+}
+
+template<class Q>
+std::vector<double> Measure(unsigned int nMessages, double dfRate, CMOOSLock * pContendedLock)
+{
+    Q Queue;
+    Producer<Q> P;
+    P.queue_ = &Queue;
+    P.messages_ = nMessages;
+    P.rate_ = dfRate;
+    P.thread_.Initialise(ProducerDispatch<Q>,&P);
+
+    std::vector<double> Latencies;
+    Latencies.reserve(nMessages);
+
+    P.thread_.Start();
+    while(Latencies.size()<nMessages)
+    {
+        if(!Queue.WaitForPush(100))
+            continue;
+
+        //the old reading path took the inbox lock for every packet
+        if(pContendedLock)
+            pContendedLock->Lock();
+
+        CMOOSMsg M;
+        while(Queue.Pop(M))
+            Latencies.push_back(MOOSLocalTime()-M.GetTime());
+
+        if(pContendedLock)
+            pContendedLock->UnLock();
+    }
+    P.thread_.Stop();
+
+    std::sort(Latencies.begin(),Latencies.end());
+    return Latencies;
+}
+
+void Report(const std::string & sName, const std::vector<double> & L)
+{
+    double p[] = {0.5,0.9,0.99,0.999};
+    std::cout<<std::left<<std::setw(12)<<sName;
+    for(unsigned int i = 0;i<sizeof(p)/sizeof(p[0]);i++)
+        std::cout<<std::setw(12)<<std::fixed<<std::setprecision(1)<<1e6*L[(unsigned int)(p[i]*(L.size()-1))];
+    std::cout<<std::setw(12)<<1e6*L.back()<<"\n";
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintHelpAndExit();
+
+    unsigned int nMessages = 50000;
+    P.GetVariable("--messages",nMessages);
+
+    double dfRate = 5000;
+    P.GetVariable("--rate",dfRate);
+
+    CMOOSLock Lock;
+    Contender C;
+    C.lock_ = &Lock;
+    bool bContend = P.GetFlag("--contend");
+    if(bContend)
+    {
+        C.thread_.Initialise(ContenderDispatch,&C);
+        C.thread_.Start();
+    }
+
+    //only the locked list shares its lock with the application
+    std::vector<double> Locked = Measure<LockedQueue>(nMessages,dfRate,bContend ? &Lock : NULL);
+    std::vector<double> LockFree = Measure<LockFreeQueue>(nMessages,dfRate,NULL);
+
+    if(bContend)
+        C.thread_.Stop();
+
+    if(Locked.size()!=nMessages || LockFree.size()!=nMessages)
+    {
+        std::cerr<<"FAIL: messages were lost\n";
+        return -1;
+    }
+
+    std::cout<<"latency in us\n";
+    std::cout<<std::left<<std::setw(12)<<"queue"<<std::setw(12)<<"p50"<<std::setw(12)<<"p90"
+            <<std::setw(12)<<"p99"<<std::setw(12)<<"p99.9"<<std::setw(12)<<"max"<<"\n";
+    Report("SafeList",Locked);
+    Report("SPSCQueue",LockFree);
+
+    std::cout<<"PASS\n";
+    return 0;
+}
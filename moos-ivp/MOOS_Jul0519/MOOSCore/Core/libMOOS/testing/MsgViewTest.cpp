@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * MsgViewTest.cpp
+ *
+ * measures how many messages per second can be decoded from a packet
+ * into CMOOSMsgs (CMOOSCommPkt::Serialize(List,false)) and into views
+ * (CMOOSCommPkt::ViewMessages) and checks the two agree.
+ */
+
+#include "MOOS/libMOOS/Comms/MsgView.h"
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <iomanip>
+
+void PrintHelpAndExit()
+{
+    std::cerr<<"measures messages decoded per second with and without views\n\n";
+    std::cerr<<"  --messages=<int>    messages per packet (default 100)\n";
+    std::cerr<<"  --payload=<int>     size of string payloads in bytes (default 64)\n";
+    std::cerr<<"  --packets=<int>     packets to decode (default 20000)\n";
+    exit(0);
+}
+
+bool Same(const MOOS::MsgView & V, const CMOOSMsg & M)
+{
+    CMOOSMsg C;
+    V.ToMsg(C);
+    return C.GetKey()==M.GetKey() &&
+            C.GetSource()==M.GetSource() &&
+            C.GetSourceAux()==M.GetSourceAux() &&
+            C.GetCommunity()==M.GetCommunity() &&
+            C.GetString()==M.GetString() &&
+            C.GetDouble()==M.GetDouble() &&
+            C.GetTime()==M.GetTime() &&
+            C.GetType()==M.GetType() &&
+            V.GetKey()==M.GetKey();
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintHelpAndExit();
+
+    unsigned int nMessages = 100;
+    P.GetVariable("--messages",nMessages);
+
+    unsigned int nPayload = 64;
+    P.GetVariable("--payload",nPayload);
+
+    unsigned int nPackets = 20000;
+    P.GetVariable("--packets",nPackets);
+
+    //half doubles, half strings - like a typical vehicle
+    MOOSMSG_LIST Out;
+    for(unsigned int i = 0;i<nMessages;i++)
+    {
+        std::string sKey = MOOSFormat("VARIABLE_%d",i);
+        if(i%2)
+            Out.push_back(CMOOSMsg(MOOS_NOTIFY,sKey,std::string(nPayload,'x')));
+        else
+            Out.push_back(CMOOSMsg(MOOS_NOTIFY,sKey,i*1.5));
+
+        Out.back().m_sSrc = "pNodeReporter";
+        Out.back().m_sSrcAux = "aux";
+        Out.back().m_sOriginatingCommunity = "alpha";
+    }
+
+    CMOOSCommPkt Pkt;
+    Pkt.Serialize(Out,true);
+
+    //first check views and messages agree
+    MOOSMSG_LIST In;
+    Pkt.Serialize(In,false);
+    MOOS::MSG_VIEW_VECTOR Views;
+    Pkt.ViewMessages(Views);
+
+    if(In.size()!=Views.size())
+    {
+        std::cerr<<"FAIL: decoded "<<In.size()<<" messages but "<<Views.size()<<" views\n";
+        return -1;
+    }
+
+    MOOSMSG_LIST::iterator q = In.begin();
+    for(unsigned int i = 0;i<Views.size();i++,++q)
+    {
+        if(!Same(Views[i],*q))
+        {
+            std::cerr<<"FAIL: view "<<i<<" differs from decoded message\n";
+            return -1;
+        }
+    }
+
+    //now time them
+    double dfStart = MOOS::Time();
+    for(unsigned int n = 0;n<nPackets;n++)
+    {
+        MOOSMSG_LIST L;
+        Pkt.Serialize(L,false);
+    }
+    double dfMsgs = MOOS::Time()-dfStart;
+
+    dfStart = MOOS::Time();
+    for(unsigned int n = 0;n<nPackets;n++)
+    {
+        Views.clear();
+        Pkt.ViewMessages(Views);
+    }
+    double dfViews = MOOS::Time()-dfStart;
+
+    double dfTotal = double(nPackets)*nMessages;
+    std::cout<<std::left<<std::setw(16)<<"decode"<<std::setw(16)<<"msgs/s"<<"\n";
+    std::cout<<std::left<<std::setw(16)<<"CMOOSMsg"<<std::setw(16)<<std::fixed<<std::setprecision(0)<<dfTotal/dfMsgs<<"\n";
+    std::cout<<std::left<<std::setw(16)<<"MsgView"<<std::setw(16)<<dfTotal/dfViews<<"\n";
+
+    std::cout<<"PASS\n";
+    return 0;
+}
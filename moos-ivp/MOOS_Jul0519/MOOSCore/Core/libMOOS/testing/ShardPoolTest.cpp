@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * ShardPoolTest.cpp
+ *
+ * exercises MOOS::DBShardPool on its own. Runs of notifications of many
+ * variables are handed to the pool and each worker copies every notification
+ * into a number of mailboxes, as the DB does for subscribers, with some
+ * variables much busier than others so the shards fall out of step. It
+ * checks that what the workers make comes back in the order the
+ * notifications were handed over and reports throughput against the number
+ * of threads, both handing runs over without waiting and waiting for each
+ * run to finish before the next (fork/join).
+ */
+
+#include "MOOS/libMOOS/DB/DBShardPool.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+void PrintHelpAndExit()
+{
+    std::cerr<<"tests ordering and measures throughput of the DB's shard pool\n\n";
+    std::cerr<<"  --messages=<int>     notifications per measurement (default 200000)\n";
+    std::cerr<<"  --vars=<int>         distinct variables (default 64)\n";
+    std::cerr<<"  --run=<int>          notifications handed over at a time (default 8)\n";
+    std::cerr<<"  --subscribers=<int>  copies made of each notification (default 4)\n";
+    std::cerr<<"  --max_threads=<int>  largest pool to try (default 8)\n";
+    exit(0);
+}
+
+/** the copies made of one notification and where it came in the order */
+class Copies : public MOOS::DBShardPool::Result
+{
+public:
+    int m_nIndex;
+    MOOSMSG_LIST m_Copies;
+};
+
+/** every seventh notification makes nothing, as for variables nobody
+subscribes to. Every fourth variable has eight times the subscribers */
+MOOS::DBShardPool::Result * CopyToSubscribers(unsigned int nShard, CMOOSMsg & Msg, void * pParam)
+{
+    MOOS::DeliberatelyNotUsed(nShard);
+
+    if(Msg.m_nID%7==3)
+        return NULL;
+
+    unsigned int nSubscribers = *static_cast<unsigned int*>(pParam);
+    if(static_cast<int>(Msg.GetDouble())%4==0)
+        nSubscribers*=8;
+
+    Copies * pCopies = new Copies;
+    pCopies->m_nIndex = Msg.m_nID;
+    for(unsigned int i = 0;i<nSubscribers;i++)
+        pCopies->m_Copies.push_back(Msg);
+    return pCopies;
+}
+
+/** hand back what the pool has finished, checking it is in order */
+bool CollectInOrder(MOOS::DBShardPool & Pool,int & nLastIndex,unsigned int & nCollected)
+{
+    std::list<MOOS::DBShardPool::Result*> Results;
+    Pool.Collect(Results);
+
+    bool bInOrder = true;
+    std::list<MOOS::DBShardPool::Result*>::iterator r;
+    for(r = Results.begin();r!=Results.end();++r)
+    {
+        Copies * pCopies = static_cast<Copies*>(*r);
+        if(pCopies->m_nIndex<=nLastIndex)
+            bInOrder = false;
+        nLastIndex = pCopies->m_nIndex;
+        nCollected++;
+        delete pCopies;
+    }
+    return bInOrder;
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintHelpAndExit();
+
+    unsigned int nMessages = 200000;
+    P.GetVariable("--messages",nMessages);
+
+    unsigned int nVars = 64;
+    P.GetVariable("--vars",nVars);
+
+    unsigned int nRun = 8;
+    P.GetVariable("--run",nRun);
+    if(nRun==0)
+        nRun = 1;
+
+    unsigned int nSubscribers = 4;
+    P.GetVariable("--subscribers",nSubscribers);
+
+    unsigned int nMaxThreads = 8;
+    P.GetVariable("--max_threads",nMaxThreads);
+
+    std::vector<std::string> Names;
+    for(unsigned int v = 0;v<nVars;v++)
+        Names.push_back(MOOSFormat("VARIABLE_%d",v));
+
+    unsigned int nExpected = 0;
+    for(unsigned int n = 0;n<nMessages;n++)
+    {
+        if(n%7!=3)
+            nExpected++;
+    }
+
+    std::cout<<std::left<<std::setw(10)<<"threads"
+            <<std::setw(16)<<"async msgs/s"
+            <<std::setw(16)<<"join msgs/s"<<"\n";
+
+    for(unsigned int nThreads = 1;nThreads<=nMaxThreads;nThreads++)
+    {
+        double Rates[2];
+        for(unsigned int bJoin = 0;bJoin<2;bJoin++)
+        {
+            //made before the clock starts as the DB gets them ready made
+            std::vector<MOOSMSG_LIST> Runs((nMessages+nRun-1)/nRun);
+            for(unsigned int n = 0;n<nMessages;n++)
+            {
+                unsigned int nVar = (n*2654435761u)%nVars;
+                CMOOSMsg Msg(MOOS_NOTIFY,Names[nVar],static_cast<double>(nVar));
+                Msg.m_nID = n;
+                Runs[n/nRun].push_back(Msg);
+            }
+
+            MOOS::DBShardPool Pool;
+            if(!Pool.Start(nThreads,CopyToSubscribers,&nSubscribers))
+            {
+                std::cerr<<"FAIL: could not start "<<nThreads<<" workers\n";
+                return -1;
+            }
+
+            int nLastIndex = -1;
+            unsigned int nCollected = 0;
+            bool bInOrder = true;
+
+            double dfStart = MOOS::Time();
+            for(unsigned int r = 0;r<Runs.size();r++)
+            {
+                Pool.Dispatch(Runs[r]);
+                if(bJoin)
+                    Pool.Drain();
+
+                //as the DB does each time it replies to a client
+                bInOrder = CollectInOrder(Pool,nLastIndex,nCollected) && bInOrder;
+            }
+            Pool.Drain();
+            bInOrder = CollectInOrder(Pool,nLastIndex,nCollected) && bInOrder;
+            Rates[bJoin] = nMessages/(MOOS::Time()-dfStart);
+
+            Pool.Stop();
+
+            if(!bInOrder)
+            {
+                std::cerr<<"FAIL: results from "<<nThreads<<" workers came back out of order\n";
+                return -1;
+            }
+            if(nCollected!=nExpected)
+            {
+                std::cerr<<"FAIL: expected "<<nExpected<<" results from "<<nThreads<<" workers but got "<<nCollected<<"\n";
+                return -1;
+            }
+        }
+
+        std::cout<<std::left<<std::setw(10)<<nThreads
+                <<std::setw(16)<<std::fixed<<std::setprecision(0)<<Rates[0]
+                <<std::setw(16)<<Rates[1]<<"\n";
+    }
+
+    std::cout<<"PASS\n";
+    return 0;
+}
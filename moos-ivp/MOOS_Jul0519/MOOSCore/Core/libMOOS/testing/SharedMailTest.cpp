@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * SharedMailTest.cpp
+ *
+ * measures what it costs to get one publication to many clients, from the
+ * fan out into their mailboxes to the packets made when each box is emptied.
+ * The classic DB gives each mailbox its own CMOOSMsg and serialises it per
+ * client. With --shared_mail each mailbox holds a MOOS::SharedMsg handle and
+ * packets, original or compact, are made from the bytes encoded when the
+ * message was published. Every allocation the program makes is counted.
+ */
+
+#include "MOOS/libMOOS/Comms/SharedMsg.h"
+#include "MOOS/libMOOS/Comms/CompactWire.h"
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <new>
+
+//counted by the replacement operator new below (one thread only)
+static unsigned long g_nAllocs = 0;
+static unsigned long g_nAllocBytes = 0;
+
+void * operator new(size_t nBytes)
+{
+    g_nAllocs++;
+    g_nAllocBytes+=nBytes;
+    void * p = malloc(nBytes ? nBytes : 1);
+    if(p==NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void * p) throw()
+{
+    free(p);
+}
+
+void PrintHelpAndExit()
+{
+    std::cerr<<"measures allocations, bytes allocated and time per publish against number of subscribers\n\n";
+    std::cerr<<"  --payload=<int>     size of the published string in bytes (default 1024)\n";
+    std::cerr<<"  --publishes=<int>   publications per subscriber count (default 2000)\n";
+    std::cerr<<"  --binary            publish as binary data\n";
+    std::cerr<<"  --batch=<int>       publications per outgoing packet (default 10)\n";
+    exit(0);
+}
+
+enum Mode
+{
+    COPY,
+    SHARED,
+    SHARED_COMPACT
+};
+
+const char * ModeName(Mode eMode)
+{
+    switch(eMode)
+    {
+    case COPY: return "copy";
+    case SHARED: return "shared";
+    default: return "compact";
+    }
+}
+
+/** publish M nPublishes times to nSubs clients, emptying every box into a
+packet each nBatch publications. Returns the packet bytes made */
+unsigned long Deliver(Mode eMode,const CMOOSMsg & M,unsigned int nSubs,
+        unsigned int nPublishes,unsigned int nBatch)
+{
+    std::vector<MOOSMSG_LIST> Boxes(nSubs);
+    std::vector<MOOS::SHARED_MSG_LIST> SharedBoxes(nSubs);
+    std::vector<MOOS::WireDictionary> Dictionaries(nSubs);
+    unsigned long nPktBytes = 0;
+
+    for(unsigned int n = 1;n<=nPublishes;n++)
+    {
+        if(eMode==COPY)
+        {
+            for(unsigned int c = 0;c<nSubs;c++)
+                Boxes[c].push_back(M);
+        }
+        else
+        {
+            MOOS::SharedMsg S(M);
+            for(unsigned int c = 0;c<nSubs;c++)
+                SharedBoxes[c].push_back(S);
+        }
+
+        if(n%nBatch!=0 && n!=nPublishes)
+            continue;
+
+        //every client fetches its mail
+        for(unsigned int c = 0;c<nSubs;c++)
+        {
+            CMOOSCommPkt Pkt;
+            switch(eMode)
+            {
+            case COPY:
+                Pkt.Serialize(Boxes[c],true);
+                Boxes[c].clear();
+                break;
+            case SHARED:
+                Pkt.Serialize(SharedBoxes[c]);
+                SharedBoxes[c].clear();
+                break;
+            case SHARED_COMPACT:
+                Pkt.SerializeCompact(SharedBoxes[c],Dictionaries[c]);
+                SharedBoxes[c].clear();
+                break;
+            }
+            nPktBytes+=Pkt.GetStreamLength();
+        }
+    }
+
+    return nPktBytes;
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintHelpAndExit();
+
+    unsigned int nPayload = 1024;
+    P.GetVariable("--payload",nPayload);
+
+    unsigned int nPublishes = 2000;
+    P.GetVariable("--publishes",nPublishes);
+
+    unsigned int nBatch = 10;
+    P.GetVariable("--batch",nBatch);
+    if(nBatch==0)
+        nBatch = 1;
+
+    std::string sPayload(nPayload,'x');
+    CMOOSMsg M(MOOS_NOTIFY,"NODE_REPORT",sPayload);
+    if(P.GetFlag("--binary"))
+        M.MarkAsBinary();
+    M.m_sSrc = "pNodeReporter";
+    M.m_sOriginatingCommunity = "alpha";
+
+    unsigned int Subscribers[] = {1,2,5,10,20,40,80};
+    unsigned int nTrials = sizeof(Subscribers)/sizeof(Subscribers[0]);
+    Mode Modes[] = {COPY,SHARED,SHARED_COMPACT};
+
+    std::cout<<std::left<<std::setw(10)<<"mail"
+            <<std::setw(8)<<"subs"
+            <<std::setw(16)<<"allocs/pub"
+            <<std::setw(16)<<"KB alloc/pub"
+            <<std::setw(16)<<"KB sent/pub"
+            <<std::setw(16)<<"us/pub"<<"\n";
+
+    for(unsigned int m = 0;m<sizeof(Modes)/sizeof(Modes[0]);m++)
+    {
+        for(unsigned int t = 0;t<nTrials;t++)
+        {
+            unsigned int nSubs = Subscribers[t];
+
+            unsigned long nAllocs = g_nAllocs;
+            unsigned long nAllocBytes = g_nAllocBytes;
+            double dfStart = MOOS::Time();
+
+            unsigned long nSent = Deliver(Modes[m],M,nSubs,nPublishes,nBatch);
+
+            double dfTime = (MOOS::Time()-dfStart)/nPublishes;
+            double dfAllocs = double(g_nAllocs-nAllocs)/nPublishes;
+            double dfAllocKB = double(g_nAllocBytes-nAllocBytes)/nPublishes/1024.0;
+
+            std::cout<<std::left<<std::setw(10)<<ModeName(Modes[m])
+                    <<std::setw(8)<<nSubs
+                    <<std::setw(16)<<std::fixed<<std::setprecision(1)<<dfAllocs
+                    <<std::setw(16)<<std::setprecision(2)<<dfAllocKB
+                    <<std::setw(16)<<double(nSent)/nPublishes/1024.0
+                    <<std::setw(16)<<dfTime*1e6<<"\n";
+        }
+    }
+
+    return 0;
+}
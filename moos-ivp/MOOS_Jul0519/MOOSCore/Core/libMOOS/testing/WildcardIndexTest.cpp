@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/*
+ * WildcardIndexTest.cpp
+ *
+ * checks that MOOS::WildcardIndex finds exactly the filters a brute force
+ * walk over every client's filters finds, and compares the time each
+ * takes to match a new variable as the number of filters grows.
+ */
+
+#include "MOOS/libMOOS/DB/WildcardIndex.h"
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <iomanip>
+#include <set>
+#include <vector>
+#include <cstdlib>
+
+void PrintHelpAndExit()
+{
+    std::cerr<<"compares indexed and brute force wildcard matching\n\n";
+    std::cerr<<"  --vehicles=<int>    number of vehicles in the fleet (default 50)\n";
+    std::cerr<<"  --lookups=<int>     variables to match per trial (default 20000)\n";
+    exit(0);
+}
+
+/** registering the same patterns again must take the new period and
+latest only flag without moving the filter in the order Match finds them */
+bool TestReRegistration()
+{
+    MOOS::WildcardIndex Index;
+    Index.Add("client_a",MOOS::MsgFilter("*","NAV_*",0.0),false);
+    Index.Add("client_b",MOOS::MsgFilter("*","NAV_*",0.0),false);
+    Index.Add("client_a",MOOS::MsgFilter("*","*_X",0.0),false);
+
+    MOOS::WildcardIndex::MATCHES Matches;
+    Index.Match("NAV_X","pNav",Matches);
+    std::vector<std::string> Before;
+    for(unsigned int n = 0;n<Matches.size();n++)
+        Before.push_back(Matches[n]->client_+"/"+Matches[n]->filter_.as_string());
+
+    if(Index.Add("client_a",MOOS::MsgFilter("*","NAV_*",2.0),true))
+    {
+        std::cerr<<"FAIL: re-registering a filter added a second one\n";
+        return false;
+    }
+
+    if(Index.Size()!=3)
+    {
+        std::cerr<<"FAIL: index holds "<<Index.Size()<<" filters after re-registration\n";
+        return false;
+    }
+
+    Index.Match("NAV_X","pNav",Matches);
+    if(Matches.size()!=Before.size())
+    {
+        std::cerr<<"FAIL: NAV_X matched "<<Matches.size()<<" filters not "<<Before.size()<<"\n";
+        return false;
+    }
+
+    for(unsigned int n = 0;n<Matches.size();n++)
+    {
+        const MOOS::WildcardIndex::Entry & rEntry = *Matches[n];
+        if(rEntry.client_+"/"+rEntry.filter_.as_string()!=Before[n])
+        {
+            std::cerr<<"FAIL: re-registration changed the match order\n";
+            return false;
+        }
+
+        bool bReRegistered = rEntry.client_=="client_a" && rEntry.filter_.var_filter()=="NAV_*";
+        if(rEntry.filter_.period()!=(bReRegistered ? 2.0 : 0.0) ||
+                rEntry.latest_only_!=bReRegistered)
+        {
+            std::cerr<<"FAIL: "<<Before[n]<<" has period "<<rEntry.filter_.period()
+                    <<" and latest only "<<rEntry.latest_only_<<" after re-registration\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+
+    if(P.GetFlag("-h","--help"))
+        PrintHelpAndExit();
+
+    if(!TestReRegistration())
+        return -1;
+
+    unsigned int nVehicles = 50;
+    P.GetVariable("--vehicles",nVehicles);
+
+    unsigned int nLookups = 20000;
+    P.GetVariable("--lookups",nLookups);
+
+    const char * Vars[] = {"NAV_X","NAV_Y","NAV_HEADING","NAV_SPEED",
+            "NODE_REPORT","DESIRED_THRUST","IVPHELM_STATE","APPCAST"};
+    unsigned int nVars = sizeof(Vars)/sizeof(Vars[0]);
+
+    const char * Apps[] = {"pHelmIvP","pNodeReporter","uSimMarine","pMarinePID"};
+    unsigned int nApps = sizeof(Apps)/sizeof(Apps[0]);
+
+    std::cout<<std::left<<std::setw(10)<<"filters"
+            <<std::setw(16)<<"brute us/var"
+            <<std::setw(16)<<"index us/var"<<"\n";
+
+    unsigned int Clients[] = {1,10,50,100,200,400};
+    unsigned int nTrials = sizeof(Clients)/sizeof(Clients[0]);
+
+    for(unsigned int t = 0;t<nTrials;t++)
+    {
+        //each client asks for a handful of vehicle specific patterns
+        std::map<std::string,std::set<MOOS::MsgFilter> > ClientFilters;
+        MOOS::WildcardIndex Index;
+        srand(t+1);
+        for(unsigned int c = 0;c<Clients[t];c++)
+        {
+            std::string sClient = MOOSFormat("client_%d",c);
+            for(unsigned int f = 0;f<4;f++)
+            {
+                std::string sVar;
+                switch(rand()%4)
+                {
+                case 0: sVar = MOOSFormat("%s_V%d",Vars[rand()%nVars],rand()%nVehicles); break;
+                case 1: sVar = MOOSFormat("%s*",Vars[rand()%nVars]); break;
+                case 2: sVar = MOOSFormat("NAV_?_V%d",rand()%nVehicles); break;
+                case 3: sVar = MOOSFormat("*_V%d",rand()%nVehicles); break;
+                }
+                std::string sApp = rand()%2 ? "*" : Apps[rand()%nApps];
+
+                MOOS::MsgFilter F(sApp,sVar,0.0);
+                bool bNew = ClientFilters[sClient].insert(F).second;
+                if(bNew!=Index.Add(sClient,F))
+                {
+                    std::cerr<<"FAIL: index and set disagree on adding "<<F.as_string()<<"\n";
+                    return -1;
+                }
+            }
+        }
+
+        //make up the variables which will appear
+        std::vector<std::pair<std::string,std::string> > NewVars;
+        for(unsigned int n = 0;n<nLookups;n++)
+        {
+            NewVars.push_back(std::make_pair(
+                    MOOSFormat("%s_V%d",Vars[rand()%nVars],rand()%nVehicles),
+                    std::string(Apps[rand()%nApps])));
+        }
+
+        //brute force - what the DB used to do
+        std::vector<std::set<std::string> > BruteResults(nLookups);
+        double dfStart = MOOS::Time();
+        for(unsigned int n = 0;n<nLookups;n++)
+        {
+            CMOOSMsg M(MOOS_NOTIFY,NewVars[n].first,0.0);
+            M.m_sSrc = NewVars[n].second;
+
+            std::map<std::string,std::set<MOOS::MsgFilter> >::const_iterator g;
+            for(g = ClientFilters.begin();g!=ClientFilters.end();++g)
+            {
+                std::set<MOOS::MsgFilter>::const_iterator h;
+                for(h = g->second.begin();h!=g->second.end();++h)
+                {
+                    if(h->Matches(M))
+                        BruteResults[n].insert(g->first+"/"+h->as_string());
+                }
+            }
+        }
+        double dfBrute = (MOOS::Time()-dfStart)/nLookups;
+
+        //indexed
+        std::vector<std::set<std::string> > IndexResults(nLookups);
+        MOOS::WildcardIndex::MATCHES Matches;
+        dfStart = MOOS::Time();
+        for(unsigned int n = 0;n<nLookups;n++)
+        {
+            Index.Match(NewVars[n].first,NewVars[n].second,Matches);
+            MOOS::WildcardIndex::MATCHES::const_iterator h;
+            for(h = Matches.begin();h!=Matches.end();++h)
+                IndexResults[n].insert((*h)->client_+"/"+(*h)->filter_.as_string());
+        }
+        double dfIndex = (MOOS::Time()-dfStart)/nLookups;
+
+        if(BruteResults!=IndexResults)
+        {
+            std::cerr<<"FAIL: index and brute force found different filters\n";
+            return -1;
+        }
+
+        std::cout<<std::left<<std::setw(10)<<Index.Size()
+                <<std::setw(16)<<std::fixed<<std::setprecision(3)<<dfBrute*1e6
+                <<std::setw(16)<<dfIndex*1e6<<"\n";
+    }
+
+    std::cout<<"PASS\n";
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ *  LogWriter.cpp
+ *  MOOS
+ *
+ */
+
+#include "LogWriter.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//size of each buffer handed to the writing thread, and how many may be queued
+#define LOG_WRITER_BUFFER_SIZE 262144
+#define LOG_WRITER_QUEUE_SIZE 256
+
+//how long the writing thread sleeps waiting for a buffer (ms)
+#define LOG_WRITER_WAIT 100
+
+
+bool _LogWriterThreadWorker(void * pParam)
+{
+	CLogWriter* pMe = (CLogWriter*) pParam;
+	return pMe->DoWriting();
+}
+
+CLogWriter::CLogWriter() : m_Full(LOG_WRITER_QUEUE_SIZE), m_Empty(LOG_WRITER_QUEUE_SIZE)
+{
+	m_pBuffer = NULL;
+	m_nStalls = 0;
+	m_pFile = NULL;
+	m_dfSyncPeriod = 0;
+	m_nBytesWritten = 0;
+	m_nWriteErrors = 0;
+	m_nRateBytes = 0;
+	m_dfRateTime = 0;
+}
+
+CLogWriter::~CLogWriter()
+{
+	Stop();
+	FreeBuffers();
+}
+
+bool CLogWriter::Start(const std::string & sFileName, double dfSyncPeriod)
+{
+	Stop();
+
+	m_sFileName = sFileName;
+	m_dfSyncPeriod = dfSyncPeriod;
+
+	m_pFile = fopen(m_sFileName.c_str(),"w");
+	if(m_pFile==NULL)
+	{
+		MOOSDebugWrite(MOOSFormat("ERROR: Failed to open File: %s",m_sFileName.c_str()));
+		return false;
+	}
+
+	//each write is a whole buffer so stdio need not copy it through its own
+	setvbuf(m_pFile,NULL,_IONBF,0);
+
+	m_StatsLock.Lock();
+	m_nBytesWritten = 0;
+	m_nWriteErrors = 0;
+	m_StatsLock.UnLock();
+
+	m_nStalls = 0;
+	m_nRateBytes = 0;
+	m_dfRateTime = MOOSTime();
+
+	m_Thread.Initialise(_LogWriterThreadWorker, this);
+	return m_Thread.Start();
+}
+
+bool CLogWriter::Stop()
+{
+	if(m_pFile==NULL)
+		return true;
+
+	//the thread writes all that was queued before it quits
+	if(m_Thread.IsThreadRunning())
+		m_Thread.Stop();
+
+	//with no thread running what remains is written here
+	Flush();
+	WriteQueued();
+
+	SyncFile();
+	fclose(m_pFile);
+	m_pFile = NULL;
+
+	return true;
+}
+
+bool CLogWriter::IsRunning()
+{
+	return m_Thread.IsThreadRunning();
+}
+
+void CLogWriter::Append(const char * pStr, size_t nLen)
+{
+	if(m_pFile==NULL || nLen==0)
+		return;
+
+	if(m_pBuffer==NULL && !m_Empty.Pop(m_pBuffer))
+	{
+		m_pBuffer = new std::string;
+		m_pBuffer->reserve(LOG_WRITER_BUFFER_SIZE);
+	}
+
+	m_pBuffer->append(pStr,nLen);
+
+	if(m_pBuffer->size()>=LOG_WRITER_BUFFER_SIZE)
+		HandOff();
+}
+
+void CLogWriter::Append(char c)
+{
+	Append(&c,1);
+}
+
+void CLogWriter::Flush()
+{
+	if(m_pBuffer!=NULL && !m_pBuffer->empty())
+		HandOff();
+}
+
+unsigned long long CLogWriter::BytesWritten()
+{
+	m_StatsLock.Lock();
+	unsigned long long nBytes = m_nBytesWritten;
+	m_StatsLock.UnLock();
+	return nBytes;
+}
+
+double CLogWriter::BytesPerSecond()
+{
+	double dfNow = MOOSTime();
+	unsigned long long nBytes = BytesWritten();
+
+	double dfRate = 0;
+	if(dfNow>m_dfRateTime && nBytes>=m_nRateBytes)
+		dfRate = (nBytes-m_nRateBytes)/(dfNow-m_dfRateTime);
+
+	m_nRateBytes = nBytes;
+	m_dfRateTime = dfNow;
+	return dfRate;
+}
+
+void CLogWriter::HandOff()
+{
+	std::string * pBuffer = m_pBuffer;
+	m_pBuffer = NULL;
+
+	//no thread (stopped, or never started) so the caller writes it
+	if(!m_Thread.IsThreadRunning())
+	{
+		WriteBuffer(*pBuffer);
+		delete pBuffer;
+		return;
+	}
+
+	//the queue is full so the disk cannot keep up - wait rather than lose data
+	if(!m_Full.Push(pBuffer))
+	{
+		m_nStalls++;
+		while(!m_Full.Push(pBuffer))
+		{
+			if(!m_Thread.IsThreadRunning())
+			{
+				WriteBuffer(*pBuffer);
+				delete pBuffer;
+				return;
+			}
+			MOOSPause(1);
+		}
+	}
+}
+
+bool CLogWriter::DoWriting()
+{
+	double dfLastSync = MOOSTime();
+
+	while(!m_Thread.IsQuitRequested())
+	{
+		if(m_Full.WaitForPush(LOG_WRITER_WAIT))
+			WriteQueued();
+
+		if(m_dfSyncPeriod>0 && MOOSTime()-dfLastSync>=m_dfSyncPeriod)
+		{
+			SyncFile();
+			dfLastSync = MOOSTime();
+		}
+	}
+
+	WriteQueued();
+
+	return true;
+}
+
+void CLogWriter::WriteQueued()
+{
+	std::string * pBuffer;
+	while(m_Full.Pop(pBuffer))
+	{
+		WriteBuffer(*pBuffer);
+
+		//back for reuse, keeping its capacity
+		pBuffer->clear();
+		if(!m_Empty.Push(pBuffer))
+			delete pBuffer;
+	}
+}
+
+void CLogWriter::WriteBuffer(const std::string & sBuffer)
+{
+	size_t nWritten = fwrite(sBuffer.data(),1,sBuffer.size(),m_pFile);
+
+	m_StatsLock.Lock();
+	m_nBytesWritten+=nWritten;
+	if(nWritten!=sBuffer.size())
+		m_nWriteErrors++;
+	m_StatsLock.UnLock();
+}
+
+void CLogWriter::SyncFile()
+{
+	if(m_pFile==NULL)
+		return;
+
+	fflush(m_pFile);
+
+#if defined(_WIN32)
+	_commit(_fileno(m_pFile));
+#elif defined(__linux__)
+	fdatasync(fileno(m_pFile));
+#else
+	fsync(fileno(m_pFile));
+#endif
+}
+
+void CLogWriter::FreeBuffers()
+{
+	std::string * pBuffer;
+	while(m_Empty.Pop(pBuffer))
+		delete pBuffer;
+	while(m_Full.Pop(pBuffer))
+		delete pBuffer;
+
+	delete m_pBuffer;
+	m_pBuffer = NULL;
+}
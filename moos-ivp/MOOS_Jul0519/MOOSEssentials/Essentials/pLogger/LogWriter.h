@@ -0,0 +1,122 @@
+/*
+ *  LogWriter.h
+ *  MOOS
+ *
+ */
+
+#ifndef CLOGWRITERH
+#define CLOGWRITERH
+
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/SPSCQueue.h"
+#include <cstdio>
+#include <string>
+
+
+/*!
+    @class   CLogWriter
+    @abstract    Launches a thread to write text to a log file in large blocks
+    @discussion  Text is appended to a buffer on the calling thread. Full buffers
+                 are handed to the writing thread through a lock free queue and
+                 come back empty through another to be reused, so after start up
+                 nothing is allocated. The writing thread also syncs the file to
+                 disk on a schedule. Only one thread may call Append and Flush.
+*/
+
+class CLogWriter
+	{
+	public:
+
+		CLogWriter();
+		~CLogWriter();
+
+		/*!
+		 @function     Start
+		 @abstract   Open the file and start the writing thread
+		 @param	sFileName  name of the file, which is truncated
+		 @param dfSyncPeriod seconds between syncs of the file to disk, none if 0
+		 */
+		bool Start(const std::string & sFileName, double dfSyncPeriod);
+
+		/*!
+		 @function Stop
+		 @abstract   Write everything appended so far, then close the file
+		 @discussion  Blocking call
+		 */
+		bool Stop();
+
+		/*!
+		 @function IsRunning
+		 @abstract   returns true if the writing thread is active
+		 */
+		bool IsRunning();
+
+		/*!
+		 @function   Append
+		 @abstract   Add text to the current buffer
+		 @discussion The buffer is handed to the writing thread once full. If the
+		             queue of full buffers is itself full this waits for room, so
+		             nothing is lost, and the wait is counted as a stall.
+		 */
+		void Append(const char * pStr, size_t nLen);
+		void Append(const std::string & sStr) {Append(sStr.data(),sStr.size());}
+		void Append(char c);
+
+		/*!
+		 @function   Flush
+		 @abstract   Hand a partly filled buffer to the writing thread
+		 */
+		void Flush();
+
+		/** buffers waiting to be written, and the most there have been */
+		unsigned int QueueDepth() const {return m_Full.Size();}
+		unsigned int QueueHighWaterMark() const {return m_Full.HighWaterMark();}
+
+		/** how many times Append had to wait for the writing thread */
+		unsigned int Stalls() const {return m_nStalls;}
+
+		/** bytes written to file, and the rate since this was last asked */
+		unsigned long long BytesWritten();
+		double BytesPerSecond();
+
+		//worker function
+		bool DoWriting();
+
+	protected:
+
+		void HandOff();
+		void WriteQueued();
+		void WriteBuffer(const std::string & sBuffer);
+		void SyncFile();
+		void FreeBuffers();
+
+		CMOOSThread m_Thread;
+
+		MOOS::SPSCQueue<std::string*> m_Full;
+		MOOS::SPSCQueue<std::string*> m_Empty;
+
+		//the buffer being filled, owned by the calling thread
+		std::string * m_pBuffer;
+		unsigned int m_nStalls;
+
+		FILE * m_pFile;
+		std::string m_sFileName;
+		double m_dfSyncPeriod;
+
+		//written by the writing thread
+		CMOOSLock m_StatsLock;
+		unsigned long long m_nBytesWritten;
+		unsigned int m_nWriteErrors;
+
+		//for the rate, kept by the calling thread
+		unsigned long long m_nRateBytes;
+		double m_dfRateTime;
+
+	private:
+		//owns its buffers and file - not copyable
+		CLogWriter(const CLogWriter &);
+		CLogWriter & operator = (const CLogWriter &);
+	};
+
+#endif
@@ -124,6 +124,9 @@ CMOOSLogger::CMOOSLogger()
 	//by default do not indicate data tyep with a D: or S: suffix
 	m_bMarkDataType = false;
 
+	//by default sync the alog to disk every 10 seconds
+	m_dfFileSyncPeriod = 10.0;
+
     //lets always sort mail by time...
     SortMailByTime(true);
 
@@ -143,10 +146,9 @@ bool CMOOSLogger::ShutDown()
 
 bool CMOOSLogger::CloseFiles()
 {
-    if(m_AsyncLogFile.is_open())
-    {
-        m_AsyncLogFile.close();
-    }
+    //the writer threads finish what is queued first
+    m_AlogWriter.Stop();
+    m_XlogWriter.Stop();
 
     if(m_SyncLogFile.is_open())
     {
@@ -276,6 +278,9 @@ bool CMOOSLogger::OnStartUp()
 
     m_MissionReader.GetConfigurationParam("MarkDataType",m_bMarkDataType);
 
+    //how often (seconds) should the alog be synced to disk? 0 means never
+    m_MissionReader.GetConfigurationParam("FileSyncPeriod",m_dfFileSyncPeriod);
+
     //do we have a path global name?
     if(!m_MissionReader.GetValue("GLOBALLOGPATH",m_sPath))
     {
@@ -543,7 +548,8 @@ bool CMOOSLogger::Iterate()
 
     //finally flush all files to be safe
     m_SyncLogFile.flush();
-    m_AsyncLogFile.flush();
+    m_AlogWriter.Flush();
+    m_XlogWriter.Flush();
     m_SystemLogFile.flush();
 
 
@@ -885,14 +891,16 @@ bool CMOOSLogger::OpenAsyncFiles()
 	else
 	{
 		//usual banner write to a regular alog file
-		if(!OpenFile(m_AsyncLogFile,m_sAsyncFileName))
+		if(!m_AlogWriter.Start(m_sAsyncFileName,m_dfFileSyncPeriod))
 			return MOOSFail("Failed to Open alog file");
 
-		DoLogBanner(m_AsyncLogFile,m_sAsyncFileName);
+		std::stringstream ss;
+		DoLogBanner(ss,m_sAsyncFileName);
+		m_AlogWriter.Append(ss.str());
 		
 		if(m_bUseExcludedLog)
 		{
-			if(!OpenFile(m_ExcludeLogFile, m_sExcludeFileName))
+			if(!m_XlogWriter.Start(m_sExcludeFileName,m_dfFileSyncPeriod))
 				return MOOSFail("failed to open xlog log");
 		}
 	}
@@ -1213,6 +1221,35 @@ CMOOSLogger::LogType CMOOSLogger::GetDestinationLog(const std::string & sMsg)
 	
 }
 
+//append sStr left justified in a field nWidth wide (as setw does)
+static void AppendPadded(std::string & sLine, const std::string & sStr, size_t nWidth)
+{
+	sLine+=sStr;
+	if(sStr.size()<nWidth)
+		sLine.append(nWidth-sStr.size(),' ');
+}
+
+//append dfVal as fixed point, left justified - the same text as a stream
+//with ios::fixed, ios::left, setw and setprecision would give but without
+//building a stream for every number
+static void AppendFixed(std::string & sLine, double dfVal, int nWidth, int nDP)
+{
+	char Buf[64];
+	int n = nDP<0 ? -1 : snprintf(Buf,sizeof(Buf),"%-*.*f",nWidth,nDP,dfVal);
+	if(n>=0 && n<(int)sizeof(Buf))
+	{
+		sLine.append(Buf,n);
+	}
+	else
+	{
+		std::ostringstream os;
+		os.setf(ios::left);
+		os.setf(ios::fixed);
+		os<<setw(nWidth)<<setprecision(nDP)<<dfVal;
+		sLine+=os.str();
+	}
+}
+
 bool CMOOSLogger::DoAsyncLog(MOOSMSG_LIST &NewMail)
 {
     //log asynchronously...
@@ -1220,8 +1257,6 @@ bool CMOOSLogger::DoAsyncLog(MOOSMSG_LIST &NewMail)
     {
         MOOSMSG_LIST::iterator q;
 
-		std::stringstream sStream[2];
-
         for(q = NewMail.begin();q!=NewMail.end();q++)
         {
             CMOOSMsg & rMsg = *q;
@@ -1231,25 +1266,26 @@ bool CMOOSLogger::DoAsyncLog(MOOSMSG_LIST &NewMail)
             //which is used for the synchronous case..
             if(m_MOOSVars.find(rMsg.m_sKey)!=m_MOOSVars.end())
             {
-				
-				
-				std::stringstream sEntry;
-				
-				sEntry.setf(ios::left);
-				
-				sEntry.setf(ios::fixed);
+				//the line is built in a string kept between calls so
+				//its memory is reused
+				std::string & sEntry = m_sAsyncEntry;
+				sEntry.clear();
 
-				sEntry<<setw(15)<<setprecision(5)<<rMsg.GetTime()-GetAppStartTime()<<' ';  // mikerb change from 3-5
+				AppendFixed(sEntry,rMsg.GetTime()-GetAppStartTime(),15,5);  // mikerb change from 3-5
+				sEntry+=' ';
 
-				sEntry<<setw(20)<<rMsg.GetKey()<<' ';
+				AppendPadded(sEntry,rMsg.GetKey(),20);
+				sEntry+=' ';
 
 				//fill in the src string
-			    std::string sSrcString = rMsg.GetSource();
+			    std::string & sSrcString = m_sAsyncSrc;
+			    sSrcString = rMsg.GetSource();
 
 				if(m_bLogAuxSrc && !rMsg.GetSourceAux().empty() )
 				{
 					//if the AuxSrc string is empty just write nothing
-					sSrcString+=":"+rMsg.GetSourceAux();
+					sSrcString+=':';
+					sSrcString+=rMsg.GetSourceAux();
 				}
 				if(m_bMarkExternalCommunityMessages)
 				{
@@ -1257,27 +1293,39 @@ bool CMOOSLogger::DoAsyncLog(MOOSMSG_LIST &NewMail)
 					if(rMsg.m_sOriginatingCommunity!=m_Comms.GetCommunityName())
 					{
 						//yes this is from an external community
-						sSrcString+="@"+rMsg.m_sOriginatingCommunity;
+						sSrcString+='@';
+						sSrcString+=rMsg.m_sOriginatingCommunity;
 					}
 				}
-			    sEntry<<setw(15)<<sSrcString<<' ';
+			    AppendPadded(sEntry,sSrcString,15);
+			    sEntry+=' ';
 
 
 				if(rMsg.IsDataType(MOOS_STRING) || rMsg.IsDataType(MOOS_DOUBLE))
 				{
 					if(m_bMarkDataType)
-						sEntry<<(rMsg.IsDouble() ? "D:" : "S:");
+						sEntry+=(rMsg.IsDouble() ? "D:" : "S:");
 
-					sEntry<<rMsg.GetAsString(12,m_nDoublePrecision)<<' ';
+					//as GetAsString(12,m_nDoublePrecision) would write it
+					if(rMsg.GetTime()==-1)
+						sEntry+=rMsg.GetAsString(12,m_nDoublePrecision);
+					else if(rMsg.IsDataType(MOOS_DOUBLE))
+						AppendFixed(sEntry,rMsg.m_dfVal,12,m_nDoublePrecision);
+					else
+						sEntry+=rMsg.m_sVal;
+
+					sEntry+=' ';
 
 				}
 				else if(rMsg.IsDataType(MOOS_BINARY_STRING))
 				{
 					//here we append to the binary log and begin each line with a summary....
-					m_BinaryLogFile<<sEntry.str();
+					m_BinaryLogFile.write(sEntry.data(), sEntry.size());
 					
 					//write in coordinates in the alog
-					sEntry<<"<MOOS_BINARY>File="<<(m_sLogRootName+".blog")<<",Offset="<<m_BinaryLogFile.tellp()<<",Bytes="<<rMsg.m_sVal.size()<<"</MOOS_BINARY>";
+					std::ostringstream sCoords;
+					sCoords<<"<MOOS_BINARY>File="<<(m_sLogRootName+".blog")<<",Offset="<<m_BinaryLogFile.tellp()<<",Bytes="<<rMsg.m_sVal.size()<<"</MOOS_BINARY>";
+					sEntry+=sCoords.str();
 					
 					//write the binary data to file
 					m_BinaryLogFile.write(rMsg.m_sVal.data(), rMsg.m_sVal.size());
@@ -1287,7 +1335,7 @@ bool CMOOSLogger::DoAsyncLog(MOOSMSG_LIST &NewMail)
 					
 				}
 				
-				
+				sEntry+='\n';
 				
 				int i=0;
 				if(m_bUseExcludedLog)
@@ -1300,8 +1348,17 @@ bool CMOOSLogger::DoAsyncLog(MOOSMSG_LIST &NewMail)
 							i = 0;
 					}
 				}
-                sStream[i]<<sEntry.str()<<endl;
-				
+
+				if(m_bCompressAlog)
+				{
+					m_sAsyncBatch[i]+=sEntry;
+				}
+				else
+				{
+					//a regular write - the writer thread does the disk work
+					CLogWriter & rWriter = i==0 ? m_AlogWriter : m_XlogWriter;
+					rWriter.Append(sEntry);
+				}
 				
             }
         }
@@ -1309,17 +1366,10 @@ bool CMOOSLogger::DoAsyncLog(MOOSMSG_LIST &NewMail)
 		if(m_bCompressAlog)
 		{
 			//send to the worker thread...
-			m_AlogZipper.Push(sStream[0].str());
-			m_XlogZipper.Push(sStream[1].str());
-		}
-		else
-		{
-			//a regular write
-			if(m_AsyncLogFile.is_open())
-				m_AsyncLogFile<<sStream[0].str();
-			
-			if(m_ExcludeLogFile.is_open())
-				m_ExcludeLogFile<<sStream[1].str();
+			m_AlogZipper.Push(m_sAsyncBatch[0]);
+			m_XlogZipper.Push(m_sAsyncBatch[1]);
+			m_sAsyncBatch[0].clear();
+			m_sAsyncBatch[1].clear();
 		}
     }
     return true;
@@ -1551,6 +1601,15 @@ std::string CMOOSLogger::MakeStatusString()
     std::stringstream ss;
     ss<<CMOOSApp::MakeStatusString()<<",";
     ss<<"LogAuxSrc="<<std::boolalpha<<m_bLogAuxSrc;
+
+    //how well is the alog writer keeping up?
+    if(m_AlogWriter.IsRunning())
+    {
+        ss<<",AlogQueue="<<m_AlogWriter.QueueDepth();
+        ss<<",AlogQueueHWM="<<m_AlogWriter.QueueHighWaterMark();
+        ss<<",AlogBytesPerSec="<<(unsigned long long)m_AlogWriter.BytesPerSecond();
+        ss<<",AlogStalls="<<m_AlogWriter.Stalls();
+    }
     return ss.str();
 }
 
@@ -38,6 +38,7 @@
 #include <set>
 #include <string>
 #include "Zipper.h"
+#include "LogWriter.h"
 
 typedef std::vector<std::string> STRING_VECTOR; 
 
@@ -102,8 +103,6 @@ protected:
     bool CreateDirectory(const std::string & sDirectory);
     std::string MakeStatusString();
 
-    std::ofstream m_AsyncLogFile;
-    std::ofstream m_ExcludeLogFile;
     std::ofstream m_SyncLogFile;
     std::ofstream m_SystemLogFile;
     std::ofstream m_BinaryLogFile;
@@ -136,6 +135,16 @@ protected:
 	bool	m_bCompressAlog;
 	CZipper m_AlogZipper;
 	CZipper m_XlogZipper;
+
+	//uncompressed alog and xlog are written by their own threads
+	CLogWriter m_AlogWriter;
+	CLogWriter m_XlogWriter;
+	double m_dfFileSyncPeriod;
+
+	//scratch space for formatting alog lines, reused to save allocations
+	std::string m_sAsyncEntry;
+	std::string m_sAsyncSrc;
+	std::string m_sAsyncBatch[2];
 	
 	
     //how many synline have been written?
@@ -0,0 +1,72 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ListSorter.cpp                                       */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include "ListSorter.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: addEntry()
+//   Returns: true if sorting was required
+
+bool ListSorter::addEntry(const ALogEntry& entry)
+{
+  if((m_entries.size() == 0) || (entry.time() >= m_entries.back().time())) {
+    m_entries.push_back(entry);
+    return(false);
+  }
+    
+  m_entries.push_back(entry);
+  m_entries.sort();
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: popEntry()
+
+ALogEntry ListSorter::popEntry()
+{
+  ALogEntry return_entry;
+  if(m_entries.size() > 0) {
+    return_entry = m_entries.front();
+    m_entries.pop_front();
+  }
+
+  if(!m_check_for_duplicates)
+    return(return_entry);
+
+  double return_entry_tstamp = return_entry.time();
+  
+  list<ALogEntry>::iterator p;
+  for(p=m_entries.begin(); p!= m_entries.end(); ) {
+    if(p->time() != return_entry_tstamp)
+      break;
+    if(*p == return_entry)
+      p = m_entries.erase(p);
+    else
+      p++;
+  }
+
+  return(return_entry);
+}
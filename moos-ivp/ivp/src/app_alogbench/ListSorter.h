@@ -0,0 +1,53 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ListSorter.h                                         */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#ifndef ALOG_LIST_SORTER_HEADER
+#define ALOG_LIST_SORTER_HEADER
+
+#include <list>
+#include "ALogEntry.h"
+
+// The list-based sorter used by alogsort and aloggrep before the
+// heap-based ALogSorter. Kept only as the baseline to time the
+// ALogSorter against, and to check it sorts the same way.
+
+class ListSorter
+{
+ public:
+  ListSorter() {m_check_for_duplicates=true;}
+  ~ListSorter() {}
+
+  bool         addEntry(const ALogEntry&);
+  ALogEntry    popEntry();
+  void         checkForDuplicates(bool v) {m_check_for_duplicates=v;}
+
+  unsigned int size() const {return(m_entries.size());}
+
+ private:
+  std::list<ALogEntry> m_entries;
+
+  bool         m_check_for_duplicates;
+};
+
+#endif
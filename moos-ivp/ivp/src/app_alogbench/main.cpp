@@ -0,0 +1,691 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <sys/time.h>
+#include <iostream>
+#include <string>
+#include "MBUtils.h"
+#include "LogUtils.h"
+#include "BufferedLineReader.h"
+#include "ALogSorter.h"
+#include "ALogDataBroker.h"
+#include "KLogStore.h"
+#include "ListSorter.h"
+
+using namespace std;
+
+void   showHelpAndExit();
+double wallTime();
+bool   makeLog(const string& filename, unsigned int mbytes, double skew);
+bool   runReaders(const string& filename);
+bool   runSorters(const string& filename, unsigned int cache, double window);
+bool   runPlots(const string& filename, double mintime, double maxtime);
+unsigned long plotPass(ALogDataBroker&, unsigned long& rows);
+unsigned long sortHash(unsigned long hash, const string& line);
+unsigned long numHash(unsigned long hash, double val);
+void   report(const string& label, double bytes, double secs,
+	      unsigned long lines);
+string fgetcLine(FILE*);
+
+//--------------------------------------------------------
+// Procedure: main
+//   Purpose: Make a synthetic alog file of a given size, or time
+//            the alog line readers on a given file, reporting the
+//            throughput of each in GB/s. Or time the alog sorters,
+//            or the building of plots from the split klog files.
+
+int main(int argc, char *argv[])
+{ 
+  string       make_file;
+  string       alog_file;
+  unsigned int mbytes = 2000;
+  double       skew   = 0;
+  bool         sort   = false;
+  unsigned int cache  = 1000;
+  double       window = 0;
+  bool         plots  = false;
+  double       mintime = 0;
+  double       maxtime = 0;
+  bool         mintime_set = false;
+  bool         maxtime_set = false;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i]; 
+    bool handled = true;
+    if((argi == "-h") || (argi == "--help"))
+      showHelpAndExit();
+    else if(strBegins(argi, "--make="))
+      make_file = argi.substr(7);
+    else if(strBegins(argi, "--size="))
+      handled = setPosUIntOnString(mbytes, argi.substr(7));
+    else if(strBegins(argi, "--skew="))
+      handled = setNonNegDoubleOnString(skew, argi.substr(7));
+    else if(argi == "--sort")
+      sort = true;
+    else if(strBegins(argi, "--cache="))
+      handled = setPosUIntOnString(cache, argi.substr(8));
+    else if(strBegins(argi, "--window="))
+      handled = setNonNegDoubleOnString(window, argi.substr(9));
+    else if(argi == "--plots")
+      plots = true;
+    else if(strBegins(argi, "--mintime="))
+      handled = mintime_set = setDoubleOnString(mintime, argi.substr(10));
+    else if(strBegins(argi, "--maxtime="))
+      handled = maxtime_set = setDoubleOnString(maxtime, argi.substr(10));
+    else if(strBegins(argi, "-"))
+      handled = false;
+    else
+      alog_file = argi;
+
+    if(!handled) {
+      cout << "Bad Arg:[" << argi << "]. Exiting." << endl;
+      exit(1);
+    }    
+  }
+
+  if(make_file != "") {
+    if(!makeLog(make_file, mbytes, skew))
+      exit(1);
+    if(alog_file == "")
+      exit(0);
+  }
+
+  if(alog_file == "")
+    showHelpAndExit();
+
+  if(!mintime_set)
+    mintime = -1e30;
+  if(!maxtime_set)
+    maxtime = 1e30;
+
+  bool ok = false;
+  if(sort)
+    ok = runSorters(alog_file, cache, window);
+  else if(plots)
+    ok = runPlots(alog_file, mintime, maxtime);
+  else
+    ok = runReaders(alog_file);
+  exit(ok ? 0 : 1);
+}
+
+//--------------------------------------------------------
+// Procedure: makeLog()
+//   Purpose: Write an alog file of roughly the given size in MB,
+//            mixing short numerical postings with the long string
+//            postings (node reports, IvP functions, appcasts)
+//            that make up most of a real helm log.
+//      Note: With a skew, each posting is stamped up to that many
+//            seconds early, as if delayed on the way to the logger,
+//            leaving the file out of order.
+
+bool makeLog(const string& filename, unsigned int mbytes, double skew)
+{
+  FILE *f = fopen(filename.c_str(), "w");
+  if(!f) {
+    cout << "Unable to open " << filename << " for writing" << endl;
+    return(false);
+  }
+
+  fprintf(f, "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\n");
+  fprintf(f, "%%%% LOG FILE:       %s\n", filename.c_str());
+  fprintf(f, "%%%% FILE OPENED ON  Sat Oct 17 12:00:00 2026\n");
+  fprintf(f, "%%%% LOGSTART               1792238400.00\n");
+  fprintf(f, "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\n");
+
+  string ipf = "P,waypt_survey^1234,1,1,H,16,1234:waypt_survey,2,35,1,";
+  while(ipf.length() < 600)
+    ipf += "100,D,course;0;359;360:speed;0;4;21,3,E,0,0,";
+
+  srand(1);
+  double limit  = (double)(mbytes) * 1000000;
+  double bytes  = 0;
+  double tstamp = 0;
+  unsigned long iter = 0;
+  while(bytes < limit) {
+    tstamp += 0.05;
+    double x = 100 + (rand() % 100000) / 100.0;
+    double y = -50 - (rand() % 100000) / 100.0;
+    double tstamp_real = tstamp;
+    if(skew > 0)
+      tstamp = tstamp_real - skew * (rand() % 1000) / 1000.0;
+    int amt = 0;
+    switch(iter % 8) {
+    case 0:
+      amt = fprintf(f, "%.3f  NAV_X  uSimMarine  %.2f\n", tstamp, x);
+      break;
+    case 1:
+      amt = fprintf(f, "%.3f  NAV_Y  uSimMarine  %.2f\n", tstamp, y);
+      break;
+    case 2:
+      amt = fprintf(f, "%.3f  DESIRED_HEADING  pHelmIvP  %d\n", tstamp,
+		    rand() % 360);
+      break;
+    case 3:
+      amt = fprintf(f, "%.3f  NODE_REPORT_LOCAL  pNodeReporter  "
+		    "NAME=alpha,X=%.2f,Y=%.2f,SPD=1.96,HDG=%d,DEP=0,"
+		    "LAT=43.825,LON=-70.329,TYPE=kayak,COLOR=yellow,"
+		    "MODE=MODE@ACTIVE:SURVEYING,ALLSTOP=clear,"
+		    "INDEX=%lu,YAW=0.58,TIME=%.2f,LENGTH=4\n", tstamp,
+		    x, y, rand() % 360, iter, 1792238400 + tstamp);
+      break;
+    case 4:
+      amt = fprintf(f, "%.3f  BHV_IPF  pHelmIvP:%lu:waypt_survey  %s\n",
+		    tstamp, iter/8, ipf.c_str());
+      break;
+    case 5:
+      amt = fprintf(f, "%.3f  IVPHELM_ITER  pHelmIvP  %lu\n", tstamp,
+		    iter/8);
+      break;
+    case 6:
+      amt = fprintf(f, "%.3f  VIEW_POINT  pHelmIvP  x=%.2f,y=%.2f,"
+		    "label=alpha_wpt,vertex_size=4,vertex_color=red\n",
+		    tstamp, x, y);
+      break;
+    default:
+      amt = fprintf(f, "%.3f  APPCAST  pHelmIvP  proc=pHelmIvP!@#"
+		    "iter=%lu!@#node=alpha!@#msg=Helm Iteration: %lu  "
+		    "(hz=4.0)(5)(4.01)!@#msg=  Solve Time (max):  0.00  "
+		    "(0.02)!@#\n", tstamp, iter/8, iter/8);
+    }
+    if(amt < 0) {
+      cout << "Failed writing " << filename << endl;
+      fclose(f);
+      return(false);
+    }
+    bytes += amt;
+    iter++;
+    tstamp = tstamp_real;
+  }
+  fclose(f);
+
+  cout << "Wrote " << filename << ": " << iter << " lines, "
+       << doubleToString(bytes / 1000000000, 2) << " GB" << endl;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: runReaders()
+//   Purpose: Read the whole file with each reader in turn. Each
+//            reader must find the same lines, or entries, as the
+//            one reading a character at a time.
+//      Note: The first pass also brings the file into the page
+//            cache, if it fits, so later passes are not favored
+//            by it. Files larger than memory time the disk.
+
+bool runReaders(const string& filename)
+{
+  // Pass 1: A character at a time with fgetc(), as the lines were
+  // read before BufferedLineReader.
+  FILE *f = fopen(filename.c_str(), "r");
+  if(!f) {
+    cout << "Unable to open " << filename << endl;
+    return(false);
+  }
+  unsigned long lines1 = 0;
+  double bytes1 = 0;
+  double start = wallTime();
+  while(1) {
+    string line = fgetcLine(f);
+    if(line == "eof")
+      break;
+    bytes1 += line.length() + 1;
+    lines1++;
+  }
+  report("fgetc line", bytes1, wallTime()-start, lines1);
+  fclose(f);
+
+  // Pass 2: getNextRawLine()
+  f = fopen(filename.c_str(), "r");
+  unsigned long lines2 = 0;
+  double bytes2 = 0;
+  start = wallTime();
+  while(1) {
+    string line = getNextRawLine(f);
+    if(line == "eof")
+      break;
+    bytes2 += line.length() + 1;
+    lines2++;
+  }
+  report("getNextRawLine", bytes2, wallTime()-start, lines2);
+  fclose(f);
+
+  // Pass 3: getNextRawALogEntry()
+  f = fopen(filename.c_str(), "r");
+  unsigned long entries3 = 0;
+  double sum3 = 0;
+  start = wallTime();
+  while(1) {
+    ALogEntry entry = getNextRawALogEntry(f, true);
+    string status = entry.getStatus();
+    if(status == "eof")
+      break;
+    if(status != "invalid") {
+      sum3 += entry.getTimeStamp();
+      entries3++;
+    }
+  }
+  report("getNextRawALogEntry", bytes1, wallTime()-start, entries3);
+  fclose(f);
+
+  // Pass 4: BufferedLineReader lines, as pointer and length
+  BufferedLineReader reader;
+  reader.open(filename);
+  unsigned long lines4 = 0;
+  double bytes4 = 0;
+  const char  *ptr;
+  unsigned int len;
+  start = wallTime();
+  while(reader.nextLine(ptr, len)) {
+    bytes4 += len + 1;
+    lines4++;
+  }
+  report("BufferedLineReader", bytes4, wallTime()-start, lines4);
+
+  // Pass 5: BufferedLineReader lines, as strings
+  reader.open(filename);
+  unsigned long lines5 = 0;
+  double bytes5 = 0;
+  string line;
+  start = wallTime();
+  while(reader.nextLine(line)) {
+    bytes5 += line.length() + 1;
+    lines5++;
+  }
+  report("  (as strings)", bytes5, wallTime()-start, lines5);
+
+  // Pass 6: BufferedLineReader entries
+  reader.open(filename);
+  unsigned long entries6 = 0;
+  double sum6 = 0;
+  ALogEntry entry;
+  start = wallTime();
+  while(reader.nextEntry(entry, true)) {
+    if(entry.getStatus() != "invalid") {
+      sum6 += entry.getTimeStamp();
+      entries6++;
+    }
+  }
+  report("  (as entries)", bytes1, wallTime()-start, entries6);
+
+  bool same_lines = ((lines1 == lines2) && (lines1 == lines4) &&
+		     (lines1 == lines5) && (bytes1 == bytes2) &&
+		     (bytes1 == bytes4) && (bytes1 == bytes5));
+  bool same_entries = ((entries3 == entries6) && (sum3 == sum6));
+  
+  cout << "Same lines:   " << boolToString(same_lines) << endl;
+  cout << "Same entries: " << boolToString(same_entries) << endl;
+  return(same_lines && same_entries);
+}
+
+//--------------------------------------------------------
+// Procedure: runSorters()
+//   Purpose: Sort the file as alogsort does, with the list sorter
+//            alogsort used before and with the ALogSorter, holding
+//            the given number of lines. And with the ALogSorter
+//            holding lines for the given window of time, if any.
+//            The sorted lines of each must be the same.
+//      Note: Each pass reads the file. The first pass only reads
+//            it, for the time taken by the reading alone.
+
+bool runSorters(const string& filename, unsigned int cache, double window)
+{
+  BufferedLineReader reader;
+  if(!reader.open(filename)) {
+    cout << "Unable to open " << filename << endl;
+    return(false);
+  }
+
+  // Pass 1: Reading only
+  unsigned long lines1 = 0;
+  string line;
+  double start = wallTime();
+  while(reader.nextLine(line))
+    lines1++;
+  double read_secs = wallTime() - start;
+  report("read only", reader.bytesRead(), read_secs, lines1);
+  
+  // Pass 2: The list sorter, holding the cache number of lines
+  reader.open(filename);
+  ListSorter list_sorter;
+  unsigned long hash2 = 2166136261UL;
+  unsigned long peak2 = 0;
+  unsigned long sorts2 = 0;
+  start = wallTime();
+  while(reader.nextLine(line)) {
+    if((line.length() > 0) && (line.at(0) == '%')) {
+      hash2 = sortHash(hash2, line);
+      continue;
+    }
+    ALogEntry entry;
+    entry.setTimeStamp(atof(getTimeStamp(line).c_str()));
+    entry.setRawLine(line);
+    if(list_sorter.addEntry(entry))
+      sorts2++;
+    if(list_sorter.size() > peak2)
+      peak2 = list_sorter.size();
+    if(list_sorter.size() > cache)
+      hash2 = sortHash(hash2, list_sorter.popEntry().getRawLine());
+  }
+  while(list_sorter.size() > 0)
+    hash2 = sortHash(hash2, list_sorter.popEntry().getRawLine());
+  report("ListSorter", reader.bytesRead(), wallTime()-start, lines1);
+  cout << "  re-sorts: " << sorts2 << ", peak lines held: " << peak2 << endl;
+
+  // Pass 3: The ALogSorter, holding the cache number of lines
+  reader.open(filename);
+  ALogSorter sorter;
+  sorter.setCacheSize(cache);
+  unsigned long hash3 = 2166136261UL;
+  unsigned long peak3 = 0;
+  unsigned long sorts3 = 0;
+  start = wallTime();
+  while(reader.nextLine(line)) {
+    if((line.length() > 0) && (line.at(0) == '%')) {
+      hash3 = sortHash(hash3, line);
+      continue;
+    }
+    double tstamp = atof(getTimeStamp(line).c_str());
+    if(sorter.addLine(tstamp, line.c_str(), line.length()))
+      sorts3++;
+    if(sorter.size() > peak3)
+      peak3 = sorter.size();
+    while(sorter.ready()) {
+      sorter.popLine(line);
+      hash3 = sortHash(hash3, line);
+    }
+  }
+  while(sorter.popLine(line))
+    hash3 = sortHash(hash3, line);
+  report("ALogSorter", reader.bytesRead(), wallTime()-start, lines1);
+  cout << "  re-sorts: " << sorts3 << ", peak lines held: " << peak3 << endl;
+
+  bool same_lines = (hash2 == hash3) && (sorts2 == sorts3);
+  cout << "Same sorted lines: " << boolToString(same_lines) << endl;
+  if(window <= 0)
+    return(same_lines);
+
+  // Pass 4: The ALogSorter, holding lines for the window of time.
+  // Not compared with the others, as a window differing from the
+  // cache may sort lines differently.
+  reader.open(filename);
+  ALogSorter wsorter;
+  wsorter.setWindow(window);
+  unsigned long peak4 = 0;
+  unsigned long sorts4 = 0;
+  double prev_tstamp = 0;
+  bool   first_pop = true;
+  unsigned long disorder4 = 0;
+  start = wallTime();
+  while(reader.nextLine(line)) {
+    if((line.length() > 0) && (line.at(0) == '%'))
+      continue;
+    double tstamp = atof(getTimeStamp(line).c_str());
+    if(wsorter.addLine(tstamp, line.c_str(), line.length()))
+      sorts4++;
+    if(wsorter.size() > peak4)
+      peak4 = wsorter.size();
+    while(wsorter.ready()) {
+      wsorter.popLine(line);
+      double pop_tstamp = atof(getTimeStamp(line).c_str());
+      if(!first_pop && (pop_tstamp < prev_tstamp))
+	disorder4++;
+      prev_tstamp = pop_tstamp;
+      first_pop = false;
+    }
+  }
+  while(wsorter.popLine(line)) {
+    double pop_tstamp = atof(getTimeStamp(line).c_str());
+    if(!first_pop && (pop_tstamp < prev_tstamp))
+      disorder4++;
+    prev_tstamp = pop_tstamp;
+    first_pop = false;
+  }
+  report("ALogSorter (window)", reader.bytesRead(), wallTime()-start, lines1);
+  cout << "  re-sorts: " << sorts4 << ", peak lines held: " << peak4
+       << ", left out of order: " << disorder4 << endl;
+
+  return(same_lines);
+}
+
+//--------------------------------------------------------
+// Procedure: runPlots()
+//   Purpose: Split the file as alogview does, then build the plots
+//            of every variable, and the helm plot, from the klog
+//            files as before, and from the klog column stores. The
+//            plots must be the same.
+//      Note: Stores left by an earlier run are removed first, so
+//            the first pass with stores includes building them.
+
+bool runPlots(const string& filename, double mintime, double maxtime)
+{
+  ALogDataBroker dbroker;
+  dbroker.addALogFile(filename);
+
+  double start = wallTime();
+  bool ok = dbroker.checkALogFiles();
+  ok = ok && dbroker.splitALogFiles();
+  ok = ok && dbroker.setTimingInfo();
+  if(!ok) {
+    cout << "Unable to split " << filename << endl;
+    return(false);
+  }
+  dbroker.setPrunedMinTime(mintime);
+  dbroker.setPrunedMaxTime(maxtime);
+  dbroker.cacheMasterIndices();
+  cout << "split:                " << doubleToString(wallTime()-start, 2)
+       << " secs, " << dbroker.sizeMix() << " variables" << endl;
+
+  string base_dir = filename;
+  rbiteString(base_dir, '.');
+  base_dir += "_alvtmp/";
+  for(unsigned int mix=0; mix<dbroker.sizeMix(); mix++) {
+    string klog = base_dir + dbroker.getVarNameFromMix(mix) + ".klog";
+    remove(KLogStore::storeFile(klog).c_str());
+  }
+  remove(KLogStore::storeFile(base_dir + "IVPHELM_SUMMARY.klog").c_str());
+
+  string labels[3] = {"klog text:", "stores (building):", "stores:"};
+  unsigned long hashes[3];
+  unsigned long rows[3];
+  for(unsigned int i=0; i<3; i++) {
+    dbroker.setUseStores(i > 0);
+    start = wallTime();
+    hashes[i] = plotPass(dbroker, rows[i]);
+    string pad = labels[i];
+    while(pad.length() < 22)
+      pad += " ";
+    cout << pad << doubleToString(wallTime()-start, 3) << " secs, "
+	 << rows[i] << " plot rows" << endl;
+  }
+
+  bool same_plots = ((hashes[0] == hashes[1]) && (hashes[0] == hashes[2]) &&
+		     (rows[0] == rows[1]) && (rows[0] == rows[2]));
+  cout << "Same plots: " << boolToString(same_plots) << endl;
+  return(same_plots);
+}
+
+//--------------------------------------------------------
+// Procedure: plotPass()
+//   Purpose: Build the LogPlot of each numerical variable, the
+//            VarPlot with sources of each variable, and the helm
+//            plot, hashing the contents of each.
+
+unsigned long plotPass(ALogDataBroker& dbroker, unsigned long& rows)
+{
+  unsigned long hash = 2166136261UL;
+  rows = 0;
+  for(unsigned int mix=0; mix<dbroker.sizeMix(); mix++) {
+    if(dbroker.getVarTypeFromMix(mix) != "string") {
+      LogPlot logplot = dbroker.getLogPlot(mix);
+      for(unsigned int i=0; i<logplot.size(); i++) {
+	hash = numHash(hash, logplot.getTimeByIndex(i));
+	hash = numHash(hash, logplot.getValueByIndex(i));
+      }
+      rows += logplot.size();
+    }
+
+    VarPlot varplot = dbroker.getVarPlot(mix, true);
+    for(unsigned int i=0; i<varplot.size(); i++) {
+      hash = numHash(hash, varplot.getTStampByIndex(i));
+      hash = sortHash(hash, varplot.getEntryByIndex(i));
+      hash = sortHash(hash, varplot.getSourceByIndex(i));
+    }
+    rows += varplot.size();
+  }
+
+  HelmPlot hplot = dbroker.getHelmPlot(0);
+  for(unsigned int i=0; i<hplot.size(); i++) {
+    hash = numHash(hash, hplot.getTimeByIndex(i));
+    hash = numHash(hash, hplot.getIterByIndex(i));
+  }
+  rows += hplot.size();
+  return(hash);
+}
+
+//--------------------------------------------------------
+// Procedure: numHash()
+//   Purpose: Fold a number, to full precision, into the hash.
+
+unsigned long numHash(unsigned long hash, double val)
+{
+  char buff[32];
+  snprintf(buff, 32, "%.17g", val);
+  return(sortHash(hash, buff));
+}
+
+//--------------------------------------------------------
+// Procedure: sortHash()
+//   Purpose: Fold a line into a running FNV-1a hash of the output,
+//            so the outputs of the sorters can be compared. The
+//            hash starts at 2166136261.
+
+unsigned long sortHash(unsigned long hash, const string& line)
+{
+  for(unsigned int i=0; i<=line.length(); i++) {
+    unsigned char c = (i < line.length()) ? line[i] : '\n';
+    hash = (hash ^ c) * 16777619UL;
+  }
+  return(hash);
+}
+
+//--------------------------------------------------------
+// Procedure: report()
+
+void report(const string& label, double bytes, double secs,
+	    unsigned long lines)
+{
+  string pad = label;
+  while(pad.length() < 22)
+    pad += " ";
+  
+  double gbps = 0;
+  if(secs > 0)
+    gbps = bytes / secs / 1000000000;
+  cout << pad << doubleToString(secs, 2) << " secs, "
+       << doubleToString(gbps, 3) << " GB/s, " << lines << " lines" << endl;
+}
+
+//--------------------------------------------------------
+// Procedure: fgetcLine()
+//   Purpose: Read a line a character at a time with fgetc(), with
+//            the same results as getNextRawLine().
+
+string fgetcLine(FILE *f)
+{
+  string str;
+  while(str.length() < ALOG_MAX_LINE_LENGTH) {
+    int c = fgetc(f);
+    if(c == EOF)
+      return("eof");
+    if(c == '\n')
+      break;
+    str.push_back((char)(c));
+  }
+  return(str);
+}
+
+//--------------------------------------------------------
+// Procedure: wallTime()
+
+double wallTime()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return((double)(tv.tv_sec) + ((double)(tv.tv_usec) / 1000000.0));
+}
+
+//--------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{ 
+  cout << "Usage:                                              " << endl;
+  cout << "  alogbench [OPTIONS] [file.alog]                   " << endl;
+  cout << "                                                    " << endl;
+  cout << "Synopsis:                                           " << endl;
+  cout << "  Time the alog line readers on the given file: a   " << endl;
+  cout << "  character at a time with fgetc(), the LogUtils    " << endl;
+  cout << "  getNextRawLine() and getNextRawALogEntry(), and   " << endl;
+  cout << "  the BufferedLineReader giving lines and entries.  " << endl;
+  cout << "  Reports the throughput of each in GB/s and checks " << endl;
+  cout << "  that all readers find the same lines.             " << endl;
+  cout << "  With --sort, instead time sorting the file as     " << endl;
+  cout << "  alogsort does, with the old list sorter and the   " << endl;
+  cout << "  ALogSorter, checking both sort the same way.      " << endl;
+  cout << "  With --plots, instead split the file and time the " << endl;
+  cout << "  building of plots from the klog files, and from   " << endl;
+  cout << "  the klog column stores, checking both agree.      " << endl;
+  cout << "                                                    " << endl;
+  cout << "Options:                                            " << endl;
+  cout << "  --help, -h                                        " << endl;
+  cout << "    Display this help message                       " << endl;
+  cout << "  --make=<file>                                     " << endl;
+  cout << "    Write a synthetic alog file of helm-like        " << endl;
+  cout << "    postings, then time it if no other file given   " << endl;
+  cout << "  --size=<MB>       (default 2000)                  " << endl;
+  cout << "    Size of the synthetic alog file in MB           " << endl;
+  cout << "  --skew=<secs>     (default 0)                     " << endl;
+  cout << "    Stamp synthetic postings up to secs early,      " << endl;
+  cout << "    leaving the file out of order                   " << endl;
+  cout << "  --sort                                            " << endl;
+  cout << "    Time the sorters rather than the readers        " << endl;
+  cout << "  --cache=<N>       (default 1000)                  " << endl;
+  cout << "    Lines held by the sorters for re-ordering       " << endl;
+  cout << "  --window=<secs>                                   " << endl;
+  cout << "    Also time the ALogSorter holding lines until    " << endl;
+  cout << "    secs older than the newest line read            " << endl;
+  cout << "  --plots                                           " << endl;
+  cout << "    Time the plots rather than the readers          " << endl;
+  cout << "  --mintime=<secs>, --maxtime=<secs>                " << endl;
+  cout << "    Prune the plots to the time range, as alogview  " << endl;
+  cout << "                                                    " << endl;
+  cout << "Examples:                                           " << endl;
+  cout << "  alogbench --make=synth.alog --size=4000           " << endl;
+  cout << "  alogbench synth.alog                              " << endl;
+  cout << "  alogbench --make=skew.alog --size=500 --skew=2    " << endl;
+  cout << "  alogbench --sort --cache=5000 --window=2 skew.alog" << endl;
+  cout << "  alogbench --plots --mintime=600 synth.alog        " << endl;
+  exit(0);
+}
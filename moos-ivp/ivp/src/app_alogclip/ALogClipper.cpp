@@ -34,7 +34,6 @@ using namespace std;
 
 ALogClipper::ALogClipper()
 {
-  m_infile  = 0;
   m_outfile = 0;
 
   m_kept_chars          = 0;
@@ -53,8 +52,8 @@ ALogClipper::ALogClipper()
 
 unsigned int ALogClipper::clip(double min_time, double max_time)
 {
-  while(m_infile) {
-    string line = getNextLine();
+  string line;
+  while(m_reader.nextLine(line)) {
 
     string linecopy  = line;    
     string timestr   = biteStringX(linecopy, ' ');
@@ -92,45 +91,6 @@ unsigned int ALogClipper::clip(double min_time, double max_time)
 // Procedure: getNextLine
 //     Notes: 
 
-string ALogClipper::getNextLine()
-{
-  if(!m_infile)
-    return("");
-  
-  const int MAX_LINE_LENGTH = 50000;
-
-  int  myint   = '\0';
-  int  buffix  = 0;
-  bool EOL     = false;
-  char buff[MAX_LINE_LENGTH];
-
-  while((!EOL) && (buffix < MAX_LINE_LENGTH)) {
-    myint = fgetc(m_infile);
-    unsigned char mychar = myint;
-    switch(myint) {
-    case EOF:
-      fclose(m_infile);
-      m_infile = 0;
-      buff[buffix] = '\0';  // attach terminating NULL
-      EOL = true;
-      break;
-    case '\n':
-      buff[buffix] = '\0';  // attach terminating NULL
-      EOL = true;
-      break;
-    default:
-      buff[buffix] = mychar;
-      buffix++;
-    }
-  }
-  string str = buff;
-  return(str);
-}
-
-//--------------------------------------------------------
-// Procedure: getNextLine
-//     Notes: 
-
 bool ALogClipper::writeNextLine(const string& line)
 {
   if(!m_outfile)
@@ -146,14 +106,7 @@ bool ALogClipper::writeNextLine(const string& line)
 
 bool ALogClipper::openALogFileRead(string alogfile)
 {
-  if(m_infile)
-    fclose(m_infile);
-
-  m_infile = fopen(alogfile.c_str(), "r");
-  if(!m_infile)
-    return(false);
-  else
-    return(true);
+  return(m_reader.open(alogfile));
 }
 
 //--------------------------------------------------------
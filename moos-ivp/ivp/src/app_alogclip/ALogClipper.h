@@ -26,6 +26,7 @@
 
 #include <string>
 #include <vector>
+#include "BufferedLineReader.h"
 
 class ALogClipper
 {
@@ -40,7 +41,6 @@ class ALogClipper
   unsigned int getDetails(const std::string& statevar);
 
  protected:
-  std::string getNextLine();
   bool        writeNextLine(const std::string& output);
 
   unsigned int m_kept_chars;
@@ -51,7 +51,7 @@ class ALogClipper
   unsigned int m_clipped_lines_back;
 
  private:
-  FILE *m_infile;
+  BufferedLineReader m_reader;
   FILE *m_outfile;
 
   std::vector<std::string> m_preserve_vars;
@@ -38,7 +38,6 @@ using namespace std;
 
 GrepHandler::GrepHandler()
 {
-  m_file_in  = 0;
   m_file_out = 0;
 
   m_lines_removed  = 0;
@@ -89,7 +88,7 @@ bool GrepHandler::setALogFile(string alogfile)
   // Part 1: Sanity Checks
   if(alogfile == "")
     return(false);
-  if(m_file_in && m_file_out) {
+  if(m_reader_in.isOpen() && m_file_out) {
     cout << "input and output alog files already specified" << endl;
     return(false);
   }
@@ -97,9 +96,8 @@ bool GrepHandler::setALogFile(string alogfile)
   
   // =====================================================
   // Part 2: If no input file yet, treat this as input file
-  if(!m_file_in) {
-    m_file_in = fopen(alogfile.c_str(), "r");
-    if(!m_file_in) {
+  if(!m_reader_in.isOpen()) {
+    if(!m_reader_in.open(alogfile)) {
       cout << "Unable to open file for reading: " << alogfile << endl;
       return(false);
     }
@@ -149,7 +147,7 @@ bool GrepHandler::setALogFile(string alogfile)
 
 bool GrepHandler::handle()
 {
-  if(!m_file_in) {
+  if(!m_reader_in.isOpen()) {
     cout << "No input alog file given - exiting" << endl;    
     return(false);
   }
@@ -167,57 +165,45 @@ bool GrepHandler::handle()
   // ==========================================================
   ALogSorter sorter;
   sorter.checkForDuplicates(m_rm_duplicates);
+  sorter.setCacheSize((unsigned int)(m_cache_size));
   
-  bool done_reading_raw    = false;
-  bool done_reading_sorted = false;
-  while(!done_reading_sorted) {
-
-    if(!done_reading_raw) {
-      string line_raw = getNextRawLine(m_file_in);
-    
-      // Part 1: Check for end of file
-      if(line_raw == "eof") 
-	done_reading_raw = true;
-      else { 
-	if(!checkRetain(line_raw))
-	  ignoreLine(line_raw);
-	else {
-	  if(!m_sort_entries) {
-	    outputLine(line_raw);
-	    if(m_first_only)
-	      done_reading_sorted = true;
-	  }
-	  else {
-	    string stime = getTimeStamp(line_raw);
-	    double dtime = atof(stime.c_str());
-	    
-	    ALogEntry entry; 
-	    entry.setTimeStamp(dtime);
-	    entry.setRawLine(line_raw);
-	    
-	    bool re_sort_noted = sorter.addEntry(entry);
-	    if(re_sort_noted) 
-	      m_re_sorts++;
-
-	  }
-	}
-      }
+  string line_raw;
+  bool done = false;
+  while(!done && m_reader_in.nextLine(line_raw)) {
+    // Part 1: Handle the line, either output or added to the sorter
+    if(!checkRetain(line_raw))
+      ignoreLine(line_raw);
+    else if(!m_sort_entries) {
+      outputLine(line_raw);
+      if(m_first_only)
+	done = true;
+    }
+    else {
+      string stime = getTimeStamp(line_raw);
+      double dtime = atof(stime.c_str());
+      
+      bool re_sort_noted = sorter.addLine(dtime, line_raw.c_str(),
+					  line_raw.length());
+      if(re_sort_noted) 
+	m_re_sorts++;
     }
 
-    // Part 2: pull back the sorted line from the sorter, if any left
-    if((sorter.size() > m_cache_size) || done_reading_raw) {
-      if(sorter.size() == 0) 
-	done_reading_sorted = true;
-      else {
-	ALogEntry entry = sorter.popEntry();
-	string line_raw = entry.getRawLine();
-	outputLine(line_raw);
-	if(m_first_only)
-	  done_reading_sorted = true;
-      }
+    // Part 2: Pull back sorted lines no longer waiting on later lines
+    while(!done && sorter.ready()) {
+      sorter.popLine(line_raw);
+      outputLine(line_raw);
+      if(m_first_only)
+	done = true;
     }
   }
 
+  // Part 3: All lines read, pull back the remaining sorted lines
+  while(!done && sorter.popLine(line_raw)) {
+    outputLine(line_raw);
+    if(m_first_only)
+      done = true;
+  }
+
   // ==========================================================
   // Phase 3: Handle last line only case
   // ==========================================================
@@ -227,8 +213,7 @@ bool GrepHandler::handle()
   
   if(m_file_out)
     fclose(m_file_out);
-  if(m_file_in)
-    fclose(m_file_in);
+  m_reader_in.close();
   
   return(true);
 }
@@ -276,20 +261,16 @@ bool GrepHandler::checkRetain(string& line_raw)
 
 string GrepHandler::quickPassGetVName(string alogfile)
 {
-  FILE* f = fopen(alogfile.c_str(), "r");
-  if(!f)
+  BufferedLineReader reader;
+  if(!reader.open(alogfile))
     return("");
 
   string vname;
-  while(1) {
-    string line_raw = getNextRawLine(f);
-    
+  string line_raw;
+  while(reader.nextLine(line_raw)) {
     // Part 1: Check if the line is a comment and handle or ignore
     if((line_raw.length() > 0) && (line_raw.at(0) == '%')) 
       continue;
-    // Part 2: Check for end of file
-    if(line_raw == "eof") 
-      break;
 
     // Part 3: Handle lines that do not begin with a number (comment
     // lines are already handled above)
@@ -305,7 +286,6 @@ string GrepHandler::quickPassGetVName(string alogfile)
       break;
     }
   }
-  fclose(f);
   return(vname);
 }
 
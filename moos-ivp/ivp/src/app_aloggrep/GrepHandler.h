@@ -27,6 +27,7 @@
 #include <vector>
 #include <string>
 #include <set>
+#include "BufferedLineReader.h"
 
 class GrepHandler
 {
@@ -88,7 +89,7 @@ class GrepHandler
   std::string m_filename_in;
   std::vector<std::string> m_subpat;
   
-  FILE *m_file_in;
+  BufferedLineReader m_reader_in;
   FILE *m_file_out;
 
  protected: // State vars
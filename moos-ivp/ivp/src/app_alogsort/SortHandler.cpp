@@ -39,10 +39,10 @@ using namespace std;
 
 SortHandler::SortHandler()
 {
-  m_file_in  = 0;
   m_file_out = 0;
 
   m_cache_size  = 1000;
+  m_window      = 0;
   m_total_lines = 0;
   m_re_sorts    = 0;
 
@@ -60,8 +60,7 @@ bool SortHandler::handleSort(const string& alogfile, const string& new_alogfile)
     return(false);
   }
 
-  m_file_in = fopen(alogfile.c_str(), "r");
-  if(!m_file_in) {
+  if(!m_reader_in.open(alogfile)) {
     cout << "input not found or unable to open - exiting" << endl;
     return(false);
   }
@@ -86,63 +85,51 @@ bool SortHandler::handleSort(const string& alogfile, const string& new_alogfile)
   }
   
   ALogSorter sorter;
-
-  bool done_reading_raw    = false;
-  bool done_reading_sorted = false;
-  while(!done_reading_sorted) {
-
-    // Step 1: grab the raw line, if any left,  and add to the sorter
-    if(!done_reading_raw) {
-      string    line_raw = getNextRawLine(m_file_in);
-      
-      // Check if line is a comment
-      if((line_raw.length() > 0) && (line_raw.at(0) == '%')) {
-	if(m_file_out)
-	  fprintf(m_file_out, "%s\n", line_raw.c_str());
-	else
-	  cout << line_raw << endl;
-      }
-
-      else if(line_raw == "eof")
-	done_reading_raw = true;
-      else {
-	string    stime = getTimeStamp(line_raw);
-	double    dtime = atof(stime.c_str());
-
-	ALogEntry entry; 
-	entry.setTimeStamp(dtime);
-	entry.setRawLine(line_raw);
+  sorter.setCacheSize(m_cache_size);
+  sorter.setWindow(m_window);
+
+  string line_raw;
+  while(m_reader_in.nextLine(line_raw)) {
+
+    // Step 1: Add the raw line to the sorter unless a comment
+    if((line_raw.length() > 0) && (line_raw.at(0) == '%')) {
+      if(m_file_out)
+	fprintf(m_file_out, "%s\n", line_raw.c_str());
+      else
+	cout << line_raw << endl;
+    }
+    else {
+      string stime = getTimeStamp(line_raw);
+      double dtime = atof(stime.c_str());
       
-	bool re_sort_noted = sorter.addEntry(entry);
-	if(re_sort_noted) {
-	  m_re_sorts++;
-	  //cout << "re-sorted:" << entry.getRawLine() << endl;
-	}
-	  
-      }
+      bool re_sort_noted = sorter.addLine(dtime, line_raw.c_str(),
+					  line_raw.length());
+      if(re_sort_noted)
+	m_re_sorts++;
     }
      
-    // Step 2: pull back the sorted line from the sorter, if any left
-    if((sorter.size() > m_cache_size) || done_reading_raw) {
-      if(sorter.size() == 0) 
-	done_reading_sorted = true;
-      else {
-	ALogEntry entry = sorter.popEntry();
-	string line_raw = entry.getRawLine();
-	if(m_file_out)
-	  fprintf(m_file_out, "%s\n", line_raw.c_str());
-	else
-	  cout << line_raw << endl;
-      }
+    // Step 2: Pull back sorted lines no longer waiting on later lines
+    while(sorter.ready()) {
+      sorter.popLine(line_raw);
+      if(m_file_out)
+	fprintf(m_file_out, "%s\n", line_raw.c_str());
+      else
+	cout << line_raw << endl;
     }
   }
 
+  // Step 3: All lines read, pull back the remaining sorted lines
+  while(sorter.popLine(line_raw)) {
+    if(m_file_out)
+      fprintf(m_file_out, "%s\n", line_raw.c_str());
+    else
+      cout << line_raw << endl;
+  }
+
   if(m_file_out)
     fclose(m_file_out);
   m_file_out = 0;
-  if(m_file_in)
-    fclose(m_file_in);
-  m_file_in = 0;
+  m_reader_in.close();
 
   return(true);
 }
@@ -152,26 +139,21 @@ bool SortHandler::handleSort(const string& alogfile, const string& new_alogfile)
 
 bool SortHandler::handleCheck(const string& alogfile)
 {
-  m_file_in = fopen(alogfile.c_str(), "r");
-  if(!m_file_in) {
+  if(!m_reader_in.open(alogfile)) {
     cout << "input not found or unable to open - exiting" << endl;
     return(false);
   }
   
+  string line_raw;
   string prev_line_raw;
   double prev_timestamp = 0;
   bool   first = true;
-  bool   done  = false;
-  while(!done) {
-    string line_raw = getNextRawLine(m_file_in);
-    
+  while(m_reader_in.nextLine(line_raw)) {
     bool line_is_comment = false;
     if((line_raw.length() > 0) && (line_raw.at(0) == '%'))
       line_is_comment = true;
 
-    if(line_raw == "eof") 
-      done = true;
-    else if(!line_is_comment) {
+    if(!line_is_comment) {
       string timestamp = getTimeStamp(line_raw);
       double double_timestamp = atof(timestamp.c_str());
       if(first == true) {
@@ -189,6 +171,7 @@ bool SortHandler::handleCheck(const string& alogfile)
       prev_timestamp = double_timestamp;
     }
   }
+  m_reader_in.close();
 
   return(true);
 }
@@ -200,7 +183,10 @@ bool SortHandler::handleCheck(const string& alogfile)
 void SortHandler::printReport()
 {
   cout << "  Total lines: " << uintToString(m_total_lines) << endl;
-  cout << "  Cache size : " << uintToString(m_cache_size)  << endl;
+  if(m_window > 0)
+    cout << "  Window     : " << doubleToStringX(m_window) << endl;
+  else
+    cout << "  Cache size : " << uintToString(m_cache_size)  << endl;
   cout << "  Re-Sorts :   " << uintToString(m_re_sorts)    << endl;
   cout << endl;
 }
@@ -27,6 +27,7 @@
 #include <vector>
 #include <string>
 #include <set>
+#include "BufferedLineReader.h"
 
 class SortHandler
 {
@@ -38,18 +39,20 @@ class SortHandler
   bool handleCheck(const std::string&);
   void printReport();
   void setCacheSize(unsigned int v) {m_cache_size=v;}
+  void setWindow(double v)          {m_window=v;}
   void setFileOverWrite(bool v)     {m_file_overwrite=v;}
 
   unsigned int getCacheSize() const {return(m_cache_size);}
   
  protected:
   unsigned int m_cache_size;
+  double       m_window;
   unsigned int m_total_lines;
   unsigned int m_re_sorts;
 
   bool  m_file_overwrite;
 
-  FILE *m_file_in;
+  BufferedLineReader m_reader_in;
   FILE *m_file_out;
 };
 
@@ -75,6 +75,9 @@ int main(int argc, char *argv[])
     cout << "  -f,--force    Force overwrite of existing file           " << endl;
     cout << "  -c,--check    Just check the ordering with no sorting    " << endl;
     cout << "  -q,--quiet    Verbose report suppressed at conclusion    " << endl;
+    cout << "  --cache=N     Hold N entries for re-ordering (1000)      " << endl;
+    cout << "  --window=S    Hold entries until S secs older than the   " << endl;
+    cout << "                newest entry read. Overrides --cache       " << endl;
     cout << "                                                           " << endl;
     cout << "See also:                                                  " << endl;
     cout << "  aloggrep, alogscan, alogrm, alogclip, alogview           " << endl;
@@ -85,6 +88,7 @@ int main(int argc, char *argv[])
   string alogfile_in;
   string alogfile_out;
   string cache_size = "1000";
+  string window;
 
   for(int i=1; i<argc; i++) {
     string argi = argv[i];
@@ -96,6 +100,8 @@ int main(int argc, char *argv[])
     }
     if(strBegins(argi, "--cache="))
       cache_size = argi.substr(8);
+    else if(strBegins(argi, "--window="))
+      window = argi.substr(9);
   }
  
   if(alogfile_in == "") {
@@ -112,6 +118,13 @@ int main(int argc, char *argv[])
     unsigned int csize = (unsigned int)(atof(cache_size.c_str()));
     handler.setCacheSize(csize);
   }
+  if(window != "") {
+    if(!isNumber(window) || (atof(window.c_str()) < 0)) {
+      cout << "Bad --window value: " << window << " - exiting" << endl;
+      exit(1);
+    }
+    handler.setWindow(atof(window.c_str()));
+  }
 
   if(check_only) {
     bool in_order = handler.handleCheck(alogfile_in);
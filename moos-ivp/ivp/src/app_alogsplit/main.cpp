@@ -71,6 +71,8 @@ int main(int argc, char *argv[])
     cout << "                                                           " << endl;
     cout << "  --max_fptrs=N  Set max number of OS file pointers allowed" << endl;
     cout << "                 to be open during splitting. Default 125. " << endl;
+    cout << "  --threads=N    Split on N threads, the file in chunks and " << endl;
+    cout << "                 written by N writers. Default 1.          " << endl;
     cout << "                                                           " << endl;
     cout << "  --detached=var      Split out all keys from complex var post " << endl;
     cout << "  --detached=var:key  Split out key from complex var post " << endl;
@@ -89,6 +91,7 @@ int main(int argc, char *argv[])
   string alogfile_in;
   string given_dir;
   string max_fptrs;
+  string threads;
   vector<string> detached_pairs;
   
   bool verbose = false;
@@ -106,6 +109,8 @@ int main(int argc, char *argv[])
       verbose = true;
     else if(strBegins(sarg, "--max_fptrs="))
       max_fptrs = sarg.substr(12);
+    else if(strBegins(sarg, "--threads="))
+      threads = sarg.substr(10);
     else if(strBegins(sarg, "--detached="))
       detached_pairs.push_back(sarg.substr(11));
     else if(strBegins(sarg, "--dir=")) 
@@ -133,6 +138,15 @@ int main(int argc, char *argv[])
     int int_max_fptrs = atoi(max_fptrs.c_str());
     handler.setMaxFilePtrCache((unsigned int)(int_max_fptrs));
   }
+
+  if(threads != "") {
+    int int_threads = atoi(threads.c_str());
+    if(!isNumber(threads) || (int_threads < 1)) {
+      cout << "Bad --threads value: " << threads << endl;
+      exit(1);
+    }
+    handler.setThreads((unsigned int)(int_threads));
+  }
   
   bool handled = handler.handle();
   if(!handled)
@@ -209,6 +209,8 @@ bool LogViewLauncher::handleConfigParam(string argi)
     m_verbose = true;
   else if((argi == "--quick") || (argi == "-q")) 
     m_quick_start = true;
+  else if(argi == "--nokcol") 
+    m_dbroker.setUseStores(false);
   else if(strBegins(argi, "--altnav=")) 
     m_alt_nav_prefix = argi.substr(9);
   else
@@ -134,6 +134,8 @@ void help_message()
   cout << "                                                              " << endl;
   cout << "  --quick,-q      Quick start (no geo shapes, logplots)       " << endl;
   cout << "  --altnav=PREF   Alt nav solution prefix, e.g., NAV_GT_      " << endl;
+  cout << "  --nokcol        Read klog files directly, without building  " << endl;
+  cout << "                  or using the .kcol column stores.           " << endl;
   cout << "                                                              " << endl;
   cout << "  --zoom=val      Set initial zoom value (default: 1)         " << endl;
   cout << "  --panx=val      Set initial panx value (default: 0)         " << endl;
@@ -0,0 +1,85 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: AOF_Avoid.cpp                                        */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include "AOF_Avoid.h"
+#include "AngleUtils.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Constructor
+
+AOF_Avoid::AOF_Avoid(IvPDomain domain) : AOF(domain)
+{
+  m_crs_ix    = domain.getIndex("course");
+  m_spd_ix    = domain.getIndex("speed");
+  m_bearing   = 0;
+  m_spread    = 60;
+  m_max_speed = 1;
+}
+
+//----------------------------------------------------------------
+// Procedure: setParam
+ 
+bool AOF_Avoid::setParam(const string& param, double value)
+{
+  if(param == "bearing")
+    m_bearing = angle360(value);
+  else if((param == "spread") && (value > 0))
+    m_spread = value;
+  else
+    return(false);
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: initialize
+
+bool AOF_Avoid::initialize()
+{
+  if((m_crs_ix == -1) || (m_spd_ix == -1))
+    return(false);
+
+  m_max_speed = m_domain.getVarHigh(m_spd_ix);
+  if(m_max_speed <= 0)
+    m_max_speed = 1;
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalBox
+
+double AOF_Avoid::evalBox(const IvPBox *b) const
+{
+  double crs = 0;
+  double spd = 0;
+  m_domain.getVal(m_crs_ix, b->pt(m_crs_ix,0), crs);
+  m_domain.getVal(m_spd_ix, b->pt(m_spd_ix,0), spd);
+
+  double diff = angleDiff(crs, m_bearing);
+  if(diff >= m_spread)
+    return(100);
+
+  double closeness = 1 - (diff / m_spread);
+  return(100 - (100 * closeness * (spd / m_max_speed)));
+}
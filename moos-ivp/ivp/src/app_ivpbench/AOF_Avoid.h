@@ -0,0 +1,55 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: AOF_Avoid.h                                          */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef AOF_AVOID_BENCH_HEADER
+#define AOF_AVOID_BENCH_HEADER
+
+#include <string>
+#include "AOF.h"
+
+//---------------------------------------------------------------
+// A stand-in for a collision avoidance objective function. Each
+// heading within the given spread of the bearing to a contact is
+// penalized, the more so the closer to the bearing and the 
+// faster the speed. Cheap to evaluate, but needing many pieces,
+// much like the functions built by the avoidance behaviors.
+
+class AOF_Avoid: public AOF {
+ public:
+  AOF_Avoid(IvPDomain domain);
+  ~AOF_Avoid() {}
+  
+ public:
+  double evalBox(const IvPBox *b) const;  // Virtual Defined
+  bool   setParam(const std::string&, double);
+  bool   initialize();
+
+private:
+  int    m_crs_ix;
+  int    m_spd_ix;
+  double m_bearing;
+  double m_spread;
+  double m_max_speed;
+};
+
+#endif
@@ -0,0 +1,964 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdlib>
+#include <ctime>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "MBUtils.h"
+#include "IvPBox.h"
+#include "IvPDomain.h"
+#include "IvPFunction.h"
+#include "IvPProblem.h"
+#include "IvPProblem_Par.h"
+#include "WorkerPool.h"
+#include "AngleUtils.h"
+#include "BuildUtils.h"
+#include "FunctionEncoder.h"
+#include "FunctionEncoderMK.h"
+#include "FunctionEncoderPK.h"
+#include "OF_Coupler.h"
+#include "OF_Reflector.h"
+#include "ZAIC_PEAK.h"
+#include "AOF_Avoid.h"
+#include "AOF_Gaussian.h"
+#include "AOF_Waypoint.h"
+#include "AOF_AvoidCollision.h"
+#include "CPAEngine.h"
+#include "CPAEngineV15.h"
+
+using namespace std;
+
+void showHelpAndExit();
+vector<IvPFunction*> buildFunctions(const IvPDomain&, unsigned int);
+vector<IvPFunction*> buildFunctions(const IvPDomain&, double crs, 
+				    double spd, const vector<double>& brgs,
+				    const vector<double>& spreads, 
+				    double depth);
+double solveAll(vector<vector<IvPFunction*> >&, const IvPDomain&,
+		bool flat, unsigned int reps, vector<double>& results,
+		unsigned long& allocs, WorkerPool *pool=0);
+bool   runParallel(const IvPDomain&, unsigned int problems, 
+		   unsigned int reps);
+bool   runMission(const IvPDomain&, unsigned int contacts, 
+		  unsigned int steps, unsigned int reps);
+double solveStep(vector<IvPFunction*>&, const IvPDomain&, 
+		 const vector<double>& warm, unsigned int reps,
+		 vector<double>& results, double& leafs);
+bool   runEncoding(const IvPDomain&, unsigned int problems, 
+		   unsigned int reps);
+bool   sameFunction(IvPFunction*, IvPFunction*);
+bool   runAOFs(unsigned int reps);
+bool   timeAOF(const std::string& label, const AOF&, unsigned int reps);
+bool   runCPA(unsigned int contacts, unsigned int reps);
+bool   runBuild(const IvPDomain&, unsigned int problems,
+		unsigned int contacts, unsigned int reps);
+
+// Every allocation in the program is counted, so the number made
+// while solving can be reported. Each thread keeps its own count,
+// and only those of the main thread are reported.
+static thread_local unsigned long g_allocs = 0;
+
+void *operator new(size_t size)
+{
+  g_allocs++;
+  void *ptr = malloc(size ? size : 1);
+  if(!ptr)
+    throw std::bad_alloc();
+  return(ptr);
+}
+
+void operator delete(void *ptr) throw()
+{
+  free(ptr);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+//   Purpose: Time the IvP solver, solving with and without the
+//            flattened pdmaps, on helm-like problems over course
+//            and speed, and over course, speed and depth. Then
+//            time a mission of slowly changing problems solved
+//            with and without the previous decision as a start.
+//            Optionally time the parallel solver over a range of
+//            functions and threads, the function encoders and
+//            the evaluation of AOFs point by point and in batches,
+//            the CPA engines, and the building and freeing of
+//            functions.
+
+int main(int argc, char *argv[])
+{ 
+  unsigned int problems = 20;
+  unsigned int contacts = 4;
+  unsigned int reps     = 50;
+  unsigned int seed     = 1;
+  unsigned int steps    = 200;
+  bool         parallel = false;
+  bool         encode   = false;
+  bool         aofs     = false;
+  bool         cpas     = false;
+  bool         builds   = false;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i]; 
+    bool handled = true;
+    if((argi == "-h") || (argi == "--help"))
+      showHelpAndExit();
+    else if(strBegins(argi, "--problems="))
+      handled = setPosUIntOnString(problems, argi.substr(11));
+    else if(strBegins(argi, "--contacts="))
+      handled = setUIntOnString(contacts, argi.substr(11));
+    else if(strBegins(argi, "--reps="))
+      handled = setPosUIntOnString(reps, argi.substr(7));
+    else if(strBegins(argi, "--seed="))
+      handled = setUIntOnString(seed, argi.substr(7));
+    else if(strBegins(argi, "--steps="))
+      handled = setUIntOnString(steps, argi.substr(8));
+    else if(argi == "--par")
+      parallel = true;
+    else if(argi == "--encode")
+      encode = true;
+    else if(argi == "--aof")
+      aofs = true;
+    else if(argi == "--cpa")
+      cpas = true;
+    else if(argi == "--build")
+      builds = true;
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Bad Arg:[" << argi << "]. Exiting." << endl;
+      exit(1);
+    }    
+  }
+  srand(seed);
+
+  IvPDomain domain_2d;
+  domain_2d.addDomain("course", 0, 359, 360);
+  domain_2d.addDomain("speed", 0, 5, 51);
+
+  IvPDomain domain_3d = domain_2d;
+  domain_3d.addDomain("depth", 0, 100, 101);
+
+  bool all_ok = true;
+  for(unsigned int dims=2; dims<=3; dims++) {
+    IvPDomain domain = domain_2d;
+    if(dims == 3)
+      domain = domain_3d;
+
+    vector<vector<IvPFunction*> > ipfs;
+    for(unsigned int i=0; i<problems; i++)
+      ipfs.push_back(buildFunctions(domain, contacts));
+
+    vector<double> box_results, flat_results;
+    unsigned long  box_allocs, flat_allocs;
+    double box_time  = solveAll(ipfs, domain, false, reps, box_results,
+				box_allocs);
+    double flat_time = solveAll(ipfs, domain, true, reps, flat_results,
+				flat_allocs);
+
+    bool same = (box_results == flat_results);
+    bool none = (box_allocs == 0) && (flat_allocs == 0);
+    all_ok = all_ok && same && none;
+
+    unsigned int solves = problems * reps;
+    cout << dims << "D problems: " << problems << " with " 
+	 << ipfs[0].size() << " functions, solved " << reps 
+	 << " times each" << endl;
+    cout << "  IvPBox solve:    " << doubleToString(1000*box_time/solves, 3)
+	 << " ms, " << box_allocs/solves << " allocations per solve" << endl;
+    cout << "  PDMapFlat solve: " << doubleToString(1000*flat_time/solves, 3)
+	 << " ms, " << flat_allocs/solves << " allocations per solve" << endl;
+    if(flat_time > 0)
+      cout << "  Speedup:         " << doubleToString(box_time/flat_time, 2)
+	   << endl;
+    cout << "  Same decisions:  " << boolToString(same) << endl;
+    cout << "  No allocations:  " << boolToString(none) << endl;
+
+    for(unsigned int i=0; i<ipfs.size(); i++)
+      for(unsigned int j=0; j<ipfs[i].size(); j++)
+	delete(ipfs[i][j]);
+  }
+
+  if(steps > 0)
+    all_ok = runMission(domain_2d, contacts, steps, reps) && all_ok;
+
+  if(parallel)
+    all_ok = runParallel(domain_2d, problems, reps) && all_ok;
+  
+  if(encode)
+    all_ok = runEncoding(domain_2d, problems, reps) && all_ok;
+
+  if(aofs)
+    all_ok = runAOFs(reps) && all_ok;
+
+  if(cpas)
+    all_ok = runCPA(contacts, reps) && all_ok;
+
+  if(builds)
+    all_ok = runBuild(domain_3d, problems, contacts, reps) && all_ok;
+
+  return(all_ok ? 0 : 1);
+}
+
+//--------------------------------------------------------
+// Procedure: buildFunctions()
+//   Purpose: Build the functions of a problem, as below, with
+//            random parameters.
+
+vector<IvPFunction*> buildFunctions(const IvPDomain& domain, 
+				    unsigned int contacts)
+{
+  double crs = rand() % 360;
+  double spd = 1 + (rand() % 30) / 10.0;
+
+  vector<double> brgs, spreads;
+  for(unsigned int i=0; i<contacts; i++) {
+    brgs.push_back(rand() % 360);
+    spreads.push_back(30 + (rand() % 60));
+  }
+
+  double depth = 0;
+  if(domain.hasDomain("depth"))
+    depth = rand() % 100;
+
+  return(buildFunctions(domain, crs, spd, brgs, spreads, depth));
+}
+
+//--------------------------------------------------------
+// Procedure: buildFunctions()
+//   Purpose: One waypoint-like function over course and speed, an
+//            avoidance function for each contact and, if the domain
+//            has depth, a function over depth alone.
+
+vector<IvPFunction*> buildFunctions(const IvPDomain& domain, double crs, 
+				    double spd, const vector<double>& brgs,
+				    const vector<double>& spreads, 
+				    double depth)
+{
+  vector<IvPFunction*> ipfs;
+
+  IvPDomain crs_domain = subDomain(domain, "course");
+  IvPDomain spd_domain = subDomain(domain, "speed");
+
+  ZAIC_PEAK crs_zaic(crs_domain, "course");
+  crs_zaic.setParams(crs, 0, 180, 50, 0, 100);
+  crs_zaic.setValueWrap(true);
+  
+  ZAIC_PEAK spd_zaic(spd_domain, "speed");
+  spd_zaic.setParams(spd, 0.1, 2, 20, 0, 100);
+
+  OF_Coupler coupler;
+  IvPFunction *wpt_ipf = coupler.couple(crs_zaic.extractIvPFunction(),
+					spd_zaic.extractIvPFunction(),
+					50, 50);
+  wpt_ipf->setPWT(100);
+  ipfs.push_back(wpt_ipf);
+
+  IvPDomain cs_domain = subDomain(domain, "course,speed");
+  for(unsigned int i=0; (i<brgs.size()) && (i<spreads.size()); i++) {
+    AOF_Avoid aof(cs_domain);
+    aof.setParam("bearing", brgs[i]);
+    aof.setParam("spread", spreads[i]);
+    aof.initialize();
+
+    OF_Reflector reflector(&aof, 1);
+    reflector.setParam("uniform_piece", "discrete @ course:3,speed:3");
+    reflector.create();
+    IvPFunction *ipf = reflector.extractIvPFunction();
+    ipf->setPWT(200);
+    ipfs.push_back(ipf);
+  }
+
+  if(domain.hasDomain("depth")) {
+    ZAIC_PEAK dep_zaic(subDomain(domain, "depth"), "depth");
+    dep_zaic.setParams(depth, 5, 20, 20, 0, 100);
+    IvPFunction *ipf = dep_zaic.extractIvPFunction();
+    ipf->setPWT(100);
+    ipfs.push_back(ipf);
+  }
+
+  return(ipfs);
+}
+
+//--------------------------------------------------------
+// Procedure: solveAll()
+//   Purpose: Solve each problem reps times, noting the decision
+//            of each, and return the total CPU time in seconds
+//            spent in IvPProblem::solve(). The allocations made in
+//            IvPProblem::solve() are totalled in allocs, after the
+//            problem has made its room in prepareSolve(). If a pool
+//            is given the parallel solver is used, and the time is
+//            the elapsed time rather than CPU time.
+//      Note: The functions are aligned to the full domain by the 
+//            first, untimed, solve of each problem.
+
+double solveAll(vector<vector<IvPFunction*> >& ipfs, 
+		const IvPDomain& domain, bool flat, 
+		unsigned int reps, vector<double>& results,
+		unsigned long& allocs, WorkerPool *pool)
+{
+  double total = 0;
+  allocs = 0;
+  for(unsigned int r=0; r<=reps; r++) {
+    for(unsigned int i=0; i<ipfs.size(); i++) {
+      IvPProblem *problem = 0;
+      if(pool)
+	problem = new IvPProblem_Par(pool);
+      else
+	problem = new IvPProblem;
+      problem->setOwnerIPFs(false);
+      problem->setSilent(true);
+      problem->setUseFlat(flat);
+      for(unsigned int j=0; j<ipfs[i].size(); j++)
+	problem->addOF(ipfs[i][j]);
+      problem->setDomain(domain);
+      problem->alignOFs();
+      problem->prepareSolve();
+
+      unsigned long start_allocs = g_allocs;
+      clock_t start = clock();
+      double  start_wall = WorkerPool::wallTime();
+      problem->solve();
+      if(r > 0) {
+	if(pool)
+	  total += WorkerPool::wallTime() - start_wall;
+	else
+	  total += (double)(clock() - start) / CLOCKS_PER_SEC;
+	allocs += g_allocs - start_allocs;
+      }
+
+      if(r == 0)
+	for(unsigned int d=0; d<domain.size(); d++)
+	  results.push_back(problem->getResult(domain.getVarName(d)));
+      delete(problem);
+    }
+  }
+  return(total);
+}
+
+//--------------------------------------------------------
+// Procedure: runParallel()
+//   Purpose: Time the parallel solver on problems over course and
+//            speed with 2 to 20 functions, using 1 to 16 threads,
+//            checking each decision against the serial solver.
+//            Returns true if all decisions are the same.
+
+bool runParallel(const IvPDomain& domain, unsigned int problems,
+		 unsigned int reps)
+{
+  unsigned int fcounts[] = {2, 5, 10, 20};
+  unsigned int tcounts[] = {1, 2, 4, 8, 16};
+
+  WorkerPool pool;
+
+  bool all_same = true;
+  cout << "Parallel solve, ms per solve (speedup over serial):" << endl;
+  cout << "  functions  serial";
+  for(unsigned int t=0; t<5; t++)
+    cout << "  threads=" << tcounts[t];
+  cout << endl;
+
+  for(unsigned int f=0; f<4; f++) {
+    vector<vector<IvPFunction*> > ipfs;
+    for(unsigned int i=0; i<problems; i++)
+      ipfs.push_back(buildFunctions(domain, fcounts[f]-1));
+
+    vector<double> serial_results;
+    unsigned long  allocs;
+    double serial_time = solveAll(ipfs, domain, false, reps,
+				  serial_results, allocs);
+
+    unsigned int solves = problems * reps;
+    cout << "  " << padString(uintToString(fcounts[f]), 9, false)
+	 << "  " << doubleToString(1000*serial_time/solves, 3);
+    for(unsigned int t=0; t<5; t++) {
+      pool.setThreads(tcounts[t]);
+      vector<double> par_results;
+      double par_time = solveAll(ipfs, domain, false, reps, 
+				 par_results, allocs, &pool);
+      bool same = (par_results == serial_results);
+      all_same = all_same && same;
+
+      cout << "  " << doubleToString(1000*par_time/solves, 3);
+      if(par_time > 0)
+	cout << " (" << doubleToString(serial_time/par_time, 2) << ")";
+      if(!same)
+	cout << " DIFF";
+    }
+    cout << endl;
+
+    for(unsigned int i=0; i<ipfs.size(); i++)
+      for(unsigned int j=0; j<ipfs[i].size(); j++)
+	delete(ipfs[i][j]);
+  }
+  cout << "  Same decisions:  " << boolToString(all_same) << endl;
+  return(all_same);
+}
+
+//--------------------------------------------------------
+// Procedure: runEncoding()
+//   Purpose: Compare the text encoder, its MK variant and the
+//            packed encoder on the functions of problems over
+//            course and speed: the length of the string, and the
+//            time to write and to read it. Returns true if each
+//            function read back from the packed string is the
+//            same as that read back from the text string.
+
+bool runEncoding(const IvPDomain& domain, unsigned int problems,
+		 unsigned int reps)
+{
+  vector<IvPFunction*> ipfs;
+  for(unsigned int i=0; i<problems; i++) {
+    vector<IvPFunction*> pvector = buildFunctions(domain, 4);
+    ipfs.insert(ipfs.end(), pvector.begin(), pvector.end());
+  }
+
+  unsigned int pieces = 0;
+  for(unsigned int i=0; i<ipfs.size(); i++) {
+    ipfs[i]->setContextStr("12:avoid_" + uintToString(i));
+    pieces += ipfs[i]->size();
+  }
+
+  bool all_same = true;
+  cout << "Encoding " << ipfs.size() << " functions, " 
+       << pieces / ipfs.size() << " pieces on average:" << endl;
+  cout << "  encoder  bytes/fcn  encode us/fcn  decode us/fcn" << endl;
+  for(unsigned int e=0; e<3; e++) {
+    string label = "text";
+    if(e == 1)
+      label = "mk";
+    else if(e == 2)
+      label = "packed";
+
+    vector<string> strs(ipfs.size());
+    double start_time = WorkerPool::wallTime();
+    for(unsigned int r=0; r<reps; r++) {
+      for(unsigned int i=0; i<ipfs.size(); i++) {
+	if(e == 0)
+	  strs[i] = IvPFunctionToString(ipfs[i]);
+	else if(e == 1)
+	  strs[i] = IvPFunctionToStringMK(ipfs[i]);
+	else
+	  strs[i] = IvPFunctionToPackedString(ipfs[i]);
+      }
+    }
+    double encode_time = WorkerPool::wallTime() - start_time;
+
+    start_time = WorkerPool::wallTime();
+    for(unsigned int r=0; r<reps; r++) {
+      for(unsigned int i=0; i<ipfs.size(); i++) {
+	IvPFunction *ipf = 0;
+	if(e == 1)
+	  ipf = StringToIvPFunctionMK(strs[i]);
+	else
+	  ipf = StringToIvPFunction(strs[i]);
+	delete(ipf);
+      }
+    }
+    double decode_time = WorkerPool::wallTime() - start_time;
+
+    unsigned long bytes = 0;
+    for(unsigned int i=0; i<strs.size(); i++) {
+      bytes += strs[i].length();
+      if(e == 2) {
+	IvPFunction *pk_ipf = StringToIvPFunction(strs[i]);
+	string       tx_str = IvPFunctionToString(ipfs[i]);
+	IvPFunction *tx_ipf = StringToIvPFunction(tx_str);
+	all_same = sameFunction(pk_ipf, tx_ipf) && all_same;
+	delete(pk_ipf);
+	delete(tx_ipf);
+      }
+    }
+
+    double calls = (double)(reps) * ipfs.size();
+    cout << "  " << padString(label, 7, false) << "  " 
+	 << padString(uintToString(bytes / strs.size()), 9) << "  "
+	 << padString(doubleToString(1000000*encode_time/calls, 1), 13)
+	 << "  "
+	 << padString(doubleToString(1000000*decode_time/calls, 1), 13)
+	 << endl;
+  }
+  cout << "  Same functions:  " << boolToString(all_same) << endl;
+
+  for(unsigned int i=0; i<ipfs.size(); i++)
+    delete(ipfs[i]);
+  return(all_same);
+}
+
+//--------------------------------------------------------
+// Procedure: runAOFs()
+//   Purpose: Time the evaluation of a few AOFs at every point of
+//            their domains, point by point as Regressor once did,
+//            and in one batch with AOF::evalPoints(). Returns true
+//            if the values are the same.
+
+bool runAOFs(unsigned int reps)
+{
+  IvPDomain cs_domain;
+  cs_domain.addDomain("course", 0, 359, 360);
+  cs_domain.addDomain("speed", 0, 5, 51);
+
+  IvPDomain xy_domain;
+  xy_domain.addDomain("x", -100, 100, 201);
+  xy_domain.addDomain("y", -100, 100, 201);
+
+  AOF_Gaussian gaussian(xy_domain);
+  gaussian.setParam("xcent", 20);
+  gaussian.setParam("ycent", -30);
+  gaussian.setParam("sigma", 40);
+
+  AOF_Waypoint waypoint(cs_domain);
+  waypoint.setParam("osx", 0);
+  waypoint.setParam("osy", 0);
+  waypoint.setParam("ptx", 100);
+  waypoint.setParam("pty", 200);
+  waypoint.setParam("desired_speed", 2);
+  waypoint.initialize();
+
+  AOF_AvoidCollision avoid(cs_domain);
+  avoid.setOwnshipParams(0, 0);
+  avoid.setContactParams(200, 150, 250, 3);
+  avoid.setParam("collision_distance", 10);
+  avoid.setParam("all_clear_distance", 75);
+  avoid.setParam("tol", 60);
+  avoid.initialize();
+
+  // Has no evalPoints() of its own, so uses the default
+  AOF_Avoid bench_avoid(cs_domain);
+  bench_avoid.setParam("bearing", 40);
+  bench_avoid.initialize();
+
+  cout << "AOF evaluations, millions per second:" << endl;
+  cout << "  aof                 per point      batch  speedup" << endl;
+  bool all_same = true;
+  all_same = timeAOF("AOF_Gaussian", gaussian, reps) && all_same;
+  all_same = timeAOF("AOF_Waypoint", waypoint, reps) && all_same;
+  all_same = timeAOF("AOF_AvoidCollision", avoid, reps) && all_same;
+  all_same = timeAOF("AOF_Avoid (default)", bench_avoid, reps) && all_same;
+  cout << "  Same values:  " << boolToString(all_same) << endl;
+  return(all_same);
+}
+
+//--------------------------------------------------------
+// Procedure: timeAOF()
+
+bool timeAOF(const string& label, const AOF& aof, unsigned int reps)
+{
+  IvPDomain domain = aof.getDomain();
+  unsigned int dim = domain.size();
+
+  // Every point of the domain, dim indices per point
+  unsigned int count = 1;
+  for(unsigned int d=0; d<dim; d++)
+    count *= domain.getVarPoints(d);
+  vector<int> pts(count * dim);
+  for(unsigned int i=0; i<count; i++) {
+    unsigned int ix = i;
+    for(unsigned int d=0; d<dim; d++) {
+      pts[(i*dim)+d] = ix % domain.getVarPoints(d);
+      ix = ix / domain.getVarPoints(d);
+    }
+  }
+
+  // Point by point: a box and a vector made for each point
+  vector<double> point_vals(count);
+  double start_time = WorkerPool::wallTime();
+  for(unsigned int r=0; r<reps; r++) {
+    for(unsigned int i=0; i<count; i++) {
+      IvPBox ptbox(dim);
+      vector<double> pvals;
+      for(unsigned int d=0; d<dim; d++) {
+	ptbox.setPTS(d, pts[(i*dim)+d], pts[(i*dim)+d]);
+	pvals.push_back(domain.getVal(d, pts[(i*dim)+d]));
+      }
+      double val = aof.evalPoint(pvals);
+      if(val == 0)
+	val = aof.evalBox(&ptbox);
+      point_vals[i] = val;
+    }
+  }
+  double point_time = WorkerPool::wallTime() - start_time;
+
+  vector<double> batch_vals(count);
+  start_time = WorkerPool::wallTime();
+  for(unsigned int r=0; r<reps; r++)
+    aof.evalPoints(&pts[0], count, &batch_vals[0]);
+  double batch_time = WorkerPool::wallTime() - start_time;
+
+  bool same = (point_vals == batch_vals);
+  double evals = (double)(count) * reps;
+  cout << "  " << padString(label, 19, false) << " "
+       << padString(doubleToString(evals/point_time/1000000, 2), 9)
+       << "  " << padString(doubleToString(evals/batch_time/1000000, 2), 9)
+       << "  " << padString(doubleToString(point_time/batch_time, 2), 7);
+  if(!same)
+    cout << " DIFF";
+  cout << endl;
+  return(same);
+}
+
+//--------------------------------------------------------
+// Procedure: runCPA()
+//   Purpose: Time the CPA of every heading and speed in the 2D
+//            domain against a few random contacts, one pair at a
+//            time with CPAEngine and CPAEngineV15. Returns true if
+//            the two give the same CPAs to within 0.01.
+
+bool runCPA(unsigned int contacts, unsigned int reps)
+{
+  if(contacts == 0)
+    contacts = 1;
+
+  vector<double> hdgs, spds;
+  for(unsigned int h=0; h<360; h++) {
+    for(unsigned int v=0; v<=50; v++) {
+      hdgs.push_back(h);
+      spds.push_back((double)(v) / 10);
+    }
+  }
+  unsigned int count = hdgs.size();
+  double tol = 60;
+
+  double cpa_time = 0;
+  double v15_time = 0;
+  bool   same = true;
+  for(unsigned int c=0; c<contacts; c++) {
+    double cnx = (rand() % 400) - 200;
+    double cny = (rand() % 400) - 200;
+    double cnh = rand() % 360;
+    double cnv = (rand() % 50) / 10.0;
+
+    CPAEngine    cpa_engine(cny, cnx, cnh, cnv, 0, 0);
+    CPAEngineV15 cpa_engine_v15(cny, cnx, cnh, cnv, 0, 0);
+
+    vector<double> cpa_vals(count);
+    double start_time = WorkerPool::wallTime();
+    for(unsigned int r=0; r<reps; r++)
+      for(unsigned int i=0; i<count; i++)
+	cpa_vals[i] = cpa_engine.evalCPA(hdgs[i], spds[i], tol);
+    cpa_time += WorkerPool::wallTime() - start_time;
+
+    vector<double> v15_vals(count);
+    start_time = WorkerPool::wallTime();
+    for(unsigned int r=0; r<reps; r++)
+      for(unsigned int i=0; i<count; i++)
+	v15_vals[i] = cpa_engine_v15.evalCPA(hdgs[i], spds[i], tol);
+    v15_time += WorkerPool::wallTime() - start_time;
+
+    for(unsigned int i=0; i<count; i++) {
+      double delta = cpa_vals[i] - v15_vals[i];
+      if((delta > 0.01) || (delta < -0.01))
+	same = false;
+    }
+  }
+
+  double evals = (double)(count) * reps * contacts / 1000000;
+  cout << "CPA: " << contacts << " contacts, " << count 
+       << " headings and speeds, " << reps << " times each" << endl;
+  cout << "  CPAEngineV15:     " << doubleToString(evals/v15_time, 2)
+       << " million per second" << endl;
+  cout << "  CPAEngine:        " << doubleToString(evals/cpa_time, 2)
+       << " million per second" << endl;
+  cout << "  Speedup:          " << doubleToString(v15_time/cpa_time, 2)
+       << endl;
+  cout << "  Same CPAs:        " << boolToString(same) << endl;
+  return(same);
+}
+
+//--------------------------------------------------------
+// Procedure: runBuild()
+//   Purpose: Time building the functions of a number of random
+//            problems, and freeing them, reporting the time and
+//            allocations of each per problem. Returns true if a
+//            copy of each function is the same as the original.
+
+bool runBuild(const IvPDomain& domain, unsigned int problems,
+	      unsigned int contacts, unsigned int reps)
+{
+  double build_time = 0;
+  double free_time  = 0;
+  unsigned long build_allocs = 0;
+  unsigned long free_allocs  = 0;
+  unsigned long pieces = 0;
+  bool   same = true;
+
+  for(unsigned int r=0; r<reps; r++) {
+    vector<vector<IvPFunction*> > ipfs;
+    unsigned long allocs = g_allocs;
+    double start_time = WorkerPool::wallTime();
+    for(unsigned int i=0; i<problems; i++)
+      ipfs.push_back(buildFunctions(domain, contacts));
+    build_time += WorkerPool::wallTime() - start_time;
+    build_allocs += g_allocs - allocs;
+
+    for(unsigned int i=0; i<ipfs.size(); i++) {
+      for(unsigned int j=0; j<ipfs[i].size(); j++) {
+	pieces += ipfs[i][j]->size();
+	if(r == 0) {
+	  IvPFunction *ipf_copy = ipfs[i][j]->copy();
+	  same = same && sameFunction(ipfs[i][j], ipf_copy);
+	  delete(ipf_copy);
+	}
+      }
+    }
+
+    allocs = g_allocs;
+    start_time = WorkerPool::wallTime();
+    for(unsigned int i=0; i<ipfs.size(); i++)
+      for(unsigned int j=0; j<ipfs[i].size(); j++)
+	delete(ipfs[i][j]);
+    free_time += WorkerPool::wallTime() - start_time;
+    free_allocs += g_allocs - allocs;
+  }
+
+  unsigned int builds = problems * reps;
+  cout << "Build: " << problems << " 3D problems with " << (contacts+2)
+       << " functions, " << pieces/builds << " pieces, built " << reps 
+       << " times" << endl;
+  cout << "  Build:           " << doubleToString(1000*build_time/builds, 3)
+       << " ms, " << build_allocs/builds << " allocations per problem" 
+       << endl;
+  cout << "  Free:            " << doubleToString(1000*free_time/builds, 3)
+       << " ms, " << free_allocs/builds << " allocations per problem" 
+       << endl;
+  cout << "  Same copies:     " << boolToString(same) << endl;
+  return(same);
+}
+
+//--------------------------------------------------------
+// Procedure: sameFunction()
+//   Purpose: True if both functions have the same context, weight,
+//            domain and pieces, weights to within 1e-9.
+
+bool sameFunction(IvPFunction *ipf_a, IvPFunction *ipf_b)
+{
+  if(!ipf_a || !ipf_b)
+    return(false);
+  if((ipf_a->getContextStr() != ipf_b->getContextStr()) ||
+     (ipf_a->getPWT() != ipf_b->getPWT()) ||
+     (ipf_a->getDim() != ipf_b->getDim()) ||
+     (ipf_a->size() != ipf_b->size()))
+    return(false);
+
+  PDMap *pdmap_a = ipf_a->getPDMap();
+  PDMap *pdmap_b = ipf_b->getPDMap();
+  if(domainToString(pdmap_a->getDomain()) !=
+     domainToString(pdmap_b->getDomain()))
+    return(false);
+
+  int dim = ipf_a->getDim();
+  for(int i=0; i<pdmap_a->size(); i++) {
+    IvPBox *box_a = pdmap_a->bx(i);
+    IvPBox *box_b = pdmap_b->bx(i);
+    for(int d=0; d<dim; d++) {
+      if((box_a->pt(d,0) != box_b->pt(d,0)) ||
+	 (box_a->pt(d,1) != box_b->pt(d,1)) ||
+	 (box_a->bd(d,0) != box_b->bd(d,0)) ||
+	 (box_a->bd(d,1) != box_b->bd(d,1)))
+	return(false);
+    }
+    for(int k=0; k<box_a->getWtc(); k++)
+      if(fabs(box_a->wt(k) - box_b->wt(k)) > 1e-9)
+	return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: runMission()
+//   Purpose: Solve a sequence of problems as a helm would meet
+//            them, the waypoint course and contact bearings 
+//            drifting a little from one step to the next. Each
+//            step is solved cold, and warm with the decision of
+//            the step before as an initial solution. Reports the
+//            leafs visited and time of each, returning true if
+//            the decisions are the same.
+
+bool runMission(const IvPDomain& domain, unsigned int contacts, 
+		unsigned int steps, unsigned int reps)
+{
+  double crs = rand() % 360;
+  double spd = 1 + (rand() % 30) / 10.0;
+
+  vector<double> brgs, spreads, drifts;
+  for(unsigned int i=0; i<contacts; i++) {
+    brgs.push_back(rand() % 360);
+    spreads.push_back(30 + (rand() % 60));
+    drifts.push_back(((rand() % 41) - 20) / 10.0);
+  }
+
+  vector<double> cold_results, warm_results, prev, none;
+  double cold_time  = 0;
+  double warm_time  = 0;
+  double cold_leafs = 0;
+  double warm_leafs = 0;
+  for(unsigned int s=0; s<steps; s++) {
+    // Every so often the waypoint moves on
+    if((s % 50) == 49)
+      crs = rand() % 360;
+    else
+      crs = angle360(crs + 0.5);
+    for(unsigned int i=0; i<brgs.size(); i++)
+      brgs[i] = angle360(brgs[i] + drifts[i]);
+
+    vector<IvPFunction*> ipfs;
+    ipfs = buildFunctions(domain, crs, spd, brgs, spreads, 0);
+
+    vector<double> cold, warm;
+    double leafs = 0;
+    cold_time  += solveStep(ipfs, domain, none, reps, cold, leafs);
+    cold_leafs += leafs;
+    warm_time  += solveStep(ipfs, domain, prev, reps, warm, leafs);
+    warm_leafs += leafs;
+
+    cold_results.insert(cold_results.end(), cold.begin(), cold.end());
+    warm_results.insert(warm_results.end(), warm.begin(), warm.end());
+    prev = warm;
+
+    for(unsigned int j=0; j<ipfs.size(); j++)
+      delete(ipfs[j]);
+  }
+
+  bool same = (cold_results == warm_results);
+
+  unsigned int solves = steps * reps;
+  cout << "Mission: " << steps << " steps with " << (contacts+1) 
+       << " functions, solved " << reps << " times each" << endl;
+  cout << "  Cold solve:      " << doubleToString(1000*cold_time/solves, 3)
+       << " ms, " << doubleToString(cold_leafs/steps, 1) 
+       << " leafs visited per solve" << endl;
+  cout << "  Warm solve:      " << doubleToString(1000*warm_time/solves, 3)
+       << " ms, " << doubleToString(warm_leafs/steps, 1) 
+       << " leafs visited per solve" << endl;
+  if(warm_time > 0)
+    cout << "  Speedup:         " << doubleToString(cold_time/warm_time, 2)
+	 << endl;
+  cout << "  Same decisions:  " << boolToString(same) << endl;
+  return(same);
+}
+
+//--------------------------------------------------------
+// Procedure: solveStep()
+//   Purpose: Solve the one problem reps times and return the total
+//            CPU time in seconds spent in IvPProblem::solve(). If
+//            warm holds a value for each variable of the domain
+//            it is given to the solver as a warm start.
+//      Note: The first, untimed, solve aligns the functions and
+//            applies their weights. Later solves find them so.
+
+double solveStep(vector<IvPFunction*>& ipfs, const IvPDomain& domain,
+		 const vector<double>& warm, unsigned int reps,
+		 vector<double>& results, double& leafs)
+{
+  unsigned int dsize = domain.size();
+  IvPBox warm_box(dsize);
+  for(unsigned int d=0; (d<dsize) && (d<warm.size()); d++) {
+    int ix = (int)(domain.getDiscreteVal(d, warm[d], 2));
+    warm_box.setPTS(d, ix, ix);
+    warm_box.setBDS(d, true, true);
+  }
+  bool use_warm = (dsize > 0) && (warm.size() == dsize);
+
+  clock_t total = 0;
+  for(unsigned int r=0; r<=reps; r++) {
+    IvPProblem problem;
+    problem.setOwnerIPFs(false);
+    problem.setSilent(true);
+    for(unsigned int j=0; j<ipfs.size(); j++)
+      problem.addOF(ipfs[j]);
+    problem.setDomain(domain);
+    problem.alignOFs();
+
+    clock_t start = clock();
+    if(use_warm) {
+      problem.setWarmStart(true);
+      problem.solve(&warm_box);
+    }
+    else
+      problem.solve();
+    if(r > 0)
+      total += clock() - start;
+
+    if(r == 0) {
+      leafs = problem.getLeafsVisited();
+      for(unsigned int d=0; d<dsize; d++)
+	results.push_back(problem.getResult(domain.getVarName(d)));
+    }
+  }
+  return((double)(total) / CLOCKS_PER_SEC);
+}
+
+//--------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{ 
+  cout << "Usage:                                              " << endl;
+  cout << "  ivpbench [OPTIONS]                                " << endl;
+  cout << "                                                    " << endl;
+  cout << "Synopsis:                                           " << endl;
+  cout << "  Time the IvP solver on helm-like problems over    " << endl;
+  cout << "  course and speed, and course, speed and depth,    " << endl;
+  cout << "  solving from the IvPBox pieces and from the       " << endl;
+  cout << "  flattened (PDMapFlat) pieces. Reports the time    " << endl;
+  cout << "  and the number of allocations per solve, which    " << endl;
+  cout << "  must be zero once the problem is prepared. Then   " << endl;
+  cout << "  solves a mission of slowly changing problems with " << endl;
+  cout << "  and without the previous decision as a warm start," << endl;
+  cout << "  reporting the time and leafs visited per solve.   " << endl;
+  cout << "                                                    " << endl;
+  cout << "Options:                                            " << endl;
+  cout << "  --help, -h                                        " << endl;
+  cout << "    Display this help message                       " << endl;
+  cout << "  --problems=<num>  (default 20)                    " << endl;
+  cout << "    Number of random problems of each kind          " << endl;
+  cout << "  --contacts=<num>  (default 4)                     " << endl;
+  cout << "    Number of avoidance functions in each problem   " << endl;
+  cout << "  --reps=<num>      (default 50)                    " << endl;
+  cout << "    Number of times each problem is solved          " << endl;
+  cout << "  --seed=<num>      (default 1)                     " << endl;
+  cout << "    Seed for the random problems                    " << endl;
+  cout << "  --steps=<num>     (default 200)                   " << endl;
+  cout << "    Number of steps in the mission, zero for none   " << endl;
+  cout << "  --par                                             " << endl;
+  cout << "    Also time the parallel solver with 2 to 20      " << endl;
+  cout << "    functions and 1 to 16 threads                   " << endl;
+  cout << "  --encode                                          " << endl;
+  cout << "    Also compare the size and speed of the text and " << endl;
+  cout << "    packed IvP function encoders                    " << endl;
+  cout << "  --aof                                             " << endl;
+  cout << "    Also time AOF evaluation point by point and in  " << endl;
+  cout << "    batches                                         " << endl;
+  cout << "  --cpa                                             " << endl;
+  cout << "    Also time CPAEngine against CPAEngineV15 with   " << endl;
+  cout << "    --contacts contacts                             " << endl;
+  cout << "  --build                                           " << endl;
+  cout << "    Also time building and freeing the functions of " << endl;
+  cout << "    the 3D problems, with allocations per problem   " << endl;
+  exit(0);
+}
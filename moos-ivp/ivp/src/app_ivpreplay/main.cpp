@@ -0,0 +1,317 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "MBUtils.h"
+#include "IvPProblem.h"
+#include "PopulatorIPP.h"
+
+using namespace std;
+
+void   showHelpAndExit();
+string algName(int);
+bool   solveFile(const string&, int alg, unsigned int reps, 
+		 map<string,double>& decision, double& secs, 
+		 double& leafs);
+bool   sameDecision(const map<string,double>&, 
+		    const map<string,double>&);
+string decisionToString(const map<string,double>&);
+
+//--------------------------------------------------------
+// Procedure: main
+//   Purpose: Solve IvP problems read from file, e.g., those the
+//            helm captured for taking long to solve, with each of
+//            the chosen algorithms. Reports the solve time and the
+//            leafs visited, and whether each algorithm reached the
+//            same decision as IvPProblem, and as the helm.
+
+int main(int argc, char *argv[])
+{ 
+  unsigned int reps = 10;
+  vector<int>  algs;
+  vector<string> files;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i]; 
+    bool handled = true;
+    if((argi == "-h") || (argi == "--help"))
+      showHelpAndExit();
+    else if(strBegins(argi, "--reps="))
+      handled = setPosUIntOnString(reps, argi.substr(7));
+    else if(strBegins(argi, "--algs=")) {
+      vector<string> svector = parseString(argi.substr(7), ',');
+      for(unsigned int j=0; j<svector.size(); j++) {
+	int alg = atoi(svector[j].c_str());
+	if(!isNumber(svector[j]) || (alg < 0) || (alg > 3))
+	  handled = false;
+	algs.push_back(alg);
+      }
+    }
+    else if(strEnds(argi, ".ipp"))
+      files.push_back(argi);
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Bad Arg:[" << argi << "]. Exiting." << endl;
+      exit(1);
+    }    
+  }
+
+  if(files.size() == 0) {
+    cout << "No .ipp files given. Exiting." << endl;
+    exit(1);
+  }
+
+  // IvPProblem is always solved, first, as the reference
+  vector<int> all_algs(1, 0);
+  if(algs.size() == 0) {
+    all_algs.push_back(2);
+    all_algs.push_back(3);
+  }
+  for(unsigned int j=0; j<algs.size(); j++) {
+    bool dup = false;
+    for(unsigned int k=0; k<all_algs.size(); k++)
+      dup = dup || (all_algs[k] == algs[j]);
+    if(!dup)
+      all_algs.push_back(algs[j]);
+  }
+
+  map<int, double> total_secs, total_leafs;
+  map<int, unsigned int> total_diffs;
+  unsigned int helm_diffs  = 0;
+  unsigned int files_ok    = 0;
+  unsigned int files_bad   = 0;
+
+  cout << padString("file", 28, false) << padString("alg", 20, false)
+       << padString("ms", 10, false) << padString("leafs", 12, false)
+       << "decision" << endl;
+
+  for(unsigned int i=0; i<files.size(); i++) {
+    map<string,double> ref_decision;
+    bool file_ok = true;
+    for(unsigned int j=0; j<all_algs.size() && file_ok; j++) {
+      int alg = all_algs[j];
+      map<string,double> decision;
+      double secs  = 0;
+      double leafs = 0;
+      if(!solveFile(files[i], alg, reps, decision, secs, leafs)) {
+	cout << "Unable to solve: " << files[i] << endl;
+	file_ok = false;
+	continue;
+      }
+      total_secs[alg]  += secs / reps;
+      total_leafs[alg] += leafs;
+
+      string note;
+      if(j == 0)
+	ref_decision = decision;
+      else if(!sameDecision(decision, ref_decision)) {
+	total_diffs[alg]++;
+	note = " DIFF";
+      }
+
+      string fname = (j == 0) ? files[i] : "";
+      cout << padString(fname, 28, false)
+	   << padString(algName(alg), 20, false)
+	   << padString(doubleToString(1000*secs/reps, 3), 10, false)
+	   << padString(doubleToString(leafs, 0), 12, false)
+	   << decisionToString(decision) << note << endl;
+    }
+    if(!file_ok) {
+      files_bad++;
+      continue;
+    }
+    files_ok++;
+
+    // The decision noted by the helm, if any. It is only compared 
+    // with IvPProblem. Weights are written to four decimal places
+    // so a near tie may be broken differently.
+    PopulatorIPP populator;
+    populator.setVerbose(false);
+    if(populator.populate(files[i])) {
+      const map<string,double>& helm = populator.getDecision();
+      if(helm.size() > 0) {
+	bool same = sameDecision(helm, ref_decision);
+	if(!same)
+	  helm_diffs++;
+	cout << padString("", 28, false) << padString("helm", 20, false)
+	     << padString(doubleToString(1000*populator.getSolveTime(), 3),
+			  10, false)
+	     << padString("", 12, false) << decisionToString(helm)
+	     << (same ? "" : " DIFF") << endl;
+      }
+      delete(populator.getIvPProblem());
+    }
+  }
+
+  unsigned int diffs = 0;
+  cout << endl << "Totals over " << files_ok << " problems:" << endl;
+  for(unsigned int j=0; j<all_algs.size(); j++) {
+    int alg = all_algs[j];
+    diffs += total_diffs[alg];
+    cout << "  " << padString(algName(alg), 20, false)
+	 << padString(doubleToString(1000*total_secs[alg], 3) + " ms,", 14, false)
+	 << doubleToString(total_leafs[alg], 0) << " leafs";
+    if(j > 0)
+      cout << ", " << total_diffs[alg] << " decisions differ";
+    cout << endl;
+  }
+  cout << "  Helm decisions differing: " << helm_diffs << endl;
+  if(files_bad > 0)
+    cout << "  Problems unable to be solved: " << files_bad << endl;
+
+  return(((diffs == 0) && (files_bad == 0)) ? 0 : 1);
+}
+
+//--------------------------------------------------------
+// Procedure: solveFile()
+//   Purpose: Solve the problem in the given file reps times with 
+//            the given algorithm, noting the decision, the total 
+//            CPU seconds spent solving and the leafs visited in 
+//            one solve.
+//      Note: The file is read again for each solve since a solved
+//            problem keeps its solution as a bound.
+
+bool solveFile(const string& filename, int alg, unsigned int reps,
+	       map<string,double>& decision, double& secs, double& leafs)
+{
+  clock_t total = 0;
+  for(unsigned int r=0; r<reps; r++) {
+    PopulatorIPP populator;
+    populator.setVerbose(false);
+    if(!populator.populate(filename, alg))
+      return(false);
+
+    IvPProblem *problem = populator.getIvPProblem();
+    if(!problem || (problem->getOFNUM() == 0) || !problem->alignOFs()) {
+      delete(problem);
+      return(false);
+    }
+    problem->setSilent(true);
+
+    clock_t start = clock();
+    problem->solve();
+    total += clock() - start;
+
+    if(r == 0) {
+      leafs = problem->getLeafsVisited();
+      IvPDomain domain = problem->getDomain();
+      for(unsigned int d=0; d<domain.size(); d++) {
+	string var = domain.getVarName(d);
+	bool   ok  = false;
+	double val = problem->getResult(var, &ok);
+	if(ok)
+	  decision[var] = val;
+      }
+    }
+    delete(problem);
+  }
+  secs = (double)(total) / CLOCKS_PER_SEC;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: sameDecision()
+
+bool sameDecision(const map<string,double>& a, 
+		  const map<string,double>& b)
+{
+  if(a.size() != b.size())
+    return(false);
+
+  map<string,double>::const_iterator p, q;
+  for(p=a.begin(); p!=a.end(); p++) {
+    q = b.find(p->first);
+    if((q == b.end()) || (fabs(p->second - q->second) > 0.000001))
+      return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: decisionToString()
+
+string decisionToString(const map<string,double>& decision)
+{
+  string str;
+  map<string,double>::const_iterator p;
+  for(p=decision.begin(); p!=decision.end(); p++) {
+    if(str != "")
+      str += ",";
+    str += p->first + "=" + doubleToStringX(p->second, 4);
+  }
+  return(str);
+}
+
+//--------------------------------------------------------
+// Procedure: algName()
+
+string algName(int alg)
+{
+  if(alg == 0)
+    return("IvPProblem");
+  else if(alg == 1)
+    return("IvPProblem_v2/full");
+  else if(alg == 2)
+    return("IvPProblem_v2");
+  else if(alg == 3)
+    return("IvPProblem_v3");
+  return("unknown");
+}
+
+//--------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{ 
+  cout << "Usage:                                              " << endl;
+  cout << "  ivpreplay file.ipp [file.ipp ...] [OPTIONS]       " << endl;
+  cout << "                                                    " << endl;
+  cout << "Synopsis:                                           " << endl;
+  cout << "  Solve IvP problems read from file, such as those  " << endl;
+  cout << "  written by pHelmIvP with capture_solve_time set,  " << endl;
+  cout << "  with IvPProblem and the other algorithms chosen.  " << endl;
+  cout << "  Reports the solve time and leafs visited, and     " << endl;
+  cout << "  whether each reached the decision of IvPProblem,  " << endl;
+  cout << "  and of the helm. Returns non-zero if any decision " << endl;
+  cout << "  differs from that of IvPProblem, or if a problem  " << endl;
+  cout << "  could not be solved.                              " << endl;
+  cout << "                                                    " << endl;
+  cout << "Options:                                            " << endl;
+  cout << "  --help, -h                                        " << endl;
+  cout << "    Display this help message                       " << endl;
+  cout << "  --reps=<num>      (default 10)                    " << endl;
+  cout << "    Number of times each problem is solved          " << endl;
+  cout << "  --algs=<list>     (default 2,3)                   " << endl;
+  cout << "    Algorithms to compare with IvPProblem (0):      " << endl;
+  cout << "    1 IvPProblem_v2, full tree                      " << endl;
+  cout << "    2 IvPProblem_v2                                 " << endl;
+  cout << "    3 IvPProblem_v3                                 " << endl;
+  exit(0);
+}
@@ -604,6 +604,7 @@ IvPFunction* BHV_AvdColregsV22::buildOvertakingIPF()
 
   //AOF_AvoidCollision aof(m_domain);
   AOF_R13 aof(m_domain);
+  aof.setCPAEngine(m_cpa_engine);
   aof.setOwnshipParams(m_osx, m_osy);
   aof.setContactParams(m_cnx, m_cny, m_cnh, m_cnv);
   aof.setParam("tol", m_time_on_leg);
@@ -717,6 +718,7 @@ IvPFunction* BHV_AvdColregsV22::buildHeadOnIPF()
     min_util_cpa_dist = (m_contact_range / 2);
 
   AOF_R14 aof(m_domain);
+  aof.setCPAEngine(m_cpa_engine);
   aof.setOwnshipParams(m_osx, m_osy);
   aof.setContactParams(m_cnx, m_cny, m_cnh, m_cnv);
   aof.setParam("tol", m_time_on_leg);
@@ -854,6 +856,7 @@ IvPFunction* BHV_AvdColregsV22::buildGiveWayIPF()
 
   AOF_R16  aof(m_domain);
 
+  aof.setCPAEngine(m_cpa_engine);
   aof.setOwnshipParams(m_osx, m_osy);
   aof.setContactParams(m_cnx, m_cny, m_cnh, m_cnv);
   bool ok = true;
@@ -1244,6 +1247,7 @@ IvPFunction* BHV_AvdColregsV22::buildCPA_IPF()
     min_util_cpa_dist = (m_contact_range / 2);
 
   AOF_CPA aof(m_domain);
+  aof.setCPAEngine(m_cpa_engine);
   aof.setOwnshipParams(m_osx, m_osy);
   aof.setContactParams(m_cnx, m_cny, m_cnh, m_cnv);
   aof.setParam("tol", 120);
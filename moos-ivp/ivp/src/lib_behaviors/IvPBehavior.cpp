@@ -51,6 +51,7 @@ IvPBehavior::IvPBehavior(IvPDomain g_domain)
   m_domain       = g_domain;
   m_info_buffer  = 0;
   m_ledger_snap  = 0;
+  m_cpa_cache    = 0;
   m_priority_wt  = 100.0;  // Default Priority Weight
   m_descriptor   = "???";  // Default descriptor
   m_bhv_state_ok = true;
@@ -33,6 +33,7 @@
 #include "InfoBuffer.h"
 #include "LedgerSnap.h"
 #include "CPAEngine.h"
+#include "CPAEngineCache.h"
 #include "VarDataPair.h"
 #include "LogicCondition.h"
 #include "BehaviorReport.h"
@@ -79,6 +80,7 @@ public:
   bool   setParamCommon(std::string, std::string);
   void   setInfoBuffer(const InfoBuffer*);
   void   setLedgerSnap(const LedgerSnap*);
+  void   setCPACache(CPAEngineCache *c) {m_cpa_cache=c;}
   void   setPlatModel(PlatModel pm) {m_plat_model=pm;}
   bool   checkUpdates();
   std::string isRunnable();
@@ -226,6 +228,7 @@ public:
 protected:
   const InfoBuffer* m_info_buffer;
   const LedgerSnap* m_ledger_snap;
+  CPAEngineCache*   m_cpa_cache;
 
   PlatModel m_plat_model;
 
@@ -578,8 +578,18 @@ bool IvPContactBehavior::updatePlatformInfo()
   //==================================================================
   // Part 3: Update the useful relative vehicle information
   
-  m_cpa_engine.reset(m_cny, m_cnx, m_cnh, m_cnv, m_osy, m_osx);
-  m_rcpa_engine.reset(m_osy, m_osx, m_osh, m_osv, m_cny, m_cnx);    
+  // Other behaviors about this contact this iteration will likely
+  // have built the same engines. If so they are copied.
+  if(m_cpa_cache) {
+    m_cpa_cache->getEngine(m_cny, m_cnx, m_cnh, m_cnv, m_osy, m_osx,
+			   m_cpa_engine);
+    m_cpa_cache->getEngine(m_osy, m_osx, m_osh, m_osv, m_cny, m_cnx,
+			   m_rcpa_engine);
+  }
+  else {
+    m_cpa_engine.reset(m_cny, m_cnx, m_cnh, m_cnv, m_osy, m_osx);
+    m_rcpa_engine.reset(m_osy, m_osx, m_osh, m_osv, m_cny, m_cnx);    
+  }
     
   m_contact_range = hypot((m_osx-m_cnx), (m_osy-m_cny));
 
@@ -96,6 +96,25 @@ double AOF_AvoidCollision::evalBox(const IvPBox *b) const
   return(eval_dist);
 }
 
+//----------------------------------------------------------------
+// Procedure: evalPoints
+//      Note: Same values as evalBox() on each point, one call for
+//            all the points rather than two per point.
+
+void AOF_AvoidCollision::evalPoints(const int *pts, unsigned int count,
+				    double *vals) const
+{
+  unsigned int dim = m_domain.size();
+  for(unsigned int i=0; i<count; i++) {
+    const int *pt = pts + (i * dim);
+    double eval_crs = m_domain.getVal(m_crs_ix, pt[m_crs_ix]);
+    double eval_spd = m_domain.getVal(m_spd_ix, pt[m_spd_ix]);
+
+    double cpa_dist = m_cpa_engine.evalCPA(eval_crs, eval_spd, m_tol);
+    vals[i] = metric(cpa_dist);
+  }
+}
+
 //----------------------------------------------------------------
 // Procedure: metric
 
@@ -37,6 +37,7 @@ class AOF_AvoidCollision: public AOF_Contact {
 
  public: // virtuals defined
   double evalBox(const IvPBox*) const;   
+  void   evalPoints(const int*, unsigned int, double*) const;
   bool   setParam(const std::string&, double);
   bool   initialize();
  public: // More virtuals defined Declare a known min/max eval range
@@ -131,7 +131,32 @@ double AOF_Waypoint::evalBox(const IvPBox *b) const
 
   m_domain.getVal(m_crs_ix, b->pt(m_crs_ix,0), eval_crs);
   m_domain.getVal(m_spd_ix, b->pt(m_spd_ix,0), eval_spd);
-  
+
+  return(evalCrsSpd(eval_crs, eval_spd));
+}
+
+//----------------------------------------------------------------
+// Procedure: evalPoints
+//      Note: Same values as evalBox() on each point, one call for
+//            all the points rather than two per point.
+
+void AOF_Waypoint::evalPoints(const int *pts, unsigned int count,
+			      double *vals) const
+{
+  unsigned int dim = m_domain.size();
+  for(unsigned int i=0; i<count; i++) {
+    const int *pt = pts + (i * dim);
+    double eval_crs = m_domain.getVal(m_crs_ix, pt[m_crs_ix]);
+    double eval_spd = m_domain.getVal(m_spd_ix, pt[m_spd_ix]);
+    vals[i] = evalCrsSpd(eval_crs, eval_spd);
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: evalCrsSpd
+
+double AOF_Waypoint::evalCrsSpd(double eval_crs, double eval_spd) const
+{
   // CALCULATE THE FIRST SCORE - SCORE_ROC
 
   double angle_diff      = angle360(eval_crs - m_angle_to_wpt);
@@ -36,9 +36,13 @@ class AOF_Waypoint: public AOF {
 
 public: // virtuals defined
   double evalBox(const IvPBox*) const; 
+  void   evalPoints(const int*, unsigned int, double*) const;
   bool   setParam(const std::string&, double);
   bool   initialize();
 
+protected:
+  double evalCrsSpd(double crs, double spd) const;
+
 protected:
   // Initialization parameters
   double m_osx;   // Ownship x position at time Tm.
@@ -0,0 +1,154 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CPAEngineCache.cpp                                   */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include "CPAEngineCache.h"
+
+using namespace std;
+
+//----------------------------------------------------------
+// Procedure: Constructor
+
+CPAEngineCache::CPAEngineCache()
+{
+  m_max_engines = 64;
+  m_hits   = 0;
+  m_misses = 0;
+
+#ifndef _WIN32
+  pthread_mutex_init(&m_mutex, 0);
+#endif
+}
+
+//----------------------------------------------------------
+// Procedure: Destructor
+
+CPAEngineCache::~CPAEngineCache()
+{
+  clear();
+
+#ifndef _WIN32
+  pthread_mutex_destroy(&m_mutex);
+#endif
+}
+
+//----------------------------------------------------------
+// Procedure: getEngine()
+//      Note: Engines in the cache are never changed or removed
+//            until clear(), so one found may be copied after the
+//            lock is released.
+//      Note: On a miss the engine is built without the lock held.
+//            Two threads missing on the same state will both
+//            build it, and only the first is kept.
+
+bool CPAEngineCache::getEngine(double cny, double cnx, double cnh,
+			       double cnv, double osy, double osx,
+			       CPAEngine& engine)
+{
+  double key[6] = {cny, cnx, cnh, cnv, osy, osx};
+
+  lock();
+  int ix = findEngine(key);
+  const CPAEngine *cached = 0;
+  if(ix >= 0) {
+    cached = m_engines[ix];
+    m_hits++;
+  }
+  else
+    m_misses++;
+  unlock();
+
+  if(cached) {
+    engine = *cached;
+    return(true);
+  }
+
+  engine.reset(cny, cnx, cnh, cnv, osy, osx);
+
+  lock();
+  if((m_engines.size() < m_max_engines) && (findEngine(key) < 0)) {
+    m_keys.insert(m_keys.end(), key, key+6);
+    m_engines.push_back(new CPAEngine(engine));
+  }
+  unlock();
+
+  return(false);
+}
+
+//----------------------------------------------------------
+// Procedure: clear()
+//      Note: The hit and miss counts are kept.
+
+void CPAEngineCache::clear()
+{
+  for(unsigned int i=0; i<m_engines.size(); i++)
+    delete(m_engines[i]);
+  m_engines.clear();
+  m_keys.clear();
+}
+
+//----------------------------------------------------------
+// Procedure: resetCounts()
+
+void CPAEngineCache::resetCounts()
+{
+  m_hits   = 0;
+  m_misses = 0;
+}
+
+//----------------------------------------------------------
+// Procedure: findEngine()
+//      Note: Called with the lock held. Few contacts are tracked
+//            at once so a linear search is fine.
+
+int CPAEngineCache::findEngine(const double *key) const
+{
+  for(unsigned int i=0; i<m_engines.size(); i++) {
+    const double *k = &m_keys[i*6];
+    if((k[0] == key[0]) && (k[1] == key[1]) && (k[2] == key[2]) &&
+       (k[3] == key[3]) && (k[4] == key[4]) && (k[5] == key[5]))
+      return((int)(i));
+  }
+  return(-1);
+}
+
+//----------------------------------------------------------
+// Procedure: lock()
+
+void CPAEngineCache::lock()
+{
+#ifndef _WIN32
+  pthread_mutex_lock(&m_mutex);
+#endif
+}
+
+//----------------------------------------------------------
+// Procedure: unlock()
+
+void CPAEngineCache::unlock()
+{
+#ifndef _WIN32
+  pthread_mutex_unlock(&m_mutex);
+#endif
+}
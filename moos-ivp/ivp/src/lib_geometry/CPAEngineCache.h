@@ -0,0 +1,90 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CPAEngineCache.h                                     */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+/****************************************************************/
+/* A set of CPAEngines shared by the behaviors of one helm      */
+/* iteration. Behaviors about the same contact build engines    */
+/* for the same contact and ownship state, and all but the      */
+/* first can copy the engine, caches and all, rather than       */
+/* build it again. States are matched exactly.                  */
+/*                                                              */
+/* Engines may be asked for from several threads at once, as    */
+/* when behaviors are run in parallel. The cache must only be   */
+/* cleared between iterations, when no engine is being copied.  */
+/****************************************************************/
+
+#ifndef CPA_ENGINE_CACHE_HEADER
+#define CPA_ENGINE_CACHE_HEADER
+
+#include <vector>
+#include "CPAEngine.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+class CPAEngineCache {
+public:
+  CPAEngineCache();
+  ~CPAEngineCache();
+
+  // Set the engine to one reset for the given state, copied from
+  // the cache if present. Returns true if it was.
+  bool getEngine(double cny, double cnx, double cnh, double cnv,
+		 double osy, double osx, CPAEngine& engine);
+
+  void clear();
+  void resetCounts();
+
+  void setMaxEngines(unsigned int v)  {m_max_engines=v;}
+
+  unsigned int size() const       {return(m_engines.size());}
+  unsigned int getHits() const    {return(m_hits);}
+  unsigned int getMisses() const  {return(m_misses);}
+
+protected:
+  int  findEngine(const double *key) const;
+  void lock();
+  void unlock();
+
+protected:
+  // Six values per engine, in the order of CPAEngine::reset()
+  std::vector<double>     m_keys;
+  std::vector<CPAEngine*> m_engines;
+
+  unsigned int m_max_engines;
+  unsigned int m_hits;
+  unsigned int m_misses;
+
+#ifndef _WIN32
+  pthread_mutex_t m_mutex;
+#endif
+
+private:
+  CPAEngineCache(const CPAEngineCache&);
+  const CPAEngineCache &operator=(const CPAEngineCache&);
+};
+
+#endif
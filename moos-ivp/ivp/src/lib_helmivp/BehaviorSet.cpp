@@ -27,6 +27,7 @@
 #include "MBUtils.h"
 #include "IvPFunction.h"
 #include "FunctionEncoder.h"
+#include "FunctionEncoderPK.h"
 #include "ColorParse.h"
 
 using namespace std;
@@ -37,6 +38,7 @@ using namespace std;
 BehaviorSet::BehaviorSet()
 {
   m_report_ipf = true;
+  m_pack_ipf   = false;
   m_curr_time  = -1;
   m_bfactory_dynamic.loadEnvVarDirectories("IVP_BEHAVIOR_DIRS");
 
@@ -177,6 +179,20 @@ void BehaviorSet::connectLedgerSnap(LedgerSnap *lsnap)
     m_behavior_specs[i].setLedgerSnap(lsnap);    
 }
 
+//------------------------------------------------------------
+// Procedure: connectCPACache()
+//      Note: Connects the cache to all bhvs. It is not "owned" by
+//            behaviors. A null cache has them build their own
+//            CPA engines.
+
+void BehaviorSet::connectCPACache(CPAEngineCache *cache)
+{
+  unsigned int vsize = m_bhv_entry.size();
+  for(unsigned int i=0; i<vsize; i++)
+    if(m_bhv_entry[i].getBehavior())
+      m_bhv_entry[i].getBehavior()->setCPACache(cache);
+}
+
 //------------------------------------------------------------
 // Procedure: applyAbleFilterMsg()
 //      Note: Apply the BHV_ABLE_FILTER msg to all behaviors
@@ -683,6 +699,24 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
 				    unsigned int iteration, 
 				    string& new_activity_state,
 				    bool& ipf_reuse)
+{
+  return(produceOF(ix, iteration, new_activity_state, ipf_reuse,
+		   m_update_results));
+}
+
+//------------------------------------------------------------
+// Procedure: produceOF()
+//      Note: The update results of the behavior are appended to
+//            the given vector rather than to m_update_results.
+//            Touches nothing shared between behaviors other than
+//            reading the info buffer and ledger, so may be called
+//            for different behaviors from different threads.
+
+IvPFunction* BehaviorSet::produceOF(unsigned int ix, 
+				    unsigned int iteration, 
+				    string& new_activity_state,
+				    bool& ipf_reuse,
+				    vector<string>& all_update_results)
 {
   // Quick index sanity check
   if(ix >= m_bhv_entry.size())
@@ -708,7 +742,7 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
     
   vector<string> update_results = bhv->getUpdateResults();
   for(unsigned int i=0; i<update_results.size(); i++)
-    m_update_results.push_back(update_results[i]);
+    all_update_results.push_back(update_results[i]);
 
   bhv->setHelmIteration(iteration);
   // Check if the behavior duration is to be reset
@@ -811,7 +845,11 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
       string ctxt_str = iter_str + ":" + desc_str;
 
       ipf->setContextStr(ctxt_str);
-      string ipf_str = IvPFunctionToString(ipf);
+      string ipf_str;
+      if(m_pack_ipf)
+	ipf_str = IvPFunctionToPackedString(ipf);
+      else
+	ipf_str = IvPFunctionToString(ipf);
       bhv->postMessage("BHV_IPF", ipf_str);
     }
     // Step 5: Handle normal case of healthy IvP function returned
@@ -1177,6 +1215,15 @@ vector<string> BehaviorSet::getSpecUpdateVars()
   return(rvector);
 }
 
+//------------------------------------------------------------
+// Procedure: addUpdateResults()
+
+void BehaviorSet::addUpdateResults(const vector<string>& results)
+{
+  for(unsigned int i=0; i<results.size(); i++)
+    m_update_results.push_back(results[i]);
+}
+
 //------------------------------------------------------------
 // Procedure: addWarning()
 
@@ -51,6 +51,7 @@ public:
   void       setDomain(IvPDomain domain);
   void       connectInfoBuffer(InfoBuffer*);
   void       connectLedgerSnap(LedgerSnap*);
+  void       connectCPACache(CPAEngineCache*);
   bool       buildBehaviorsFromSpecs();
   SpecBuild  buildBehaviorFromSpec(BehaviorSpec spec, std::string s="",
 				   bool on_startup=false);
@@ -73,10 +74,14 @@ public:
   unsigned int size()                   {return(m_bhv_entry.size());}
 
   void         setReportIPF(bool v)     {m_report_ipf=v;}
+  void         setPackIPF(bool v)       {m_pack_ipf=v;}
   bool         stateOK(unsigned int);
   void         resetStateOK();
   IvPFunction* produceOF(unsigned int ix, unsigned int iter, 
 			 std::string& activity_state, bool& ipf_reuse);
+  IvPFunction* produceOF(unsigned int ix, unsigned int iter, 
+			 std::string& activity_state, bool& ipf_reuse,
+			 std::vector<std::string>& update_results);
 
   BehaviorReport produceOFX(unsigned int ix, unsigned int iter, 
 			    std::string& activity_state);
@@ -108,6 +113,7 @@ public:
   std::vector<std::string> getContactNames();
   
   void                     clearUpdateResults() {m_update_results.clear();}
+  void                     addUpdateResults(const std::vector<std::string>&);
   void                     addWarning(const std::string&);
   std::vector<std::string> getWarnings()     {return(m_warnings);}
   void                     clearWarnings()   {m_warnings.clear();}
@@ -176,6 +182,7 @@ protected:
   std::string m_ownship;
 
   bool    m_report_ipf;
+  bool    m_pack_ipf;
   double  m_curr_time;
   bool    m_completed_pending;
 
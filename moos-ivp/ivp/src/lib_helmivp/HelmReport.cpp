@@ -47,6 +47,8 @@ void HelmReport::initialize()
   m_iteration     = 0;
   m_ofnum         = 0;
   m_create_time   = 0;
+  m_create_wall_time = 0;
+  m_iter_wall_time   = 0;
   m_solve_time    = 0;
   m_halted        = false;
   m_active_goal   = false;
@@ -56,6 +58,9 @@ void HelmReport::initialize()
 
   m_total_pcs_formed = 0;
   m_total_pcs_cached = 0;
+  m_cpa_cache_hits   = 0;
+  m_iter_allocs      = 0;
+  m_cpa_cache_misses = 0;
 }
 
 //-----------------------------------------------------------
@@ -582,12 +587,22 @@ string HelmReport::getReportAsString(const HelmReport& prep, bool full) const
     report += (",total_pcs_formed=" + uintToString(m_total_pcs_formed));
   if(full || (m_total_pcs_cached != prep.getTotalPcsCached()))
     report += (",total_pcs_cached=" + uintToString(m_total_pcs_cached));
+  if(full || (m_cpa_cache_hits != prep.getCPACacheHits()))
+    report += (",cpa_cache_hits=" + uintToString(m_cpa_cache_hits));
+  if(full || (m_cpa_cache_misses != prep.getCPACacheMisses()))
+    report += (",cpa_cache_misses=" + uintToString(m_cpa_cache_misses));
+  if(full || (m_iter_allocs != prep.getIterAllocs()))
+    report += (",iter_allocs=" + uintToString(m_iter_allocs));
   if(full || (m_warning_count != prep.getWarnings()))
     report += (",warnings=" + uintToString(m_warning_count));
   if(full || (m_solve_time != prep.getSolveTime()))
     report += (",solve_time=" + doubleToString(m_solve_time, 2));
   if(full || (m_create_time != prep.getCreateTime()))
     report += (",create_time=" + doubleToString(m_create_time, 2));
+  if(full || (m_create_wall_time != prep.getCreateWallTime()))
+    report += (",create_wall_time=" + doubleToString(m_create_wall_time, 2));
+  if(full || (m_iter_wall_time != prep.getIterWallTime()))
+    report += (",iter_wall_time=" + doubleToString(m_iter_wall_time, 4));
 
   if(full || (m_max_create_time != prep.getMaxCreateTime()))
     report += (",max_create_time=" + doubleToString(m_max_create_time, 2));
@@ -697,6 +712,10 @@ void HelmReport::print() const
   cout << "ofnum:" << m_ofnum << endl;
   cout << "total_pcs_formed:" << m_total_pcs_formed << endl;
   cout << "total_pcs_cached:" << m_total_pcs_cached << endl;
+  cout << "cpa_cache_hits:" << m_cpa_cache_hits << endl;
+  cout << "cpa_cache_misses:" << m_cpa_cache_misses << endl;
+  cout << "iter_allocs:" << m_iter_allocs << endl;
+  cout << "iter_wall_time:" << m_iter_wall_time << endl;
   cout << "halted:" << boolToString(m_halted) << endl;
   cout << "active_goal:" << boolToString(m_active_goal) << endl;
 }
@@ -708,10 +727,12 @@ void HelmReport::print() const
 // 
 //  Helm Iteration: 2       (hz=0.25)(1)  (hz=0.25)(1)  (hz=0.25)(max)
 //    IvP functions:  0
+//    CPA Engines:    6 cached, 2 built
+//    Allocations:    3
 //    Mode(s):        ACTIVE:LOITERING
 //    SolveTime:      0.00    (max=0.00)
-//    CreateTime:     0.00    (max=0.00)
-//    LoopTime:       0.00    (max=0.00)
+//    CreateTime:     0.00    (max=0.00)   (wall=0.00)
+//    LoopTime:       0.00    (max=0.00)   (wall=0.0061)
 //    Halted:         false   (0 warnings: 0 total)
 //    Active Goal:    true    
 //  Helm Decision: [speed,0,5,26] [course,0,359,360] 
@@ -734,6 +755,10 @@ list<string> HelmReport::formattedSummary(double curr_time, bool verbose) const
   rlist.push_back("  IvP Functions:   " + uintToString(m_ofnum));
   rlist.push_back("  Pieces (Formed): " + uintToString(m_total_pcs_formed));
   rlist.push_back("  Pieces (Cached): " + uintToString(m_total_pcs_cached));
+  str =  "  CPA Engines:     " + uintToString(m_cpa_cache_hits) + " cached, ";
+  str += uintToString(m_cpa_cache_misses) + " built";
+  rlist.push_back(str);
+  rlist.push_back("  Allocations:     " + uintToString(m_iter_allocs));
   rlist.push_back("  Mode(s):         " + m_modes);
 
   str =  "  SolveTime:   " + doubleToString(m_solve_time,2);
@@ -742,10 +767,12 @@ list<string> HelmReport::formattedSummary(double curr_time, bool verbose) const
 
   str =  "  CreateTime:  " + doubleToString(m_create_time,2);
   str += "   (max=" + doubleToString(m_max_create_time,2) + ")";
+  str += "   (wall=" + doubleToString(m_create_wall_time,2) + ")";
   rlist.push_back(str);
 
   str =  "  LoopTime:    " + doubleToString(getLoopTime(),2);
   str += "   (max=" + doubleToString(m_max_loop_time,2) + ")";
+  str += "   (wall=" + doubleToString(m_iter_wall_time,4) + ")";
   rlist.push_back(str);
 
   str = "  Halted:         " + boolToString(m_halted);
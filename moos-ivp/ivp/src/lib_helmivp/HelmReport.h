@@ -75,7 +75,12 @@ public:
   void  setOFNUM(unsigned int ofnum)         {m_ofnum=ofnum;}
   void  setTotalPcsFormed(unsigned int v)    {m_total_pcs_formed=v;}
   void  setTotalPcsCached(unsigned int v)    {m_total_pcs_cached=v;}
+  void  setCPACacheHits(unsigned int v)      {m_cpa_cache_hits=v;}
+  void  setCPACacheMisses(unsigned int v)    {m_cpa_cache_misses=v;}
+  void  setIterAllocs(unsigned int v)        {m_iter_allocs=v;}
   void  setCreateTime(double t)              {m_create_time=t;}
+  void  setCreateWallTime(double t)          {m_create_wall_time=t;}
+  void  setIterWallTime(double t)            {m_iter_wall_time=t;}
   void  setSolveTime(double t)               {m_solve_time=t;}
   void  setMaxLoopTime(double t)             {m_max_loop_time=t;}
   void  setMaxCreateTime(double t)           {m_max_create_time=t;}
@@ -90,8 +95,13 @@ public:
   unsigned int getOFNUM()      const  {return(m_ofnum);}
   unsigned int getTotalPcsFormed() const {return(m_total_pcs_formed);}
   unsigned int getTotalPcsCached() const {return(m_total_pcs_cached);}
+  unsigned int getCPACacheHits() const   {return(m_cpa_cache_hits);}
+  unsigned int getCPACacheMisses() const {return(m_cpa_cache_misses);}
+  unsigned int getIterAllocs() const     {return(m_iter_allocs);}
   double       getTimeUTC()    const  {return(m_time_utc);}
   double       getCreateTime() const  {return(m_create_time);}
+  double       getCreateWallTime() const {return(m_create_wall_time);}
+  double       getIterWallTime() const   {return(m_iter_wall_time);}
   double       getSolveTime()  const  {return(m_solve_time);}
   double       getLoopTime()   const  {return(m_solve_time+m_create_time);}
   bool         getHalted()     const  {return(m_halted);}
@@ -186,12 +196,17 @@ protected:
   unsigned int  m_iteration;       // +
   unsigned int  m_ofnum;           // +
   double        m_create_time;     // + 
+  double        m_create_wall_time;
+  double        m_iter_wall_time;   // Whole iteration, incl freeing
   double        m_solve_time;      // + 
   bool          m_halted;          // +
   bool          m_active_goal;     // + nov1419
 
   unsigned int  m_total_pcs_formed;
   unsigned int  m_total_pcs_cached;
+  unsigned int  m_cpa_cache_hits;
+  unsigned int  m_cpa_cache_misses;
+  unsigned int  m_iter_allocs;       // IvPBox and IvPGrid heap blocks
   
   double        m_max_create_time;
   double        m_max_solve_time;
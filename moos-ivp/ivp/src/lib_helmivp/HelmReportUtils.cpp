@@ -45,9 +45,14 @@ HelmReport string2HelmReport(const string& str)
 //            ofnum=3,
 //            total_pcs_formed=1123,
 //            total_pcs_cached=341,
+//            cpa_cache_hits=6,
+//            cpa_cache_misses=2,
+//            iter_allocs=3,
 //            warnings=0,
 //            solve_time=0.01,
 //            create_time=0.0,    
+//            create_wall_time=0.0,    
+//            iter_wall_time=0.0061,    
 //            loop_time=0.01,    
 //            utc_time=131223429183.22,    
 //            var=speed:2,var=course:124,
@@ -83,12 +88,22 @@ HelmReport string2HelmReport(const string& str,
       report.setTotalPcsFormed(atoi(right.c_str()));
     else if(left == "total_pcs_cached")
       report.setTotalPcsCached(atoi(right.c_str()));
+    else if(left == "cpa_cache_hits")
+      report.setCPACacheHits(atoi(right.c_str()));
+    else if(left == "cpa_cache_misses")
+      report.setCPACacheMisses(atoi(right.c_str()));
+    else if(left == "iter_allocs")
+      report.setIterAllocs(atoi(right.c_str()));
     else if(left == "warnings")
       report.setWarningCount(atoi(right.c_str()));
     else if(left == "solve_time")
       report.setSolveTime(atof(right.c_str()));
     else if(left == "create_time")
       report.setCreateTime(atof(right.c_str()));
+    else if(left == "create_wall_time")
+      report.setCreateWallTime(atof(right.c_str()));
+    else if(left == "iter_wall_time")
+      report.setIterWallTime(atof(right.c_str()));
     else if(left == "max_create_time")
       report.setMaxCreateTime(atof(right.c_str()));
     else if(left == "max_solve_time")
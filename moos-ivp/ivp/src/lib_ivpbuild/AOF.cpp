@@ -50,6 +50,31 @@ double AOF::extract(const string& varname, const vector<double>& point) const
 }
 
 
+//----------------------------------------------------------------
+// Procedure: evalPoints()
+//      Note: The point box and vector are made once per call, not
+//            once per point, but each point is still two virtual
+//            calls. AOFs evaluated often should override this.
+
+void AOF::evalPoints(const int *pts, unsigned int count, double *vals) const
+{
+  unsigned int dim = m_domain.size();
+
+  IvPBox ptbox(dim);
+  vector<double> pvals(dim, 0);
+  for(unsigned int i=0; i<count; i++) {
+    const int *pt = pts + (i * dim);
+    for(unsigned int d=0; d<dim; d++) {
+      ptbox.setPTS(d, pt[d], pt[d]);
+      pvals[d] = m_domain.getVal(d, pt[d]);
+    }
+    double val = evalPoint(pvals);
+    if(val == 0)
+      val = evalBox(&ptbox);
+    vals[i] = val;
+  }
+}
+
 //----------------------------------------------------------------
 // Procedure: getCatMsgsAOF()
 
@@ -47,6 +47,13 @@ public:
   {return(0);}
 
   virtual double evalPoint(const std::vector<double>&) const {return(0);}
+
+  // Evaluate count points, given as dim domain indices per point,
+  // into vals. By default each is evaluated with evalPoint(), or
+  // with evalBox() if that gives zero, as Regressor always has.
+  virtual void  evalPoints(const int *pts, unsigned int count,
+			   double *vals) const;
+
   virtual bool  initialize() {return(true);}
   virtual bool  setParam(const std::string&, double) {return(false);}
   virtual bool  setParam(const std::string&, const std::string&) 
@@ -60,10 +60,7 @@ double AOF_Gaussian::evalPoint(const vector<double>& point) const
   double xval = extract("x", point);
   double yval = extract("y", point);
 
-  double dist = hypot((xval - m_xcent), (yval - m_ycent));
-  double pct  = pow(M_E, -((dist*dist)/(2*(m_sigma * m_sigma))));
-
-  return(pct * m_range);
+  return(evalXY(xval, yval));
 }
 
 //----------------------------------------------------------------
@@ -77,6 +74,42 @@ double AOF_Gaussian::evalBox(const IvPBox *b) const
   m_domain.getVal(0, b->pt(0,0), xval);
   m_domain.getVal(1, b->pt(1,0), yval);
   
+  return(evalXY(xval, yval));
+}
+
+//----------------------------------------------------------------
+// Procedure: evalPoints
+//      Note: Same values as AOF::evalPoints(), i.e., as evalPoint()
+//            or, where that is zero, evalBox(), without the calls.
+
+void AOF_Gaussian::evalPoints(const int *pts, unsigned int count,
+			      double *vals) const
+{
+  unsigned int dim = m_domain.size();
+  int xix = m_domain.getIndex("x");
+  int yix = m_domain.getIndex("y");
+
+  for(unsigned int i=0; i<count; i++) {
+    const int *pt = pts + (i * dim);
+    double xval = 0;
+    double yval = 0;
+    if(xix >= 0)
+      xval = m_domain.getVal(xix, pt[xix]);
+    if(yix >= 0)
+      yval = m_domain.getVal(yix, pt[yix]);
+
+    double val = evalXY(xval, yval);
+    if((val == 0) && (dim > 1))
+      val = evalXY(m_domain.getVal(0, pt[0]), m_domain.getVal(1, pt[1]));
+    vals[i] = val;
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: evalXY
+
+double AOF_Gaussian::evalXY(double xval, double yval) const
+{
   double dist = hypot((xval - m_xcent), (yval - m_ycent));
   double pct  = pow(M_E, -((dist*dist)/(2*(m_sigma * m_sigma))));
 
@@ -39,8 +39,12 @@ class AOF_Gaussian: public AOF {
  public:
   double evalBox(const IvPBox *b) const;  // Virtual Defined
   double evalPoint(const std::vector<double>& point) const;
+  void   evalPoints(const int*, unsigned int, double*) const;
   bool   setParam(const std::string&, double);
 
+private:
+  double evalXY(double xval, double yval) const;
+
 private:
   double m_xcent;  
   double m_ycent;
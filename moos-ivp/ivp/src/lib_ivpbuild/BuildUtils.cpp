@@ -609,6 +609,9 @@ IvPBox stringToBox(const string& str)
 
 //------------------------------------------------------------------
 // Procedure: makeUniformDistro
+//      Note: The boxes are held in the BoxSet in the reverse of the
+//            order they are made, i.e., the reverse of the order
+//            given by the version below.
 
 BoxSet* makeUniformDistro(const IvPBox& outer_box, 
 			  const IvPBox& unif_box, 
@@ -616,10 +619,28 @@ BoxSet* makeUniformDistro(const IvPBox& outer_box,
 {
   BoxSet *boxset = new BoxSet;
 
-  // Error case: The boxes are not of the same dimension - return empty.
+  vector<IvPBox*> boxes;
+  makeUniformDistro(outer_box, unif_box, degree, boxes);
+  for(unsigned int i=0; i<boxes.size(); i++)
+    boxset->addBox(boxes[i]);
+
+  return(boxset);
+}
+
+//------------------------------------------------------------------
+// Procedure: makeUniformDistro
+//   Purpose: As above, but the new boxes are appended to the given
+//            vector, sparing the caller a BoxSet node for each box
+//            when the boxes are just to be moved into a PDMap.
+
+void makeUniformDistro(const IvPBox& outer_box, 
+		       const IvPBox& unif_box, 
+		       int degree, vector<IvPBox*>& boxes)
+{
+  // Error case: The boxes are not of the same dimension - none made.
   int dim = outer_box.getDim();
   if(dim != unif_box.getDim())
-    return(boxset);
+    return;
   
   int d;
   // Store the size of the outer_box for easy access later.
@@ -642,6 +663,7 @@ BoxSet* makeUniformDistro(const IvPBox& outer_box,
     if(remVal > 0) dimVal++;
     unifPieces = unifPieces * dimVal;
   }
+  boxes.reserve(boxes.size() + unifPieces);
   
   //int  currix = 0;
   bool unif_done = false;
@@ -649,7 +671,7 @@ BoxSet* makeUniformDistro(const IvPBox& outer_box,
     IvPBox* newbox = new IvPBox(dim, degree);
     for(d=0; d<dim; d++)
       newbox->setPTS(d, ulow[d], min((ulow[d]+uval[d]-1), uhgh[d]));
-    boxset->addBox(newbox);
+    boxes.push_back(newbox);
     //currix++;
     
     unif_done = true;
@@ -671,8 +693,6 @@ BoxSet* makeUniformDistro(const IvPBox& outer_box,
   delete [] uhgh;   // Now free up the memory in all those
   delete [] ulow;   // temporary 'convenience' arrays.
   delete [] uval;
-
-  return(boxset);
 }
 
 
@@ -27,6 +27,7 @@
 #define BUILD_UTIL_HEADER
 
 #include <string>
+#include <vector>
 #include "PDMap.h"
 #include "BoxSet.h"
 
@@ -47,6 +48,8 @@ std::string domainToString(const IvPDomain&, bool=true);
 std::string domainAndBoxToString(const IvPBox&, const IvPDomain&);
 
 BoxSet*  makeUniformDistro(const IvPBox&, const IvPBox&, int=1);
+void     makeUniformDistro(const IvPBox&, const IvPBox&, int,
+			   std::vector<IvPBox*>&);
 BoxSet*  subtractBox(const IvPBox&, const IvPBox&);
 IvPBox*  cutBox(IvPBox*, int);
 IvPBox*  quarterBox(IvPBox*, int, bool);
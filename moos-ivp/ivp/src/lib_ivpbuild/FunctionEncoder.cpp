@@ -28,6 +28,7 @@
 #include "MBUtils.h"
 #include "BuildUtils.h"
 #include "FunctionEncoder.h"
+#include "FunctionEncoderPK.h"
 #include "IvPDomain.h"
 
 using namespace std;
@@ -287,11 +288,15 @@ vector<string> IvPFunctionToVector(const string& whole_string,
 
 //--------------------------------------------------------------
 // Procedure: StringToIvPFunction()
+//      Note: Strings in the packed K form are handed to the packed
+//            decoder, so callers may be given either form.
 
 IvPFunction *StringToIvPFunction(const string& str)
 {
   if(str == "")
     return(0);
+  if(str[0] == 'K')
+    return(PackedStringToIvPFunction(str));
 
   int d, i;
 
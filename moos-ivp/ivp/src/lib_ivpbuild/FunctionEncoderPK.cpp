@@ -0,0 +1,335 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: FunctionEncoderPK.cpp                                */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "MBUtils.h"
+#include "BuildUtils.h"
+#include "FunctionEncoderPK.h"
+
+using namespace std;
+
+static const char *pk_b64_chars = 
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Value of each base64 character, -1 for all others
+static const signed char pk_b64_values[256] = {
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,62,-1,-1,-1,63,
+  52,53,54,55,56,57,58,59,60,61,-1,-1,-1,-1,-1,-1,
+  -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,
+  15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1,
+  -1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,
+  41,42,43,44,45,46,47,48,49,50,51,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1};
+
+//--------------------------------------------------------------
+// Procedure: putDigits()
+//   Purpose: Append val to str as base64 digits of five bits each,
+//            low bits first, with 32 added to all but the last.
+
+static void putDigits(string& str, unsigned long val)
+{
+  while(val >= 0x20) {
+    str += pk_b64_chars[(val & 0x1f) | 0x20];
+    val >>= 5;
+  }
+  str += pk_b64_chars[val];
+}
+
+//--------------------------------------------------------------
+// Procedure: getDigits()
+//   Purpose: Read a value written by putDigits() from chars[ix],
+//            advancing ix. Returns false if a digit is missing.
+//      Note: chars must end in a character that is not base64,
+//            such as the terminating null of a string.
+
+static bool getDigits(const unsigned char *chars, unsigned int& ix, 
+		      unsigned long& val)
+{
+  val = 0;
+  for(unsigned int shift=0; shift < 64; shift += 5) {
+    int digit = pk_b64_values[chars[ix]];
+    if(digit < 0)
+      return(false);
+    ix++;
+    val |= ((unsigned long)(digit & 0x1f)) << shift;
+    if((digit & 0x20) == 0)
+      return(true);
+  }
+  return(false);
+}
+
+//--------------------------------------------------------------
+// Procedure: getPiece()
+//   Purpose: Read one piece from chars[ix] into box, advancing ix.
+//            Returns false if the digits run out or the piece does
+//            not lie within the domain, pts[d] points per dimension.
+
+static bool getPiece(const unsigned char *chars, unsigned int& ix,
+		     const unsigned long *pts, IvPBox *box)
+{
+  unsigned int cix = ix;
+  int dim = box->getDim();
+  for(int d=0; d<dim; d++) {
+    unsigned long lval  = 0;
+    unsigned long width = 0;
+    if(!getDigits(chars, cix, lval) || 
+       !getDigits(chars, cix, width))
+      return(false);
+    // A box must lie within the domain, as the grid assumes
+    unsigned long low  = (lval >> 2);
+    unsigned long high = low + width;
+    if((high < low) || (high >= pts[d]))
+      return(false);
+    box->setPTS(d, (int)(low), (int)(high));
+    if(lval & 1)
+      box->bd(d,0) = 0;
+    if(lval & 2)
+      box->bd(d,1) = 0;
+  }
+  int wtc = box->getWtc();
+  for(int k=0; k<wtc; k++) {
+    unsigned long zval = 0;
+    if(!getDigits(chars, cix, zval))
+      return(false);
+    double coef = (double)(zval >> 1) * 0.0001;
+    if(zval & 1)
+      coef = -(double)((zval + 1) >> 1) * 0.0001;
+    box->wt(k) = coef;
+  }
+  ix = cix;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: nextInt()
+//   Purpose: Read the unsigned integer from cix up to the next
+//            comma, and move cix past the comma. Returns false if
+//            the field is empty, holds anything but digits, or
+//            runs past the end of the string.
+
+static bool nextInt(const string& str, unsigned int& cix, int& val)
+{
+  unsigned int slen  = str.length();
+  unsigned int start = cix;
+  val = 0;
+  while((cix < slen) && (str[cix] >= '0') && (str[cix] <= '9')) {
+    if(val > 100000000)
+      return(false);
+    val = (val * 10) + (str[cix] - '0');
+    cix++;
+  }
+  if((cix == start) || (cix >= slen) || (str[cix] != ','))
+    return(false);
+  cix++;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: nextTag()
+//   Purpose: Check the field at cix is the one letter tag, and
+//            move cix past it and its comma.
+
+static bool nextTag(const string& str, unsigned int& cix, char tag)
+{
+  if(((cix+1) >= str.length()) || (str[cix] != tag) || (str[cix+1] != ','))
+    return(false);
+  cix += 2;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: IvPFunctionToPackedString()
+//      Note: cstr is short for context_string
+//
+// K,cstr_len,cstr,dim,pcs,deg,pwt,
+// D,course;0;359;360:speed;0;8;9,G,9,4,
+// F,<base64 digits of all pieces>
+
+string IvPFunctionToPackedString(IvPFunction *ivp_function)
+{
+  PDMap *pdmap = ivp_function->getPDMap();
+  if(!pdmap || (pdmap->size() == 0))
+    return("");
+
+  int dim = ivp_function->getDim();
+  int pcs = pdmap->size();
+  int deg = pdmap->getDegree();
+  int wtc = (deg*dim)+1;
+  double pwt  = ivp_function->getPWT();
+  string cstr = ivp_function->getContextStr();
+
+  IvPBox gelbox = pdmap->getGelBox();
+
+  string domain_str = domainToString(pdmap->getDomain());
+  domain_str = findReplace(domain_str, ',', ';');
+
+  string str = "K," + intToString(cstr.length()) + "," + cstr + ",";
+  str += intToString(dim) + "," + intToString(pcs) + ",";
+  str += intToString(deg) + ",";
+  str += dstringCompact(doubleToString(pwt)) + ",D," + domain_str + ",G,";
+  for(int d=0; d<dim; d++)
+    str += intToString(gelbox.pt(d,1)) + ",";
+  str += "F,";
+
+  // Write the pieces as base64 digits, most values taking
+  // no more than four of them.
+  str.reserve(str.length() + (pcs * ((2*dim)+wtc) * 4));
+  for(int i=0; i<pcs; i++) {
+    IvPBox *ibox = pdmap->bx(i);
+    for(int d=0; d<dim; d++) {
+      unsigned long low   = (unsigned int)(ibox->pt(d,0));
+      unsigned long width = (unsigned int)(ibox->pt(d,1) - ibox->pt(d,0));
+      unsigned long flags = 0;
+      if(ibox->bd(d,0)==0)
+	flags |= 1;
+      if(ibox->bd(d,1)==0)
+	flags |= 2;
+      putDigits(str, (low << 2) | flags);
+      putDigits(str, width);
+    }
+    // Weights rounded to four decimals as IvPFunctionToString()
+    // does, then zigzag encoded so small negatives stay short.
+    for(int k=0; k<wtc; k++) {
+      double jwt = ibox->wt(k);
+      unsigned long ival = (unsigned long)((fabs(jwt) * 10000) + 0.5);
+      unsigned long zval = ival << 1;
+      if((jwt < 0) && (ival != 0))
+	zval = zval - 1;
+      putDigits(str, zval);
+    }
+  }
+  return(str);
+}
+
+//--------------------------------------------------------------
+// Procedure: PackedStringToIvPFunction()
+//   Returns: A new IvPFunction, or null if the string is not a
+//            well formed packed function.
+
+IvPFunction *PackedStringToIvPFunction(const string& str)
+{
+  if((str.length() < 2) || (str[0] != 'K') || (str[1] != ','))
+    return(0);
+
+  // Part 1: Read the header, the same as the H form but for the
+  // context string, which is taken by its length.
+  unsigned int cix = 2;
+  int cstr_len = 0;
+  if(!nextInt(str, cix, cstr_len) || ((cix + cstr_len) >= str.length()))
+    return(0);
+  string cstr = str.substr(cix, cstr_len);
+  cix += cstr_len + 1;
+
+  int dim = 0;
+  int pcs = 0;
+  int deg = 0;
+  if(!nextInt(str, cix, dim) || !nextInt(str, cix, pcs) ||
+     !nextInt(str, cix, deg))
+    return(0);
+  if((dim <= 0) || (pcs <= 0) || (deg > 2))
+    return(0);
+
+  char  *pwt_end = 0;
+  double pwt = strtod(str.c_str() + cix, &pwt_end);
+  cix = pwt_end - str.c_str();
+  if((cix >= str.length()) || (str[cix] != ','))
+    return(0);
+  cix++;
+  
+  if(!nextTag(str, cix, 'D'))
+    return(0);
+  string::size_type domain_end = str.find(',', cix);
+  if(domain_end == string::npos)
+    return(0);
+  string domain_str = str.substr(cix, domain_end - cix);
+  cix = domain_end + 1;
+  IvPDomain domain = stringToDomain(findReplace(domain_str, ';', ','));
+  if((int)(domain.size()) != dim)
+    return(0);
+
+  if(!nextTag(str, cix, 'G'))
+    return(0);
+  IvPBox gelbox(dim,0);
+  for(int d=0; d<dim; d++) {
+    int gel_high = 0;
+    if(!nextInt(str, cix, gel_high) || 
+       (gel_high >= (int)(domain.getVarPoints(d))))
+      return(0);
+    gelbox.setPTS(d, 0, gel_high);
+  }
+
+  if(!nextTag(str, cix, 'F'))
+    return(0);
+
+  // Part 2: Unpack the pieces into their boxes, stopping at the
+  // first character that is not base64, e.g., trailing white space.
+  // Every value takes at least one digit, so a string too short for
+  // the claimed pieces is rejected before anything is sized from
+  // the header.
+  const unsigned char *chars = (const unsigned char*)(str.c_str() + cix);
+  int  wtc = (deg*dim)+1;
+  unsigned long long min_digits = (unsigned long long)(pcs) * 
+    (unsigned long long)((2*dim) + wtc);
+  if(min_digits > (str.length() - cix))
+    return(0);
+
+  unsigned int dix = 0;
+  bool ok = true;
+
+  vector<unsigned long> pts(dim);
+  for(int d=0; d<dim; d++)
+    pts[d] = domain.getVarPoints(d);
+
+  PDMap *pdmap = new PDMap(pcs, domain, deg);
+  for(int i=0; (i<pcs) && ok; i++) {
+    IvPBox *newbox = new IvPBox(dim,deg);
+    pdmap->bx(i) = newbox;
+    ok = getPiece(chars, dix, &pts[0], newbox);
+  }
+
+  if(!ok) {
+    delete(pdmap);
+    return(0);
+  }
+
+  pdmap->setGelBox(gelbox);
+  pdmap->updateGrid(1,1);
+  IvPFunction *new_of = new IvPFunction(pdmap);
+  new_of->setPWT(pwt);
+  new_of->setContextStr(cstr);
+
+  return(new_of);
+}
@@ -0,0 +1,59 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: FunctionEncoderPK.h                                  */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+/****************************************************************/
+/* A packed string form of an IvPFunction, for posting BHV_IPF  */
+/* with less text to write, log and parse than the H form of    */
+/* FunctionEncoder. The header is the same as the H form, up to */
+/* and including the grid, but begins with a K. The pieces then */
+/* follow the F as one run of base64 (A-Z,a-z,0-9,+,/) digits.  */
+/* Each value takes five bits per digit, low bits first, with   */
+/* 32 added to every digit but its last:                        */
+/*                                                              */
+/*   per dimension: (low<<2) | excl_low | excl_high<<1          */
+/*                  high-low                                    */
+/*   per weight:    zigzag of the weight * 10000                */
+/*                                                              */
+/* Weights are kept to four decimals, as in the H form, so the  */
+/* two decode to the same function. The string is printable and */
+/* holds no commas after the header, so it may be split with    */
+/* IvPFunctionToVector() and logged like the H form. Since      */
+/* StringToIvPFunction() reads either form, consumers need not  */
+/* know which one a helm posts.                                 */
+/****************************************************************/
+
+#ifndef FUNCTION_ENCODER_PK_HEADER
+#define FUNCTION_ENCODER_PK_HEADER
+
+#include <string>
+#include "IvPFunction.h"
+
+// Convert an IvPFunction to packed string representation
+std::string IvPFunctionToPackedString(IvPFunction*);
+
+// Create an IvPFunction based on a packed string representation
+IvPFunction *PackedStringToIvPFunction(const std::string&);
+
+#endif
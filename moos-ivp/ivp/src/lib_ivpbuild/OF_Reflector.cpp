@@ -25,6 +25,7 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 #include "OF_Reflector.h"
 #include "BuildUtils.h"
 #include "IvPFunction.h"
@@ -693,20 +694,17 @@ void OF_Reflector::makeUniform()
 
   int degree = m_regressor->getDegree();
   
-  BoxSet *boxset = makeUniformDistro(universe, m_uniform_piece, degree);
-  int vsize = boxset->size();
+  // Last made is first, as when taken from the BoxSet version
+  vector<IvPBox*> boxes;
+  makeUniformDistro(universe, m_uniform_piece, degree, boxes);
+  reverse(boxes.begin(), boxes.end());
+  int vsize = boxes.size();
   if(vsize == 0)
     return;
   
   m_pdmap = new PDMap(vsize, domain, degree);
-  BoxSetNode *bsn = boxset->retBSN(FIRST);
-  int index = 0;
-  while(bsn) {
-    m_pdmap->bx(index) = bsn->getBox();
-    index++;
-    bsn = bsn->getNext();
-  }
-  delete(boxset);
+  for(int index=0; index<vsize; index++)
+    m_pdmap->bx(index) = boxes[index];
 
   m_pdmap->setGelBox(m_uniform_grid);
 
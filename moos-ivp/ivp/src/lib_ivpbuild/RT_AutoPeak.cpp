@@ -110,8 +110,8 @@ PDMap* RT_AutoPeak::create(PDMap *pdmap, int max_more_pcs)
 
       // If no errors, set the new weights, add back to the pqueue
       if(new_box) {
-	m_regressor->setWeight(cut_box, false);
-	m_regressor->setWeight(new_box, false);
+	IvPBox *halves[2] = {cut_box, new_box};
+	m_regressor->setWeights(halves, 2);
 	
 
 	// Now update the PQueue if appropriate
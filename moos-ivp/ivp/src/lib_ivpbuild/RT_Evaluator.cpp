@@ -58,16 +58,28 @@ void RT_Evaluator::evaluate(PDMap *pdmap, PQueue& pqueue)
   if(pdmap->getDomain().size() != m_regressor->getAOF()->getDim())
     return;
 
-  // If PQueue is null, just set piece weights
-  if(pqueue.null()) {
-    for(int i=0; i<pdmap->size(); i++) 
-      m_regressor->setWeight(pdmap->bx(i), false);
-  }
-  // If PQueue is not null, set weights, calc delta, add to PQueue
-  else {
-    for(int i=0; i<pdmap->size(); i++) {
-      double delta = m_regressor->setWeight(pdmap->bx(i), true);
-      pqueue.insert(i, delta);
+  // Weights are set a block of pieces at a time, so the AOF is
+  // asked for the values of many points at once.
+  const int block = 256;
+  IvPBox *boxes[block];
+  double  deltas[block];
+
+  int psize = pdmap->size();
+  for(int start=0; start<psize; start+=block) {
+    int count = psize - start;
+    if(count > block)
+      count = block;
+    for(int i=0; i<count; i++)
+      boxes[i] = pdmap->bx(start+i);
+
+    // If PQueue is null, just set piece weights
+    if(pqueue.null()) 
+      m_regressor->setWeights(boxes, count);
+    // If PQueue is not null, set weights, calc delta, add to PQueue
+    else {
+      m_regressor->setWeights(boxes, count, deltas);
+      for(int i=0; i<count; i++)
+	pqueue.insert(start+i, deltas[i]);
     }
   }
 }
@@ -83,8 +83,11 @@ PDMap* RT_Smart::create(PDMap *pdmap, PQueue& pqueue,
     IvPBox *new_box = cutBox(cut_box, sdim_ix);
 
     if(new_box) {
-      double err1 = m_regressor->setWeight(cut_box, true);
-      double err2 = m_regressor->setWeight(new_box, true);
+      IvPBox *halves[2] = {cut_box, new_box};
+      double  errs[2];
+      m_regressor->setWeights(halves, 2, errs);
+      double err1 = errs[0];
+      double err2 = errs[1];
 
 #if 0 // mikerb aug16
       double maxval1 = cut_box->maxval();
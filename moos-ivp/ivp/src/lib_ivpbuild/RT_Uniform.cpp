@@ -24,6 +24,7 @@
 /* <http://www.gnu.org/licenses/>.                               */
 /*****************************************************************/
 
+#include <algorithm>
 #include "RT_Uniform.h"
 #include "BuildUtils.h"
 #include "Regressor.h"
@@ -47,20 +48,17 @@ PDMap* RT_Uniform::create(const IvPBox* unifbox, const IvPBox* gelbox)
 
   int degree = m_regressor->getDegree();
   
-  BoxSet *boxset = makeUniformDistro(universe, *unifbox, degree);
-  int vsize = boxset->size();
+  // Last made is first, as when taken from the BoxSet version
+  vector<IvPBox*> boxes;
+  makeUniformDistro(universe, *unifbox, degree, boxes);
+  reverse(boxes.begin(), boxes.end());
+  int vsize = boxes.size();
   if(vsize == 0)
     return(0);
   
   PDMap *pdmap = new PDMap(vsize, domain, degree);
-  BoxSetNode *bsn = boxset->retBSN(FIRST);
-  int index = 0;
-  while(bsn) {
-    pdmap->bx(index) = bsn->getBox();
-    index++;
-    bsn = bsn->getNext();
-  }
-  delete(boxset);
+  for(int index=0; index<vsize; index++)
+    pdmap->bx(index) = boxes[index];
 
   bool gridset = false;
   if(gelbox)
@@ -28,6 +28,7 @@
 #include "BuildUtils.h"
 #include "Regressor.h"
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -46,14 +47,33 @@ PDMap* RT_UniformX::create(const IvPBox& unifbox, const IvPBox& gelbox)
   IvPBox    universe = domainToBox(domain);
   int       degree   = m_regressor->getDegree();
 
-  BoxSet *boxset = makeUniformDistro(universe, unifbox, degree);
+  // Last made is first, as when taken from the BoxSet version
+  vector<IvPBox*> boxes;
+  makeUniformDistro(universe, unifbox, degree, boxes);
+  reverse(boxes.begin(), boxes.end());
 
   handleOverlappingPlatBasins();
   
-  boxset = subtractPlateaus(boxset);
-  boxset = subtractBasins(boxset);
+  // The pieces need be in a BoxSet only if there are plateaus or
+  // basins to cut from them.
+  if((m_plateaus.size() + m_basins.size()) > 0) {
+    BoxSet *boxset = new BoxSet;
+    for(unsigned int i=0; i<boxes.size(); i++)
+      boxset->addBox(boxes[i], LAST);
+
+    boxset = subtractPlateaus(boxset);
+    boxset = subtractBasins(boxset);
+
+    boxes.clear();
+    BoxSetNode *bsn = boxset->retBSN(FIRST);
+    while(bsn) {
+      boxes.push_back(bsn->getBox());
+      bsn = bsn->getNext();
+    }
+    delete(boxset);
+  }
 
-  int remaining_pcs = boxset->size();
+  int remaining_pcs = (int)(boxes.size());
   int plateau_pcs   = (int)(m_plateaus.size());
   int basin_pcs     = (int)(m_basins.size());
 
@@ -62,14 +82,11 @@ PDMap* RT_UniformX::create(const IvPBox& unifbox, const IvPBox& gelbox)
     return(0);
 
   PDMap *pdmap = new PDMap(total_pdmap_pcs, domain, degree);
-  BoxSetNode *bsn = boxset->retBSN(FIRST);
   int index = 0;
-  while(bsn) {
-    pdmap->bx(index) = bsn->getBox();
+  for(unsigned int i=0; i<boxes.size(); i++) {
+    pdmap->bx(index) = boxes[i];
     index++;
-    bsn = bsn->getNext();
   }
-  delete(boxset);
 
   for(unsigned int i=0; i<m_plateaus.size(); i++) {
     pdmap->bx(index) = m_plateaus[i].copy();
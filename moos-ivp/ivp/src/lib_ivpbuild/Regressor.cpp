@@ -93,6 +93,10 @@ Regressor::Regressor(const AOF *g_aof, int g_degree)
   m_total_setwts = 0;
   m_total_evals  = 0;
 
+  m_emask        = 0;
+  m_center_flag  = false;
+  m_samples      = 0;
+
 }
 
 //-------------------------------------------------------------
@@ -117,6 +121,67 @@ Regressor::~Regressor()
 //            degree = 2  QUADRATIC
 
 double Regressor::setWeight(IvPBox *gbox, bool feedback)
+{
+  if(sampled(gbox)) {
+    setSamplePts(gbox);
+    m_sample_pts.clear();
+    addSamplePts(m_sample_pts);
+    m_sample_vals.resize(m_samples);
+    m_aof->evalPoints(&m_sample_pts[0], m_samples, &m_sample_vals[0]);
+    m_total_evals += m_samples;
+    useSampleVals(&m_sample_vals[0]);
+  }
+  return(fitWeight(gbox, feedback));
+}
+
+//-------------------------------------------------------------
+// Procedure: setWeights
+//   Purpose: Set the interior function of each of the given boxes
+//            as setWeight() would, but with the sample points of
+//            all the boxes handed to the AOF in one evalPoints()
+//            call. If errors is non-null, the error of each fit
+//            is returned in it, as setWeight() with feedback.
+
+void Regressor::setWeights(IvPBox **boxes, unsigned int count, 
+			   double *errors)
+{
+  // Part 1: Gather the sample points of all the boxes
+  m_sample_pts.clear();
+  m_sample_ix.resize(count);
+  unsigned int total = 0;
+  for(unsigned int i=0; i<count; i++) {
+    m_sample_ix[i] = total;
+    if(sampled(boxes[i])) {
+      setSamplePts(boxes[i]);
+      addSamplePts(m_sample_pts);
+      total += m_samples;
+    }
+  }
+
+  // Part 2: Evaluate them all at once
+  m_sample_vals.resize(total);
+  if(total > 0)
+    m_aof->evalPoints(&m_sample_pts[0], total, &m_sample_vals[0]);
+  m_total_evals += total;
+
+  // Part 3: Fit each box to its share of the values
+  for(unsigned int i=0; i<count; i++) {
+    if(sampled(boxes[i])) {
+      setSamplePts(boxes[i]);
+      useSampleVals(&m_sample_vals[m_sample_ix[i]]);
+    }
+    double error = fitWeight(boxes[i], (errors != 0));
+    if(errors)
+      errors[i] = error;
+  }
+}
+
+//-------------------------------------------------------------
+// Procedure: fitWeight
+//   Purpose: Set the interior function of the box from the values
+//            sampled at its corners and center.
+
+double Regressor::fitWeight(IvPBox *gbox, bool feedback)
 {
   m_total_setwts++;
   if(m_degree==0)  // Piecewise Scalar
@@ -139,11 +204,7 @@ double Regressor::setWeight(IvPBox *gbox, bool feedback)
 double Regressor::setWeight0(IvPBox *gbox, bool feedback)
 {
   int i;
-  setCorners(gbox);
-  
-  bool center_flag = centerBox(gbox, m_center_point);
-  if(center_flag)
-    m_center_val = this->evalPtBox(m_center_point);
+  bool center_flag = m_center_flag;
   
   double val = 0.0;
   for(i=0; (i < m_corners); i++)
@@ -189,11 +250,7 @@ double Regressor::setWeight1(IvPBox *gbox, bool feedback)
   
   // Part 3: Handle the general case
   int i, d;
-  setCorners(gbox);
-  
-  bool center_flag = centerBox(gbox, m_center_point);
-  if(center_flag)
-    m_center_val = this->evalPtBox(m_center_point);
+  bool center_flag = m_center_flag;
 
   for(d=0; (d <= m_dim); d++)
     m_vals[d] = 0.0;
@@ -350,11 +407,7 @@ double Regressor::setWeight1(IvPBox *gbox, bool feedback)
 double Regressor::setWeight2(IvPBox *gbox, bool feedback)
 {
   int i, d;
-  setCorners(gbox);
-  
-  bool center_flag = centerBox(gbox, m_center_point);
-  if(center_flag)
-    m_center_val = this->evalPtBox(m_center_point);
+  bool center_flag = m_center_flag;
 
   for(d=0; d<=(m_dim*2); d++)
     m_vals[d] = 0.0;
@@ -530,10 +583,25 @@ void Regressor::setQuadCoeffs(double  x1, double  y1, double  x2,
 
 
 //-------------------------------------------------------------
-// Procedure: setCorners
-//   Purpose: To set the corners of the given box, and then to 
-//            eval the AOF at each corner. The trick is to NOT
-//            eval the AOF more than once if a box has an edge 
+// Procedure: sampled
+//   Purpose: True if the weight of the box is fit to values of the
+//            AOF sampled in the box. A known plateau or basin in a
+//            linear function is instead given the known max or min.
+
+bool Regressor::sampled(const IvPBox *gbox) const
+{
+  if((m_degree < 0) || (m_degree > 2))
+    return(false);
+  if((m_degree == 1) && (gbox->getPlat() != 0) && m_aof->minMaxKnown())
+    return(false);
+  return(true);
+}
+
+//-------------------------------------------------------------
+// Procedure: setSamplePts
+//   Purpose: To set the corners and center of the given box, the
+//            points at which the AOF is evaluated. The trick is to
+//            NOT eval the AOF more than once if a box has an edge 
 //            length equal to 1 in one or more dimensions. It is
 //            thought that evaluating the AOF is typically the 
 //            most expensive part of regression so we try to 
@@ -579,7 +647,7 @@ void Regressor::setQuadCoeffs(double  x1, double  y1, double  x2,
 //                       dim=0
 //           
 
-void Regressor::setCorners(IvPBox *gbox)
+void Regressor::setSamplePts(const IvPBox *gbox)
 {
   int i, d;
   
@@ -591,48 +659,62 @@ void Regressor::setCorners(IvPBox *gbox)
     }
   }
   
-  int emask = 0;
+  m_emask = 0;
   for(d=0; (d < m_dim); d++)
     if(gbox->pt(d,1) == gbox->pt(d,0))
-      emask += m_mask[d];
+      m_emask += m_mask[d];
 
-  // Evaluate the AOF at each of the corners. If one or more of the 
-  // edge lengths of the gbox is 1 (high==low) then avoid evaluating
-  // the AOF at that point by "borrowing" its value from another pt.
-  m_corner_val[0] = this->evalPtBox(m_corner_point[0]);
-  for(i=1; (i < m_corners); i++) {
-    bool borrow = (emask & i);
-    if(borrow) {
-      int lender = ((emask & i) ^ i);
-      m_corner_val[i] = m_corner_val[lender];
-    }
-    else
-      m_corner_val[i] = this->evalPtBox(m_corner_point[i]);
+  m_center_flag = centerBox(gbox, m_center_point);
+
+  // One sample for each corner not borrowing, and the center
+  m_samples = 1;
+  for(i=1; (i < m_corners); i++)
+    if(!(m_emask & i))
+      m_samples++;
+  if(m_center_flag)
+    m_samples++;
+}
 
+//-------------------------------------------------------------
+// Procedure: addSamplePts
+//   Purpose: Append the points set by setSamplePts() that are to
+//            be evaluated, dim domain indices per point: the first
+//            corner, each corner not borrowing, then the center.
+
+void Regressor::addSamplePts(vector<int>& pts) const
+{
+  for(int i=0; (i < m_corners); i++) {
+    if((i == 0) || !(m_emask & i))
+      for(int d=0; (d < m_dim); d++)
+	pts.push_back(m_corner_point[i]->pt(d,0));
   }
+  if(m_center_flag)
+    for(int d=0; (d < m_dim); d++)
+      pts.push_back(m_center_point->pt(d,0));
 }
 
 //-------------------------------------------------------------
-// Procedure: evalPtBox()
-//   Purpose: Evaluate a point box based on the set of linear coefficients.
+// Procedure: useSampleVals
+//   Purpose: Take the values of the AOF at the points given by
+//            addSamplePts(), in the same order. If one or more of
+//            the edge lengths of the box is 1 (high==low), corners
+//            not evaluated "borrow" the value of another corner.
 
-double Regressor::evalPtBox(const IvPBox *gbox)
+void Regressor::useSampleVals(const double *vals)
 {
-  m_total_evals++;
-  if(!m_aof) 
-    return(0);
-  
-  unsigned int dim = gbox->getDim();
-  if(dim != m_domain.size())
-    return(0);
-  
-  vector<double> pvals;
-  for(unsigned int d=0; d<dim; d++)
-    pvals.push_back(m_domain.getVal(d, gbox->pt(d)));
-  double val = m_aof->evalPoint(pvals);
-  if(val == 0)
-    val = m_aof->evalBox(gbox);
-  return(val);
+  unsigned int k = 0;
+  m_corner_val[0] = vals[k++];
+  for(int i=1; (i < m_corners); i++) {
+    bool borrow = (m_emask & i);
+    if(borrow) {
+      int lender = ((m_emask & i) ^ i);
+      m_corner_val[i] = m_corner_val[lender];
+    }
+    else
+      m_corner_val[i] = vals[k++];
+  }
+  if(m_center_flag)
+    m_center_val = vals[k++];
 }
 
 
@@ -39,6 +39,7 @@ public:
   int     getDegree() const   {return(m_degree);}
 
   double  setWeight(IvPBox*, bool feedback=false);
+  void    setWeights(IvPBox**, unsigned int count, double *errors=0);
   void    setStrictRange(bool val) {m_strict_range = val;}
 
   unsigned int getMessageCnt() const {return(m_messages.size());}
@@ -50,13 +51,16 @@ public:
   unsigned int getTotalEvals() const {return(m_total_evals);}
   
 protected:
-  void    setCorners(IvPBox*);
+  bool    sampled(const IvPBox*) const;
+  void    setSamplePts(const IvPBox*);
+  void    addSamplePts(std::vector<int>&) const;
+  void    useSampleVals(const double*);
+  double  fitWeight(IvPBox*, bool);
   double  setWeight0(IvPBox*, bool);
   double  setWeight1(IvPBox*, bool);
   double  setWeight2(IvPBox*, bool);
   void    setQuadCoeffs(double, double,  double,  double, double, 
 			double, double&, double&, double&);
-  double  evalPtBox(const IvPBox*);
   bool    centerBox(const IvPBox*, IvPBox*);
 
 protected:
@@ -80,6 +84,16 @@ protected:
   int*      m_mask;
   double*   m_vals;
 
+  // Set by setSamplePts() for the box being fitted
+  int          m_emask;
+  bool         m_center_flag;
+  unsigned int m_samples;
+
+  // Points to evaluate, and their values, kept between calls
+  std::vector<int>          m_sample_pts;
+  std::vector<double>       m_sample_vals;
+  std::vector<unsigned int> m_sample_ix;
+
   int       m_degree;
 
   double    m_pteval_min;
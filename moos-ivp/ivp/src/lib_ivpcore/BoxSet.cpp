@@ -90,6 +90,19 @@ void BoxSet::makeEmptyAndDeleteBoxes()
   m_size=0; 
 } 
 
+//---------------------------------------------------------------
+// Procedure: makeEmptyKeepBSNs
+//   Purpose: o Remove all BSNs from the set but do NOT delete them,
+//              for sets whose BSNs are owned elsewhere, e.g., by
+//              an IvPGrid.
+
+void BoxSet::makeEmptyKeepBSNs()
+{
+  m_head=0; 
+  m_tail=0; 
+  m_size=0; 
+} 
+
 //---------------------------------------------------------------
 // Procedure: addBox
 //   Purpose: o Create and add a BSN to the set.
@@ -40,6 +40,7 @@ public:
 
   void makeEmpty();
   void makeEmptyAndDeleteBoxes();
+  void makeEmptyKeepBSNs();
   int  getSize()     { return(m_size); }
   int  size()        { return(m_size); }
 
@@ -28,6 +28,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstdio>
+#include <atomic>
 #include "IvPBox.h"
 #include "BoxSet.h"
 
@@ -36,6 +37,8 @@
 
 using namespace std;
 
+static atomic<unsigned long> s_heap_blocks(0);
+
 //-------------------------------------------------------------
 // construct a new box with given weight and memory for the given
 // number of dimensions
@@ -44,20 +47,14 @@ IvPBox::IvPBox(int g_dim, int g_degree)
 {
   m_dim     = (short int) g_dim;
   m_degree  = (short int) g_degree;
-  m_pts     = 0;
-  m_bds     = 0;
-  m_wts     = 0;
 
   m_of      = 0;
   m_markval = false;
   m_plat    = 0;
   
+  allocate();
   if(m_dim > 0) {
     int wtc = (m_degree * m_dim)+1;
-    m_pts = new int[m_dim * 2];
-    m_bds = new bool[m_dim * 2];
-    m_wts = new double[wtc];
-    
     int i;
     for(i=0; (i < m_dim); i++) {
       m_pts[i*2]   = 0;
@@ -78,20 +75,14 @@ IvPBox::IvPBox(const IvPBox &b)
 {
   m_dim     = b.m_dim;
   m_degree  = b.m_degree;
-  m_pts     = 0;
-  m_bds     = 0;
-  m_wts     = 0;
 
   m_markval = b.m_markval;
   m_of      = b.m_of;
   m_plat    = b.m_plat;
 
+  allocate();
   if(m_dim > 0) {
     int wtc = (m_degree * m_dim)+1;
-    m_pts = new int[m_dim*2];
-    m_bds = new bool[m_dim*2];
-    m_wts = new double[wtc];
-
     int i;
     for(i=0; i<(m_dim*2); i++) {
       m_pts[i] = b.m_pts[i];
@@ -108,9 +99,62 @@ IvPBox::IvPBox(const IvPBox &b)
 
 IvPBox::~IvPBox()
 {
-  if(m_pts) delete [] m_pts;
-  if(m_bds) delete [] m_bds;
-  if(m_wts) delete [] m_wts;
+  release();
+}
+
+//-------------------------------------------------------------
+// Procedure: allocate()
+//   Purpose: Point m_pts, m_bds and m_wts at room for a box of the
+//            current dimension and degree, in the box itself if
+//            it fits, otherwise in one block from the heap. The
+//            contents are left unset.
+
+void IvPBox::allocate()
+{
+  m_pts   = 0;
+  m_bds   = 0;
+  m_wts   = 0;
+  m_block = 0;
+  if(m_dim == 0)
+    return;
+
+  int wtc = getWtc();
+  if((m_dim <= LOCAL_DIM) && (wtc <= LOCAL_WTC)) {
+    m_pts = m_local_pts;
+    m_bds = m_local_bds;
+    m_wts = m_local_wts;
+    return;
+  }
+
+  // Widest type first so each array is aligned
+  unsigned int bytes = (wtc * sizeof(double)) + 
+    (m_dim * 2 * (sizeof(int) + sizeof(bool)));
+  m_block = new char[bytes];
+  s_heap_blocks.fetch_add(1, memory_order_relaxed);
+  m_wts   = (double*)(m_block);
+  m_pts   = (int*)(m_wts + wtc);
+  m_bds   = (bool*)(m_pts + (m_dim * 2));
+}
+
+//-------------------------------------------------------------
+// Procedure: getHeapBlocks()
+
+unsigned long IvPBox::getHeapBlocks()
+{
+  return(s_heap_blocks.load(memory_order_relaxed));
+}
+
+//-------------------------------------------------------------
+// Procedure: release()
+
+void IvPBox::release()
+{
+  if(m_block)
+    delete [] m_block;
+  m_block = 0;
+  m_pts   = 0;
+  m_bds   = 0;
+  m_wts   = 0;
 }
 
 //------------------------------------------------------
@@ -132,24 +176,13 @@ const IvPBox &IvPBox::operator=(const IvPBox &right)
     
     int wtc = (right.m_degree * right.m_dim) + 1;
 
-    if(m_dim != right.m_dim) {
-      if(m_pts) delete [] m_pts;
-      if(m_bds) delete [] m_bds;
-      m_pts = new int[right.m_dim*2];
-      m_bds = new bool[right.m_dim*2];
-    }
-    
     if((m_dim != right.m_dim) || (m_degree != right.m_degree)) {
-      if(m_wts) 
-	delete [] m_wts;
-      m_wts = 0;
-      if(right.m_dim > 0)
-	m_wts = new double[wtc];
+      release();
+      m_dim    = right.m_dim;
+      m_degree = right.m_degree;
+      allocate();
     }
 
-    m_dim     = right.m_dim;
-    m_degree  = right.m_degree;
-
     for(i=0; i<(m_dim*2); i++) {
       m_pts[i] = right.m_pts[i];
       m_bds[i] = right.m_bds[i];
@@ -614,46 +647,37 @@ void IvPBox::transDomain(int newEdges, const int *edgeMap)
 {
   assert(newEdges>=0);
 
-  // First handle the setting of the new piece boundardy
-  int i, newDim = m_dim + newEdges;
-
-  int *newPts = new int[newDim*2]; 
-  for(i=0; i<newDim; i++) {        
-    newPts[i*2]   = 0;
-    newPts[i*2+1] = 0;
-  }
-  for(i=0; (i<m_dim); i++) {
-    newPts[edgeMap[i]*2]   = m_pts[i*2];
-    newPts[edgeMap[i]*2+1] = m_pts[i*2+1];
-  }
+  // Keep the old box to copy from while the new one is set
+  IvPBox old(*this);
+  release();
+  m_dim = old.m_dim + newEdges;
+  allocate();
 
-  bool *newBds = new bool[newDim*2];
-  for(i=0; i<newDim; i++) {
-    newBds[i*2]   = 1;
-    newBds[i*2+1] = 1;
+  // First handle the setting of the new piece boundardy
+  int i;
+  for(i=0; i<m_dim; i++) {        
+    m_pts[i*2]   = 0;
+    m_pts[i*2+1] = 0;
+    m_bds[i*2]   = 1;
+    m_bds[i*2+1] = 1;
   }
-  for(i=0; i<m_dim; i++) {
-    newBds[edgeMap[i]*2]   = m_bds[i*2];
-    newBds[edgeMap[i]*2+1] = m_bds[i*2+1];
+  for(i=0; (i<old.m_dim); i++) {
+    m_pts[edgeMap[i]*2]   = old.m_pts[i*2];
+    m_pts[edgeMap[i]*2+1] = old.m_pts[i*2+1];
+    m_bds[edgeMap[i]*2]   = old.m_bds[i*2];
+    m_bds[edgeMap[i]*2+1] = old.m_bds[i*2+1];
   }
 
-  delete [] m_pts;  m_pts=newPts;
-  delete [] m_bds;  m_bds=newBds;
-
   // Now handle the setting of the new interior function
+  int wtc = getWtc();
+  for(i=0; i<wtc; i++)
+    m_wts[i] = 0.0;
   if(m_degree != 0) {
-    int     newWtc = m_dim + newEdges + 1;
-    double *newWts = new double[newWtc];
-    for(i=0; i<newWtc; i++)
-      newWts[i] = 0.0;
-    for(i=0; i<m_dim; i++)
-      newWts[edgeMap[i]] = m_wts[i];
-    newWts[newWtc-1] = m_wts[m_dim];
-    delete [] m_wts;
-    m_wts = newWts;
+    for(i=0; i<old.m_dim; i++)
+      m_wts[edgeMap[i]] = old.m_wts[i];
   }
-
-  m_dim = newDim;
+  if(old.m_wts)
+    m_wts[wtc-1] = old.m_wts[old.getWtc()-1];
 }
 
 
@@ -25,6 +25,11 @@
 
 /****************************************************************/
 /* Boundary-type info was added March 16th, 2001                */
+/*                                                              */
+/* The bounds and interior function of boxes of up to three     */
+/* dimensions and up to four weights, e.g., linear boxes over   */
+/* course, speed and depth, are held in the box itself. Larger  */
+/* boxes hold them in one block from the heap.                  */
 /****************************************************************/
 
 #ifndef IvPBOX_HEADER
@@ -82,8 +87,18 @@ public:
   void    transDomain(int, const int*);
 
   unsigned int size() const;
+
+  // Heap blocks taken so far by all boxes too big to be held in
+  // place, over all threads
+  static unsigned long getHeapBlocks();
   
 protected:
+  void    allocate();
+  void    release();
+
+protected:
+  enum {LOCAL_DIM=3, LOCAL_WTC=4};
+
   uint16    m_dim;
   uint16    m_degree;
   int*      m_pts;
@@ -92,6 +107,11 @@ protected:
   int       m_of;
   bool      m_markval;
   int       m_plat;
+
+  char*     m_block;   // Heap storage if too big for the below
+  int       m_local_pts[LOCAL_DIM*2];
+  bool      m_local_bds[LOCAL_DIM*2];
+  double    m_local_wts[LOCAL_WTC];
 };
 #endif
 
@@ -39,6 +39,7 @@ IvPFunction::IvPFunction(PDMap *g_pdmap)
 
   m_pdmap = g_pdmap;
   m_pwt   = 10.0;
+  m_weighted = false;
 }
 
 //-------------------------------------------------------------
@@ -131,6 +132,7 @@ IvPFunction *IvPFunction::copy() const
   IvPFunction *ipf = new IvPFunction(pdmap);
   ipf->setPWT(m_pwt);
   ipf->setContextStr(m_context_string);
+  ipf->setWeighted(m_weighted);
 
   return(ipf);
 }
@@ -38,6 +38,7 @@ public:
   void   setPWT(double);
   void   setContextStr(const std::string& s) {m_context_string=s;}
   bool   transDomain(IvPDomain);
+  void   setWeighted(bool v)  {m_weighted=v;}
 
   double      getPWT()         {return(m_pwt);}
   PDMap*      getPDMap()       {return(m_pdmap);}
@@ -46,6 +47,7 @@ public:
   int         size()           {return(m_pdmap->size());}
   int         getDim()         {return(m_pdmap->getDim());}
   std::string getContextStr()  {return(m_context_string);}
+  bool        isWeighted() const {return(m_weighted);}
   std::string getVarName(int); 
   std::string getGridConfig() const;
   double      getValMaxUtil() const;
@@ -57,5 +59,10 @@ protected:
   PDMap*      m_pdmap;
   double      m_pwt;
   std::string m_context_string;
+
+  // True once a Problem has applied the priority weight to the
+  // pdmap, so a function carried over to a later problem is not
+  // normalized and weighted a second time.
+  bool        m_weighted;
 };
 #endif
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <cassert>
 #include <cmath>
+#include <atomic>
 #include "IvPGrid.h"
 #include "IvPDomain.h"
 
@@ -38,6 +39,8 @@ const bool HIGH = 1;
 
 using namespace std;
 
+static atomic<unsigned long> s_node_blocks(0);
+
 //---------------------------------------------------------------
 // Constructor
 // Notes: The constructor does not do many things that are left for
@@ -55,16 +58,22 @@ IvPGrid::IvPGrid(const IvPDomain& gdomain, bool gboxFlag)
   boxFlag       = gboxFlag;
   total_grids   = 1;          // uninitialized
   grid          = 0;          // uninitialized
+  gridSets      = 0;          // uninitialized
   gridUB        = 0;          // uninitialized
+  gridUBFresh   = 0;          // uninitialized
   gridLUB       = 0;          // uninitialized
   dup_flag      = false;
   maxval        = 0.0;
   empty         = true;
+  nodeBlockSize = 0;
+  nodeBlockUsed = 0;
+  freeNodes     = 0;
   GELS_PER_DIM  = new int   [dim];
   PTS_PER_GEL   = new int   [dim];
   DIM_WT        = new long  [dim];
   IX_BOX_BOUND  = new long *[dim];
   IX_BOX        = new long  [dim];
+  CURSOR        = new long  [3*dim];
   DOMAIN_LOW    = new int   [dim];
   DOMAIN_HIGH   = new int   [dim];
   DOMAIN_SIZE   = new int   [dim];
@@ -93,6 +102,7 @@ IvPGrid::~IvPGrid()
   delete [] PTS_PER_GEL;
   delete [] DIM_WT;          
   delete [] IX_BOX;          
+  delete [] CURSOR;
   delete [] DOMAIN_LOW;
   delete [] DOMAIN_HIGH;     
   delete [] DOMAIN_SIZE;
@@ -101,10 +111,12 @@ IvPGrid::~IvPGrid()
   if(gridUBFresh) delete [] gridUBFresh;  
   if(grid) {
     for(int i=0; i<total_grids; i++)
-      if(grid[i])
-	delete(grid[i]);
+      gridSets[i].makeEmptyKeepBSNs();
+    delete [] gridSets;
     delete [] grid;
   }
+  for(unsigned int i=0; i<nodeBlocks.size(); i++)
+    delete [] nodeBlocks[i];
 
 #if 0  // Linear Upper Bound code in testing
   if(gridLUB) {
@@ -169,9 +181,10 @@ void IvPGrid::initialize(const IvPBox &gelbox)
   // significant" digit etc.
 
   if(boxFlag) {
-    grid = new BoxSet* [total_grids];
+    grid     = new BoxSet* [total_grids];
+    gridSets = new BoxSet [total_grids];
     for(i=0; i<total_grids; i++)
-      grid[i] = new BoxSet;
+      grid[i] = &gridSets[i];
   }
 
   gridUB      = new double  [total_grids];
@@ -210,7 +223,7 @@ void IvPGrid::addBox(IvPBox *b, bool BX, bool UB)
       ix += IX_BOX[d] * DIM_WT[d];   // set in setIXBOX(b) call above.
 
     if(BX) {
-      grid[ix]->addBox(b, LAST);
+      grid[ix]->addBSN(*newNode(b), LAST);
       empty = false;
     }
     if(UB) {
@@ -275,8 +288,8 @@ void IvPGrid::remBox(const IvPBox *rbox)
       nextbsn = bsn->getNext();
       IvPBox *ibox = bsn->getBox();
       if(rbox == ibox) {
-	grid[ix]->remBSN(bsn);      // Must delete BSN also 
-	delete(bsn);             
+	grid[ix]->remBSN(bsn);      // Must free BSN also 
+	freeNode(bsn);             
       }
       bsn = nextbsn;
     }
@@ -284,6 +297,57 @@ void IvPGrid::remBox(const IvPBox *rbox)
   }
 }
 
+//---------------------------------------------------------------
+// Procedure: getNodeBlocks
+
+unsigned long IvPGrid::getNodeBlocks()
+{
+  return(s_node_blocks.load(memory_order_relaxed));
+}
+
+//---------------------------------------------------------------
+// Procedure: newNode
+//   Purpose: o Return a node holding the given box, reusing one 
+//              freed by remBox() if possible, otherwise taken from
+//              the last block of nodes. 
+//            o Blocks double in size, from 256 up to 8192 nodes.
+
+BoxSetNode *IvPGrid::newNode(IvPBox *b)
+{
+  BoxSetNode *bsn = freeNodes;
+  if(bsn)
+    freeNodes = bsn->m_next;
+  else {
+    if(nodeBlockUsed == nodeBlockSize) {
+      if(nodeBlockSize == 0)
+	nodeBlockSize = 256;
+      else if(nodeBlockSize < 8192)
+	nodeBlockSize *= 2;
+      nodeBlocks.push_back(new BoxSetNode[nodeBlockSize]);
+      s_node_blocks.fetch_add(1, memory_order_relaxed);
+      nodeBlockUsed = 0;
+    }
+    bsn = &(nodeBlocks.back()[nodeBlockUsed++]);
+  }
+  bsn->m_prev = 0;
+  bsn->m_next = 0;
+  bsn->m_box  = b;
+  return(bsn);
+}
+
+//---------------------------------------------------------------
+// Procedure: freeNode
+//   Purpose: Keep the given node, already removed from its BoxSet,
+//            for reuse by newNode().
+
+void IvPGrid::freeNode(BoxSetNode *bsn)
+{
+  bsn->m_box  = 0;
+  bsn->m_prev = 0;
+  bsn->m_next = freeNodes;
+  freeNodes   = bsn;
+}
+
 //---------------------------------------------------------------
 // Procedure: getBS
 //   Purpose: o Take given box, visit each of the grids associated
@@ -322,6 +386,63 @@ BoxSet *IvPGrid::getBS(const IvPBox *b, bool int_check)
   return(retBS);
 }
 
+//---------------------------------------------------------------
+// Procedure: getBS
+//   Purpose: o Same as getBS() above but the boxes are written to
+//              the given vector, which the caller may reuse across
+//              queries so no memory is allocated once it has grown.
+//            o Rather than marking boxes and then removing dups, a
+//              box in several grids is kept only in the first of
+//              those grids visited. Grids are visited from the high
+//              corner down, so that is the grid at the lower of the
+//              two high corners of the box and the query in each
+//              dimension. Boxes come out in the same order as with
+//              removeDups().
+
+void IvPGrid::getBS(const IvPBox *b, vector<IvPBox*>& boxes, 
+		    bool int_check)
+{
+  getBS(b, boxes, CURSOR, int_check);
+}
+
+//---------------------------------------------------------------
+// Procedure: getBS
+//   Purpose: Same as getBS() above, walking the grids with the
+//            cursor given by the caller rather than IX_BOX[], so
+//            nothing in the grid is changed.
+
+void IvPGrid::getBS(const IvPBox *b, vector<IvPBox*>& boxes, 
+		    long *cursor, bool int_check) const
+{
+  boxes.clear();
+  setCursor(b, cursor);
+
+  const long *high = cursor + (2*dim);
+
+  bool moreGrids = true;
+  while(moreGrids) {
+    long ix = 0;
+    for(int d=dim-1; d>=0; d--)
+      ix += cursor[d] * DIM_WT[d];
+    
+    BoxSetNode *bsn = grid[ix]->retBSN(FIRST);
+    while(bsn != 0) {
+      IvPBox *iBox = bsn->getBox();
+      bool keep = !int_check || b->intersect(iBox);
+      for(int d=0; keep && dup_flag && (d<dim); d++) {
+	long relPT = min(DOMAIN_HIGH[d]-DOMAIN_LOW[d],
+			 iBox->pt(d, HIGH)-DOMAIN_LOW[d]);
+	long first = min(relPT / PTS_PER_GEL[d], high[d]);
+	keep = (cursor[d] == first);
+      }
+      if(keep)
+	boxes.push_back(iBox);
+      bsn = bsn->getNext();
+    }
+    moreGrids = moveCursor(cursor);
+  }
+}
+
 //---------------------------------------------------------------
 // Procedure: getBS
 //   Purpose: o Take given box, visit each of the grids associated
@@ -359,6 +480,29 @@ BoxSet *IvPGrid::getBS_Thresh(const IvPBox *qbox, double thresh)
   return(retBS);
 }
 
+//---------------------------------------------------------------
+// Procedure: getGELs
+//   Purpose: o Fill gels with the index of each grid element that
+//              intersects the given box, in the order getBS()
+//              visits them.
+//            o The caller owns the vector so it may be reused
+//              across queries without reallocating.
+
+void IvPGrid::getGELs(const IvPBox *b, vector<long>& gels)
+{
+  gels.clear();
+  setIXBOX(b);                      // Set IX_BOX array.
+
+  bool moreGrids = true;
+  while(moreGrids) {
+    long ix = 0;
+    for(int d=dim-1; d>=0; d--)
+      ix += IX_BOX[d] * DIM_WT[d];
+    gels.push_back(ix);
+    moreGrids = moveToNextGrid();
+  }
+}
+
 //---------------------------------------------------------------
 // Procedure: getCheapBound
 //   Purpose: There is an upper bound associated with each grid element.
@@ -368,30 +512,41 @@ BoxSet *IvPGrid::getBS_Thresh(const IvPBox *qbox, double thresh)
 
 double IvPGrid::getCheapBound(const IvPBox *qbox)
 {
-  long    ix;
+  if(qbox)
+    return(getCheapBound(qbox, CURSOR));
+
   double  result=-99999.0;
 
   bool firstGrid = true;
-  if(qbox) {
-    setIXBOX(qbox);                  // Set IX_BOX array.
-    bool moreGrids = true;
-    while(moreGrids) {
-      ix = 0;                        // March thru each grid that
-      for(int d=dim-1; d>=0; d--)    // intersects given box. IX_BOX[]
-	ix += IX_BOX[d] * DIM_WT[d]; // set in setIXBOX(b) call above.
-      if(!gridUBFresh[ix])
-	if(firstGrid || (gridUB[ix]>result))
-	  result = gridUB[ix];
-      firstGrid = false;
-      moreGrids = moveToNextGrid();
-    }
+  for(int ix=1; ix<total_grids; ix++) {
+    if(!gridUBFresh[ix])
+      if(firstGrid || (gridUB[ix] > result))
+	result = gridUB[ix];
   }
-  if(!qbox) {
-    for(int ix=1; ix<total_grids; ix++) {
-      if(!gridUBFresh[ix])
-	if(firstGrid || (gridUB[ix] > result))
-	  result = gridUB[ix];
-    }
+  return(result);
+}
+
+//---------------------------------------------------------------
+// Procedure: getCheapBound
+//   Purpose: Bound for the grids intersecting the given box, using
+//            the cursor given by the caller rather than IX_BOX[].
+
+double IvPGrid::getCheapBound(const IvPBox *qbox, long *cursor) const
+{
+  double result = -99999.0;
+
+  bool firstGrid = true;
+  setCursor(qbox, cursor);
+  bool moreGrids = true;
+  while(moreGrids) {
+    long ix = 0;
+    for(int d=dim-1; d>=0; d--)
+      ix += cursor[d] * DIM_WT[d];
+    if(!gridUBFresh[ix])
+      if(firstGrid || (gridUB[ix]>result))
+	result = gridUB[ix];
+    firstGrid = false;
+    moreGrids = moveCursor(cursor);
   }
   return(result);
 }
@@ -536,6 +691,54 @@ inline bool IvPGrid::moveToNextGrid()
   return(moreGrids);
 }
 
+//---------------------------------------------------------------
+// Procedure: setCursor
+//   Purpose: Same as setIXBOX() but for a cursor given by the
+//            caller. The first dim entries play the part of
+//            IX_BOX[], the next dim the low bounds, and the last 
+//            dim the high bounds of IX_BOX_BOUND[].
+
+void IvPGrid::setCursor(const IvPBox* b, long *cursor) const
+{
+  long *low  = cursor + dim;
+  long *high = cursor + (2*dim);
+
+  long relPT = 0;
+  for(int d=0; d<dim; d++) {
+    if(b->bd(d,0) == 1)
+      relPT = max(0, b->pt(d, LOW)-DOMAIN_LOW[d]);
+    else
+      relPT = max(0, 1 + b->pt(d, LOW)-DOMAIN_LOW[d]);
+    low[d] = relPT / PTS_PER_GEL[d];
+    relPT = min(DOMAIN_HIGH[d]-DOMAIN_LOW[d],
+		b->pt(d, HIGH)-DOMAIN_LOW[d]);
+    high[d] = relPT / PTS_PER_GEL[d];
+    cursor[d] = high[d];
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: moveCursor
+//   Purpose: Same as moveToNextGrid() but for a cursor given by
+//            the caller.
+
+inline bool IvPGrid::moveCursor(long *cursor) const
+{
+  const long *low  = cursor + dim;
+  const long *high = cursor + (2*dim);
+
+  bool moreGrids = false;
+  for(int d=dim-1; (d>=0)&&(!moreGrids); d--) {
+    if(cursor[d] > low[d]) {
+      cursor[d]--;
+      moreGrids = true;
+    }
+    else
+      if(d != 0) cursor[d] = high[d];
+  }
+  return(moreGrids);
+}
+
 //---------------------------------------------------------------
 // Procedure: calcBoxesPerGEL
 //   Purpose: Prints general info on grid construction
@@ -27,6 +27,7 @@
 #define GRID_HEADER
 
 #include <string>
+#include <vector>
 #include "BoxSet.h"
 
 class IvPDomain;
@@ -38,10 +39,18 @@ public:
   void     addBox(IvPBox*, bool BX=1, bool UB=1);
   void     remBox(const IvPBox *);
   BoxSet*  getBS(const IvPBox*, bool=true);
+  void     getBS(const IvPBox*, std::vector<IvPBox*>&, bool=true);
   BoxSet*  getBS_Thresh(const IvPBox*, double);
+  void     getGELs(const IvPBox*, std::vector<long>&);
   double   getCheapBound(const IvPBox *b=0);
   double   getTightBound(const IvPBox *b=0);
   double*  getLinearBound(const IvPBox *b);
+
+  // As above but safe to call from several threads at once. The
+  // caller provides the grid cursor, room for 3*getDim() longs.
+  void     getBS(const IvPBox*, std::vector<IvPBox*>&, long *cursor,
+		 bool=true) const;
+  double   getCheapBound(const IvPBox*, long *cursor) const;
   void     scaleBounds(double);
   void     moveBounds(double);
 
@@ -50,12 +59,20 @@ public:
   IvPBox   getMaxPt()          {return(maxpt);}
   double   getMaxVal()         {return(maxval);}
   bool     isEmpty()           {return(empty);}
+  BoxSet*  getGEL(long ix)     {return(grid ? grid[ix] : 0);}
   
   std::string getGridConfig() const;
 
+  // Blocks of nodes taken so far by all grids, over all threads
+  static unsigned long getNodeBlocks();
+
  protected:
   void     setIXBOX(const IvPBox*);
   bool     moveToNextGrid();
+  void     setCursor(const IvPBox*, long *cursor) const;
+  bool     moveCursor(long *cursor) const;
+  BoxSetNode* newNode(IvPBox*);
+  void     freeNode(BoxSetNode*);
 
 
 
@@ -73,11 +90,13 @@ protected:
   double** gridLUB;            // Upper linear bound
   bool*    gridUBFresh;        // Fresh/NotFresh if first bound
   BoxSet** grid;               // LList of Boxes int each grid
+  BoxSet*  gridSets;           // The BoxSets, in one allocation
   int*     GELS_PER_DIM;       // # of grids per dimension
   int*     PTS_PER_GEL;        // # domain pts btwn grid lines
   long*    DIM_WT;             // Translate 1D array to nD grid
   long**   IX_BOX_BOUND;       // Indicates grids intersect box
   long*    IX_BOX;             // Indicates particular gel
+  long*    CURSOR;             // Cursor for the vector queries
   int*     DOMAIN_LOW;         // For each dim, lower bound
   int*     DOMAIN_HIGH;        // For each dim, upper bound
   int*     DOMAIN_SIZE;        // For each dim, domain size
@@ -87,6 +106,14 @@ protected:
   IvPBox   maxpt;
   double   maxval;
   bool     empty;
+
+  // The nodes of the BoxSets are taken from blocks owned by the
+  // grid, rather than each taken from the heap, and are freed
+  // with the grid. Nodes removed by remBox() are kept for reuse.
+  std::vector<BoxSetNode*> nodeBlocks;
+  unsigned int nodeBlockSize;  // # nodes in the last block
+  unsigned int nodeBlockUsed;  // # nodes used of the last block
+  BoxSetNode*  freeNodes;      // Nodes given back by remBox()
 };  
 
 #endif
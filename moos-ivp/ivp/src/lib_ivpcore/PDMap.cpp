@@ -30,6 +30,7 @@
 #include "PDMap.h"
 #include "BoxSet.h"
 #include "IvPGrid.h"
+#include "PDMapFlat.h"
 
 #ifdef _WIN32
 #   include <float.h>
@@ -62,6 +63,7 @@ PDMap::PDMap(int g_boxCount, const IvPDomain& g_domain, int g_degree)
   m_domain   = g_domain;
   m_degree   = g_degree;
   m_grid     = 0;
+  m_flat     = 0;
 
   int dim = m_domain.size();
 
@@ -93,6 +95,9 @@ PDMap::PDMap(const PDMap *pdmap)
   m_grid->initialize(m_gelbox);
   for(i=0; (i < m_boxCount); i++)
     m_grid->addBox(m_boxes[i], 1, 1);
+
+  m_flat = 0;
+  updateFlat();
 }
 
 //-------------------------------------------------------------
@@ -109,6 +114,9 @@ PDMap::~PDMap()
 
   if(m_grid) 
     delete(m_grid);
+
+  if(m_flat)
+    delete(m_flat);
 }
 
 //-------------------------------------------------------------
@@ -126,10 +134,8 @@ PDMap::~PDMap()
 int PDMap::getIX(const IvPBox *gbox)
 { 
   assert(m_grid);
-  BoxSet *intBoxes = m_grid->getBS(gbox);
-  int retIX = intBoxes->retBSN()->getBox()->ofindex();
-  delete(intBoxes);
-  return(retIX);
+  m_grid->getBS(gbox, m_query_boxes);
+  return(m_query_boxes[0]->ofindex());
 }
 
 //-------------------------------------------------------------
@@ -147,6 +153,8 @@ void PDMap::applyWeight(double weight)
     m_boxes[i]->scaleWT(weight);
   if(m_grid) 
     m_grid->scaleBounds(weight);
+  if(m_flat)
+    m_flat->scaleWT(weight);
 }
 
 //-------------------------------------------------------------
@@ -161,6 +169,8 @@ void PDMap::applyScalar(double scalar_val)
     m_boxes[i]->moveIntercept(scalar_val);
   if(m_grid) 
     m_grid->moveBounds(scalar_val);
+  if(m_flat)
+    m_flat->moveIntercept(scalar_val);
 }
 
 //-------------------------------------------------------------
@@ -355,7 +365,8 @@ string PDMap::getGridConfig() const
 // Procedure: evalPoint()
 //     Notes: o Evaluate the value (based on the pieces) of given box.
 //            o The given box should be a point box.
-//            o If grid is "filled" use it. Else iterate thru boxes.
+//            o If the flattened copy is current use it, otherwise if
+//              grid is "filled" use it. Else iterate thru boxes.
 //            o If "covered" is non-null, it is to reflect whether or not
 //              the given pointbox is contained/covered by one of the boxes
 //              in the PDMap. This may be interpreted as negative infinity
@@ -377,6 +388,15 @@ double PDMap::evalPoint(const IvPBox *gbox, bool* covered) const
     return(retVal);
   }    
 
+  if(m_flat && (m_flat->size() == m_boxCount)) {
+    int ix = m_flat->getPiece(gbox);
+    if(ix < 0)
+      return(retVal);
+    if(covered)
+      *covered = true;
+    return(m_flat->ptVal(ix, gbox));
+  }
+
   if(m_grid==0) {
     //cout << "Warning!!! PDMap::evalPoint() working w/out grid!!!" << endl;
     for(int i=0; (i < m_boxCount); i++)
@@ -448,6 +468,23 @@ void PDMap::updateGrid(bool BX, bool UB)
 
   for(int i=0; (i < m_boxCount); i++)
     m_grid->addBox(m_boxes[i], BX, UB);
+
+  updateFlat();
+}
+
+//-------------------------------------------------------------
+// Procedure: updateFlat()
+//   Purpose: Rebuild the flattened (structure of arrays) copy of
+//            the boxes and grid used by the solver and evalPoint.
+//      Note: Changes made to boxes through bx() are not seen by
+//            the flattened copy until this, or updateGrid(), is 
+//            called, as IvPProblem::preCompact() does.
+
+void PDMap::updateFlat()
+{
+  if(!m_flat)
+    m_flat = new PDMapFlat;
+  m_flat->build(*this);
 }
 
 //-------------------------------------------------------------
@@ -475,6 +512,11 @@ void PDMap::growBoxArray(int amt)
     newboxes[i] = 0;
   delete [] m_boxes;
   m_boxes = newboxes;
+
+  if(m_flat) {
+    delete(m_flat);
+    m_flat = 0;
+  }
 }
 
 //---------------------------------------------------------------------
@@ -520,6 +562,10 @@ bool PDMap::transDomain(const IvPDomain& gdomain,
 
   m_domain = gdomain;  // Added mikerb
   delete [] setFlag;
+  if(m_flat) {
+    delete(m_flat);
+    m_flat = 0;
+  }
   if(m_grid)
     updateGrid(1,1);
   return(true);
@@ -27,10 +27,12 @@
 #define PDMAP_HEADER
 
 #include <string> 
+#include <vector>
 #include "IvPBox.h"
 #include "BoxSet.h"
 #include "IvPGrid.h"
 #include "IvPDomain.h"
+#include "PDMapFlat.h"
 
 class PDMap {
 public:
@@ -45,6 +47,7 @@ public:
   
   int       getDim() const        {return(m_domain.size());}
   IvPGrid*  getGrid()             {return(m_grid);}
+  const PDMapFlat* getFlat() const {return(m_flat);}
   IvPBox    getGelBox() const     {return(m_gelbox);}
   IvPDomain getDomain() const     {return(m_domain);}
   BoxSet*   getBS(const IvPBox*); 
@@ -56,6 +59,7 @@ public:
   double    getMaxWT() const;
 
   void      updateGrid(bool BX=1, bool UB=1);
+  void      updateFlat();
   bool      setGelBox(const IvPBox& box);
   void      setGelBox();
   std::string getGridConfig() const;
@@ -84,6 +88,9 @@ protected:
   int       m_degree;   // Zero:Scalar, Nonzero: Linear
   IvPBox    m_gelbox;
   IvPGrid*  m_grid;
+  PDMapFlat* m_flat;  // Snapshot of boxes for the solver
+
+  std::vector<IvPBox*> m_query_boxes; // Reused by getIX()
 }; 
 #endif
 
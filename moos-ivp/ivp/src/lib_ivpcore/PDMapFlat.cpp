@@ -0,0 +1,364 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: PDMapFlat.cpp                                        */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstring>
+#include "PDMapFlat.h"
+#include "PDMap.h"
+#include "IvPGrid.h"
+#include "BoxSet.h"
+
+using namespace std;
+
+//-------------------------------------------------------------
+// Procedure: Constructor()
+
+PDMapFlat::PDMapFlat()
+{
+  m_block = 0;
+  m_query = 0;
+  clear();
+}
+
+//-------------------------------------------------------------
+// Procedure: Destructor()
+
+PDMapFlat::~PDMapFlat()
+{
+  clear();
+}
+
+//-------------------------------------------------------------
+// Procedure: clear()
+
+void PDMapFlat::clear()
+{
+  if(m_block)
+    delete [] m_block;
+
+  m_block     = 0;
+  m_count     = 0;
+  m_dim       = 0;
+  m_degree    = 0;
+  m_wtc       = 0;
+  m_gels      = 0;
+  m_wts       = 0;
+  m_lo        = 0;
+  m_hi        = 0;
+  m_gel_start = 0;
+  m_gel_ixs   = 0;
+  m_stamp     = 0;
+  m_lo_bd     = 0;
+  m_hi_bd     = 0;
+  m_grid      = 0;
+}
+
+//-------------------------------------------------------------
+// Procedure: build()
+//   Purpose: Take a snapshot of the boxes in the given pdmap and
+//            of the contents of each element of its grid.
+//      Note: Each box has its ofindex set to its position in the
+//            pdmap, as PDMap::getIX() expects. That index is how
+//            the boxes in a grid element are found in the arrays.
+//      Note: If the grid does not hold boxes, or holds a box not
+//            in the pdmap, the grid is not used and getBS() will
+//            check every piece.
+
+void PDMapFlat::build(PDMap& pdmap)
+{
+  clear();
+
+  int count = pdmap.size();
+  for(int i=0; i<count; i++)
+    if(pdmap.bx(i) == 0)
+      return;
+
+  for(int i=0; i<count; i++)
+    pdmap.bx(i)->ofindex() = i;
+
+  m_count  = count;
+  m_dim    = pdmap.getDim();
+  m_degree = pdmap.getDegree();
+  m_wtc    = (m_degree * m_dim) + 1;
+
+  // Count the entries in the grid, confirming along the way that
+  // every box in the grid is one of ours.
+  IvPGrid *grid = pdmap.getGrid();
+  long entries  = 0;
+  if(grid && (grid->getGEL(0) != 0)) {
+    m_gels = grid->getTotalGrids();
+    for(long g=0; (g < m_gels) && grid; g++) {
+      BoxSetNode *bsn = grid->getGEL(g)->retBSN(FIRST);
+      while(bsn && grid) {
+	IvPBox *box = bsn->getBox();
+	int ix = box->ofindex();
+	if((ix < 0) || (ix >= count) || (pdmap.bx(ix) != box))
+	  grid = 0;
+	entries++;
+	bsn = bsn->getNext();
+      }
+    }
+    if(!grid) {
+      m_gels  = 0;
+      entries = 0;
+    }
+  }
+  m_grid = grid;
+
+  // One allocation, widest types first so each array is aligned.
+  size_t dbls  = (size_t)(m_wtc) * count;
+  size_t ints  = (size_t)(2 * m_dim) * count + (m_gels + 1) + entries;
+  size_t uints = (size_t)(count);
+  size_t chars = (size_t)(2 * m_dim) * count;
+
+  size_t bytes = (dbls * sizeof(double)) + (ints * sizeof(int)) +
+    (uints * sizeof(unsigned int)) + chars;
+  m_block = new char[bytes];
+
+  m_wts       = (double*)(m_block);
+  m_lo        = (int*)(m_wts + dbls);
+  m_hi        = m_lo + (m_dim * count);
+  m_gel_start = m_hi + (m_dim * count);
+  m_gel_ixs   = m_gel_start + (m_gels + 1);
+  m_stamp     = (unsigned int*)(m_gel_ixs + entries);
+  m_lo_bd     = (unsigned char*)(m_stamp + uints);
+  m_hi_bd     = m_lo_bd + (m_dim * count);
+
+  for(int i=0; i<count; i++) {
+    const IvPBox *box = pdmap.getBox(i);
+    for(int d=0; d<m_dim; d++) {
+      m_lo[d*count+i]    = box->pt(d,0);
+      m_hi[d*count+i]    = box->pt(d,1);
+      m_lo_bd[d*count+i] = box->bd(d,0);
+      m_hi_bd[d*count+i] = box->bd(d,1);
+    }
+    for(int k=0; k<m_wtc; k++)
+      m_wts[k*count+i] = box->wt(k);
+  }
+  memset(m_stamp, 0, uints * sizeof(unsigned int));
+  m_query = 0;
+
+  // Room for the largest possible query, so none grows the vectors
+  m_query_gels.reserve(m_gels);
+  m_query_ixs.reserve(count);
+
+  int next = 0;
+  for(long g=0; g<m_gels; g++) {
+    m_gel_start[g] = next;
+    BoxSetNode *bsn = m_grid->getGEL(g)->retBSN(FIRST);
+    while(bsn) {
+      m_gel_ixs[next++] = bsn->getBox()->ofindex();
+      bsn = bsn->getNext();
+    }
+  }
+  m_gel_start[m_gels] = next;
+}
+
+//-------------------------------------------------------------
+// Procedure: intersect()
+//   Purpose: Determine if piece i intersects the given box. Same
+//            test as IvPBox::intersect(const IvPBox*).
+
+bool PDMapFlat::intersect(int i, const IvPBox *gbox) const
+{
+  int d;
+  for(d=0; (d < m_dim); d++) {
+    int ix = d*m_count+i;
+    if(m_lo[ix] > gbox->pt(d,1))
+      return(false);
+    if(m_hi[ix] < gbox->pt(d,0))
+      return(false);
+  }
+
+  for(d=0; (d < m_dim); d++) {
+    int ix = d*m_count+i;
+    if(m_lo[ix] == gbox->pt(d,1))
+      if((m_lo_bd[ix]==0) || (gbox->bd(d,1)==0))
+	return(false);
+    if(m_hi[ix] == gbox->pt(d,0))
+      if((m_hi_bd[ix]==0) || (gbox->bd(d,0)==0))
+	return(false);
+  }
+  return(true);
+}
+
+//-------------------------------------------------------------
+// Procedure: intersect()
+//   Purpose: o Set rbox to the region common to nbox and piece i,
+//              with the interior function of rbox being the sum
+//              of the two.
+//            o Same result as nbox->intersect(piece, rbox).
+//            o Returns false, leaving rbox alone, if they do not
+//              intersect.
+
+bool PDMapFlat::intersect(int i, const IvPBox *nbox, IvPBox *rbox) const
+{
+  if(!intersect(i, nbox))
+    return(false);
+
+  for(int d=0; (d < m_dim); d++) {
+    int  ix   = d*m_count+i;
+    int  n_lo = nbox->pt(d,0);
+    int  n_hi = nbox->pt(d,1);
+    bool n_lb = nbox->bd(d,0);
+    bool n_hb = nbox->bd(d,1);
+
+    if(n_lo > m_lo[ix]) {
+      rbox->pt(d,0) = n_lo;
+      rbox->bd(d,0) = n_lb;
+    }
+    else if(n_lo < m_lo[ix]) {
+      rbox->pt(d,0) = m_lo[ix];
+      rbox->bd(d,0) = m_lo_bd[ix];
+    }
+    else {
+      rbox->pt(d,0) = n_lo;
+      rbox->bd(d,0) = n_lb && m_lo_bd[ix];
+    }
+
+    if(n_hi < m_hi[ix]) {
+      rbox->pt(d,1) = n_hi;
+      rbox->bd(d,1) = n_hb;
+    }
+    else if(n_hi > m_hi[ix]) {
+      rbox->pt(d,1) = m_hi[ix];
+      rbox->bd(d,1) = m_hi_bd[ix];
+    }
+    else {
+      rbox->pt(d,1) = n_hi;
+      rbox->bd(d,1) = n_hb && m_hi_bd[ix];
+    }
+  }
+
+  int wtc = nbox->getWtc();
+  for(int k=0; k<wtc; k++)
+    rbox->wt(k) = nbox->wt(k) + m_wts[k*m_count+i];
+
+  return(true);
+}
+
+//-------------------------------------------------------------
+// Procedure: ptVal()
+//   Purpose: Value of piece i at the given point box. Same as
+//            IvPBox::ptVal().
+
+double PDMapFlat::ptVal(int i, const IvPBox *gbox) const
+{
+  if(m_degree==0)
+    return(m_wts[i]);
+  else if(m_degree==1) {
+    double retval = m_wts[m_dim*m_count+i];
+    for(int d=0; (d < m_dim); d++)
+      retval += (m_wts[d*m_count+i] * gbox->pt(d,0));
+    return(retval);
+  }
+  else if(m_degree==2) {
+    double retval = m_wts[(m_dim*2)*m_count+i];
+    for(int d=0; (d < m_dim); d++) {
+      int p = gbox->pt(d,0);
+      retval += (m_wts[d*m_count+i]*p*p) + (m_wts[(d+m_dim)*m_count+i]*p);
+    }
+    return(retval);
+  }
+  else
+    return(0);
+}
+
+//-------------------------------------------------------------
+// Procedure: scaleWT()
+//   Purpose: Multiply the interior function of every piece by the
+//            given amount, as PDMap::applyWeight() does the boxes.
+
+void PDMapFlat::scaleWT(double amount)
+{
+  int total = m_wtc * m_count;
+  for(int i=0; i<total; i++)
+    m_wts[i] *= amount;
+}
+
+//-------------------------------------------------------------
+// Procedure: moveIntercept()
+//   Purpose: Add the given amount to the interior function of
+//            every piece, as PDMap::applyScalar() does the boxes.
+
+void PDMapFlat::moveIntercept(double amount)
+{
+  double *intercepts = m_wts + ((m_wtc-1) * m_count);
+  for(int i=0; i<m_count; i++)
+    intercepts[i] += amount;
+}
+
+//-------------------------------------------------------------
+// Procedure: getBS()
+//   Purpose: o Fill ixs with the index of each piece intersecting
+//              the given box, no duplicates.
+//            o Pieces are given in the same order as the grid's
+//              IvPGrid::getBS() would give the boxes.
+
+void PDMapFlat::getBS(const IvPBox *qbox, vector<int>& ixs) const
+{
+  ixs.clear();
+
+  if(!m_grid) {
+    for(int i=0; i<m_count; i++)
+      if(intersect(i, qbox))
+	ixs.push_back(i);
+    return;
+  }
+
+  // Stamp each piece with the query number the first time it is
+  // seen so pieces in several grid elements are reported once.
+  m_query++;
+  if(m_query == 0) {
+    memset(m_stamp, 0, m_count * sizeof(unsigned int));
+    m_query = 1;
+  }
+
+  m_grid->getGELs(qbox, m_query_gels);
+  for(unsigned int g=0; g<m_query_gels.size(); g++) {
+    long gel = m_query_gels[g];
+    for(int j=m_gel_start[gel]; j<m_gel_start[gel+1]; j++) {
+      int ix = m_gel_ixs[j];
+      if(m_stamp[ix] == m_query)
+	continue;
+      m_stamp[ix] = m_query;
+      if(intersect(ix, qbox))
+	ixs.push_back(ix);
+    }
+  }
+}
+
+//-------------------------------------------------------------
+// Procedure: getPiece()
+//   Purpose: Return the index of the one piece containing the
+//            given point box, or -1 if no piece, or more than one
+//            piece, contains it.
+
+int PDMapFlat::getPiece(const IvPBox *ptbox) const
+{
+  getBS(ptbox, m_query_ixs);
+  if(m_query_ixs.size() != 1)
+    return(-1);
+  return(m_query_ixs[0]);
+}
@@ -0,0 +1,106 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: PDMapFlat.h                                          */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+/****************************************************************/
+/* A read-only snapshot of the pieces of a PDMap, laid out as   */
+/* one array per dimension (structure of arrays) in a single    */
+/* allocation. The boxes of each grid element are kept as runs  */
+/* of piece indices into the same arrays. Used by the solver    */
+/* and by PDMap::evalPoint() so the inner loops walk contiguous */
+/* memory rather than a linked list of pointers to boxes.       */
+/*                                                              */
+/* The snapshot does not track later changes to the boxes. It   */
+/* is rebuilt by PDMap::updateFlat(), which is called whenever  */
+/* the grid is rebuilt, and by anything altering the boxes     */
+/* directly, e.g., IvPProblem::preCompact(). Weight changes     */
+/* made through the PDMap are applied to the snapshot as well.  */
+/****************************************************************/
+
+#ifndef PDMAP_FLAT_HEADER
+#define PDMAP_FLAT_HEADER
+
+#include <vector>
+#include "IvPBox.h"
+
+class PDMap;
+class IvPGrid;
+
+class PDMapFlat {
+public:
+  PDMapFlat();
+  ~PDMapFlat();
+
+  void   build(PDMap&);
+  void   clear();
+
+  int    size() const        {return(m_count);}
+  int    getDim() const      {return(m_dim);}
+  int    getDegree() const   {return(m_degree);}
+
+  int    lo(int d, int i) const  {return(m_lo[d*m_count+i]);}
+  int    hi(int d, int i) const  {return(m_hi[d*m_count+i]);}
+  double wt(int k, int i) const  {return(m_wts[k*m_count+i]);}
+
+  bool   intersect(int i, const IvPBox*) const;
+  bool   intersect(int i, const IvPBox*, IvPBox*) const;
+  double ptVal(int i, const IvPBox*) const;
+
+  void   scaleWT(double);
+  void   moveIntercept(double);
+
+  void   getBS(const IvPBox*, std::vector<int>&) const;
+  int    getPiece(const IvPBox*) const;
+
+protected:
+  int    m_count;
+  int    m_dim;
+  int    m_degree;
+  int    m_wtc;
+  int    m_gels;
+
+  char*  m_block;     // The one allocation holding all below
+
+  double*        m_wts;       // [wtc][count] interior function
+  int*           m_lo;        // [dim][count] lower bound
+  int*           m_hi;        // [dim][count] upper bound
+  int*           m_gel_start; // [gels+1] start of each gel's run
+  int*           m_gel_ixs;   // pieces in each gel, in grid order
+  unsigned int*  m_stamp;     // [count] last query to see piece
+  unsigned char* m_lo_bd;     // [dim][count] lower bound inclusive
+  unsigned char* m_hi_bd;     // [dim][count] upper bound inclusive
+
+  IvPGrid*       m_grid;
+
+  // Scratch space for queries, kept to avoid reallocating
+  mutable unsigned int      m_query;
+  mutable std::vector<long> m_query_gels;
+  mutable std::vector<int>  m_query_ixs;
+
+private:
+  PDMapFlat(const PDMapFlat&);
+  const PDMapFlat &operator=(const PDMapFlat&);
+};
+
+#endif
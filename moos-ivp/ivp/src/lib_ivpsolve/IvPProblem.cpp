@@ -42,6 +42,7 @@ using namespace std;
 IvPProblem::IvPProblem(Compactor *g_compactor)
 {
   nodeBox = 0;
+  m_node_boxes = 0;
   if(g_compactor) {
     compactor = g_compactor;
     ownCompactor = false;
@@ -52,6 +53,7 @@ IvPProblem::IvPProblem(Compactor *g_compactor)
   }
 
   m_leafs_visited = 0;
+  m_use_flat = true;
 }
 
 //---------------------------------------------------------------
@@ -59,6 +61,10 @@ IvPProblem::IvPProblem(Compactor *g_compactor)
 
 IvPProblem::~IvPProblem() 
 {
+  for(int i=0; (i < m_node_boxes); i++)
+    delete(nodeBox[i]);
+  delete [] nodeBox;
+
   if(ownCompactor)
     delete(compactor);
 }
@@ -88,31 +94,41 @@ void IvPProblem::preCompact()
       }
     } 
     pdmap->removeNULLs();
+    // Compaction alters boxes in place, so the flattened copy of 
+    // the boxes must be refreshed.
+    pdmap->updateFlat();
   }
 }
 
 //---------------------------------------------------------------
-// Procedure: solvePrior
-//   Purpose: Does the necessary things before starting the branch
-//            and bound process.
-
-void IvPProblem::solvePrior(const IvPBox *isolBox)
+// Procedure: prepareSolve
+//   Purpose: Make everything the solve will need: the box at each
+//            level of the tree, a grid for each OF, room for the
+//            pieces found at each level and for the solution.
+//      Note: solve() calls this itself. Calling it beforehand keeps
+//            every allocation out of the solve. Calling it again
+//            allocates nothing unless the problem has changed.
+
+void IvPProblem::prepareSolve()
 {
-  // Reset timer (may have values from previous solve invocation)
-  // Start timer after (perhaps) outputting start message.
-  if(!m_silent) cout << "---> entering IvP Solve routine: " << endl;
+  if(m_ofnum == 0)
+    return;
 
-  // A nodeBox is associated with each level of the tree. 
-  // Initialized here rather than in constructor since we need to 
-  // know the number of objective functions first.
-  nodeBox = new IvPBox*[m_ofnum+1];
+  const IvPBox& universe = m_ofs[0]->getPDMap()->getUniverse();
 
-  for(int i=0; (i < m_ofnum+1); i++)
-    nodeBox[i] = m_ofs[0]->getPDMap()->getUniverse().copy();
-  nodeBox[0]->setWT(0.0);
-  
-  if(isolBox)
-    processInitSol(isolBox);
+  // A nodeBox is associated with each level of the tree. Made 
+  // here rather than in constructor since we need to know the
+  // number of objective functions first. Kept across solves.
+  if(m_node_boxes != m_ofnum+1) {
+    for(int i=0; (i < m_node_boxes); i++)
+      delete(nodeBox[i]);
+    delete [] nodeBox;
+
+    m_node_boxes = m_ofnum+1;
+    nodeBox = new IvPBox*[m_node_boxes];
+    for(int i=0; (i < m_node_boxes); i++)
+      nodeBox[i] = universe.copy();
+  }
 
   // Really shouldn't have to take care of the grid here, but will
   // do anyway so we can run the solve process confident that all
@@ -124,8 +140,53 @@ void IvPProblem::solvePrior(const IvPBox *isolBox)
       //cout << "] having a null grid. A default one was provided" << endl;
       pdmap->updateGrid();
     }
+    else if(m_use_flat) {
+      const PDMapFlat *flat = pdmap->getFlat();
+      if(!flat || (flat->size() != pdmap->size()))
+	pdmap->updateFlat();
+    }
   }
 
+  if(m_level_ixs.size() < (unsigned int)(m_ofnum))
+    m_level_ixs.resize(m_ofnum);
+  if(m_level_boxes.size() < (unsigned int)(m_ofnum))
+    m_level_boxes.resize(m_ofnum);
+
+  // Make room for every piece at each level now, so the search
+  // itself never needs to grow the vectors.
+  for(int k=1; (k < m_ofnum); k++) {
+    unsigned int pieces = m_ofs[k]->getPDMap()->size();
+    if(m_use_flat)
+      m_level_ixs[k].reserve(pieces);
+    else
+      m_level_boxes[k].reserve(pieces);
+  }
+
+  if(!m_maxbox && !m_spare_box)
+    m_spare_box = universe.copy();
+}
+
+//---------------------------------------------------------------
+// Procedure: solvePrior
+//   Purpose: Does the necessary things before starting the branch
+//            and bound process.
+
+void IvPProblem::solvePrior(const IvPBox *isolBox)
+{
+  // Reset timer (may have values from previous solve invocation)
+  // Start timer after (perhaps) outputting start message.
+  if(!m_silent) cout << "---> entering IvP Solve routine: " << endl;
+
+  prepareSolve();
+
+  // Node boxes may hold the last search of a previous solve
+  const IvPBox& universe = m_ofs[0]->getPDMap()->getUniverse();
+  for(int i=0; (i < m_ofnum+1); i++)
+    *nodeBox[i] = universe;
+  nodeBox[0]->setWT(0.0);
+  
+  if(isolBox)
+    processInitSol(isolBox);
 }
 
 //---------------------------------------------------------------
@@ -155,8 +216,12 @@ bool IvPProblem::solve(const IvPBox *isolBox)
   int boxCount = pdmap->size();
   for(int i=0; i<boxCount; i++) {
     nodeBox[1]->copy(pdmap->bx(i));
-    if(!m_maxbox || (upperCheapBound(1, nodeBox[1]) > (m_maxwt + m_epsilon)))
-      solveRecurse(1);
+    if(!m_maxbox || (upperCheapBound(1, nodeBox[1]) > (m_maxwt + m_epsilon))) {
+      if(m_use_flat)
+	solveRecurseFlat(1);
+      else
+	solveRecurse(1);
+    }
   }    
  
   solvePost();
@@ -187,18 +252,24 @@ void IvPProblem::solveRecurse(int level)
     return;
   }
   
-  IvPGrid *grid = m_ofs[level]->getPDMap()->getGrid();
-  BoxSet *levelBoxes;
-  if(grid)
-    levelBoxes = grid->getBS(nodeBox[level]);
-  else
-    levelBoxes = m_ofs[level]->getPDMap()->getBS(nodeBox[level]);
-  BoxSetNode *levBSN = levelBoxes->retBSN(FIRST);
+  // The boxes at this level are written to a vector kept for the
+  // level rather than to a new BoxSet, so nothing is allocated.
+  vector<IvPBox*>& levelBoxes = m_level_boxes[level];
 
-  while(levBSN != NULL) {
-    BoxSetNode *nextLevBSN = levBSN->getNext();
+  PDMap   *pdmap = m_ofs[level]->getPDMap();
+  IvPGrid *grid  = pdmap->getGrid();
+  if(grid)
+    grid->getBS(nodeBox[level], levelBoxes);
+  else {
+    levelBoxes.clear();
+    for(int i=0; i<pdmap->size(); i++)
+      if(nodeBox[level]->intersect(pdmap->getBox(i)))
+	levelBoxes.push_back(pdmap->bx(i));
+  }
 
-    IvPBox *cbox = levBSN->getBox();
+  unsigned int count = levelBoxes.size();
+  for(unsigned int i=0; i<count; i++) {
+    IvPBox *cbox = levelBoxes[i];
     result = nodeBox[level]->intersect(cbox, nodeBox[level+1]);
     
     if(result) {
@@ -206,26 +277,57 @@ void IvPProblem::solveRecurse(int level)
       if(!m_maxbox || (upperBound > (m_maxwt + m_epsilon)))
 	solveRecurse(level+1);
     }
-
-    levBSN = nextLevBSN;
   }
-  delete(levelBoxes);
 }
 
 
+//---------------------------------------------------------------
+// Procedure: solveRecurseFlat
+//      Note: Same search as solveRecurse() but the pieces at each
+//            level are found, and intersected with the node box,
+//            in the pdmap's flattened copy. No BoxSet is created 
+//            and no box is dereferenced in the inner loop.
+
+void IvPProblem::solveRecurseFlat(int level)
+{
+  // check for and handle the boundary condition
+  if(level == m_ofnum) {
+    m_leafs_visited++;
+    bool   ok = false;
+    double currWT = compactor->maxVal(nodeBox[level], &ok);
+    if(ok)
+      if((m_maxbox==NULL) || (currWT > m_maxwt))
+	newSolution(currWT, nodeBox[level]);
+    return;
+  }
+
+  PDMap *pdmap = m_ofs[level]->getPDMap();
+  const PDMapFlat *flat = pdmap->getFlat();
+  if(!flat || (flat->size() != pdmap->size())) {
+    solveRecurse(level);
+    return;
+  }
+
+  vector<int>& ixs = m_level_ixs[level];
+  flat->getBS(nodeBox[level], ixs);
+
+  unsigned int count = ixs.size();
+  for(unsigned int i=0; i<count; i++) {
+    if(flat->intersect(ixs[i], nodeBox[level], nodeBox[level+1])) {
+      double upperBound = upperCheapBound(level+1, nodeBox[level+1]);
+      if(!m_maxbox || (upperBound > (m_maxwt + m_epsilon)))
+	solveRecurseFlat(level+1);
+    }
+  }
+}
+
 //---------------------------------------------------------------
 // Procedure: solvePost
 
 void IvPProblem::solvePost()
 {
-  // Delete nodeBoxes here since solve may be invoked 
-  // again later, and the number of objective functions may be 
-  // different then.
-  for(int i=0; (i < m_ofnum+1); i++)
-    delete(nodeBox[i]);
-
-  delete [] nodeBox;  
-  nodeBox = 0;  
+  // The nodeBoxes are kept for the next solve, if any. They are
+  // made again then if the number of objective functions changes.
 }
 
 
@@ -26,6 +26,7 @@
 #ifndef IVPPROBLEM_HEADER
 #define IVPPROBLEM_HEADER
 
+#include <vector>
 #include "Problem.h"
 #include "Compactor.h"
 
@@ -35,22 +36,34 @@ public:
   ~IvPProblem();
 
   void   preCompact();
+  void   prepareSolve();
   bool   solve(const IvPBox *isolbox=0);
   double getLeafsVisited() const {return(m_leafs_visited);}
+  void   setUseFlat(bool v)      {m_use_flat=v;}
 
 protected:
   void   solvePrior(const IvPBox *b=0);
   void   solveRecurse(int);
+  void   solveRecurseFlat(int);
   void   solvePost();
   double upperTightBound(int, IvPBox*);
   double upperCheapBound(int, IvPBox*);
   
 protected:  
   IvPBox**   nodeBox;
+  int        m_node_boxes;
   Compactor* compactor;
   bool       ownCompactor;
 
   double     m_leafs_visited;
+
+  // Solve using the flattened pdmaps. The pieces found at each
+  // level are kept in a vector per level, reused across solves.
+  bool       m_use_flat;
+  std::vector<std::vector<int> > m_level_ixs;
+
+  // Likewise the boxes found at each level when not using them
+  std::vector<std::vector<IvPBox*> > m_level_boxes;
 };  
 
 #endif
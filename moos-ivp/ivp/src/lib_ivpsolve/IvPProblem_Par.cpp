@@ -0,0 +1,419 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: IvPProblem_Par.cpp                                   */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include "IvPProblem_Par.h"
+#include "IvPGrid.h"
+#include "PDMap.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Procedure: Constructor
+//      Note: The pool, if any, is not owned by the problem.
+
+IvPProblem_Par::IvPProblem_Par(WorkerPool *pool, Compactor *c) :
+  IvPProblem(c)
+{
+  m_pool            = pool;
+  m_jobs_per_thread = 8;
+  m_frontier_level  = 0;
+  m_shared_wt       = 0;
+  m_shared_set      = false;
+
+#ifndef _WIN32
+  pthread_mutex_init(&m_mutex, 0);
+#endif
+}
+
+//---------------------------------------------------------------
+// Procedure: Destructor
+
+IvPProblem_Par::~IvPProblem_Par() 
+{
+  clearJobs();
+
+  for(unsigned int i=0; i<m_searches.size(); i++) {
+    Search *search = m_searches[i];
+    for(unsigned int j=0; j<search->node_box.size(); j++)
+      delete(search->node_box[j]);
+    if(search->best_box)
+      delete(search->best_box);
+    delete(search);
+  }
+
+#ifndef _WIN32
+  pthread_mutex_destroy(&m_mutex);
+#endif
+}
+
+//---------------------------------------------------------------
+// Procedure: solve
+//      Note: The jobs find the boxes at each level through the
+//            grid of each pdmap, with a cursor of their own, and
+//            not through the flattened pdmaps which keep scratch
+//            space for one query at a time.
+
+bool IvPProblem_Par::solve(const IvPBox *isolBox)
+{
+  bool serial = (!m_pool || (m_pool->getThreads() <= 1));
+
+  // With a nonzero epsilon the serial decision depends on the
+  // order in which solutions are found, which is lost here.
+  if((m_epsilon != 0) || (m_thresh != 100))
+    serial = true;
+
+  if(serial || (m_ofnum == 0))
+    return(IvPProblem::solve(isolBox));
+
+  solvePrior(isolBox);
+
+  if(!m_silent) {
+    cout << "******* Entering IvPProblem_Par::solve()" << endl;
+    cout << "Ofs:" << m_ofnum << " Threads:" << m_pool->getThreads() << endl;
+  }
+
+  buildFrontier();
+
+  Result blank;
+  blank.found = false;
+  blank.wt    = 0;
+  blank.box   = 0;
+  blank.leafs = 0;
+  m_results.assign(m_frontier.size(), blank);
+
+  m_shared_wt  = 0;
+  m_shared_set = false;
+  m_pool->run(jobMain, this, m_frontier.size());
+
+  // Taken in search order, a job's solution replaces the one 
+  // before it only if strictly better, as in the serial search.
+  for(unsigned int i=0; i<m_results.size(); i++) {
+    m_leafs_visited += m_results[i].leafs;
+    if(m_results[i].found)
+      if(!m_maxbox || (m_results[i].wt > m_maxwt))
+	newSolution(m_results[i].wt, m_results[i].box);
+  }
+
+  clearJobs();
+  solvePost();
+
+  if(!m_silent)
+    cout << "******* DONE IvPProblem_Par::solve()" << endl;
+  
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: buildFrontier
+//   Purpose: Expand the top of the search tree a level at a time,
+//            in the order the serial search would, until there 
+//            are enough nodes to keep each thread busy.
+//      Note: Nodes are pruned only against the initial solution,
+//            if any, which the serial search would also have.
+
+void IvPProblem_Par::buildFrontier()
+{
+  clearJobs();
+
+  unsigned int target = m_pool->getThreads() * m_jobs_per_thread;
+
+  PDMap *pdmap = m_ofs[0]->getPDMap();
+  int boxCount = pdmap->size();
+  for(int i=0; i<boxCount; i++) {
+    nodeBox[1]->copy(pdmap->bx(i));
+    double bound = IvPProblem::upperCheapBound(1, nodeBox[1]);
+    if(!m_maxbox || (bound > (m_maxwt + m_epsilon)))
+      m_frontier.push_back(nodeBox[1]->copy());
+  }
+  m_frontier_level = 1;
+
+  vector<IvPBox*> boxes, next;
+  while((m_frontier.size() < target) && (m_frontier_level < m_ofnum)) {
+    int      level = m_frontier_level;
+    IvPGrid *grid  = m_ofs[level]->getPDMap()->getGrid();
+
+    next.clear();
+    for(unsigned int i=0; i<m_frontier.size(); i++) {
+      grid->getBS(m_frontier[i], boxes);
+      for(unsigned int j=0; j<boxes.size(); j++) {
+	if(m_frontier[i]->intersect(boxes[j], nodeBox[level+1])) {
+	  double bound = IvPProblem::upperCheapBound(level+1, nodeBox[level+1]);
+	  if(!m_maxbox || (bound > (m_maxwt + m_epsilon)))
+	    next.push_back(nodeBox[level+1]->copy());
+	}
+      }
+      delete(m_frontier[i]);
+    }
+    m_frontier = next;
+    m_frontier_level++;
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: jobMain
+
+void IvPProblem_Par::jobMain(unsigned int ix, void *param)
+{
+  static_cast<IvPProblem_Par*>(param)->solveJob(ix);
+}
+
+//---------------------------------------------------------------
+// Procedure: solveJob
+//   Purpose: Search the subtree under the given frontier node,
+//            starting from the initial solution, if any.
+
+void IvPProblem_Par::solveJob(unsigned int ix)
+{
+  Search *search = acquireSearch();
+
+  search->best_set = (m_maxbox != 0);
+  search->best_wt  = m_maxwt;
+  search->found    = false;
+  search->leafs    = 0;
+  search->nodes    = 0;
+
+  lock();
+  search->shared_set = m_shared_set;
+  search->shared_wt  = m_shared_wt;
+  unlock();
+
+  search->node_box[m_frontier_level]->copy(m_frontier[ix]);
+  solveRecursePar(m_frontier_level, *search);
+
+  Result& result = m_results[ix];
+  result.found = search->found;
+  result.wt    = search->best_wt;
+  result.leafs = search->leafs;
+  if(search->found)
+    result.box = search->best_box->copy();
+
+  releaseSearch(search);
+}
+
+//---------------------------------------------------------------
+// Procedure: solveRecursePar
+//      Note: Same search as IvPProblem::solveRecurse() but with
+//            the state of the search held apart for each thread.
+//            The compactor is assumed to keep no state of its own.
+
+void IvPProblem_Par::solveRecursePar(int level, Search& search)
+{
+  if(level == m_ofnum) {
+    search.leafs++;
+    bool   ok = false;
+    double currWT = compactor->maxVal(search.node_box[level], &ok);
+    if(ok)
+      if(!search.best_set || (currWT > search.best_wt))
+	newLocalSolution(currWT, search.node_box[level], search);
+    return;
+  }
+
+  vector<IvPBox*>& levelBoxes = search.level_boxes[level];
+  long *cursor = &(search.cursor[0]);
+
+  IvPGrid *grid = m_ofs[level]->getPDMap()->getGrid();
+  grid->getBS(search.node_box[level], levelBoxes, cursor, true);
+
+  IvPBox *node_box = search.node_box[level];
+  IvPBox *next_box = search.node_box[level+1];
+
+  unsigned int count = levelBoxes.size();
+  for(unsigned int i=0; i<count; i++) {
+    if(node_box->intersect(levelBoxes[i], next_box)) {
+      double upperBound = upperCheapBound(level+1, next_box, cursor);
+      if(!prune(upperBound, search))
+	solveRecursePar(level+1, search);
+    }
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: prune
+//   Purpose: Determine if a node with the given upper bound may
+//            be passed over.
+//      Note: Against the search's own solution the rule is that
+//            of the serial search. The best solution of all jobs
+//            may come later in the search order, so a node is 
+//            passed over on it only if clearly worse. A solution
+//            of equal value earlier in the order is never lost.
+
+bool IvPProblem_Par::prune(double bound, Search& search)
+{
+  if(search.best_set && !(bound > (search.best_wt + m_epsilon)))
+    return(true);
+
+  // The shared bound is refreshed now and then, rather than 
+  // taking the lock at every node.
+  if((search.nodes++ % 32) == 0) {
+    lock();
+    search.shared_set = m_shared_set;
+    search.shared_wt  = m_shared_wt;
+    unlock();
+  }
+
+  if(search.shared_set) {
+    double margin = 0.000001 * (1 + fabs(search.shared_wt));
+    if(bound < (search.shared_wt - margin))
+      return(true);
+  }
+  return(false);
+}
+
+//---------------------------------------------------------------
+// Procedure: newLocalSolution
+
+void IvPProblem_Par::newLocalSolution(double wt, const IvPBox *box,
+				      Search& search)
+{
+  if(!search.best_box)
+    search.best_box = box->copy();
+  else
+    search.best_box->copy(box);
+  search.best_wt  = wt;
+  search.best_set = true;
+  search.found    = true;
+
+  lock();
+  if(!m_shared_set || (wt > m_shared_wt)) {
+    m_shared_wt  = wt;
+    m_shared_set = true;
+  }
+  search.shared_set = m_shared_set;
+  search.shared_wt  = m_shared_wt;
+  unlock();
+}
+
+//---------------------------------------------------------------
+// Procedure: upperCheapBound
+//      Note: Same as IvPProblem::upperCheapBound() but with the
+//            grid cursor given by the caller.
+
+double IvPProblem_Par::upperCheapBound(int level, const IvPBox *box, 
+				       long *cursor) const
+{
+  double bound = box->maxVal();
+
+  for(int i=level; (i < m_ofnum); i++)
+    bound += m_ofs[i]->getPDMap()->getGrid()->getCheapBound(box, cursor);
+
+  return(bound);
+}
+
+//---------------------------------------------------------------
+// Procedure: acquireSearch
+//   Purpose: Hand out an idle search, or a new one, fitted to the
+//            problem being solved.
+
+IvPProblem_Par::Search *IvPProblem_Par::acquireSearch()
+{
+  Search *search = 0;
+
+  lock();
+  if(!m_idle_searches.empty()) {
+    search = m_idle_searches.back();
+    m_idle_searches.pop_back();
+  }
+  unlock();
+
+  if(!search) {
+    search = new Search;
+    search->best_box = 0;
+    lock();
+    m_searches.push_back(search);
+    unlock();
+  }
+
+  const IvPBox *model = nodeBox[0];
+  unsigned int  boxes = (unsigned int)(m_ofnum+1);
+
+  bool fits = (search->node_box.size() == boxes);
+  if(fits)
+    fits = ((search->node_box[0]->getDim() == model->getDim()) &&
+	    (search->node_box[0]->getDegree() == model->getDegree()));
+  if(!fits) {
+    for(unsigned int j=0; j<search->node_box.size(); j++)
+      delete(search->node_box[j]);
+    search->node_box.clear();
+    for(unsigned int j=0; j<boxes; j++)
+      search->node_box.push_back(model->copy());
+    if(search->best_box) {
+      delete(search->best_box);
+      search->best_box = 0;
+    }
+  }
+
+  if(search->level_boxes.size() < boxes)
+    search->level_boxes.resize(boxes);
+  search->cursor.resize(3 * model->getDim());
+
+  return(search);
+}
+
+//---------------------------------------------------------------
+// Procedure: releaseSearch
+
+void IvPProblem_Par::releaseSearch(Search *search)
+{
+  lock();
+  m_idle_searches.push_back(search);
+  unlock();
+}
+
+//---------------------------------------------------------------
+// Procedure: clearJobs
+
+void IvPProblem_Par::clearJobs()
+{
+  for(unsigned int i=0; i<m_frontier.size(); i++)
+    delete(m_frontier[i]);
+  m_frontier.clear();
+
+  for(unsigned int i=0; i<m_results.size(); i++)
+    if(m_results[i].box)
+      delete(m_results[i].box);
+  m_results.clear();
+}
+
+//---------------------------------------------------------------
+// Procedure: lock
+
+void IvPProblem_Par::lock()
+{
+#ifndef _WIN32
+  pthread_mutex_lock(&m_mutex);
+#endif
+}
+
+//---------------------------------------------------------------
+// Procedure: unlock
+
+void IvPProblem_Par::unlock()
+{
+#ifndef _WIN32
+  pthread_mutex_unlock(&m_mutex);
+#endif
+}
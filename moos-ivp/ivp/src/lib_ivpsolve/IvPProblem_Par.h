@@ -0,0 +1,133 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: IvPProblem_Par.h                                     */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+/****************************************************************/
+/* A branch and bound solver spreading the search over threads. */
+/* The top of the search tree is expanded, in the order of the  */
+/* serial search, until there are several nodes for each thread.*/
+/* The subtree under each node is a job for a WorkerPool. Each  */
+/* job prunes with the best solution it has found itself, as    */
+/* the serial search would, and with the best found by any job, */
+/* but only where that bound is strictly better. The results of */
+/* the jobs are then taken in order, keeping the first of equal */
+/* value, so the decision is the one the serial search reaches. */
+/*                                                              */
+/* The pool is owned by the caller so threads are not created   */
+/* for each problem. Without a pool of more than one thread, or */
+/* with a nonzero epsilon or threshold below 100, the problem   */
+/* is solved by IvPProblem::solve() in the usual way.           */
+/****************************************************************/
+ 
+#ifndef IVPPROBLEM_PAR_HEADER
+#define IVPPROBLEM_PAR_HEADER
+
+#include <vector>
+#include "IvPProblem.h"
+#include "WorkerPool.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+class IvPProblem_Par: public IvPProblem {
+public:
+  IvPProblem_Par(WorkerPool *pool=0, Compactor *c=0);
+  ~IvPProblem_Par();
+
+  bool solve(const IvPBox *isolbox=0);
+
+  void setWorkerPool(WorkerPool *pool) {m_pool=pool;}
+
+  // Nodes to expand for each thread before handing out jobs
+  void setJobsPerThread(unsigned int v) {if(v>0) m_jobs_per_thread=v;}
+
+protected:
+  // The state of the search made by one thread
+  struct Search {
+    std::vector<IvPBox*>               node_box;
+    std::vector<std::vector<IvPBox*> > level_boxes;
+    std::vector<long>                  cursor;
+    double   best_wt;
+    bool     best_set;
+    IvPBox*  best_box;
+    bool     found;
+    double   leafs;
+    double   shared_wt;
+    bool     shared_set;
+    unsigned int nodes;
+  };
+
+  // The outcome of one job
+  struct Result {
+    bool    found;
+    double  wt;
+    IvPBox* box;
+    double  leafs;
+  };
+
+  void    buildFrontier();
+  void    solveJob(unsigned int);
+  void    solveRecursePar(int, Search&);
+  bool    prune(double, Search&);
+  void    newLocalSolution(double, const IvPBox*, Search&);
+  double  upperCheapBound(int, const IvPBox*, long*) const;
+
+  Search* acquireSearch();
+  void    releaseSearch(Search*);
+  void    clearJobs();
+
+  void    lock();
+  void    unlock();
+
+  static void jobMain(unsigned int, void*);
+
+protected:
+  WorkerPool*  m_pool;
+  unsigned int m_jobs_per_thread;
+
+  // Nodes at the top of the tree, in serial search order, each
+  // the root of one job. All are at the same level.
+  std::vector<IvPBox*> m_frontier;
+  int                  m_frontier_level;
+  std::vector<Result>  m_results;
+
+  // Searches are kept across solves, handed to jobs as needed
+  std::vector<Search*> m_searches;
+  std::vector<Search*> m_idle_searches;
+
+  // Best value found by any job so far
+  double       m_shared_wt;
+  bool         m_shared_set;
+
+#ifndef _WIN32
+  pthread_mutex_t m_mutex;
+#endif
+
+private:
+  IvPProblem_Par(const IvPProblem_Par&);
+  const IvPProblem_Par &operator=(const IvPProblem_Par&);
+};  
+
+#endif
@@ -55,6 +55,9 @@ bool PopulatorIPP::populate(string filename, int alg)
   if(m_ivp_problem)
     delete(m_ivp_problem);
 
+  m_solve_time = -1;
+  m_decision.clear();
+
   if(alg == 0)
     m_ivp_problem = new IvPProblem;
   else if((alg == 1) || (alg == 2)) {
@@ -112,7 +115,9 @@ bool PopulatorIPP::handleLine(string line)
       return(true);
     }
   }
-  if(left == "ipf") {
+  // A function already normalized and weighted, e.g., as given 
+  // to the solver in a problem captured by the helm.
+  if((left == "ipf") || (left == "ipf_weighted")) {
     if(m_verbose)
       cout << "." << flush;
 
@@ -120,16 +125,39 @@ bool PopulatorIPP::handleLine(string line)
     if(ipf) {
       if(m_grid_override_size != 0)
 	overrideGrid(ipf);
+      if(left == "ipf_weighted")
+	ipf->setWeighted(true);
       m_ivp_problem->addOF(ipf);
       return(true);
     }
   }
   if(left == "ipfs")
     return(true);
+  if(left == "solve_time")
+    return(setNonNegDoubleOnString(m_solve_time, right));
+  if(left == "decision")
+    return(handleDecision(right));
 
   return(false);
 }
 
+//-------------------------------------------------------------
+// Procedure: handleDecision
+//   Example: decision = course=135,speed=1.5
+
+bool PopulatorIPP::handleDecision(string str)
+{
+  vector<string> svector = parseString(str, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string var = biteStringX(svector[i], '=');
+    string val = svector[i];
+    if((var == "") || !isNumber(val))
+      return(false);
+    m_decision[var] = atof(val.c_str());
+  }
+  return(true);
+}
+
 
 //-------------------------------------------------------------
 // Procedure: overrideGrid()
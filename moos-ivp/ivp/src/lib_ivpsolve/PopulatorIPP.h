@@ -26,13 +26,15 @@
 #ifndef POPULATOR_IPP_HEADER
 #define POPULATOR_IPP_HEADER
 
+#include <map>
 #include <string>
 #include "IvPProblem.h"
  
 class PopulatorIPP
 {
 public:
-  PopulatorIPP() {m_ivp_problem=0; m_grid_override_size=0;}
+  PopulatorIPP() {m_ivp_problem=0; m_grid_override_size=0; 
+    m_verbose=false; m_solve_time=-1;}
   ~PopulatorIPP() {}
   
   bool populate(std::string filename, int alg=0);
@@ -40,10 +42,16 @@ public:
   void setVerbose(bool v)          {m_verbose=v;}
   IvPProblem* getIvPProblem()      {return(m_ivp_problem);}
 
+  // Noted in problems captured by the helm, if given
+  double getSolveTime() const      {return(m_solve_time);}
+  const std::map<std::string, double>& getDecision() const
+    {return(m_decision);}
+
   void setGridOverrideSize(int v)  {m_grid_override_size=v;}
   
 protected:
   bool handleLine(std::string);
+  bool handleDecision(std::string);
   void overrideGrid(IvPFunction*);
 
   
@@ -53,6 +61,9 @@ protected:
 
   int         m_grid_override_size;
 
+  double      m_solve_time;
+  std::map<std::string, double> m_decision;
+
 };
 #endif
 
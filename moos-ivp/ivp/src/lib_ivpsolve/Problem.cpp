@@ -26,6 +26,7 @@
 #include <iostream>
 #include <cstring> 
 #include <cassert>
+#include <cmath>
 #include "Problem.h"
 #include "IvPBox.h"
 #include "IvPFunction.h"
@@ -39,12 +40,14 @@ using namespace std;
 Problem::Problem()
 {
   m_maxbox    = 0;
+  m_spare_box = 0;
   m_ofnum     = 0;
   m_ofs       = 0;
   m_silent    = true;
   m_owner_ofs = true;
 
   m_epsilon   = 0.0;
+  m_warm_start = false;
   m_thresh    = 100.0;  // By default find global max
 }
 
@@ -55,6 +58,8 @@ Problem::~Problem()
 {
   if(m_maxbox)
     delete(m_maxbox);
+  if(m_spare_box)
+    delete(m_spare_box);
   if(m_ofs && m_owner_ofs) {
     for(int i=0; (i < m_ofnum); i++)
       delete(m_ofs[i]);
@@ -126,13 +131,18 @@ void Problem::addOF(IvPFunction *gof)
   // positive priority weight.
   if(gof->getPWT() <= 0) return;
 
-  double range = gof->getPDMap()->getMaxWT() - gof->getPDMap()->getMinWT();
-  if(range > 100)
-    gof->getPDMap()->normalize(0,100);
-
-  // Apply the priority weight to the OF
-  gof->getPDMap()->applyWeight(gof->getPWT());
-
+  // A function carried over from an earlier problem, e.g., one a 
+  // behavior asked the helm to reuse, has been normalized and had
+  // its priority weight applied already. Its grid is kept as is.
+  if(!gof->isWeighted()) {
+    double range = gof->getPDMap()->getMaxWT() - gof->getPDMap()->getMinWT();
+    if(range > 100)
+      gof->getPDMap()->normalize(0,100);
+
+    // Apply the priority weight to the OF
+    gof->getPDMap()->applyWeight(gof->getPWT());
+    gof->setWeighted(true);
+  }
 
   IvPFunction** newOFs = new IvPFunction*[m_ofnum+1];
   for(int i=0; (i < m_ofnum); i++)
@@ -343,6 +353,15 @@ void  Problem::processInitSol(const IvPBox *isolBox)
   
   if(!m_silent) 
     cout << "initial solution weight: " << weight << endl;
+
+  // As a warm start the solution serves only as a bound. It is 
+  // lowered a touch so a solution of equal weight found in the
+  // search still replaces it, and the search ends where it would
+  // have without it. The margin also covers rounding differences
+  // between this sum and the one made at the leaves.
+  if(m_warm_start)
+    weight -= 0.000001 * (1 + fabs(weight));
+
   if(covered)
     if(m_maxbox==0 || (weight > m_maxwt))
       newSolution(weight, isolBox);
@@ -356,7 +375,14 @@ void Problem::newSolution(double newMaxWT, const IvPBox *newMaxBox)
 {
   assert(newMaxBox);
 
-  if(!m_maxbox) 
+  // The first solution goes in the spare box, if one was made 
+  // before the solve, so finding it allocates nothing.
+  if(!m_maxbox && m_spare_box) {
+    m_maxbox = m_spare_box;
+    m_spare_box = 0;
+    *m_maxbox = *newMaxBox;
+  }
+  else if(!m_maxbox) 
     m_maxbox = newMaxBox->copy();
   else
     m_maxbox->copy(newMaxBox);
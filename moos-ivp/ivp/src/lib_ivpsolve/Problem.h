@@ -51,6 +51,7 @@ public:    // Virtual Function
   void   initialSolution2();
   void   sortOFs(bool high_to_low=true);
   void   processInitSol(const IvPBox*);
+  void   setWarmStart(bool v)    {m_warm_start=v;}
   void   setEpsilon(double v)    {if(v>=0) m_epsilon=v;}
   void   setThresh(double);
 
@@ -74,6 +75,7 @@ protected:
 
 protected:
   IvPBox*       m_maxbox;   // Box of best working solution
+  IvPBox*       m_spare_box; // Room for m_maxbox made before a solve
   double        m_maxwt;    // Value of best working solution
 
   bool          m_owner_ofs;
@@ -83,6 +85,7 @@ protected:
 
   double        m_epsilon;  // thresh for branching, delta above curr max
   double        m_thresh;   // thresh for branching, pct of global max
+  bool          m_warm_start; // initial solution only a bound
 
   IvPDomain     m_domain;
 };
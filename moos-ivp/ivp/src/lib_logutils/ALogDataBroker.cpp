@@ -27,6 +27,8 @@
 #include "ALogDataBroker.h"
 #include "MBUtils.h"
 #include "LogUtils.h"
+#include "BufferedLineReader.h"
+#include "KLogStore.h"
 #include "FileBuffer.h"
 #include "Populator_VPlugPlots.h"
 #include "Populator_HelmPlots.h"
@@ -45,6 +47,7 @@ ALogDataBroker::ALogDataBroker()
 {
   // Init config vars
   m_verbose  = false;
+  m_use_stores = true;
   m_max_fileptrs = 100;
   m_vqual = "med";
   
@@ -112,6 +115,7 @@ ALogDataBroker& ALogDataBroker::operator=(const ALogDataBroker& other)
 
   m_verbose      = other.m_verbose;
   m_progress     = other.m_progress;
+  m_use_stores   = other.m_use_stores;
   m_max_fileptrs = other.m_max_fileptrs;
   m_vqual        = other.m_vqual;
 
@@ -700,17 +704,13 @@ string ALogDataBroker::getRegionInfo()
 
     // Check if the klog file can be found and opened
     string klog = m_base_dirs[aix] + "/REGION_INFO.klog";
-    FILE *f = fopen(klog.c_str(), "r");
-    if(f) {
-      while(m_region_info == "") {
-
-	string line_raw = getNextRawLine(f);
+    BufferedLineReader reader;
+    if(reader.open(klog)) {
+      string line_raw;
+      while((m_region_info == "") && reader.nextLine(line_raw)) {
 	// Check if the line is a comment
 	if((line_raw.length() > 0) && (line_raw.at(0) == '%'))
 	  continue;
-	// Check for end of file
-	if(line_raw == "eof") 
-	  break;
 	
 	// Otherwise handle a normal line
 	string varname = getVarName(line_raw);
@@ -718,7 +718,7 @@ string ALogDataBroker::getRegionInfo()
 	if(varname == "REGION_INFO")
 	  m_region_info = varval;
       }
-      fclose(f);
+      reader.close();
 
       if(m_region_info != "")
 	return(m_region_info);
@@ -728,6 +728,43 @@ string ALogDataBroker::getRegionInfo()
   return("");
 }
 
+//----------------------------------------------------------------
+// Procedure: openKLogStore()
+//   Purpose: Open the column store of a klog, building it the first
+//            time it is needed.
+//   Returns: false if stores are not in use or the store could not
+//            be built, e.g., in a read-only split directory. The
+//            klog should then be read directly.
+
+bool ALogDataBroker::openKLogStore(const string& klog, 
+				   KLogStore& store) const
+{
+  if(!m_use_stores)
+    return(false);
+
+  bool ok = store.open(klog);
+  if(!ok && m_verbose)
+    cout << "No column store for " << klog << endl;
+  return(ok);
+}
+
+//----------------------------------------------------------------
+// Procedure: openKLogReader()
+//   Purpose: Open a reader on a klog of entries. If the klog has a
+//            column store, the lines of blocks wholly before the
+//            pruned min time are passed over.
+
+bool ALogDataBroker::openKLogReader(const string& klog, double skew,
+				    BufferedLineReader& reader) const
+{
+  KLogStore store;
+  if(!openKLogStore(klog, store))
+    return(reader.open(klog));
+
+  unsigned long long begin = store.firstOffset(m_pruned_logtmin, skew);
+  return(reader.openRange(klog, begin, store.klogSize()));
+}
+
 //----------------------------------------------------------------
 // Procedure: getLogPlot()
 
@@ -749,11 +786,31 @@ LogPlot ALogDataBroker::getLogPlot(unsigned int mix)
   string vname = m_mix_vname[mix];
 
   unsigned int aix = m_mix_alog_ix[mix];
+  double skew = m_logskew[aix];
   
-  // Part 2: Confirm that the klog file can be found and opened
+  // Part 2: Populate from the column store of the klog if possible,
+  // reading only the blocks from the pruned min time onwards.
   string klog = m_base_dirs[aix] + "/" + varname + ".klog";
-  FILE *f = fopen(klog.c_str(), "r");
-  if(!f) {
+  KLogStore store;
+  if(openKLogStore(klog, store)) {
+    logplot.setVarName(varname);
+    unsigned long long row  = store.firstRow(m_pruned_logtmin, skew);
+    unsigned long long rows = store.size();
+    for(; row<rows; row++) {
+      double d_tstamp = store.getTime(row);
+      if((d_tstamp + skew) < m_pruned_logtmin)
+	continue;
+      if((d_tstamp + skew) > m_pruned_logtmax)
+	break;
+      logplot.setValue(d_tstamp, store.getValue(row));
+    }
+    logplot.applySkew(skew);
+    return(logplot);
+  }
+
+  // Part 3: Otherwise confirm the klog file can be found and opened
+  BufferedLineReader reader;
+  if(!reader.open(klog)) {
     if(m_verbose)
       cout << "Could not create LogPlot from " << klog << endl;
     return(logplot);
@@ -762,19 +819,14 @@ LogPlot ALogDataBroker::getLogPlot(unsigned int mix)
   if(m_verbose)
     cout << "ALogDataBroker::getLogPlot() varname: " << varname << endl;
 
-  // Part 3: Populate the LogPlot
+  // Part 4: Populate the LogPlot
   logplot.setVarName(varname);
 			
-  bool done = false;
-  while(!done) {
-    
-    string line_raw = getNextRawLine(f);
+  string line_raw;
+  while(reader.nextLine(line_raw)) {
     // Check if the line is a comment
     if((line_raw.length() > 0) && (line_raw.at(0) == '%'))
       continue;
-    // Check for end of file
-    if(line_raw == "eof") 
-      break;
 
     // Otherwise handle a normal line
     string tstamp = getTimeStamp(line_raw);
@@ -791,9 +843,6 @@ LogPlot ALogDataBroker::getLogPlot(unsigned int mix)
     logplot.setValue(d_tstamp, d_varval);
   }
 
-  if(f)
-    fclose(f);
-
   logplot.applySkew(m_logskew[aix]);
 
   if(m_verbose)
@@ -824,17 +873,56 @@ VarPlot ALogDataBroker::getVarPlot(unsigned int mix, bool include_source)
     is_double = false;
 
   unsigned int aix = m_mix_alog_ix[mix];
-      
-  // Part 2: Confirm that the klog file can be found and opened
+  double skew = m_logskew[aix];
+
+  // Part 2: Populate from the column store of the klog if possible.
+  // The sources are checked for uniformity over the same rows the
+  // klog reading below would check, up to the first row past the
+  // pruned max time.
   string klog = m_base_dirs[aix] + "/" + varname + ".klog";
-  FILE *f = fopen(klog.c_str(), "r");
-  if(!f) {
+  KLogStore store;
+  if(openKLogStore(klog, store)) {
+    varplot.setVName(vname);
+    varplot.setVarName(varname);
+    unsigned long long row  = store.firstRow(m_pruned_logtmin, skew);
+    unsigned long long rows = store.size();
+    for(; row<rows; row++) {
+      double d_tstamp = store.getTime(row);
+      if((d_tstamp + skew) < m_pruned_logtmin)
+	continue;
+      if((d_tstamp + skew) > m_pruned_logtmax)
+	break;
+
+      string varval = store.getString(row);
+      if(is_double)
+	varval = dstringCompact(varval);
+      string varsrc;
+      if(include_source)
+	varsrc = store.getSource(row);
+      varplot.setValue(d_tstamp, varval, varsrc);
+    }
+    varplot.applySkew(skew);
+
+    bool   uform_source = true;
+    string all_source;
+    if(include_source && (rows > 0)) {
+      all_source = store.getSource(0);
+      uform_source = store.uniformSource((row < rows) ? row+1 : rows);
+    }
+    if(uform_source)
+      varplot.setSource(all_source);
+    return(varplot);
+  }
+
+  // Part 3: Otherwise confirm the klog file can be found and opened
+  BufferedLineReader reader;
+  if(!reader.open(klog)) {
     if(m_verbose)
       cout << "Could not create VarPlot from " << klog << endl;
     return(varplot);
   }
 
-  // Part 3: Populate the VarPlot
+  // Part 4: Populate the VarPlot
   varplot.setVName(vname);
   varplot.setVarName(varname);
 
@@ -845,15 +933,11 @@ VarPlot ALogDataBroker::getVarPlot(unsigned int mix, bool include_source)
   bool first_source = true;
   string all_source = "";
   
-  bool done = false;
-  while(!done) {
-    string line_raw = getNextRawLine(f);
+  string line_raw;
+  while(reader.nextLine(line_raw)) {
     // Check if the line is a comment
     if((line_raw.length() > 0) && (line_raw.at(0) == '%'))
       continue;
-    // Check for end of file
-    if(line_raw == "eof") 
-      break;
     
     // Otherwise handle a normal line
     string tstamp = stripBlankEnds(getTimeStamp(line_raw));
@@ -891,8 +975,6 @@ VarPlot ALogDataBroker::getVarPlot(unsigned int mix, bool include_source)
   if(!include_source || uform_source)
     varplot.setSource(all_source);
 
-  if(f)
-    fclose(f);
   return(varplot);
 }
 
@@ -914,8 +996,8 @@ HelmPlot ALogDataBroker::getHelmPlot(unsigned int aix)
 
   // Part 2: Confirm that the IVPHELM_SUMMARY.klog file can be found and opened
   string klog = m_base_dirs[aix] + "/IVPHELM_SUMMARY.klog";
-  FILE *f = fopen(klog.c_str(), "r");
-  if(!f) {
+  BufferedLineReader reader;
+  if(!openKLogReader(klog, m_logskew[aix], reader)) {
     if(m_verbose)
       cout << "Could not create HelmPlot from " << klog << endl;
     return(hplot);
@@ -925,16 +1007,11 @@ HelmPlot ALogDataBroker::getHelmPlot(unsigned int aix)
   Populator_HelmPlots populator;
 
   vector<ALogEntry> entries;
-  bool done = false;
-  while(!done) {
-    ALogEntry entry = getNextRawALogEntry(f, true);
-
+  ALogEntry entry;
+  while(reader.nextEntry(entry, true)) {
     // Check if the line is a comment
     if(entry.getStatus() == "invalid")
       continue;
-    // Check for end of file
-    if(entry.getStatus() == "eof") 
-      break;
 
     double tstamp = entry.getTimeStamp();
     if((tstamp + m_logskew[aix]) < m_pruned_logtmin)
@@ -972,8 +1049,8 @@ AppLogPlot ALogDataBroker::getAppLogPlot(unsigned int alix)
   // Part 2: Confirm that the APP_LOG_app.klog file can be found and opened
   string app_name = m_alix_appname[alix];
   string klog = m_base_dirs[aix] + "/APP_LOG_" + app_name + ".klog";
-  FILE *f = fopen(klog.c_str(), "r");
-  if(!f) {
+  BufferedLineReader reader;
+  if(!openKLogReader(klog, m_logskew[aix], reader)) {
     if(m_verbose)
       cout << "Could not create AppLogPlot from " << klog << endl;
     return(alplot);
@@ -983,16 +1060,11 @@ AppLogPlot ALogDataBroker::getAppLogPlot(unsigned int alix)
   Populator_AppLogPlot populator;
 
   vector<ALogEntry> entries;
-  bool done = false;
-  while(!done) {
-    ALogEntry entry = getNextRawALogEntry(f, true);
-
+  ALogEntry entry;
+  while(reader.nextEntry(entry, true)) {
     // Check if the line is a comment
     if(entry.getStatus() == "invalid")
       continue;
-    // Check for end of file
-    if(entry.getStatus() == "eof") 
-      break;
 
     double tstamp = entry.getTimeStamp();
     if((tstamp + m_logskew[aix]) < m_pruned_logtmin)
@@ -1032,46 +1104,36 @@ EncounterPlot ALogDataBroker::getEncounterPlot(unsigned int aix)
   // Part 2: Get at least one COLLISION_DETECT_PARAMS entry
   // Confirm COLLISION_DETECT_PARAMS.klog file can be found and opened
   string klog1 = m_base_dirs[aix] + "/COLLISION_DETECT_PARAMS.klog";
-  FILE *f1 = fopen(klog1.c_str(), "r");
-  if(!f1) {
+  BufferedLineReader reader;
+  ALogEntry entry;
+  if(!reader.open(klog1)) {
     if(m_verbose) {
       cout << "WARNING: No COLLISION_DETECT_PARAMS info. Using defaults." << endl;
     }
   }
   else {
-    while(1) {
-      ALogEntry entry = getNextRawALogEntry(f1, true);      
+    while(reader.nextEntry(entry, true)) {
       // Check if the line is a comment
       if(entry.getStatus() == "invalid")
 	continue;
-      if(entry.getStatus() == "eof") 
-	break;      
       entries.push_back(entry);
     }
-    fclose(f1);
   }
 
 
   // Part 3: Get the ENCOUNTER_SUMMARY entries.
   // Confirm that the EVAL_LOITER_SUMMARY.klog file can be found and opened
   string klog2 = m_base_dirs[aix] + "/ENCOUNTER_SUMMARY.klog";
-  FILE *f2 = fopen(klog2.c_str(), "r");
-  if(!f2) {
+  if(!reader.open(klog2)) {
     if(m_verbose)
       cout << "Could not create EncounterPlot from " << klog2 << endl;
     return(eplot);
   }
   
-  bool done = false;
-  while(!done) {
-    ALogEntry entry = getNextRawALogEntry(f2, true);
-
+  while(reader.nextEntry(entry, true)) {
     // Check if the line is a comment
     if(entry.getStatus() == "invalid")
       continue;
-    // Check for end of file
-    if(entry.getStatus() == "eof") 
-      break;
 
     double tstamp = entry.getTimeStamp();
     if(tstamp < m_pruned_logtmin)
@@ -1081,7 +1143,7 @@ EncounterPlot ALogDataBroker::getEncounterPlot(unsigned int aix)
 
     entries.push_back(entry);
   }
-  fclose(f2);
+  reader.close();
 
 
   // Part 3: Populate the Encounter Plot
@@ -1114,8 +1176,8 @@ VPlugPlot ALogDataBroker::getVPlugPlot(unsigned int aix)
   string klog = m_base_dirs[aix] + "/VISUALS.klog";
   if(m_verbose)
     cout << "klog: " << klog << endl;
-  FILE *f = fopen(klog.c_str(), "r");
-  if(!f) {
+  BufferedLineReader reader;
+  if(!reader.open(klog)) {
     if(m_verbose)
       cout << "Could not create VPlugPlot from " << klog << endl;
     return(vplot);
@@ -1128,11 +1190,9 @@ VPlugPlot ALogDataBroker::getVPlugPlot(unsigned int aix)
   char carriage_return = 13;
   vector<ALogEntry> entries;
   int  count=0;
-  bool done = false;
-  while(!done) {
+  ALogEntry entry;
+  while(reader.nextEntry(entry, true)) {
     count++;
-    ALogEntry entry = getNextRawALogEntry(f, true);
-
     if((count % 1000) ==0) {
       cout << "     Reading alog visual entries: " << uintToCommaString(count);
       cout << carriage_return << flush;
@@ -1141,9 +1201,6 @@ VPlugPlot ALogDataBroker::getVPlugPlot(unsigned int aix)
     // Check if the line is a comment
     if(entry.getStatus() == "invalid")
       continue;
-    // Check for end of file
-    if(entry.getStatus() == "eof") 
-      break;
 
     //populator.populateFromEntry(entry);
     entries.push_back(entry);   // former
@@ -1224,26 +1281,23 @@ IPF_Plot ALogDataBroker::getIPFPlot(unsigned int aix, string bhv_name)
 
   // Part 3: Apply the IVPHELM_DOMAIN to the populator
   string domain_klog = m_base_dirs[aix] + "/IVPHELM_DOMAIN.klog";
-  FILE *f1 = fopen(domain_klog.c_str(), "r");
-  if(!f1) {
+  BufferedLineReader reader;
+  if(!reader.open(domain_klog)) {
     if(m_verbose)
       cout << "Could not find IVPHELM_DOMAIN from " << domain_klog << endl;
     return(ipf_plot);
   }
-  ALogEntry domain_entry = getNextRawALogEntry(f1);
-  string status = domain_entry.getStatus();
-  if(status != "eof") {
+  ALogEntry domain_entry;
+  if(reader.nextEntry(domain_entry)) {
     string domain_str = domain_entry.getStringVal();
     populator.setIvPDomain(domain_str);
   }
-  fclose(f1);
 
 
   // Part 4: Apply the BHV_IPF entries for this behavior to the populator
   // Part 4A: Confirm that the klog file can be found and opened
   string klog = m_base_dirs[aix] + "/BHV_IPF_" + bhv_name + ".klog";
-  FILE *f = fopen(klog.c_str(), "r");
-  if(!f) {
+  if(!reader.open(klog)) {
     if(m_verbose)
       cout << "Could not create IPFPlot from " << klog << endl;
     return(ipf_plot);
@@ -1251,15 +1305,9 @@ IPF_Plot ALogDataBroker::getIPFPlot(unsigned int aix, string bhv_name)
 
   // Part 4B: Apply the BHV_IPF entries
   vector<ALogEntry> entries;
-  bool done = false;
-  while(!done) {
-    ALogEntry entry = getNextRawALogEntry(f);
-
-    string entry_status = entry.getStatus();
-    if(entry_status == "eof")
-      done = true;
-    else
-      entries.push_back(entry);
+  ALogEntry entry;
+  while(reader.nextEntry(entry)) {
+    entries.push_back(entry);
 
     double tstamp = entry.getTimeStamp();
     if(tstamp < m_pruned_logtmin)
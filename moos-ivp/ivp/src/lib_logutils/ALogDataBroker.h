@@ -37,6 +37,9 @@
 #include "IPF_Plot.h"
 #include "TaskDiary.h"
 
+class BufferedLineReader;
+class KLogStore;
+
 class ALogDataBroker
 {
  public:
@@ -61,6 +64,7 @@ class ALogDataBroker
   void setMaxFilePtrs(unsigned int v) {m_max_fileptrs=v;}
   void setVQual(std::string s) {m_vqual=s;}
   void addDetachedPair(std::string s) {m_detached_pairs.push_back(s);}
+  void setUseStores(bool v=true) {m_use_stores=v;}
   
   LogPlot      getLogPlot(unsigned int mix);
   VarPlot      getVarPlot(unsigned int mix, bool src=false);
@@ -116,6 +120,10 @@ class ALogDataBroker
  protected:
   std::vector<std::string> getRawVarSummary(unsigned int) const;
 
+  bool openKLogStore(const std::string& klog, KLogStore&) const;
+  bool openKLogReader(const std::string& klog, double skew,
+		      BufferedLineReader&) const;
+
  protected:
 
   // Parallel indices - one per alog file [AIX] Populated In
@@ -165,6 +173,7 @@ class ALogDataBroker
   
   bool m_verbose;
   bool m_progress;
+  bool m_use_stores;
   unsigned int m_max_fileptrs;
   std::string m_vqual;
 };
@@ -45,6 +45,7 @@ ScanReport ALogScanner::scan()
   if(m_verbose)
     cout << endl;
   
+  ALogEntry entry;
   while(!done) {
 
     if(m_verbose) {
@@ -55,7 +56,7 @@ ScanReport ALogScanner::scan()
       }
     }
     
-    ALogEntry entry = getNextRawALogEntry(m_file, true);
+    m_reader.nextEntry(entry, true);
     string status = entry.getStatus();
     // Check for the end of the file
     if(status == "eof")
@@ -101,9 +102,10 @@ ScanReport ALogScanner::scan()
 ScanReport ALogScanner::scanRateOnly()
 {
   ScanReport report;
+  ALogEntry entry;
   bool done = false;
   while(!done) {
-    ALogEntry entry = getNextRawALogEntry(m_file, true);
+    m_reader.nextEntry(entry, true);
     string status = entry.getStatus();
     if(status == "eof")
       done = true;
@@ -118,11 +120,7 @@ ScanReport ALogScanner::scanRateOnly()
 
 bool ALogScanner::openALogFile(string alogfile)
 {
-  m_file = fopen(alogfile.c_str(), "r");
-  if(!m_file)
-    return(false);
-  else
-    return(true);
+  return(m_reader.open(alogfile));
 }
 
 
@@ -28,11 +28,12 @@
 #include <map>
 #include <string>
 #include "ScanReport.h"
+#include "BufferedLineReader.h"
 
 class ALogScanner
 {
  public:
-  ALogScanner() {m_file=0; m_use_full_source=true; m_verbose=true;}
+  ALogScanner() {m_use_full_source=true; m_verbose=true;}
   ~ALogScanner() {}
 
   bool       openALogFile(std::string);
@@ -43,7 +44,7 @@ class ALogScanner
   void  setVerbose(bool v=true)  {m_verbose=v;}
   
  private:
-  FILE *m_file;
+  BufferedLineReader m_reader;
   bool  m_use_full_source;
 
   bool  m_verbose; 
@@ -21,105 +21,273 @@
 /* <http://www.gnu.org/licenses/>.                               */
 /*****************************************************************/
 
-#include <iostream>
-#include "MBUtils.h"
+#include <algorithm>
+#include <cstring>
 #include "ALogSorter.h"
-#include "LogUtils.h"
 
 using namespace std;
 
+// Size of the blocks holding the text of lines. Longer lines get a
+// block of their own.
+static const unsigned int SORT_BLOCK_SIZE = 1048576;
+
+//--------------------------------------------------------
+// Procedure: laterLine()
+//   Returns: true if line one is sorted after line two. Used as the
+//            heap ordering, putting the earliest line on top.
+
+static bool laterLine(const ALogSortLine& one, const ALogSortLine& two)
+{
+  if(one.tstamp != two.tstamp)
+    return(one.tstamp > two.tstamp);
+  return(one.seq > two.seq);
+}
+
+//--------------------------------------------------------
+// Procedure: Constructor
+
+ALogSorter::ALogSorter()
+{
+  m_seq    = 0;
+  m_newest = 0;
+
+  m_curr_block = 0;
+  m_curr_used  = 0;
+
+  m_check_for_duplicates = true;
+  m_sort_warnings = 0;
+
+  m_cache_size = 1000;
+  m_window     = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: Destructor
+
+ALogSorter::~ALogSorter()
+{
+  for(unsigned int i=0; i<m_blocks.size(); i++)
+    delete [] m_blocks[i];
+}
+
 //--------------------------------------------------------
 // Procedure: addEntry()
 //   Returns: true if sorting was required
+//      Note: Only the time stamp and raw line of the entry are kept.
 
 bool ALogSorter::addEntry(const ALogEntry& entry, bool forced_order)
 {
-  // Case 1: list is empty, just add the new entry
-  if(m_entries.size() == 0) {
-    m_entries.push_back(entry);
-    return(false);
-  }
-  
-  // Case 2: new entry is a line with no or bogus timestamp due to being
-  // a continuation of a previous line as with DB_VARSUMMARY. Give it a
-  // forced time stamp which is just the timestamp at the end of the list
-  if(forced_order) {
-    ALogEntry entry_copy = entry;
-    double time_stamp_prev = m_entries.back().time();
-    entry_copy.setTimeStamp(time_stamp_prev);
-    m_entries.push_back(entry_copy);
-    return(false);
-  }
-    
-  // Case 3: new entry is in correct order, just add new entry
-  double time_stamp_this = entry.time();
-  double time_stamp_prev = m_entries.back().time();
-  if(time_stamp_this >= time_stamp_prev) {
-    m_entries.push_back(entry);
-    return(false);
-  }
-    
-  // Case 3: new entry is out of order!!
-#if 1
-  if(time_stamp_this < m_entries.front().time())
-    m_sort_warnings++;
-    
-  m_entries.push_back(entry);
-  m_entries.sort();
-#endif
-
-#if 0
-  bool inserted = false;
-  list<ALogEntry>::reverse_iterator p;
-  for(p=m_entries.rbegin(); ((p!=m_entries.rend()) && !inserted); p++) {
-    if(time_stamp_this <= p->time()) {
-      p--;
-      m_entries.insert(p.base(), entry);
-      inserted = true;
+  string line = entry.getRawLine();
+  return(addLine(entry.time(), line.c_str(), line.length(), forced_order));
+}
+
+//--------------------------------------------------------
+// Procedure: addLine()
+//   Returns: true if sorting was required
+
+bool ALogSorter::addLine(double tstamp, const char *line, unsigned int len,
+			 bool forced_order)
+{
+  bool sorted = false;
+  if(m_lines.size() > 0) {
+    // Case 1: new line is a line with no or bogus timestamp due to
+    // being a continuation of a previous line as with DB_VARSUMMARY.
+    // Give it a forced time stamp which is the newest time stamp.
+    if(forced_order)
+      tstamp = m_newest;
+
+    // Case 2: new line is out of order!!
+    else if(tstamp < m_newest) {
+      if(tstamp < m_lines.front().tstamp)
+	m_sort_warnings++;
+      sorted = true;
     }
   }
-  if(!inserted) {
-    m_entries.push_front(entry);
-    cout << "Sort warning!!!" << endl;
-  }
-#endif
+  if(m_lines.empty() || (tstamp > m_newest))
+    m_newest = tstamp;
 
-  return(true);
+  ALogSortLine sline;
+  sline.tstamp = tstamp;
+  sline.seq    = m_seq++;
+  sline.len    = len;
+  sline.block  = storeText(line, len, sline.offset);
+
+  m_lines.push_back(sline);
+  push_heap(m_lines.begin(), m_lines.end(), laterLine);
+
+  return(sorted);
 }
 
 //--------------------------------------------------------
 // Procedure: popEntry()
+//      Note: The entry has only the time stamp and raw line set.
 
 ALogEntry ALogSorter::popEntry()
 {
   ALogEntry return_entry;
-  if(m_entries.size() > 0) {
-    return_entry = m_entries.front();
-    m_entries.pop_front();
+
+  double tstamp;
+  string line;
+  if(popLine(tstamp, line)) {
+    return_entry.setTimeStamp(tstamp);
+    return_entry.setRawLine(line);
   }
+  return(return_entry);
+}
 
-  // If we're not checking for duplicates, we're done now
-  if(!m_check_for_duplicates)
-    return(return_entry);
+//--------------------------------------------------------
+// Procedure: popLine()
+//   Returns: false if the sorter is empty
 
-  // Go through the remaining entries and continue to check for
-  // duplicate. We assume the entries are all sorted by now, so we can
-  // stop checking once we hit an entry with a different timestamp
+bool ALogSorter::popLine(string& line)
+{
+  double tstamp;
+  return(popLine(tstamp, line));
+}
+
+//--------------------------------------------------------
+// Procedure: popLine()
+//   Returns: false if the sorter is empty
+
+bool ALogSorter::popLine(double& tstamp, string& line)
+{
+  if(m_lines.size() == 0)
+    return(false);
+
+  ALogSortLine top = m_lines.front();
+  pop_heap(m_lines.begin(), m_lines.end(), laterLine);
+  m_lines.pop_back();
+
+  tstamp = top.tstamp;
+  line.assign(m_blocks[top.block] + top.offset, top.len);
+
+  // If checking for duplicates, remove any remaining line of the
+  // same time and text. Lines of the same time are now on top of
+  // the heap. Those not duplicates are put back, keeping their
+  // sequence, so they come out in the same order.
+  if(m_check_for_duplicates) {
+    vector<ALogSortLine> kept;
+    while((m_lines.size() > 0) && (m_lines.front().tstamp == top.tstamp)) {
+      ALogSortLine next = m_lines.front();
+      pop_heap(m_lines.begin(), m_lines.end(), laterLine);
+      m_lines.pop_back();
+      if(sameText(next, top))
+	removeLine(next);
+      else
+	kept.push_back(next);
+    }
+    for(unsigned int i=0; i<kept.size(); i++) {
+      m_lines.push_back(kept[i]);
+      push_heap(m_lines.begin(), m_lines.end(), laterLine);
+    }
+  }
   
-  double return_entry_tstamp = return_entry.time();
+  removeLine(top);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: ready()
+//   Returns: true if the earliest line can be popped, without a
+//            line still to be added needing to come before it
+
+bool ALogSorter::ready() const
+{
+  if(m_lines.size() == 0)
+    return(false);
+
+  if(m_window > 0)
+    return(m_lines.front().tstamp < (m_newest - m_window));
   
-  list<ALogEntry>::iterator p;
-  for(p=m_entries.begin(); p!= m_entries.end(); ) {
-    ALogEntry entry = *p;
-    if(entry.time() != return_entry_tstamp)
-      break;
-
-    if(entry == return_entry)
-      p = m_entries.erase(p);
-    else
-      p++;
+  return(m_lines.size() > m_cache_size);
+}
+
+//--------------------------------------------------------
+// Procedure: sameText()
+
+bool ALogSorter::sameText(const ALogSortLine& one,
+			  const ALogSortLine& two) const
+{
+  if(one.len != two.len)
+    return(false);
+
+  const char *text1 = m_blocks[one.block] + one.offset;
+  const char *text2 = m_blocks[two.block] + two.offset;
+  return(memcmp(text1, text2, one.len) == 0);
+}
+
+//--------------------------------------------------------
+// Procedure: storeText()
+//   Purpose: Copy the text of a line into the current block, moving
+//            to another block if it does not fit.
+//   Returns: The index of the block, with the offset in the block
+
+unsigned int ALogSorter::storeText(const char *text, unsigned int len,
+				   unsigned int& offset)
+{
+  bool fits = false;
+  if(m_blocks.size() > 0)
+    fits = ((m_curr_used + len) <= m_block_size[m_curr_block]);
+
+  // If no lines are left in the current block, start it over
+  if(!fits && (m_blocks.size() > 0) && (m_block_lines[m_curr_block] == 0)) {
+    m_curr_used = 0;
+    fits = (len <= m_block_size[m_curr_block]);
+    if(!fits)
+      m_free_blocks.push_back(m_curr_block);
   }
 
-  return(return_entry);
+  // Otherwise take a free block, or make a new one
+  if(!fits) {
+    unsigned int size = SORT_BLOCK_SIZE;
+    if(len > size)
+      size = len;
+
+    unsigned int ix = m_blocks.size();
+    if(m_free_blocks.size() > 0) {
+      ix = m_free_blocks.back();
+      m_free_blocks.pop_back();
+    }
+    else {
+      m_blocks.push_back(0);
+      m_block_size.push_back(0);
+      m_block_lines.push_back(0);
+    }
+
+    if(m_block_size[ix] < size) {
+      delete [] m_blocks[ix];
+      m_blocks[ix] = new char[size];
+      m_block_size[ix] = size;
+    }
+    m_curr_block = ix;
+    m_curr_used  = 0;
+  }
+
+  offset = m_curr_used;
+  if(len > 0)
+    memcpy(m_blocks[m_curr_block] + offset, text, len);
+  m_curr_used += len;
+  m_block_lines[m_curr_block]++;
+  return(m_curr_block);
 }
 
+//--------------------------------------------------------
+// Procedure: removeLine()
+//   Purpose: Let go of the text of a line popped from the heap. A
+//            block with no lines left is free for reuse, and if it
+//            was made larger than the usual size, is deleted.
+
+void ALogSorter::removeLine(const ALogSortLine& sline)
+{
+  unsigned int ix = sline.block;
+  m_block_lines[ix]--;
+  if((m_block_lines[ix] > 0) || (ix == m_curr_block))
+    return;
+
+  if(m_block_size[ix] > SORT_BLOCK_SIZE) {
+    delete [] m_blocks[ix];
+    m_blocks[ix] = 0;
+    m_block_size[ix] = 0;
+  }
+  m_free_blocks.push_back(ix);
+}
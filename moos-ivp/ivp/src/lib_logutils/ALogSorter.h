@@ -24,40 +24,77 @@
 #ifndef ALOG_SORTER_HEADER
 #define ALOG_SORTER_HEADER
 
-#include <list>
+#include <string>
+#include <vector>
 #include "ALogEntry.h"
 
+// A line held by the sorter. The text is kept in one of the
+// sorter's text blocks, by block index and offset. The sequence
+// number keeps lines of equal time in the order they were added.
+
+struct ALogSortLine
+{
+  double        tstamp;
+  unsigned long seq;
+  unsigned int  block;
+  unsigned int  offset;
+  unsigned int  len;
+};
+
 class ALogSorter
 {
  public:
-  ALogSorter() {m_check_for_duplicates=true; m_sort_warnings=0;}
-  ~ALogSorter() {}
+  ALogSorter();
+  ~ALogSorter();
 
   bool         addEntry(const ALogEntry&, bool force_order=false);
+  bool         addLine(double tstamp, const char *line, unsigned int len,
+		       bool force_order=false);
   ALogEntry    popEntry();
+  bool         popLine(std::string& line);
   void         checkForDuplicates(bool v) {m_check_for_duplicates=v;}
 
-  unsigned int size() const         {return(m_entries.size());}
+  void         setCacheSize(unsigned int v) {m_cache_size=v;}
+  void         setWindow(double v)          {m_window=v;}
+  bool         ready() const;
+
+  unsigned int size() const         {return(m_lines.size());}
   unsigned int sortWarnings() const {return(m_sort_warnings);}
 
  private:
-  std::list<ALogEntry> m_entries;
+  bool         popLine(double& tstamp, std::string& line);
+  void         removeLine(const ALogSortLine&);
+  bool         sameText(const ALogSortLine&, const ALogSortLine&) const;
+  unsigned int storeText(const char *text, unsigned int len,
+			 unsigned int& offset);
+  
+ private: // Blocks are owned, so no copies
+  ALogSorter(const ALogSorter&);
+  ALogSorter& operator=(const ALogSorter&);
 
-  bool         m_check_for_duplicates;
-
-  unsigned int m_sort_warnings;
+ private:
+  // Min-heap of lines by time, then by sequence
+  std::vector<ALogSortLine> m_lines;
+  unsigned long m_seq;
+  double        m_newest;
+
+  // Text blocks, the number of lines held in each, and the blocks
+  // free for reuse
+  std::vector<char*>        m_blocks;
+  std::vector<unsigned int> m_block_size;
+  std::vector<unsigned int> m_block_lines;
+  std::vector<unsigned int> m_free_blocks;
+  unsigned int  m_curr_block;
+  unsigned int  m_curr_used;
+
+  bool          m_check_for_duplicates;
+  unsigned int  m_sort_warnings;
+
+  // Lines are ready to pop when more than the cache size are held,
+  // or if the window is set, when they are older than the newest
+  // line by more than the window.
+  unsigned int  m_cache_size;
+  double        m_window;
 };
 
 #endif 
-
-
-
-
-
-
-
-
-
-
-
-
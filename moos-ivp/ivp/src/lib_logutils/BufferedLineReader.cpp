@@ -0,0 +1,259 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: BufferedLineReader.cpp                               */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstring>
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+#include "BufferedLineReader.h"
+#include "LogUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: Constructor
+//      Note: The block must hold at least one full-length line
+//            plus its newline, or long lines could not be found.
+
+BufferedLineReader::BufferedLineReader(unsigned int block_size)
+{
+  if(block_size < (ALOG_MAX_LINE_LENGTH + 1))
+    block_size = ALOG_MAX_LINE_LENGTH + 1;
+
+  m_file  = 0;
+  m_eof   = false;
+  m_block = new char[block_size];
+  m_block_size = block_size;
+  m_beg   = 0;
+  m_end   = 0;
+
+  m_ranged     = false;
+  m_range_left = 0;
+
+  m_bytes_read = 0;
+  m_lines_read = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: Destructor
+
+BufferedLineReader::~BufferedLineReader()
+{
+  close();
+  delete [] m_block;
+}
+
+//--------------------------------------------------------
+// Procedure: open()
+
+bool BufferedLineReader::open(const string& filename)
+{
+  close();
+
+  m_file = fopen(filename.c_str(), "r");
+  if(!m_file)
+    return(false);
+
+  // The block is our buffer. Don't let stdio copy through its own.
+  setvbuf(m_file, 0, _IONBF, 0);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: openRange()
+//   Purpose: Read only the bytes from begin up to end. The begin
+//            should be the start of a line, and the end should be
+//            just past a newline, or the end of the file.
+
+bool BufferedLineReader::openRange(const string& filename,
+				   unsigned long long begin,
+				   unsigned long long end)
+{
+  if(!open(filename))
+    return(false);
+
+#ifdef _WIN32
+  int res = _fseeki64(m_file, (__int64)(begin), SEEK_SET);
+#else
+  int res = fseeko(m_file, (off_t)(begin), SEEK_SET);
+#endif
+  if(res != 0) {
+    close();
+    return(false);
+  }
+
+  m_ranged = true;
+  m_range_left = 0;
+  if(end > begin)
+    m_range_left = end - begin;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: close()
+
+void BufferedLineReader::close()
+{
+  if(m_file)
+    fclose(m_file);
+  m_file = 0;
+  m_eof  = false;
+  m_beg  = 0;
+  m_end  = 0;
+
+  m_ranged     = false;
+  m_range_left = 0;
+
+  m_bytes_read = 0;
+  m_lines_read = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: nextLine()
+//   Returns: false if no complete line remains in the file.
+
+bool BufferedLineReader::nextLine(const char*& line, unsigned int& len)
+{
+  bool eol;
+  return(nextLine(line, len, eol));
+}
+
+//--------------------------------------------------------
+// Procedure: nextLine()
+//      Note: As with getNextRawLine(), the string stops at the
+//            first NULL character if the line has one.
+
+bool BufferedLineReader::nextLine(string& line)
+{
+  const char  *ptr;
+  unsigned int len;
+  bool eol;
+  if(!nextLine(ptr, len, eol))
+    return(false);
+
+  const char *nul = (const char*)(memchr(ptr, '\0', len));
+  if(nul)
+    len = nul - ptr;
+  line.assign(ptr, len);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: nextEntry()
+//      Note: Status is "eof" once no complete line remains, and
+//            "invalid" for lines that do not parse as an entry.
+
+bool BufferedLineReader::nextEntry(ALogEntry& entry, bool allstrings)
+{
+  entry = ALogEntry();
+
+  const char  *ptr;
+  unsigned int len;
+  bool eol;
+  if(!nextLine(ptr, len, eol)) {
+    entry.setStatus("eof");
+    return(false);
+  }
+
+  // A line broken for length has no value field. Matches the
+  // handling of overlong lines in getNextRawALogEntry().
+  if(!eol) {
+    entry.setStatus("invalid");
+    return(true);
+  }
+
+  parseRawALogEntry(ptr, len, entry, allstrings);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: nextLine()
+//      Note: eol is false if the line was broken for length
+//            rather than ended by a newline.
+
+bool BufferedLineReader::nextLine(const char*& line, unsigned int& len,
+				  bool& eol)
+{
+  if(!m_file)
+    return(false);
+
+  while(1) {
+    unsigned int avail = m_end - m_beg;
+    unsigned int span  = avail;
+    if(span > ALOG_MAX_LINE_LENGTH)
+      span = ALOG_MAX_LINE_LENGTH;
+
+    const char *beg = m_block + m_beg;
+    const char *nl  = (const char*)(memchr(beg, '\n', span));
+    if(nl) {
+      line = beg;
+      len  = nl - beg;
+      eol  = true;
+      m_beg += len + 1;
+      m_lines_read++;
+      return(true);
+    }
+    if(span == ALOG_MAX_LINE_LENGTH) {
+      line = beg;
+      len  = span;
+      eol  = false;
+      m_beg += len;
+      m_lines_read++;
+      return(true);
+    }
+    if(m_eof || !fillBlock())
+      return(false);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: fillBlock()
+//   Purpose: Move unread bytes to the front of the block and read
+//            from the file into the remainder.
+//   Returns: false if nothing more could be read.
+
+bool BufferedLineReader::fillBlock()
+{
+  unsigned int avail = m_end - m_beg;
+  if((avail > 0) && (m_beg > 0))
+    memmove(m_block, m_block + m_beg, avail);
+  m_beg = 0;
+  m_end = avail;
+
+  size_t want = m_block_size - m_end;
+  if(m_ranged && (want > m_range_left))
+    want = (size_t)(m_range_left);
+
+  size_t amt = 0;
+  if(want > 0)
+    amt = fread(m_block + m_end, 1, want, m_file);
+  if(amt == 0) {
+    m_eof = true;
+    return(false);
+  }
+  if(m_ranged)
+    m_range_left -= amt;
+  m_end += amt;
+  m_bytes_read += amt;
+  return(true);
+}
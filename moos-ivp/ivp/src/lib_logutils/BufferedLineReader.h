@@ -0,0 +1,88 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: BufferedLineReader.h                                 */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef BUFFERED_LINE_READER_HEADER
+#define BUFFERED_LINE_READER_HEADER
+
+#include <cstdio>
+#include <string>
+#include "ALogEntry.h"
+
+// Reads an alog (or klog) file a large block at a time, handing
+// out lines as pointers into the block. Lines are split exactly
+// as getNextRawLine() splits them: an unterminated last line is
+// dropped, and lines longer than the max line length are broken.
+// A range of the file may be read instead, from a line start to
+// just past a newline, and lines are then split as they would be
+// reading the whole file.
+
+class BufferedLineReader
+{
+public:
+  BufferedLineReader(unsigned int block_size=1048576);
+  ~BufferedLineReader();
+
+  bool open(const std::string& filename);
+  bool openRange(const std::string& filename,
+		 unsigned long long begin, unsigned long long end);
+  void close();
+  bool isOpen() const {return(m_file != 0);}
+
+  // Line is valid only until the next call. No NULL terminator.
+  bool nextLine(const char*& line, unsigned int& len);
+  bool nextLine(const char*& line, unsigned int& len, bool& eol);
+  bool nextLine(std::string& line);
+  bool nextEntry(ALogEntry& entry, bool allstrings=false);
+
+  unsigned long long bytesRead() const {return(m_bytes_read);}
+  unsigned long int  linesRead() const {return(m_lines_read);}
+
+  // Bytes handed out in lines so far, i.e. where the next line
+  // begins, counted from where reading began.
+  unsigned long long tell() const {return(m_bytes_read-(m_end-m_beg));}
+
+protected:
+  bool fillBlock();
+
+private: // The block is owned, so no copies
+  BufferedLineReader(const BufferedLineReader&);
+  BufferedLineReader& operator=(const BufferedLineReader&);
+
+protected:
+  FILE        *m_file;
+  bool         m_eof;
+
+  char        *m_block;
+  unsigned int m_block_size;
+  unsigned int m_beg;
+  unsigned int m_end;
+
+  // If reading a range, the bytes of it still to be read
+  bool               m_ranged;
+  unsigned long long m_range_left;
+
+  unsigned long long m_bytes_read;
+  unsigned long int  m_lines_read;
+};
+
+#endif
@@ -0,0 +1,578 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: KLogStore.cpp                                        */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+#include "KLogStore.h"
+#include "BufferedLineReader.h"
+#include "LogUtils.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+// The store file layout. The header is followed by the string
+// heap, written as the klog is read, and then the block index and
+// the columns. Each section starts on an 8 byte boundary. Numbers
+// are in the byte order of the machine, since the store is only a
+// local cache of the klog. A store from another machine is seen as
+// stale by the byte order check and rebuilt.
+
+#define KLOG_STORE_MAGIC "KLOGCOL1"
+#define KLOG_STORE_ORDER 0x01020304
+
+struct KLogStoreHeader
+{
+  char         magic[8];
+  unsigned int byte_order;
+  unsigned int block_rows;
+
+  // Size and modification time of the klog the store was built from
+  unsigned long long klog_size;
+  long long          klog_mtime;
+
+  unsigned long long rows;
+  unsigned long long blocks;
+  unsigned long long sources;
+
+  unsigned long long off_heap;
+  unsigned long long heap_size;
+  unsigned long long off_block;
+  unsigned long long off_time;
+  unsigned long long off_dval;
+  unsigned long long off_voff;
+  unsigned long long off_vlen;
+  unsigned long long off_vsrc;
+  unsigned long long off_soff;
+  unsigned long long off_slen;
+};
+
+static bool writeSection(FILE*, const void*, unsigned long long size,
+			 unsigned long long& offset);
+static bool writeHeap(FILE*, const string&, unsigned long long& size);
+
+//--------------------------------------------------------
+// Constructor
+
+KLogStore::KLogStore()
+{
+  m_data      = 0;
+  m_data_size = 0;
+
+  m_rows   = 0;
+  m_blocks = 0;
+
+  m_header = 0;
+  m_block  = 0;
+  m_time   = 0;
+  m_dval   = 0;
+  m_voff   = 0;
+  m_vlen   = 0;
+  m_vsrc   = 0;
+  m_soff   = 0;
+  m_slen   = 0;
+  m_heap   = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: storeFile()
+//   Purpose: Name the store of a klog, e.g. NAV_X.klog -> NAV_X.kcol
+
+string KLogStore::storeFile(const string& klog)
+{
+  string store = klog;
+  if(strEnds(store, ".klog"))
+    store = store.substr(0, store.length()-5);
+  return(store + ".kcol");
+}
+
+//--------------------------------------------------------
+// Procedure: build()
+//   Purpose: Read the klog once, and write its store. The columns
+//            hold exactly what the ALogDataBroker would parse from
+//            each line: the time stamp and value with atof(), and
+//            the value string with blank ends stripped.
+//      Note: The store is written under a temporary name and then
+//            renamed, so a reader never sees a partial store.
+
+bool KLogStore::build(const string& klog, const string& store)
+{
+  struct stat info;
+  if(stat(klog.c_str(), &info) != 0)
+    return(false);
+
+  BufferedLineReader reader;
+  if(!reader.open(klog))
+    return(false);
+
+  string tmp_file = store + ".tmp";
+  FILE *f = fopen(tmp_file.c_str(), "wb");
+  if(!f)
+    return(false);
+
+  KLogStoreHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, KLOG_STORE_MAGIC, 8);
+  header.byte_order = KLOG_STORE_ORDER;
+  header.block_rows = KLOG_STORE_BLOCK_ROWS;
+  header.klog_size  = (unsigned long long)(info.st_size);
+  header.klog_mtime = (long long)(info.st_mtime);
+
+  // Part 1: Hold the place of the header, filled in at the end
+  unsigned long long offset = 0;
+  bool ok = writeSection(f, &header, sizeof(header), offset);
+  header.off_heap = offset;
+
+  // Part 2: Read the lines, writing value strings to the heap
+  vector<double>             times;
+  vector<double>             dvals;
+  vector<unsigned long long> voffs;
+  vector<unsigned int>       vlens;
+  vector<unsigned int>       vsrcs;
+  vector<unsigned long long> soffs;
+  vector<unsigned int>       slens;
+  vector<KLogStoreBlock>     blocks;
+  map<string, unsigned int>  source_ids;
+
+  unsigned long long heap_size  = 0;
+  unsigned long long line_start = 0;
+  bool after_newline = true;
+
+  string line;
+  const char  *ptr;
+  unsigned int len;
+  bool eol;
+  while(ok) {
+    unsigned long long line_offset = reader.tell();
+    if(!reader.nextLine(ptr, len, eol))
+      break;
+
+    // A line broken for length gives a row that is not a line start
+    if(after_newline)
+      line_start = line_offset;
+    after_newline = eol;
+
+    // As in BufferedLineReader::nextLine(), stop at a NULL
+    const char *nul = (const char*)(memchr(ptr, '\0', len));
+    if(nul)
+      len = nul - ptr;
+    line.assign(ptr, len);
+    if((line.length() > 0) && (line.at(0) == '%'))
+      continue;
+
+    double tstamp = atof(getTimeStamp(line).c_str());
+    string varval = getDataEntry(line);
+    double dval   = atof(varval.c_str());
+    varval = stripBlankEnds(varval);
+
+    string source = getSourceName(line);
+    unsigned int source_id = soffs.size();
+    map<string, unsigned int>::iterator p = source_ids.find(source);
+    if(p != source_ids.end())
+      source_id = p->second;
+    else {
+      source_ids[source] = source_id;
+      soffs.push_back(heap_size);
+      slens.push_back(source.length());
+      ok = ok && writeHeap(f, source, heap_size);
+    }
+
+    // A time stamp that is not a number is never skipped by the
+    // ALogDataBroker, so its block must never be skipped either.
+    double tkey = tstamp;
+    if(tstamp != tstamp)
+      tkey = HUGE_VAL;
+
+    if((times.size() % KLOG_STORE_BLOCK_ROWS) == 0) {
+      KLogStoreBlock block;
+      block.tmin   = tkey;
+      block.tmax   = tkey;
+      block.offset = line_start;
+      block.source = source_id;
+      block.unused = 0;
+      blocks.push_back(block);
+    }
+    else {
+      KLogStoreBlock& block = blocks.back();
+      if(tkey < block.tmin)
+	block.tmin = tkey;
+      if(tkey > block.tmax)
+	block.tmax = tkey;
+      if(block.source != source_id)
+	block.source = KLOG_STORE_MIXED;
+    }
+
+    times.push_back(tstamp);
+    dvals.push_back(dval);
+    voffs.push_back(heap_size);
+    vlens.push_back(varval.length());
+    vsrcs.push_back(source_id);
+    ok = ok && writeHeap(f, varval, heap_size);
+  }
+  reader.close();
+
+  // Part 3: Pad the heap and write the index and the columns
+  header.heap_size = heap_size;
+  offset += heap_size;
+  ok = ok && writeSection(f, 0, 0, offset);
+
+  header.rows    = times.size();
+  header.blocks  = blocks.size();
+  header.sources = soffs.size();
+
+  header.off_block = offset;
+  if(blocks.size() > 0)
+    ok = ok && writeSection(f, &blocks[0],
+			    blocks.size() * sizeof(KLogStoreBlock), offset);
+  header.off_time = offset;
+  if(times.size() > 0) {
+    ok = ok && writeSection(f, &times[0], times.size() * 8, offset);
+    header.off_dval = offset;
+    ok = ok && writeSection(f, &dvals[0], dvals.size() * 8, offset);
+    header.off_voff = offset;
+    ok = ok && writeSection(f, &voffs[0], voffs.size() * 8, offset);
+    header.off_vlen = offset;
+    ok = ok && writeSection(f, &vlens[0], vlens.size() * 4, offset);
+    header.off_vsrc = offset;
+    ok = ok && writeSection(f, &vsrcs[0], vsrcs.size() * 4, offset);
+  }
+  header.off_soff = offset;
+  if(soffs.size() > 0) {
+    ok = ok && writeSection(f, &soffs[0], soffs.size() * 8, offset);
+    header.off_slen = offset;
+    ok = ok && writeSection(f, &slens[0], slens.size() * 4, offset);
+  }
+
+  // Part 4: Fill in the header, and move the store into place
+  ok = ok && (fseek(f, 0, SEEK_SET) == 0);
+  ok = ok && (fwrite(&header, sizeof(header), 1, f) == 1);
+  ok = (fclose(f) == 0) && ok;
+
+  if(ok) {
+    remove(store.c_str());
+    ok = (rename(tmp_file.c_str(), store.c_str()) == 0);
+  }
+  if(!ok)
+    remove(tmp_file.c_str());
+  return(ok);
+}
+
+//--------------------------------------------------------
+// Procedure: open()
+//   Purpose: Map the store of the given klog, first building it if
+//            it is missing, or stale, or unreadable.
+//   Returns: false if no usable store could be had. The caller may
+//            then read the klog itself.
+
+bool KLogStore::open(const string& klog, bool build_if_stale)
+{
+  close();
+
+  struct stat kinfo;
+  if(stat(klog.c_str(), &kinfo) != 0)
+    return(false);
+
+  string store = storeFile(klog);
+  for(unsigned int attempt=0; attempt<2; attempt++) {
+    struct stat sinfo;
+    if((stat(store.c_str(), &sinfo) == 0) &&
+       mapFile(store, (unsigned long long)(sinfo.st_size))) {
+      if((m_header->klog_size  == (unsigned long long)(kinfo.st_size)) &&
+	 (m_header->klog_mtime == (long long)(kinfo.st_mtime)))
+	return(true);
+      close();
+    }
+    if(!build_if_stale || (attempt > 0) || !build(klog, store))
+      return(false);
+  }
+  return(false);
+}
+
+//--------------------------------------------------------
+// Procedure: close()
+
+void KLogStore::close()
+{
+  if(m_data) {
+#ifdef _WIN32
+    delete [] m_data;
+#else
+    munmap(m_data, m_data_size);
+#endif
+  }
+  m_data      = 0;
+  m_data_size = 0;
+
+  m_rows   = 0;
+  m_blocks = 0;
+
+  m_header = 0;
+  m_block  = 0;
+  m_time   = 0;
+  m_dval   = 0;
+  m_voff   = 0;
+  m_vlen   = 0;
+  m_vsrc   = 0;
+  m_soff   = 0;
+  m_slen   = 0;
+  m_heap   = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: klogSize()
+//   Returns: The size of the klog the store was built from
+
+unsigned long long KLogStore::klogSize() const
+{
+  if(!m_header)
+    return(0);
+  return(m_header->klog_size);
+}
+
+//--------------------------------------------------------
+// Procedure: getString()
+//   Returns: The value string of the row. Not NULL terminated.
+
+const char* KLogStore::getString(unsigned long long row,
+				 unsigned int& len) const
+{
+  len = m_vlen[row];
+  return(m_heap + m_voff[row]);
+}
+
+//--------------------------------------------------------
+// Procedure: getString()
+
+string KLogStore::getString(unsigned long long row) const
+{
+  return(string(m_heap + m_voff[row], m_vlen[row]));
+}
+
+//--------------------------------------------------------
+// Procedure: getSource()
+
+string KLogStore::getSource(unsigned long long row) const
+{
+  unsigned int source_id = m_vsrc[row];
+  return(string(m_heap + m_soff[source_id], m_slen[source_id]));
+}
+
+//--------------------------------------------------------
+// Procedure: firstRow()
+//   Returns: The first row of the first block holding a time, plus
+//            the skew, not below tmin. Rows before it need not be
+//            read. The number of rows if there is no such block.
+//      Note: The skew is added rather than taken from tmin so the
+//            comparison is made just as the caller makes it.
+
+unsigned long long KLogStore::firstRow(double tmin, double skew) const
+{
+  for(unsigned int i=0; i<m_blocks; i++) {
+    if((m_block[i].tmax + skew) >= tmin)
+      return((unsigned long long)(i) * KLOG_STORE_BLOCK_ROWS);
+  }
+  return(m_rows);
+}
+
+//--------------------------------------------------------
+// Procedure: firstOffset()
+//   Returns: As firstRow(), but the offset in the klog to read the
+//            lines from. The klog size if there is no such block.
+//      Note: The lines read from the offset may include comments
+//            and lines of earlier blocks, all below tmin.
+
+unsigned long long KLogStore::firstOffset(double tmin, double skew) const
+{
+  for(unsigned int i=0; i<m_blocks; i++) {
+    if((m_block[i].tmax + skew) >= tmin)
+      return(m_block[i].offset);
+  }
+  return(m_header->klog_size);
+}
+
+//--------------------------------------------------------
+// Procedure: uniformSource()
+//   Returns: true if the first given number of rows all have the
+//            same source. Only blocks of mixed sources are read.
+
+bool KLogStore::uniformSource(unsigned long long rows) const
+{
+  if(rows > m_rows)
+    rows = m_rows;
+  if(rows == 0)
+    return(true);
+
+  unsigned int source_id = m_vsrc[0];
+  for(unsigned int i=0; i<m_blocks; i++) {
+    unsigned long long beg = (unsigned long long)(i) * KLOG_STORE_BLOCK_ROWS;
+    if(beg >= rows)
+      break;
+    if(m_block[i].source == source_id)
+      continue;
+    if(m_block[i].source != KLOG_STORE_MIXED)
+      return(false);
+    unsigned long long end = beg + KLOG_STORE_BLOCK_ROWS;
+    if(end > rows)
+      end = rows;
+    for(unsigned long long j=beg; j<end; j++) {
+      if(m_vsrc[j] != source_id)
+	return(false);
+    }
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: mapFile()
+//   Purpose: Map the store into memory, or read it in if mapping
+//            is not available.
+
+bool KLogStore::mapFile(const string& store, unsigned long long size)
+{
+  close();
+  if(size < sizeof(KLogStoreHeader))
+    return(false);
+
+#ifdef _WIN32
+  FILE *f = fopen(store.c_str(), "rb");
+  if(!f)
+    return(false);
+  m_data = new char[size];
+  size_t amt = fread(m_data, 1, size, f);
+  fclose(f);
+  m_data_size = size;
+  if(amt != size) {
+    close();
+    return(false);
+  }
+#else
+  int fd = ::open(store.c_str(), O_RDONLY);
+  if(fd < 0)
+    return(false);
+  void *addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if(addr == MAP_FAILED)
+    return(false);
+  m_data = (char*)(addr);
+  m_data_size = size;
+#endif
+
+  if(!checkLayout(size)) {
+    close();
+    return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: checkLayout()
+//   Purpose: Confirm the header is of this version and byte order,
+//            and that each section lies within the file, then set
+//            the column pointers.
+
+bool KLogStore::checkLayout(unsigned long long size)
+{
+  const KLogStoreHeader *header = (const KLogStoreHeader*)(m_data);
+  if(memcmp(header->magic, KLOG_STORE_MAGIC, 8) != 0)
+    return(false);
+  if((header->byte_order != KLOG_STORE_ORDER) ||
+     (header->block_rows != KLOG_STORE_BLOCK_ROWS))
+    return(false);
+
+  unsigned long long rows    = header->rows;
+  unsigned long long sources = header->sources;
+  unsigned long long blocks  = (rows + KLOG_STORE_BLOCK_ROWS - 1) /
+    KLOG_STORE_BLOCK_ROWS;
+  if((header->blocks != blocks) || (blocks > 0xFFFFFFFF))
+    return(false);
+
+  unsigned long long offs[9] = {header->off_heap, header->off_block,
+    header->off_time, header->off_dval, header->off_voff,
+    header->off_vlen, header->off_vsrc, header->off_soff,
+    header->off_slen};
+  unsigned long long lens[9] = {header->heap_size,
+    blocks * sizeof(KLogStoreBlock), rows * 8, rows * 8, rows * 8,
+    rows * 4, rows * 4, sources * 8, sources * 4};
+  for(unsigned int i=0; i<9; i++) {
+    if((lens[i] > 0) && (((offs[i] % 8) != 0) || (offs[i] > size) ||
+			 (lens[i] > (size - offs[i]))))
+      return(false);
+  }
+
+  m_header = header;
+  m_rows   = rows;
+  m_blocks = (unsigned int)(blocks);
+  m_heap   = m_data + header->off_heap;
+  m_block  = (const KLogStoreBlock*)(m_data + header->off_block);
+  m_time   = (const double*)(m_data + header->off_time);
+  m_dval   = (const double*)(m_data + header->off_dval);
+  m_voff   = (const unsigned long long*)(m_data + header->off_voff);
+  m_vlen   = (const unsigned int*)(m_data + header->off_vlen);
+  m_vsrc   = (const unsigned int*)(m_data + header->off_vsrc);
+  m_soff   = (const unsigned long long*)(m_data + header->off_soff);
+  m_slen   = (const unsigned int*)(m_data + header->off_slen);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: writeSection()
+//   Purpose: Write the bytes at the offset, then pad with zeros up
+//            to the next 8 byte boundary, advancing the offset.
+
+static bool writeSection(FILE *f, const void *data,
+			 unsigned long long size, unsigned long long& offset)
+{
+  if((size > 0) && (fwrite(data, 1, size, f) != size))
+    return(false);
+  offset += size;
+
+  static const char zeros[8] = {0,0,0,0,0,0,0,0};
+  unsigned int pad = (8 - (offset % 8)) % 8;
+  if((pad > 0) && (fwrite(zeros, 1, pad, f) != pad))
+    return(false);
+  offset += pad;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: writeHeap()
+//   Purpose: Append a string to the heap, unpadded.
+
+static bool writeHeap(FILE *f, const string& str, unsigned long long& size)
+{
+  if((str.length() > 0) && (fwrite(str.c_str(), 1, str.length(), f) !=
+			    str.length()))
+    return(false);
+  size += str.length();
+  return(true);
+}
@@ -0,0 +1,112 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: KLogStore.h                                          */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef KLOG_STORE_HEADER
+#define KLOG_STORE_HEADER
+
+#include <string>
+
+// A column store of one klog file, built once beside the klog as
+// VAR.kcol and memory mapped for reading. Each row is one posting
+// (comment lines are left out), with columns for the time stamp,
+// the value as a double, and the value as a string in a heap. The
+// rows are grouped in blocks of KLOG_STORE_BLOCK_ROWS, and a block
+// index of time extremes lets a time range query skip the blocks
+// outside the range. The store is rebuilt if the klog changes.
+
+#define KLOG_STORE_BLOCK_ROWS 4096
+
+struct KLogStoreHeader;
+
+struct KLogStoreBlock
+{
+  double tmin;
+  double tmax;
+
+  // Offset in the klog of a line start at or before the first row
+  unsigned long long offset;
+
+  // Source of every row in the block, or KLOG_STORE_MIXED
+  unsigned int source;
+  unsigned int unused;
+};
+
+#define KLOG_STORE_MIXED 0xFFFFFFFF
+
+class KLogStore
+{
+public:
+  KLogStore();
+  ~KLogStore() {close();}
+
+  static std::string storeFile(const std::string& klog);
+  static bool build(const std::string& klog, const std::string& store);
+
+  bool open(const std::string& klog, bool build_if_stale=true);
+  void close();
+  bool isOpen() const {return(m_data != 0);}
+
+  unsigned long long size() const {return(m_rows);}
+  unsigned int blocks() const     {return(m_blocks);}
+
+  unsigned long long klogSize() const;
+
+  double getTime(unsigned long long row) const  {return(m_time[row]);}
+  double getValue(unsigned long long row) const {return(m_dval[row]);}
+
+  const char*  getString(unsigned long long row, unsigned int& len) const;
+  std::string  getString(unsigned long long row) const;
+  std::string  getSource(unsigned long long row) const;
+
+  unsigned long long firstRow(double tmin, double skew=0) const;
+  unsigned long long firstOffset(double tmin, double skew=0) const;
+  bool uniformSource(unsigned long long rows) const;
+
+protected:
+  bool mapFile(const std::string& store, unsigned long long size);
+  bool checkLayout(unsigned long long size);
+
+private: // The mapping is owned, so no copies
+  KLogStore(const KLogStore&);
+  KLogStore& operator=(const KLogStore&);
+
+protected:
+  char              *m_data;
+  unsigned long long m_data_size;
+
+  unsigned long long m_rows;
+  unsigned int       m_blocks;
+
+  const KLogStoreHeader    *m_header;
+  const KLogStoreBlock     *m_block;
+  const double             *m_time;
+  const double             *m_dval;
+  const unsigned long long *m_voff;
+  const unsigned int       *m_vlen;
+  const unsigned int       *m_vsrc;
+  const unsigned long long *m_soff;
+  const unsigned int       *m_slen;
+  const char               *m_heap;
+};
+
+#endif
@@ -24,11 +24,19 @@
 #include <iostream>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include "MBUtils.h"
 #include "LogUtils.h"
-#include <cstdio>
 
-#define MAX_LINE_LENGTH 500000
+#define MAX_LINE_LENGTH ALOG_MAX_LINE_LENGTH
+
+// Lines are read a character at a time. Skip the per-character
+// stream locking where the platform allows it.
+#ifdef _WIN32
+#define GETC(f) fgetc(f)
+#else
+#define GETC(f) getc_unlocked(f)
+#endif
 
 using namespace std;
 
@@ -437,16 +445,15 @@ string getNextRawLine(FILE *fileptr)
   bool   EOL     = false;
   int    buffix  = 0;
   int    myint   = '\0';
-  char   buff[MAX_LINE_LENGTH];
+  char   buff[MAX_LINE_LENGTH+1];
 
   while((!EOL) && (buffix < MAX_LINE_LENGTH)) {
-    myint = fgetc(fileptr);
+    myint = GETC(fileptr);
     unsigned char mychar = myint;
     switch(myint) {
     case EOF:
       return("eof");
     case '\n':
-      buff[buffix] = '\0';  // attach terminating NULL
       EOL = true;
       break;
     default:
@@ -454,6 +461,7 @@ string getNextRawLine(FILE *fileptr)
       buffix++;
     }
   }
+  buff[buffix] = '\0';  // attach terminating NULL
   string str = buff;  
   return(str);
 }
@@ -461,6 +469,9 @@ string getNextRawLine(FILE *fileptr)
 
 //--------------------------------------------------------
 // Procedure: getNextRawALogEntry()
+//      Note: A last line with no newline gives an "eof" entry. A
+//            line longer than MAX_LINE_LENGTH gives an "invalid"
+//            entry, and the remainder is read as the next line.
 
 ALogEntry getNextRawALogEntry(FILE *fileptr, bool allstrings)
 {
@@ -472,103 +483,181 @@ ALogEntry getNextRawALogEntry(FILE *fileptr, bool allstrings)
   }
   
   bool EOLine  = false;
-  bool EOFile  = false;
   int  buffix  = 0;
   int  lineix  = 0;
   int  myint   = '\0';
   char buff[MAX_LINE_LENGTH];
 
-  string time, var, rawsrc, val;
-
-  // Simple state machine: 
-  //   0: time
-  //   1: between time and variable
-  //   2: variable
-  //   3: between variable and source
-  //   4: source
-  //   5: between source and value
-  //   6: value
-  int  state = 0;
-
-  while((!EOLine) && (!EOFile) && (lineix < MAX_LINE_LENGTH)) {
-    myint = fgetc(fileptr);
-    unsigned char mychar = myint;
-    switch(myint) {
-    case EOF:
-      EOFile = true;
-      break;
-    case ' ':
-    case '\t':
-      if(state==0) {
-	buff[buffix] = '\0';
-	time = buff;
-	buffix = 0;
-	state=1;
-      }
-      else if(state==2) {
-	buff[buffix] = '\0';
-	var = buff;
-	buffix = 0;
-	state=3;
-      }
-      else if(state==4) {
-	buff[buffix] = '\0';
-	rawsrc = buff;
-	buffix = 0;
-	state=5;
-      }
-      else if(state==6) {      // mikerb nov1121
-	buff[buffix] = mychar;
-	buffix++;
-      }
-      break;	  
-    case '\n':
-      buff[buffix] = '\0';  // attach terminating NULL
-      val = buff;
+  while((!EOLine) && (lineix < MAX_LINE_LENGTH)) {
+    myint = GETC(fileptr);
+    if(myint == EOF) {
+      entry.setStatus("eof");
+      return(entry);
+    }
+    if(myint == '\n')
       EOLine = true;
-      break;
-    default:
-      if(state==1) 
-	state=2;
-      else if(state==3)
-	state=4;
-      else if(state==5)
-	state=6;
-      buff[buffix] = mychar;
+    else {
+      buff[buffix] = (unsigned char)(myint);
       buffix++;
     }
     lineix++;
   }
   
-  //cout << "t:" << time << " v:" << var << " s:" << src << " v:" << val << endl;
+  if(!EOLine)
+    entry.setStatus("invalid");
+  else
+    parseRawALogEntry(buff, buffix, entry, allstrings);
+  return(entry);
+}
 
-  string src    = biteString(rawsrc,':');
-  string srcaux = rawsrc;
+
+//--------------------------------------------------------
+// Procedure: parseRawALogEntry()
+//   Purpose: Parse one alog line, given without its newline, into
+//            the time, variable, source and value fields.
+//   Returns: false, with the status set to "invalid", if the line
+//            is not a full entry with a numerical timestamp.
+//      Note: Fields are separated by blanks or tabs. The value is
+//            the remainder of the line, blanks included. A field
+//            stops at a NULL character if it has one.
+
+static unsigned int fieldLen(const char *field, unsigned int len);
+static bool isNumber(const char *buff, unsigned int len);
+
+bool parseRawALogEntry(const char *line, unsigned int len,
+		       ALogEntry& entry, bool allstrings)
+{
+  // Find the first three fields, then the start of the value
+  unsigned int fbeg[3] = {0, 0, 0};
+  unsigned int fend[3] = {0, 0, 0};
+  unsigned int i = 0;
+  unsigned int fields = 0;
+  while((i < len) && (fields < 3)) {
+    fbeg[fields] = i;
+    while((i < len) && (line[i] != ' ') && (line[i] != '\t'))
+      i++;
+    fend[fields] = i;
+    if(i == len)
+      break;
+    fields++;
+    while((i < len) && ((line[i] == ' ') || (line[i] == '\t')))
+      i++;
+  }
+
+  // A field cut off by the end of line is taken as the value, and
+  // the fields after it are empty. A line with only a time stamp
+  // has an empty time field and a value.
+  unsigned int tlen = 0;
+  unsigned int vlen = 0;
+  unsigned int slen = 0;
+  unsigned int vbeg = 0;
+  unsigned int vend = 0;
+  if(fields > 0)
+    tlen = fieldLen(line, fend[0]);
+  if(fields > 1)
+    vlen = fieldLen(line + fbeg[1], fend[1] - fbeg[1]);
+  if(fields > 2)
+    slen = fieldLen(line + fbeg[2], fend[2] - fbeg[2]);
+  if((fields < 3) && (i == len)) {
+    vbeg = fbeg[fields];
+    vend = fend[fields];
+  }
+  else if((fields == 3) && (i < len)) {
+    vbeg = i;
+    vend = len;
+  }
 
   // Check for lines that may be carriage return continuation of previous line's
   // data field as in DB_VARSUMMARY
-  if((time != "") && (time.at(0) != '%')) {
-    if(!isNumber(time.substr(0,1))) {
+  if((tlen > 0) && (line[0] != '%')) {
+    if((line[0] < '0') || (line[0] > '9')) {
       entry.setStatus("invalid");
-      return(entry);
+      return(false);
     }
   }
-	
 
-  if((time!="")&&(var!="")&&(src!="")&&(val!="") && isNumber(time)) {
-    if(allstrings || !isNumber(val))
-      entry.set(atof(time.c_str()), var, src, srcaux, val);
-    else
-      entry.set(atof(time.c_str()), var, src, srcaux, atof(val.c_str()));
+  // The source may have an aux part after a colon
+  const char  *src = line + fbeg[2];
+  const char  *colon = (const char*)(memchr(src, ':', slen));
+  unsigned int srclen = slen;
+  if(colon)
+    srclen = colon - src;
+
+  const char  *val = line + vbeg;
+  unsigned int valen = fieldLen(val, vend - vbeg);
+  if((tlen == 0) || (vlen == 0) || (srclen == 0) || (valen == 0) ||
+     !isNumber(line, tlen)) {
+    entry.setStatus("invalid");
+    return(false);
   }
-  else {
-    if(EOFile)
-      entry.setStatus("eof");
+
+  string varname(line + fbeg[1], vlen);
+  string source(src, srclen);
+  string srcaux;
+  if(colon)
+    srcaux.assign(colon + 1, slen - srclen - 1);
+
+  double tstamp = atof(string(line, tlen).c_str());
+  if(allstrings || !isNumber(val, valen))
+    entry.set(tstamp, varname, source, srcaux, string(val, valen));
+  else
+    entry.set(tstamp, varname, source, srcaux, 
+	      atof(string(val, valen).c_str()));
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: fieldLen()
+//   Returns: The length of the field up to any NULL character
+
+static unsigned int fieldLen(const char *field, unsigned int len)
+{
+  const char *nul = (const char*)(memchr(field, '\0', len));
+  if(nul)
+    len = nul - field;
+  return(len);
+}
+
+//--------------------------------------------------------
+// Procedure: isNumber()
+//      Note: Same as isNumber() in MBUtils with blanks allowed,
+//            for a field given by a pointer and length. As with
+//            stripBlankEnds(), the end is also stripped of any
+//            carriage returns.
+
+static bool isNumber(const char *buff, unsigned int len)
+{
+  while((len > 0) && ((buff[0] == ' ') || (buff[0] == '\t'))) {
+    buff++;
+    len--;
+  }
+  while((len > 0) && ((buff[len-1] == ' ') || (buff[len-1] == '\t') ||
+		      (buff[len-1] == '\r') || (buff[len-1] == '\n')))
+    len--;
+
+  if((len > 1) && (buff[0] == '+')) {
+    buff++;
+    len--;
+  }
+
+  unsigned int digi_cnt = 0;
+  unsigned int deci_cnt = 0;
+  for(unsigned int i=0; i<len; i++) {
+    if((buff[i] >= '0') && (buff[i] <= '9'))
+      digi_cnt++;
+    else if(buff[i] == '.') {
+      deci_cnt++;
+      if(deci_cnt > 1)
+	return(false);
+    }
+    else if(buff[i] == '-') {
+      if((digi_cnt > 0) || (deci_cnt > 0))
+	return(false);
+    }
     else
-      entry.setStatus("invalid");
+      return(false);
   }
-  
-  return(entry);
+  return(digi_cnt > 0);
 }
 
 
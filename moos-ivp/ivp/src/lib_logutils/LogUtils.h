@@ -28,6 +28,8 @@
 #include <string>
 #include "ALogEntry.h"
 
+#define ALOG_MAX_LINE_LENGTH 500000
+
 std::string getTimeStamp(const std::string& line);
 std::string getVarName(const std::string& line);
 std::string getSourceName(const std::string& line);
@@ -36,6 +38,8 @@ std::string getDataEntry(const std::string& line);
 
 std::string getNextRawLine(FILE*);
 ALogEntry   getNextRawALogEntry(FILE*, bool allstrings=false);
+bool        parseRawALogEntry(const char *line, unsigned int len,
+			      ALogEntry& entry, bool allstrings=false);
 
 
 void   stripInsigDigits(std::string& line);
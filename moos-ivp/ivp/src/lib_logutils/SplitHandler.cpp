@@ -25,15 +25,30 @@
 #include <cstdlib>
 #include <cstdio>
 #include <cmath>
+#include <cstring>
+#include <cerrno>
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
 #include "MBUtils.h"
 #include "SplitHandler.h"
 #include "LogUtils.h"
+#include "BufferedLineReader.h"
 #include "JsonUtils.h"
 #include "TermUtils.h"
 #include "ColorParse.h"
+#include "WorkerPool.h"
 
 using namespace std;
 
+// Size of the chunks of a parallel split, before rounding up to
+// the end of a line
+static const unsigned long long SPLIT_CHUNK_SIZE = 16777216;
+
+static bool findChunkEnds(const string& filename,
+			  unsigned long long chunk_size,
+			  vector<unsigned long long>& ends);
+
 //--------------------------------------------------------
 // Constructor()
 
@@ -44,6 +59,7 @@ SplitHandler::SplitHandler(string alog_file)
   m_verbose   = false;
   m_progress  = false;
   m_max_cache = 125;  // Default limit for concurrent fopen fileptrs
+  m_threads   = 1;
   
   // Init state variables
   m_alog_file_confirmed = false;
@@ -143,8 +159,11 @@ bool SplitHandler::handlePreCheckALogFile()
 
 bool SplitHandler::handleMakeSplitFiles()
 {
-  FILE *file_in = fopen(m_alog_file.c_str(), "r");
-  if(!file_in) {
+  if(m_threads > 1)
+    return(handleMakeSplitFilesParallel());
+  
+  BufferedLineReader reader;
+  if(!reader.open(m_alog_file)) {
     cout << "Unable to open [" << m_alog_file << "] exiting." << endl;
     return(false);
   }
@@ -152,9 +171,8 @@ bool SplitHandler::handleMakeSplitFiles()
   char carriage_return = 13;
   unsigned int lines_read = 0;
   
-  bool done = false;
-  while(!done) {    
-    string line_raw = getNextRawLine(file_in);
+  string line_raw;
+  while(reader.nextLine(line_raw)) {
 
     if(m_progress) {
       lines_read++;
@@ -163,187 +181,520 @@ bool SplitHandler::handleMakeSplitFiles()
 	cout << carriage_return << flush;
       }
     }
-    
-    //cout << "line: [" << line_raw << "]" << endl;
-    // Check if the line has the timestamp
-    if((m_logstart.length() == 0) && strContains(line_raw, "LOGSTART")) {
-      line_raw = findReplace(line_raw, "LOGSTART", "X");
-      biteStringX(line_raw, 'X');
-      m_logstart = line_raw;
-      continue;
-    }
-    // Check if the line is a comment
-    if((line_raw.length() > 0) && (line_raw.at(0) == '%'))
-      continue;
-    // Check for end of file
-    if(line_raw == "eof") 
+
+    bool ok = splitLine(line_raw);
+    if(!ok)
       break;
+  }
 
-    // Otherwise handle a normal line
-    string varname = getVarName(line_raw);
+  if(m_progress) {
+    cout << termColor("blue");
+    cout << "  Lines Read: " << uintToCommaString(lines_read) << endl;
+    cout << termColor();
+  }
+  
+  if(m_verbose)
+    cout << "Done writing to klog files. Total files: " <<
+      m_file_ptr.size() << endl;
+  
+  // Close all the file pointers before finishing
+  map<string, FILE*>::iterator p;
+  for(p=m_file_ptr.begin(); p!=m_file_ptr.end(); p++) {
+    FILE *ptr = p->second;
+    fclose(ptr);
+  }
+  
+  if(m_max_cache_exceeded) {
+    cout << "WARNING: Maximum concurrent fopen fileptr cache exceeded." << endl;
+    cout << "This is not an error, but the alog file pre-splitting    " << endl;
+    cout << "phase will be slower in these cases.                     " << endl;
+    cout << "Total unique varnames: " << m_state.var_type.size() << endl;
+  }
+  
+  return(true);
+}
 
-    // Replace slashes in variable names - filesystems get confused
-    varname = findReplace(varname, "/", "_");
-    
-    // Reject any line that doesn't begin with a number
-    string one_char = line_raw.substr(0,1);
-    if(!isNumber(one_char) || (varname=="DB_VARSUMMARY"))
-      continue;
+//--------------------------------------------------------
+// Procedure: handleMakeSplitFilesParallel()
+//   Purpose: Same as handleMakeSplitFiles() but with the file split
+//            in chunks on the threads of a worker pool, and the
+//            klog files written by writers, each with a share of
+//            the klog files.
+//      Note: Each run of the pool splits the next batch of chunks
+//            while the batch before is written. Chunks are merged
+//            in file order between runs, so the klog files and the
+//            summary are the same as from the serial split.
+
+struct SplitJobs {
+  SplitHandler       *handler;
+  vector<SplitChunk*> split;
+  vector<SplitChunk*> write;
+};
+
+bool SplitHandler::handleMakeSplitFilesParallel()
+{
+  vector<unsigned long long> ends;
+  if(!findChunkEnds(m_alog_file, SPLIT_CHUNK_SIZE, ends)) {
+    cout << "Unable to open [" << m_alog_file << "] exiting." << endl;
+    return(false);
+  }
 
-    string tstamp = getTimeStamp(line_raw);
-    if(m_time_min == "")
-      m_time_min = tstamp;
-    m_time_max = tstamp;
-
-    if((varname=="VIEW_POINT")   || (varname=="VIEW_POLYGON") ||
-       (varname=="VIEW_SEGLIST") || (varname=="VIEW_CIRCLE")  ||
-       (varname=="GRID_INIT")    || (varname=="VIEW_MARKER")  ||
-       (varname=="GRID_DELTA")   || (varname=="VIEW_SEGLR")   ||
-       (varname=="VIEW_ARROW")   || 
-       (varname=="VIEW_RANGE_PULSE")  ||
-       (varname=="VIEW_COMMS_PULSE"))
-      varname = "VISUALS";
-
-    // A measure implemented here to accommodate older alogfile formats where
-    // the behavior name in BHV_IPF is foobar1234 where 1234 is the helm 
-    // iteration. In Release 15.4 , the format it foobar^1234. If the separator
-    // is not found, we look to see if the behavior name ends with the current
-    // helm iteration, and remove it. Luckily the current helm iteration is 
-    // apparently reliably logged before the BHV_IPF. So we note it here to
-    // apply this measure. Bit of a hack, but should be not needed once the
-    // newer format (with the '^' separator) is more widely adopted.
-    if(varname == "IVPHELM_ITER") {
-      string sval = getDataEntry(line_raw);
-      string iter = biteString(sval, '.');
-      m_curr_helm_iter = iter;
-    }
+  WorkerPool pool;
+  pool.setThreads(m_threads);
 
-    // Handle BHV_IPF: Break out into sep files for each behavior
-    // P,waypt_return^445,1,1,H,16,445:waypt_return,2,35,1,100,D,
-    if(varname == "BHV_IPF") {
-      string sval = getDataEntry(line_raw);       
-      biteString(sval, ',');                   
-      string bhv_name  = biteString(sval, ',');      
-      if(strContains(bhv_name, '^'))
-	bhv_name = biteString(bhv_name, '^');
-      else
-	bhv_name = findReplace(bhv_name, m_curr_helm_iter, "");
-      varname = "BHV_IPF_" + bhv_name; 
-      m_bhv_names.insert(bhv_name);
-    }
+  // Writers share the limit on open file pointers
+  m_writers.clear();
+  m_var_writer.clear();
+  m_writers.resize(m_threads);
+  for(unsigned int i=0; i<m_writers.size(); i++) {
+    m_writers[i].max_cache = m_max_cache / m_threads;
+    m_writers[i].max_cache_exceeded = false;
+  }
 
-    // Handle APP_LOG: Break out into sep files for each MOOSApp
-    if(varname == "APP_LOG") {
-      string src = getSourceName(line_raw);       
-      varname = "APP_LOG_" + src; 
-      m_applogging_app_names.insert(src);
-    }
+  char carriage_return = 13;
+  unsigned long int lines_read = 0;
 
-    // Part 1: Determine the vehicle name if not already known
-    // Typically the MOOSDB automatically names itself MOOSDB_COMMUNITY, 
-    // For example, MOOSDB_alpha. DB_TIME is published by the MOOSDB.
-    if((m_vname.length() == 0) && (varname == "DB_TIME")) {
-      string var_src = getSourceName(line_raw);
-      biteString(var_src, '_');
-      m_vname = var_src;
+  bool ok = true;
+  unsigned int next_chunk = 0;
+  vector<SplitChunk*> merged;
+  while(ok && ((next_chunk < ends.size()) || (merged.size() > 0))) {
+    SplitJobs jobs;
+    jobs.handler = this;
+    jobs.write   = merged;
+    while((jobs.split.size() < m_threads) && (next_chunk < ends.size())) {
+      SplitChunk *chunk = new SplitChunk;
+      chunk->begin = 0;
+      if(next_chunk > 0)
+	chunk->begin = ends[next_chunk-1];
+      chunk->end = ends[next_chunk];
+      chunk->lines_read = 0;
+      chunk->ok = false;
+      chunk->state.iter_known = (next_chunk == 0);
+      jobs.split.push_back(chunk);
+      next_chunk++;
     }
 
-    if((m_vtype.length() == 0) &&
-       ((varname == "NODE_REPORT_LOCAL") ||
-	(varname == "NODE_REPORT_LOCAL_FIRST"))) {
-
-      string sval    = tolower(getDataEntry(line_raw));
-      string vtype   = tokStringParse(sval, "type", ',', '=');      
-      string vcolor  = tokStringParse(sval, "color", ',', '=');      
-      string vlength = tokStringParse(sval, "length", ',', '=');      
-      if(vtype != "")
-	m_vtype   = vtype;
-      if(vcolor != "")
-	m_vcolor   = vcolor;
-      if(vlength != "")
-	m_vlength = vlength;
+    unsigned int write_jobs = 0;
+    if(jobs.write.size() > 0)
+      write_jobs = m_writers.size();
+    pool.run(splitJob, &jobs, jobs.split.size() + write_jobs);
+
+    for(unsigned int i=0; i<jobs.write.size(); i++)
+      delete(jobs.write[i]);
+    for(unsigned int i=0; i<m_writers.size(); i++) {
+      if(m_writers[i].error != "") {
+	cout << m_writers[i].error << endl;
+	ok = false;
+      }
     }
 
-    // Part 1P5: If this variable is a DETACHED variable
-    // Example:
-    //    APP_OVERVIEW = "temp=98.5,fuel=14.5,age=11.9,errs=11"
-    // 
-    // --detach=APP_OVERVIEW:fuel
-    //
-    // Would create a klog file as if the variable APP_OVERVIEW:FUEL
-    // were originally in the alog file
-
-    set<string> dkeys = detachedSet(varname); // detached key, e.g., fuel
-    if(dkeys.size() != 0) {
-      string sval = tolower(stripBlankEnds(getDataEntry(line_raw)));
-      // If datafield is string in JSON format, convert to CSP format
-      if(isBraced(sval))
-	sval = jsonToCsp(sval);
-
-      if(dkeys.count("all") != 0) {
-	dkeys = tokStringAll(sval);
-      }      
-
-      set<string>::iterator p;
-      for(p=dkeys.begin(); p!=dkeys.end(); p++) {
-	string dkey = *p;
-	if(m_verbose)
-	  cout << "Handling Detached: var: " << varname << ", dkey:"
-	       << dkey << endl;
-
-	string dval = tokStringParse(sval, tolower(dkey));
-	if(m_verbose)
-	  cout << "sval:" << sval << ", dval:" << dval << endl;
-
-	if(isNumber(dval)) {
-	  string varname_aug = varname;
-	  string timestamp = getTimeStamp(line_raw);
-	  string src_name = getSourceName(line_raw);
-	  varname_aug += ":" + toupper(dkey);
-	  line_raw = timestamp + "  " + varname_aug;
-	  line_raw += "  " + src_name + "  " + dval;
-	  if(m_verbose)
-	    cout << "newline:" << line_raw << endl;
-	  bool ok = handleSplitLine(varname_aug, line_raw);
-	  if(!ok)
-	    break;
-	}	
+    // Merge the chunks just split, in file order, to be written on
+    // the next run of the pool
+    merged = jobs.split;
+    for(unsigned int i=0; i<merged.size(); i++) {
+      if(!merged[i]->ok) {
+	cout << "Unable to read [" << m_alog_file << "] exiting." << endl;
+	ok = false;
       }
+      mergeChunk(*merged[i]);
+      lines_read += merged[i]->lines_read;
+    }
+
+    if(m_progress) {
+      cout << "  Lines Read: " << uintToCommaString(lines_read);
+      cout << carriage_return << flush;
     }
-    // Now handled the full original line with no detachements
-    bool ok = handleSplitLine(varname, line_raw);
-    if(!ok)
-      break;
-    
   }
 
+  for(unsigned int i=0; i<merged.size(); i++)
+    delete(merged[i]);
+  
   if(m_progress) {
     cout << termColor("blue");
     cout << "  Lines Read: " << uintToCommaString(lines_read) << endl;
     cout << termColor();
   }
+
+  // Close all the file pointers before finishing
+  unsigned int total_files = 0;
+  for(unsigned int i=0; i<m_writers.size(); i++) {
+    map<string, FILE*>::iterator p;
+    for(p=m_writers[i].file_ptr.begin(); p!=m_writers[i].file_ptr.end(); p++)
+      fclose(p->second);
+    total_files += m_writers[i].file_ptr.size();
+    if(m_writers[i].max_cache_exceeded)
+      m_max_cache_exceeded = true;
+  }
+  m_writers.clear();
   
   if(m_verbose)
     cout << "Done writing to klog files. Total files: " <<
-      m_file_ptr.size() << endl;
-  
-  // Close all the file pointers before finishing
-  map<string, FILE*>::iterator p;
-  for(p=m_file_ptr.begin(); p!=m_file_ptr.end(); p++) {
-    FILE *ptr = p->second;
-    fclose(ptr);
-  }
+      total_files << endl;
   
   if(m_max_cache_exceeded) {
     cout << "WARNING: Maximum concurrent fopen fileptr cache exceeded." << endl;
     cout << "This is not an error, but the alog file pre-splitting    " << endl;
     cout << "phase will be slower in these cases.                     " << endl;
-    cout << "Total unique varnames: " << m_var_type.size() << endl;
+    cout << "Total unique varnames: " << m_state.var_type.size() << endl;
   }
   
-  if(file_in)
-    fclose(file_in);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: splitJob()
+//      Note: Run on a thread of the pool. The first jobs each
+//            split a chunk, the rest each run one writer.
+
+void SplitHandler::splitJob(unsigned int job_ix, void *param)
+{
+  SplitJobs    *jobs    = static_cast<SplitJobs*>(param);
+  SplitHandler *handler = jobs->handler;
+
+  if(job_ix < jobs->split.size())
+    handler->splitChunk(*(jobs->split[job_ix]));
+  else {
+    unsigned int writer_ix = job_ix - jobs->split.size();
+    handler->writeChunks(handler->m_writers[writer_ix], jobs->write);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: splitChunk()
+//   Purpose: Split the lines of the chunk, gathering them in the
+//            chunk for each klog file.
+
+void SplitHandler::splitChunk(SplitChunk& chunk)
+{
+  chunk.lines_read = 0;
+  chunk.ok = false;
+  
+  BufferedLineReader reader;
+  if(!reader.openRange(m_alog_file, chunk.begin, chunk.end))
+    return;
+
+  string line_raw;
+  while(reader.nextLine(line_raw)) {
+    chunk.lines_read++;
+    splitLine(line_raw, &chunk);
+  }
+  chunk.ok = true;
+}
+
+//--------------------------------------------------------
+// Procedure: mergeChunk()
+//   Purpose: Merge the state of a chunk into the state of the split,
+//            as if its lines had been split after those before.
+//      Note: A chunk that used the helm iteration before finding
+//            it, or took a LOGSTART line already found before it,
+//            is first split again knowing both.
+
+void SplitHandler::mergeChunk(SplitChunk& chunk)
+{
+  SplitState& cstate = chunk.state;
+  if(cstate.iter_needed ||
+     (cstate.logstart_taken && (m_state.logstart != ""))) {
+    chunk.out.clear();
+    cstate = SplitState();
+    cstate.logstart = m_state.logstart;
+    cstate.curr_helm_iter = m_state.curr_helm_iter;
+    splitChunk(chunk);
+  }
+
+  if(m_state.logstart == "")
+    m_state.logstart = cstate.logstart;
+  if(m_state.time_min == "")
+    m_state.time_min = cstate.time_min;
+  if(cstate.time_max != "")
+    m_state.time_max = cstate.time_max;
+  if(m_state.vname == "")
+    m_state.vname = cstate.vname;
+  if(m_state.vtype == "") {
+    if(cstate.vcolor != "")
+      m_state.vcolor = cstate.vcolor;
+    if(cstate.vlength != "")
+      m_state.vlength = cstate.vlength;
+    m_state.vtype = cstate.vtype;
+  }
+  if(cstate.iter_known)
+    m_state.curr_helm_iter = cstate.curr_helm_iter;
 
+  m_state.bhv_names.insert(cstate.bhv_names.begin(), cstate.bhv_names.end());
+  m_state.applogging_app_names.insert(cstate.applogging_app_names.begin(),
+				      cstate.applogging_app_names.end());
+
+  map<string, string>::iterator p;
+  for(p=cstate.var_type.begin(); p!=cstate.var_type.end(); p++) {
+    string& vartype = m_state.var_type[p->first];
+    if(vartype != "string")
+      vartype = p->second;
+  }
+
+  map<string, set<string> >::iterator q;
+  for(q=cstate.var_srcs.begin(); q!=cstate.var_srcs.end(); q++)
+    m_state.var_srcs[q->first].insert(q->second.begin(), q->second.end());
+
+  // New klog variables are handed to the writers in turn
+  map<string, string>::iterator r;
+  for(r=chunk.out.begin(); r!=chunk.out.end(); r++) {
+    if(m_var_writer.count(r->first) != 0)
+      continue;
+    unsigned int writer_ix = m_var_writer.size() % m_writers.size();
+    m_var_writer[r->first] = writer_ix;
+    m_writers[writer_ix].varnames.push_back(r->first);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: writeChunks()
+//   Purpose: Append the lines gathered in the chunks, in chunk
+//            order, to each of the klog files of the writer.
+
+void SplitHandler::writeChunks(SplitWriter& writer,
+			       const vector<SplitChunk*>& chunks)
+{
+  for(unsigned int i=0; i<writer.varnames.size(); i++) {
+    const string& varname = writer.varnames[i];
+
+    bool  cached_file_ptr = false;
+    FILE *file_ptr = 0;
+    map<string, FILE*>::iterator p = writer.file_ptr.find(varname);
+    if(p != writer.file_ptr.end()) {
+      file_ptr = p->second;
+      cached_file_ptr = true;
+    }
+    
+    for(unsigned int j=0; j<chunks.size(); j++) {
+      map<string, string>::const_iterator q = chunks[j]->out.find(varname);
+      if(q == chunks[j]->out.end())
+	continue;
+
+      if(!file_ptr) {
+	string new_file = m_basedir + "/" + varname + ".klog"; 
+	errno = 0;
+	file_ptr = fopen(new_file.c_str(), "a");
+	if(!file_ptr) {
+	  writer.error = "Unable to open new file for VarName: [[" +
+	    varname + "]]\n full filename: [[" + new_file + "]]\nError: " +
+	    intToString(errno);
+	  return;
+	}
+	bool vip = (m_vip_cache.count(varname) != 0);
+	if(vip || (writer.file_ptr.size() <= writer.max_cache)) {
+	  writer.file_ptr[varname] = file_ptr;
+	  cached_file_ptr = true;
+	}
+	else
+	  writer.max_cache_exceeded = true;
+      }
+      fwrite(q->second.data(), 1, q->second.size(), file_ptr);
+    }
+
+    if(file_ptr && !cached_file_ptr)
+      fclose(file_ptr);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: splitLine()
+//   Purpose: Handle one line of the alog file. With no chunk, the
+//            line goes straight to its klog file. Otherwise it is
+//            gathered in the chunk, with the chunk's own state.
+//      Note: With a chunk, may be run on several threads at once,
+//            each with its own chunk. Nothing of the handler is
+//            changed, or printed, in that case.
+//   Returns: false if a klog file could not be written
+
+bool SplitHandler::splitLine(string line_raw, SplitChunk *chunk)
+{
+  SplitState& state = chunk ? chunk->state : m_state;
+  bool verbose = m_verbose && !chunk;
+  
+  //cout << "line: [" << line_raw << "]" << endl;
+  // Check if the line has the timestamp
+  if((state.logstart.length() == 0) && strContains(line_raw, "LOGSTART")) {
+    line_raw = findReplace(line_raw, "LOGSTART", "X");
+    biteStringX(line_raw, 'X');
+    state.logstart = line_raw;
+    state.logstart_taken = true;
+    return(true);
+  }
+  // Check if the line is a comment
+  if((line_raw.length() > 0) && (line_raw.at(0) == '%'))
+    return(true);
+
+  // Otherwise handle a normal line
+  string varname = getVarName(line_raw);
+
+  // Replace slashes in variable names - filesystems get confused
+  varname = findReplace(varname, "/", "_");
+    
+  // Reject any line that doesn't begin with a number
+  string one_char = line_raw.substr(0,1);
+  if(!isNumber(one_char) || (varname=="DB_VARSUMMARY"))
+    return(true);
+
+  string tstamp = getTimeStamp(line_raw);
+  if(state.time_min == "")
+    state.time_min = tstamp;
+  state.time_max = tstamp;
+
+  if((varname=="VIEW_POINT")   || (varname=="VIEW_POLYGON") ||
+     (varname=="VIEW_SEGLIST") || (varname=="VIEW_CIRCLE")  ||
+     (varname=="GRID_INIT")    || (varname=="VIEW_MARKER")  ||
+     (varname=="GRID_DELTA")   || (varname=="VIEW_SEGLR")   ||
+     (varname=="VIEW_ARROW")   || 
+     (varname=="VIEW_RANGE_PULSE")  ||
+     (varname=="VIEW_COMMS_PULSE"))
+    varname = "VISUALS";
+
+  // A measure implemented here to accommodate older alogfile formats where
+  // the behavior name in BHV_IPF is foobar1234 where 1234 is the helm 
+  // iteration. In Release 15.4 , the format it foobar^1234. If the separator
+  // is not found, we look to see if the behavior name ends with the current
+  // helm iteration, and remove it. Luckily the current helm iteration is 
+  // apparently reliably logged before the BHV_IPF. So we note it here to
+  // apply this measure. Bit of a hack, but should be not needed once the
+  // newer format (with the '^' separator) is more widely adopted.
+  if(varname == "IVPHELM_ITER") {
+    string sval = getDataEntry(line_raw);
+    string iter = biteString(sval, '.');
+    state.curr_helm_iter = iter;
+    state.iter_known = true;
+  }
+
+  // Handle BHV_IPF: Break out into sep files for each behavior
+  // P,waypt_return^445,1,1,H,16,445:waypt_return,2,35,1,100,D,
+  if(varname == "BHV_IPF") {
+    string sval = getDataEntry(line_raw);       
+    biteString(sval, ',');                   
+    string bhv_name  = biteString(sval, ',');      
+    if(strContains(bhv_name, '^'))
+      bhv_name = biteString(bhv_name, '^');
+    else if(!state.iter_known)
+      state.iter_needed = true;  // Chunk will be split again
+    else
+      bhv_name = findReplace(bhv_name, state.curr_helm_iter, "");
+    varname = "BHV_IPF_" + bhv_name; 
+    state.bhv_names.insert(bhv_name);
+  }
+
+  // Handle APP_LOG: Break out into sep files for each MOOSApp
+  if(varname == "APP_LOG") {
+    string src = getSourceName(line_raw);       
+    varname = "APP_LOG_" + src; 
+    state.applogging_app_names.insert(src);
+  }
+
+  // Part 1: Determine the vehicle name if not already known
+  // Typically the MOOSDB automatically names itself MOOSDB_COMMUNITY, 
+  // For example, MOOSDB_alpha. DB_TIME is published by the MOOSDB.
+  if((state.vname.length() == 0) && (varname == "DB_TIME")) {
+    string var_src = getSourceName(line_raw);
+    biteString(var_src, '_');
+    state.vname = var_src;
+  }
+
+  if((state.vtype.length() == 0) &&
+     ((varname == "NODE_REPORT_LOCAL") ||
+      (varname == "NODE_REPORT_LOCAL_FIRST"))) {
+
+    string sval    = tolower(getDataEntry(line_raw));
+    string vtype   = tokStringParse(sval, "type", ',', '=');      
+    string vcolor  = tokStringParse(sval, "color", ',', '=');      
+    string vlength = tokStringParse(sval, "length", ',', '=');      
+    if(vtype != "")
+      state.vtype   = vtype;
+    if(vcolor != "")
+      state.vcolor   = vcolor;
+    if(vlength != "")
+      state.vlength = vlength;
+  }
+
+  // Part 1P5: If this variable is a DETACHED variable
+  // Example:
+  //    APP_OVERVIEW = "temp=98.5,fuel=14.5,age=11.9,errs=11"
+  // 
+  // --detach=APP_OVERVIEW:fuel
+  //
+  // Would create a klog file as if the variable APP_OVERVIEW:FUEL
+  // were originally in the alog file
+
+  set<string> dkeys = detachedSet(varname); // detached key, e.g., fuel
+  if(dkeys.size() != 0) {
+    string sval = tolower(stripBlankEnds(getDataEntry(line_raw)));
+    // If datafield is string in JSON format, convert to CSP format
+    if(isBraced(sval))
+      sval = jsonToCsp(sval);
+
+    if(dkeys.count("all") != 0) {
+      dkeys = tokStringAll(sval);
+    }      
+
+    set<string>::iterator p;
+    for(p=dkeys.begin(); p!=dkeys.end(); p++) {
+      string dkey = *p;
+      if(verbose)
+	cout << "Handling Detached: var: " << varname << ", dkey:"
+	     << dkey << endl;
+
+      string dval = tokStringParse(sval, tolower(dkey));
+      if(verbose)
+	cout << "sval:" << sval << ", dval:" << dval << endl;
+
+      if(isNumber(dval)) {
+	string varname_aug = varname;
+	string timestamp = getTimeStamp(line_raw);
+	string src_name = getSourceName(line_raw);
+	varname_aug += ":" + toupper(dkey);
+	line_raw = timestamp + "  " + varname_aug;
+	line_raw += "  " + src_name + "  " + dval;
+	if(verbose)
+	  cout << "newline:" << line_raw << endl;
+	bool ok = outputLine(varname_aug, line_raw, chunk);
+	if(!ok)
+	  break;
+      }	
+    }
+  }
+  // Now handled the full original line with no detachements
+  return(outputLine(varname, line_raw, chunk));
+}
+
+//--------------------------------------------------------
+// Procedure: outputLine()
+//   Purpose: Write the line to its klog file, or with a chunk, add
+//            it to the lines gathered for the klog file. And note
+//            the type and source of the variable.
+
+bool SplitHandler::outputLine(const string& varname, const string& line_raw,
+			      SplitChunk *chunk)
+{
+  SplitState& state = chunk ? chunk->state : m_state;
+  if(chunk) {
+    string& out = chunk->out[varname];
+    out += line_raw;
+    out += '\n';
+  }
+  else if(!handleSplitLine(varname, line_raw))
+    return(false);
+    
+  // ===============================================================
+  // Part 1: Update the type information
+  // ===============================================================
+  if(state.var_type[varname] != "string") {
+    string vardata = getDataEntry(line_raw);
+    if(!isNumber(vardata))
+      state.var_type[varname] = "string";
+    else
+      state.var_type[varname] = "double";
+  }
+
+  // ===============================================================
+  // Part 2: Update the source information
+  // ===============================================================
+  string varsrc = getSourceNameNoAux(line_raw);
+  state.var_srcs[varname].insert(varsrc);
   return(true);
 }
 
@@ -401,24 +752,7 @@ bool SplitHandler::handleSplitLine(const std::string& varname,
   }
   
   // ===============================================================
-  // Part 3: Update the type information
-  // ===============================================================
-  if(m_var_type[varname] != "string") {
-    string vardata = getDataEntry(line_raw);
-    if(!isNumber(vardata))
-      m_var_type[varname] = "string";
-    else
-      m_var_type[varname] = "double";
-  }
-
-  // ===============================================================
-  // Part 4: Update the source information
-  // ===============================================================
-  string varsrc = getSourceNameNoAux(line_raw);
-  m_var_srcs[varname].insert(varsrc);
-  
-  // ===============================================================
-  // Part 5: Write the line to the appropriate file
+  // Part 2: Write the line to the appropriate file
   // ===============================================================
   fprintf(file_ptr, "%s\n", line_raw.c_str());
   if(!cached_file_ptr)
@@ -437,36 +771,36 @@ bool SplitHandler::handleMakeSplitSummary()
   if(!f) 
     return(false);
 
-  string total_vars = uintToString(m_var_type.size());
+  string total_vars = uintToString(m_state.var_type.size());
   fprintf(f, "total_vars=%s\n", total_vars.c_str());
 
-  fprintf(f, "logstart=%s\n", m_logstart.c_str());
-  fprintf(f, "logtmin=%s\n", m_time_min.c_str());
-  fprintf(f, "logtmax=%s\n", m_time_max.c_str());
-  fprintf(f, "vname=%s\n", m_vname.c_str());
-  if(m_vtype != "")
-    fprintf(f, "vtype=%s\n", m_vtype.c_str());
-  if(m_vcolor != "")
-    fprintf(f, "vcolor=%s\n", m_vcolor.c_str());
-  if(m_vlength != "")
-    fprintf(f, "vlength=%s\n", m_vlength.c_str());
-
-  if(m_bhv_names.size() != 0) {
-    string bhvs = stringSetToString(m_bhv_names);
+  fprintf(f, "logstart=%s\n", m_state.logstart.c_str());
+  fprintf(f, "logtmin=%s\n", m_state.time_min.c_str());
+  fprintf(f, "logtmax=%s\n", m_state.time_max.c_str());
+  fprintf(f, "vname=%s\n", m_state.vname.c_str());
+  if(m_state.vtype != "")
+    fprintf(f, "vtype=%s\n", m_state.vtype.c_str());
+  if(m_state.vcolor != "")
+    fprintf(f, "vcolor=%s\n", m_state.vcolor.c_str());
+  if(m_state.vlength != "")
+    fprintf(f, "vlength=%s\n", m_state.vlength.c_str());
+
+  if(m_state.bhv_names.size() != 0) {
+    string bhvs = stringSetToString(m_state.bhv_names);
     fprintf(f, "bhvs=%s\n", bhvs.c_str());
   }
 
-  if(m_applogging_app_names.size() != 0) {
-    string apps = stringSetToString(m_applogging_app_names);
+  if(m_state.applogging_app_names.size() != 0) {
+    string apps = stringSetToString(m_state.applogging_app_names);
     fprintf(f, "applogging_apps=%s\n", apps.c_str());
   }
 
   map<string, string>::iterator p;
-  for(p=m_var_type.begin(); p!=m_var_type.end(); p++) {
+  for(p=m_state.var_type.begin(); p!=m_state.var_type.end(); p++) {
     string varname = p->first;
     string vartype = p->second;
 
-    set<string> srcs = m_var_srcs[varname];
+    set<string> srcs = m_state.var_srcs[varname];
     string str_srcs;
     set<string>::iterator p;
     for(p=srcs.begin(); p!=srcs.end(); p++) {
@@ -487,13 +821,14 @@ bool SplitHandler::handleMakeSplitSummary()
 //--------------------------------------------------------
 // Procedure: detachedSet()
 
-set<string> SplitHandler::detachedSet(string var)
+set<string> SplitHandler::detachedSet(string var) const
 {
   set<string> subvars;
-  if(m_map_dpairs.count(var) == 0)
+  map<string, set<string> >::const_iterator p = m_map_dpairs.find(var);
+  if(p == m_map_dpairs.end())
     return(subvars);
 
-  return(m_map_dpairs[var]);
+  return(p->second);
 }
 
 //--------------------------------------------------------
@@ -614,3 +949,60 @@ bool SplitHandler::handlePreCheckSplitDir()
 
 
 
+
+//--------------------------------------------------------
+// Procedure: findChunkEnds()
+//   Purpose: Find where each chunk of the file ends, just past the
+//            first newline at or after the chunk size, so every
+//            chunk but the last ends with a full line.
+//   Returns: false if the file could not be read
+
+static bool findChunkEnds(const string& filename,
+			  unsigned long long chunk_size,
+			  vector<unsigned long long>& ends)
+{
+  FILE *f = fopen(filename.c_str(), "r");
+  if(!f)
+    return(false);
+
+#ifdef _WIN32
+  _fseeki64(f, 0, SEEK_END);
+  unsigned long long fsize = (unsigned long long)(_ftelli64(f));
+#else
+  fseeko(f, 0, SEEK_END);
+  unsigned long long fsize = (unsigned long long)(ftello(f));
+#endif
+
+  char buff[65536];
+  unsigned long long pos = 0;
+  while(pos < fsize) {
+    unsigned long long end = pos + chunk_size;
+    if(end >= fsize) {
+      ends.push_back(fsize);
+      break;
+    }
+
+    // Look for the newline ending the line the chunk size falls in
+#ifdef _WIN32
+    _fseeki64(f, (__int64)(end - 1), SEEK_SET);
+#else
+    fseeko(f, (off_t)(end - 1), SEEK_SET);
+#endif
+    end = fsize;
+    unsigned long long at = pos + chunk_size - 1;
+    size_t amt = 0;
+    while((amt = fread(buff, 1, sizeof(buff), f)) > 0) {
+      const char *nl = (const char*)(memchr(buff, '\n', amt));
+      if(nl) {
+	end = at + (nl - buff) + 1;
+	break;
+      }
+      at += amt;
+    }
+    ends.push_back(end);
+    pos = end;
+  }
+
+  fclose(f);
+  return(true);
+}
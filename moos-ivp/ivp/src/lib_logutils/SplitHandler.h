@@ -28,6 +28,67 @@
 #include <string>
 #include <map>
 #include <set>
+#include <cstdio>
+
+// Running state of a split, updated line by line. A parallel split
+// keeps one for each chunk of the file, merged in file order.
+
+struct SplitState
+{
+  SplitState() {iter_known=true; iter_needed=false; logstart_taken=false;}
+
+  std::string logstart;
+  std::string time_min;
+  std::string time_max;
+  std::string vname;
+  std::string vtype;
+  std::string vcolor;
+  std::string vlength;
+
+  // A chunk past the first doesn't know the helm iteration at its
+  // start, or if the LOGSTART line has already been seen. If either
+  // turns out to matter, the chunk is split again once known.
+  std::string curr_helm_iter;
+  bool        iter_known;
+  bool        iter_needed;
+  bool        logstart_taken;
+  
+  // Each map key is a MOOS variable name
+  std::map<std::string, std::string> var_type;
+  std::map<std::string, std::set<std::string> > var_srcs;
+
+  // Keep track of all unique bhv names for summary file
+  std::set<std::string> bhv_names;
+  // Keep track of all unique apps with applogging for summary file
+  std::set<std::string> applogging_app_names;
+};
+
+// A chunk of the alog file, beginning at a line start and ending
+// just past a newline. The lines for each klog file are gathered
+// in file order, keyed on the klog variable name.
+
+struct SplitChunk
+{
+  unsigned long long begin;
+  unsigned long long end;
+  unsigned long int  lines_read;
+  bool               ok;
+
+  SplitState state;
+  std::map<std::string, std::string> out;
+};
+
+// Writes the gathered lines of a share of the klog files, keeping
+// open at most its share of the file pointers.
+
+struct SplitWriter
+{
+  std::vector<std::string>     varnames;
+  std::map<std::string, FILE*> file_ptr;
+  unsigned int                 max_cache;
+  bool                         max_cache_exceeded;
+  std::string                  error;
+};
 
 class SplitHandler
 {
@@ -40,6 +101,7 @@ class SplitHandler
   void setVerbose(bool v)          {m_verbose=v;}
   void setProgress(bool v)         {m_progress=v;}
   void setDirectory(std::string s) {m_given_dir=s;}
+  void setThreads(unsigned int v)  {m_threads=v;}
   void setMaxFilePtrCache(unsigned int);
   bool addDetachedPair(std::string);
   bool addDetachedPair(std::string, std::string);
@@ -47,13 +109,24 @@ class SplitHandler
  protected:
   bool handlePreCheckSplitDir();
   bool handleMakeSplitFiles();
+  bool handleMakeSplitFilesParallel();
   bool handleMakeSplitSummary();
 
   bool handleSplitLine(const std::string& varname,
 		       const std::string& rawline);
+
+  bool splitLine(std::string line_raw, SplitChunk *chunk=0);
+  bool outputLine(const std::string& varname,
+		  const std::string& line_raw, SplitChunk *chunk);
+
+  void splitChunk(SplitChunk&);
+  void mergeChunk(SplitChunk&);
+  void writeChunks(SplitWriter&, const std::vector<SplitChunk*>&);
+  
+  static void splitJob(unsigned int job_ix, void *param);
   
   std::string detached(std::string varname);
-  std::set<std::string> detachedSet(std::string varname);
+  std::set<std::string> detachedSet(std::string varname) const;
   
  protected: // Config variables
   std::string  m_alog_file;
@@ -61,39 +134,29 @@ class SplitHandler
   bool         m_verbose;
   bool         m_progress;
   unsigned int m_max_cache;
+  unsigned int m_threads;
 
   std::map<std::string, std::string> m_map_detached_pairs;
   std::map<std::string, std::set<std::string> > m_map_dpairs;
   
  protected: // State variables
   std::string m_basedir;
-  std::string m_logstart;
-  std::string m_time_min;
-  std::string m_time_max;
-  std::string m_vname;
-  std::string m_vtype;
-  std::string m_vcolor;
-  std::string m_vlength;
 
   bool m_alog_file_confirmed;
 
   bool m_split_dir_prior;
   bool m_max_cache_exceeded;
   
-  std::string m_curr_helm_iter;
-
   std::set<std::string> m_vip_cache;
   
   // Each map key is a MOOS variable name
-  std::map<std::string, FILE*>       m_file_ptr;
-  std::map<std::string, std::string> m_var_type;
-  std::map<std::string, std::set<std::string> > m_var_srcs;
+  std::map<std::string, FILE*> m_file_ptr;
 
-  // Keep track of all unique bhv names for summary file
-  std::set<std::string> m_bhv_names;
-  // Keep track of all unique apps with applogging for summary file
-  std::set<std::string> m_applogging_app_names;
+  SplitState m_state;
+
+  // Parallel split only: the writer of each klog variable
+  std::vector<SplitWriter>            m_writers;
+  std::map<std::string, unsigned int> m_var_writer;
 };
 
 #endif
-
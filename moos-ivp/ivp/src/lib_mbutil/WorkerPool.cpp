@@ -0,0 +1,221 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: WorkerPool.cpp                                       */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <ctime>
+#include "WorkerPool.h"
+
+using namespace std;
+
+//--------------------------------------------------------------
+// Constructor
+
+WorkerPool::WorkerPool()
+{
+  m_threads    = 1;
+  m_func       = 0;
+  m_param      = 0;
+  m_jobs       = 0;
+  m_next_job   = 0;
+  m_jobs_done  = 0;
+  m_generation = 0;
+  m_quit       = false;
+
+#ifndef _WIN32
+  pthread_mutex_init(&m_mutex, 0);
+  pthread_cond_init(&m_cond_start, 0);
+  pthread_cond_init(&m_cond_done, 0);
+#endif
+}
+
+//--------------------------------------------------------------
+// Destructor
+
+WorkerPool::~WorkerPool()
+{
+  stopThreads();
+
+#ifndef _WIN32
+  pthread_cond_destroy(&m_cond_done);
+  pthread_cond_destroy(&m_cond_start);
+  pthread_mutex_destroy(&m_mutex);
+#endif
+}
+
+//--------------------------------------------------------------
+// Procedure: setThreads()
+//      Note: Zero is treated as one, i.e., the caller does all the
+//            work. If a thread cannot be created the pool carries
+//            on with the threads it has.
+
+void WorkerPool::setThreads(unsigned int threads)
+{
+  if(threads == 0)
+    threads = 1;
+  if(threads == m_threads)
+    return;
+
+  stopThreads();
+  m_threads = 1;
+
+#ifndef _WIN32
+  m_quit = false;
+  for(unsigned int i=1; i<threads; i++) {
+    pthread_t worker;
+    if(pthread_create(&worker, 0, threadMain, this) != 0)
+      break;
+    m_workers.push_back(worker);
+    m_threads++;
+  }
+#endif
+}
+
+//--------------------------------------------------------------
+// Procedure: run()
+//   Purpose: Call func(ix, param) once for each ix in [0,jobs),
+//            spread over the threads of the pool. Returns once all
+//            calls have returned. Jobs may finish in any order.
+
+void WorkerPool::run(JobFunc func, void *param, unsigned int jobs)
+{
+  if(!func || (jobs == 0))
+    return;
+
+#ifndef _WIN32
+  if(!m_workers.empty()) {
+    pthread_mutex_lock(&m_mutex);
+    m_func      = func;
+    m_param     = param;
+    m_jobs      = jobs;
+    m_next_job  = 0;
+    m_jobs_done = 0;
+    m_generation++;
+    pthread_cond_broadcast(&m_cond_start);
+
+    workJobs();
+    while(m_jobs_done < m_jobs)
+      pthread_cond_wait(&m_cond_done, &m_mutex);
+    pthread_mutex_unlock(&m_mutex);
+    return;
+  }
+#endif
+
+  for(unsigned int ix=0; ix<jobs; ix++)
+    func(ix, param);
+}
+
+//--------------------------------------------------------------
+// Procedure: threadCPUTime()
+
+double WorkerPool::threadCPUTime()
+{
+#if !defined(_WIN32) && defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    return((double)(ts.tv_sec) + ((double)(ts.tv_nsec) / 1000000000.0));
+#endif
+  return((double)(clock()) / CLOCKS_PER_SEC);
+}
+
+//--------------------------------------------------------------
+// Procedure: wallTime()
+
+double WorkerPool::wallTime()
+{
+#if !defined(_WIN32) && defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  if(clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+    return((double)(ts.tv_sec) + ((double)(ts.tv_nsec) / 1000000000.0));
+#endif
+  return((double)(time(0)));
+}
+
+//--------------------------------------------------------------
+// Procedure: stopThreads()
+
+void WorkerPool::stopThreads()
+{
+#ifndef _WIN32
+  if(m_workers.empty())
+    return;
+
+  pthread_mutex_lock(&m_mutex);
+  m_quit = true;
+  pthread_cond_broadcast(&m_cond_start);
+  pthread_mutex_unlock(&m_mutex);
+
+  for(unsigned int i=0; i<m_workers.size(); i++)
+    pthread_join(m_workers[i], 0);
+  m_workers.clear();
+#endif
+}
+
+//--------------------------------------------------------------
+// Procedure: workJobs()
+//      Note: Called with the mutex held, which is released only
+//            while a job is being run.
+
+void WorkerPool::workJobs()
+{
+#ifndef _WIN32
+  while(m_next_job < m_jobs) {
+    unsigned int ix    = m_next_job++;
+    JobFunc      func  = m_func;
+    void        *param = m_param;
+
+    pthread_mutex_unlock(&m_mutex);
+    func(ix, param);
+    pthread_mutex_lock(&m_mutex);
+
+    m_jobs_done++;
+    if(m_jobs_done == m_jobs)
+      pthread_cond_broadcast(&m_cond_done);
+  }
+#endif
+}
+
+//--------------------------------------------------------------
+// Procedure: threadMain()
+//      Note: A thread starting after a run has begun waits for the
+//            next run. The run it missed is finished by the others.
+
+void *WorkerPool::threadMain(void *arg)
+{
+#ifndef _WIN32
+  WorkerPool *pool = static_cast<WorkerPool*>(arg);
+
+  pthread_mutex_lock(&pool->m_mutex);
+  unsigned int seen = pool->m_generation;
+  while(true) {
+    while(!pool->m_quit && (pool->m_generation == seen))
+      pthread_cond_wait(&pool->m_cond_start, &pool->m_mutex);
+    if(pool->m_quit)
+      break;
+    seen = pool->m_generation;
+    pool->workJobs();
+  }
+  pthread_mutex_unlock(&pool->m_mutex);
+#endif
+  return(0);
+}
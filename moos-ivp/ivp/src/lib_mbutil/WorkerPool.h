@@ -0,0 +1,94 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: WorkerPool.h                                         */
+/*    DATE: Oct 2026                                             */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+/****************************************************************/
+/* A fixed set of threads kept alive between calls to run(),    */
+/* each taking the next job index until all have been handed    */
+/* out. The calling thread takes jobs as well, and run() does   */
+/* not return until every job has finished. With one thread, or */
+/* on platforms without pthreads, jobs are simply run in order  */
+/* by the caller.                                               */
+/****************************************************************/
+
+#ifndef WORKER_POOL_HEADER
+#define WORKER_POOL_HEADER
+
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+class WorkerPool {
+public:
+  WorkerPool();
+  ~WorkerPool();
+
+  typedef void (*JobFunc)(unsigned int job_ix, void *param);
+
+  // Total threads working on a run, including the caller
+  void         setThreads(unsigned int);
+  unsigned int getThreads() const {return(m_threads);}
+
+  void run(JobFunc, void *param, unsigned int jobs);
+
+  // CPU seconds used so far by the calling thread alone
+  static double threadCPUTime();
+
+  // Seconds on a clock that only moves forward, for wall times
+  static double wallTime();
+
+protected:
+  void stopThreads();
+  void workJobs();
+
+  static void *threadMain(void*);
+
+protected:
+  unsigned int  m_threads;
+
+  // Description of the run in progress
+  JobFunc       m_func;
+  void*         m_param;
+  unsigned int  m_jobs;
+  unsigned int  m_next_job;
+  unsigned int  m_jobs_done;
+  unsigned int  m_generation;
+  bool          m_quit;
+
+#ifndef _WIN32
+  std::vector<pthread_t> m_workers;
+
+  pthread_mutex_t m_mutex;
+  pthread_cond_t  m_cond_start;
+  pthread_cond_t  m_cond_done;
+#endif
+
+private:
+  WorkerPool(const WorkerPool&);
+  const WorkerPool &operator=(const WorkerPool&);
+};
+
+#endif
@@ -26,12 +26,16 @@
 #endif
 
 #include <iostream>
+#include <cstdio>
 #include <string>
 #include "HelmEngine.h"
 #include "MBUtils.h"
 #include "MBTimer.h"
 #include "IO_Utilities.h"
+#include "BuildUtils.h"
+#include "FunctionEncoder.h"
 #include "IvPProblem.h"
+#include "IvPGrid.h"
 #include "BehaviorSet.h"
 
 using namespace std;
@@ -57,6 +61,18 @@ HelmEngine::HelmEngine(IvPDomain g_ivp_domain,
   m_max_loop_time   = 0;
   m_max_solve_time  = 0;
   m_max_create_time = 0;
+
+  m_warm_start = true;
+
+  m_capture_time   = 0;
+  m_capture_prefix = "helm_capture";
+  m_capture_max    = 100;
+  m_capture_count  = 0;
+
+  m_use_cpa_cache = true;
+
+  m_iter_start_time   = 0;
+  m_iter_start_allocs = 0;
 }
 
 //-----------------------------------------------------------
@@ -91,6 +107,9 @@ unsigned long int HelmEngine::size() const
 HelmReport HelmEngine::determineNextDecision(BehaviorSet *bhv_set, 
 					     double curr_time)
 {
+  m_iter_start_time   = WorkerPool::wallTime();
+  m_iter_start_allocs = IvPBox::getHeapBlocks() + IvPGrid::getNodeBlocks();
+
   // Update the HelmEngine member variables
   m_iteration++;
   m_bhv_set     = bhv_set;
@@ -164,6 +183,13 @@ bool HelmEngine::part1_PreliminaryBehaviorSetHandling()
   // spawned behaviors.
   m_bhv_set->setPlatModel(m_pmodel);
 
+  // Engines from the last iteration are for states now past.
+  m_cpa_cache.clear();
+  if(m_use_cpa_cache)
+    m_bhv_set->connectCPACache(&m_cpa_cache);
+  else
+    m_bhv_set->connectCPACache(0);
+
   // Update Modes and add mode_summary to the m_helm_report.
   m_bhv_set->consultModeSet();
   string mode_summary = m_bhv_set->getModeSummary();
@@ -189,6 +215,9 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
   string msgx = "part2_GetFunctionsFromBehaviorSet: fl=" +
     intToString(filter_level); 
   m_helm_report.addMsg(msgx);
+
+  if(m_ipf_pool.getThreads() > 1)
+    return(part2_GetFunctionsInParallel(filter_level));
   
   // get all the objective functions and add time info to helm report
   m_create_timer.start();
@@ -206,111 +235,216 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
       //cout << " Reuse (" << bname << "):" << boolToString(ipf_reuse) << endl;
       //cout << "********************************************" << endl;
       
-      if(newof) {
-	m_total_pcs_formed += (unsigned int)(newof->size());
-	if(m_bhv_set->isBehaviorAGoalBehavior(bhv_ix))
-	  m_helm_report.setActiveGoal(true);
-      }
-      
-      // check if reuse indicated. If so then get previous ipf
-      if(!newof && ipf_reuse) {
-	string bhv_name = m_bhv_set->getDescriptor(bhv_ix);
-	if(m_map_ipfs_prev.count(bhv_name)) {
-	  newof = m_map_ipfs_prev[bhv_name];
-	  m_map_ipfs_prev[bhv_name] = 0; // so it's not deleted 2x
-	  m_total_pcs_cached += (unsigned int)(newof->size());
-	}
-      }
-
-      BehaviorReport bhv_report;
-
       m_ipf_timer.stop();
 
-      // Determine the amt of time the bhv has been in this state
-      // double state_elapsed = m_bhv_set->getStateElapsed(bhv_ix);
-      double state_time_entered = m_bhv_set->getStateTimeEntered(bhv_ix);
-
-      if(!m_bhv_set->stateOK(bhv_ix)) {
-	m_helm_report.setHalted(true);
-	m_helm_report.addMsg("HELM HALTING: Safety Emergency!!!");
-	bool ok;
-	string bhv_error_str = m_info_buffer->sQuery("BHV_ERROR", ok);
-	if(!ok)
-	  bhv_error_str = " - unknown - ";
-	m_helm_report.setHaltMsg("BHV_ERROR: " + bhv_error_str);
+      double of_time = m_ipf_timer.get_float_cpu_time();
+      if(!part2_HandleProducedOF(bhv_ix, newof, bhv_state,
+				 ipf_reuse, of_time)) {
 	m_create_timer.stop();
 	return(false);
       }
+    }
+  }
+  m_create_timer.stop();
+
+  m_helm_report.setUpdateResults(m_bhv_set->getUpdateResults());
+
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: produceOFJob()
+//      Note: Run on a thread of the pool, one call per behavior.
+//            Results go only into the job's own slot.
+
+struct ProducedOF {
+  unsigned int   bhv_ix;
+  IvPFunction   *ipf;
+  string         bhv_state;
+  bool           ipf_reuse;
+  double         cpu_time;
+  vector<string> update_results;
+};
+
+struct ProduceOFJobs {
+  BehaviorSet        *bhv_set;
+  unsigned int        iteration;
+  vector<ProducedOF> *slots;
+};
+
+static void produceOFJob(unsigned int job_ix, void *param)
+{
+  ProduceOFJobs *jobs = static_cast<ProduceOFJobs*>(param);
+  ProducedOF&    slot = (*(jobs->slots))[job_ix];
+
+  double start_time = WorkerPool::threadCPUTime();
+  slot.ipf = jobs->bhv_set->produceOF(slot.bhv_ix, jobs->iteration,
+				      slot.bhv_state, slot.ipf_reuse,
+				      slot.update_results);
+  slot.cpu_time = WorkerPool::threadCPUTime() - start_time;
+}
+
+//------------------------------------------------------------------
+// Procedure: part2_GetFunctionsInParallel()
+//   Purpose: Same as part2_GetFunctionsFromBehaviorSet() but with
+//            the behaviors of this filter level building their IvP
+//            functions concurrently on the threads of m_ipf_pool.
+//      Note: Behaviors only read the info buffer and ledger snap,
+//            neither of which change during this part, and post
+//            messages to their own buffers. Everything else is
+//            done afterwards in behavior order, so the helm report
+//            and update results are as they would be sequentially.
+//      Note: A halting behavior stops the handling of behaviors 
+//            after it, but they will have run by then. Their IvP
+//            functions are discarded.
+
+bool HelmEngine::part2_GetFunctionsInParallel(int filter_level)
+{
+  vector<ProducedOF> slots;
+  unsigned int bhv_ix, bhv_cnt = m_bhv_set->size();
+  for(bhv_ix=0; bhv_ix<bhv_cnt; bhv_ix++) {
+    if(m_bhv_set->getFilterLevel(bhv_ix) == filter_level) {
+      ProducedOF slot;
+      slot.bhv_ix    = bhv_ix;
+      slot.ipf       = 0;
+      slot.ipf_reuse = false;
+      slot.cpu_time  = 0;
+      slots.push_back(slot);
+    }
+  }
+
+  ProduceOFJobs jobs;
+  jobs.bhv_set   = m_bhv_set;
+  jobs.iteration = m_iteration;
+  jobs.slots     = &slots;
+
+  m_create_timer.start();
+  m_ipf_pool.run(produceOFJob, &jobs, slots.size());
+
+  bool ok = true;
+  for(unsigned int i=0; i<slots.size(); i++) {
+    if(!ok) {
+      delete(slots[i].ipf);
+      continue;
+    }
+    m_bhv_set->addUpdateResults(slots[i].update_results);
+    ok = part2_HandleProducedOF(slots[i].bhv_ix, slots[i].ipf,
+				slots[i].bhv_state, slots[i].ipf_reuse,
+				slots[i].cpu_time);
+  }
+  m_create_timer.stop();
+  if(!ok)
+    return(false);
+
+  m_helm_report.setUpdateResults(m_bhv_set->getUpdateResults());
+
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: part2_HandleProducedOF()
+//   Purpose: Note in the helm report, and in m_map_ipfs, the result
+//            of the given behavior producing its IvP function.
+//   Returns: false if the behavior has halted the helm.
+
+bool HelmEngine::part2_HandleProducedOF(unsigned int bhv_ix,
+					IvPFunction *newof,
+					const string& bhv_state,
+					bool ipf_reuse, double of_time)
+{
+  if(newof) {
+    m_total_pcs_formed += (unsigned int)(newof->size());
+    if(m_bhv_set->isBehaviorAGoalBehavior(bhv_ix))
+      m_helm_report.setActiveGoal(true);
+  }
       
-      string upd_summary = m_bhv_set->getUpdateSummary(bhv_ix);
-      string descriptor  = m_bhv_set->getDescriptor(bhv_ix);
+  // check if reuse indicated. If so then get previous ipf
+  if(!newof && ipf_reuse) {
+    string bhv_name = m_bhv_set->getDescriptor(bhv_ix);
+    if(m_map_ipfs_prev.count(bhv_name)) {
+      newof = m_map_ipfs_prev[bhv_name];
+      m_map_ipfs_prev[bhv_name] = 0; // so it's not deleted 2x
+      m_total_pcs_cached += (unsigned int)(newof->size());
+    }
+  }
+
+  BehaviorReport bhv_report;
+
+  // Determine the amt of time the bhv has been in this state
+  // double state_elapsed = m_bhv_set->getStateElapsed(bhv_ix);
+  double state_time_entered = m_bhv_set->getStateTimeEntered(bhv_ix);
+
+  if(!m_bhv_set->stateOK(bhv_ix)) {
+    m_helm_report.setHalted(true);
+    m_helm_report.addMsg("HELM HALTING: Safety Emergency!!!");
+    bool ok;
+    string bhv_error_str = m_info_buffer->sQuery("BHV_ERROR", ok);
+    if(!ok)
+      bhv_error_str = " - unknown - ";
+    m_helm_report.setHaltMsg("BHV_ERROR: " + bhv_error_str);
+    return(false);
+  }
+      
+  string upd_summary = m_bhv_set->getUpdateSummary(bhv_ix);
+  string descriptor  = m_bhv_set->getDescriptor(bhv_ix);
       
 #if 0 // mikerb jan 2016
-      string msgk = descriptor + ", state=" + bhv_state;
-      m_helm_report.addMsg(msgk);
+  string msgk = descriptor + ", state=" + bhv_state;
+  m_helm_report.addMsg(msgk);
 #endif
       
-      string report_line = descriptor;
-      if(!bhv_report.isEmpty()) {
-	double of_time  = m_ipf_timer.get_float_cpu_time();
-	double pieces   = bhv_report.getAvgPieces();
-	double pwt      = bhv_report.getPriority();
-	string timestr  = doubleToString(of_time,2);
-	report_line += " produces obj-function - time:" + timestr;
-	report_line += " pcs: " + doubleToString(pieces);
-	report_line += " pwt: " + doubleToString(pwt);
-      }
+  string report_line = descriptor;
+  if(!bhv_report.isEmpty()) {
+    double pieces   = bhv_report.getAvgPieces();
+    double pwt      = bhv_report.getPriority();
+    string timestr  = doubleToString(of_time,2);
+    report_line += " produces obj-function - time:" + timestr;
+    report_line += " pcs: " + doubleToString(pieces);
+    report_line += " pwt: " + doubleToString(pwt);
+  }
 
-      if(newof) {
-	double of_time  = m_ipf_timer.get_float_cpu_time();
-	int    pieces   = newof->size();
-	string timestr  = doubleToString(of_time,2);
-	report_line += " produces obj-function - time:" + timestr;
-	report_line += " pcs: " + doubleToString(pieces);
-	report_line += " pwt: " + doubleToString(newof->getPWT());
-      }
-      else
-	report_line += " did NOT produce an obj-function";
-      m_helm_report.addMsg(report_line);
+  if(newof) {
+    int    pieces   = newof->size();
+    string timestr  = doubleToString(of_time,2);
+    report_line += " produces obj-function - time:" + timestr;
+    report_line += " pcs: " + doubleToString(pieces);
+    report_line += " pwt: " + doubleToString(newof->getPWT());
+  }
+  else
+    report_line += " did NOT produce an obj-function";
+  m_helm_report.addMsg(report_line);
       
-      if(newof) {
-	double of_time  = m_ipf_timer.get_float_cpu_time();
-	double pwt = newof->getPWT();
-	int    pcs = newof->size();
+  if(newof) {
+    double pwt = newof->getPWT();
+    int    pcs = newof->size();
 
-	string mode = m_bhv_set->getBehaviorMode(bhv_ix);
-	string submode = m_bhv_set->getBehaviorSubMode(bhv_ix);
+    string mode = m_bhv_set->getBehaviorMode(bhv_ix);
+    string submode = m_bhv_set->getBehaviorSubMode(bhv_ix);
 	
-	m_helm_report.addActiveBHV(descriptor, state_time_entered, pwt,
-				   pcs, of_time, upd_summary, 1,
-				   mode, submode);
-	//m_ivp_functions.push_back(newof);
-	m_map_ipfs[descriptor] = newof;
-      }
+    m_helm_report.addActiveBHV(descriptor, state_time_entered, pwt,
+			       pcs, of_time, upd_summary, 1,
+			       mode, submode);
+    //m_ivp_functions.push_back(newof);
+    m_map_ipfs[descriptor] = newof;
+  }
 
-      if(bhv_state=="disabled")
-	m_helm_report.addDisabledBHV(descriptor, state_time_entered, 
-				    upd_summary);
-      if(bhv_state=="running")
-	m_helm_report.addRunningBHV(descriptor, state_time_entered, 
-				    upd_summary);
-      if(bhv_state=="idle")
-	m_helm_report.addIdleBHV(descriptor, state_time_entered, 
+  if(bhv_state=="disabled")
+    m_helm_report.addDisabledBHV(descriptor, state_time_entered, 
 				 upd_summary);
-      if(bhv_state=="completed") {
-	m_helm_report.addCompletedBHV(descriptor, state_time_entered,
-				      upd_summary);
-	//cout << "****** completed: " << descriptor << endl;
-	//cout << "****** hr_cbhvs: " << m_helm_report.getCompletedCnt() << endl;
-	m_helm_report.addMsg("executing setCompletedPending:true");
-	m_bhv_set->setCompletedPending(true);
-      }
-    }
+  if(bhv_state=="running")
+    m_helm_report.addRunningBHV(descriptor, state_time_entered, 
+				upd_summary);
+  if(bhv_state=="idle")
+    m_helm_report.addIdleBHV(descriptor, state_time_entered, 
+			     upd_summary);
+  if(bhv_state=="completed") {
+    m_helm_report.addCompletedBHV(descriptor, state_time_entered,
+				  upd_summary);
+    //cout << "****** completed: " << descriptor << endl;
+    //cout << "****** hr_cbhvs: " << m_helm_report.getCompletedCnt() << endl;
+    m_helm_report.addMsg("executing setCompletedPending:true");
+    m_bhv_set->setCompletedPending(true);
   }
-  m_create_timer.stop();
-
-  m_helm_report.setUpdateResults(m_bhv_set->getUpdateResults());
-
   return(true);
 }
 
@@ -439,6 +573,7 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
   m_ivp_problem = new IvPProblem;
   m_ivp_problem->setOwnerIPFs(false);
   m_solve_timer.start();
+  double solve_start = WorkerPool::threadCPUTime();
   map<string, IvPFunction*>::iterator p;
   for(p=m_map_ipfs.begin(); p!=m_map_ipfs.end(); p++) {
     if(p->second != 0)
@@ -446,15 +581,33 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
   }
   m_ivp_problem->setDomain(m_sub_domain);
   m_ivp_problem->alignOFs();
-  m_ivp_problem->solve();
+
+  // The previous decision is usually close to this one, so it is
+  // given to the solver as a bound to prune with from the start.
+  // It does not change the decision reached.
+  IvPBox warm_box;
+  if(m_warm_start && buildWarmStartBox(warm_box)) {
+    m_ivp_problem->setWarmStart(true);
+    m_ivp_problem->solve(&warm_box);
+  }
+  else
+    m_ivp_problem->solve();
   m_solve_timer.stop();
+  double solve_time = WorkerPool::threadCPUTime() - solve_start;
   
+  if(phase != "prefilter")
+    m_prev_decision.clear();
+
   unsigned int dsize = m_sub_domain.size();
   for(unsigned int i=0; i<dsize; i++) {
     string dom_name = m_sub_domain.getVarName(i);
-    double decision = m_ivp_problem->getResult(dom_name);
+    bool   ok = false;
+    double decision = m_ivp_problem->getResult(dom_name, &ok);
     string post_str = "DESIRED_" + toupper(dom_name);
 
+    if(ok && (phase != "prefilter"))
+      m_prev_decision[dom_name] = decision;
+
     // Add the decision to the report and a message for output  
     if(phase == "prefilter")
       m_info_buffer->setValue((post_str + "_UNFILTERED"), decision);
@@ -463,6 +616,9 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
       m_helm_report.addMsg(post_str+": " + doubleToString(decision,2));
     }
   }    
+
+  if((m_capture_time > 0) && (solve_time >= m_capture_time))
+    captureProblem(phase, solve_time);
   
   if(phase == "prefilter")
     m_ivp_problem->setOwnerIPFs(false);
@@ -473,6 +629,90 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
   return(true);
 }
 
+//------------------------------------------------------------------
+// Procedure: buildWarmStartBox()
+//   Purpose: Build the point box in m_sub_domain of the previous
+//            decision. Returns false if the previous decision did
+//            not cover every variable of the domain.
+
+bool HelmEngine::buildWarmStartBox(IvPBox& box) const
+{
+  unsigned int dsize = m_sub_domain.size();
+  if(dsize == 0)
+    return(false);
+
+  IvPBox pt_box(dsize);
+  for(unsigned int i=0; i<dsize; i++) {
+    string dom_name = m_sub_domain.getVarName(i);
+    map<string, double>::const_iterator p = m_prev_decision.find(dom_name);
+    if(p == m_prev_decision.end())
+      return(false);
+    int ix = (int)(m_sub_domain.getDiscreteVal(i, p->second, 2));
+    pt_box.setPTS(i, ix, ix);
+    pt_box.setBDS(i, true, true);
+  }
+  box = pt_box;
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: captureProblem()
+//   Purpose: Write the problem just solved to a file, in the form
+//            read by PopulatorIPP, so it may be solved again off
+//            line, e.g., by ivpreplay. The file is named by the
+//            iteration, and the decision and solve time are noted.
+//      Note: The functions are written as given to the solver, 
+//            normalized and weighted, and marked as such so they
+//            are not weighted again when read.
+
+bool HelmEngine::captureProblem(const string& phase, double solve_time)
+{
+  if(!m_ivp_problem || (m_capture_count >= m_capture_max))
+    return(false);
+
+  string filename = m_capture_prefix + "_" + uintToString(m_iteration);
+  if(phase == "prefilter")
+    filename += "_prefilter";
+  filename += ".ipp";
+
+  FILE *f = fopen(filename.c_str(), "w");
+  if(!f)
+    return(false);
+  m_capture_count++;
+
+  string decision;
+  for(unsigned int i=0; i<m_sub_domain.size(); i++) {
+    string dom_name = m_sub_domain.getVarName(i);
+    bool   ok = false;
+    double val = m_ivp_problem->getResult(dom_name, &ok);
+    if(!ok)
+      continue;
+    if(decision != "")
+      decision += ",";
+    decision += dom_name + "=" + doubleToStringX(val, 6);
+  }
+
+  fprintf(f, "// Captured by pHelmIvP at iteration %u (%s)\n",
+	  m_iteration, phase.c_str());
+  fprintf(f, "solve_time = %s\n", doubleToStringX(solve_time, 6).c_str());
+  if(decision != "")
+    fprintf(f, "decision = %s\n", decision.c_str());
+  fprintf(f, "domain = %s\n", domainToString(m_sub_domain).c_str());
+
+  map<string, IvPFunction*>::iterator p;
+  for(p=m_map_ipfs.begin(); p!=m_map_ipfs.end(); p++) {
+    IvPFunction *ipf = p->second;
+    if(!ipf)
+      continue;
+    string key = "ipf";
+    if(ipf->isWeighted())
+      key = "ipf_weighted";
+    fprintf(f, "%s = %s\n", key.c_str(), IvPFunctionToString(ipf).c_str());
+  }
+  fclose(f);
+  return(true);
+}
+
 //------------------------------------------------------------------
 // Procedure: part5_FreeMemoryIPFs()
 
@@ -503,9 +743,14 @@ bool HelmEngine::part6_FinishHelmReport()
   double create_time = m_create_timer.get_float_cpu_time();
   double solve_time  = m_solve_timer.get_float_cpu_time();
   double loop_time = create_time + solve_time;
+
+  // With behaviors run in parallel the CPU time is summed over all
+  // threads, so the wall time is reported alongside it.
+  double create_wall_time = m_create_timer.get_float_wall_time();
   m_create_timer.reset();
   m_solve_timer.reset();
   m_helm_report.setCreateTime(create_time);
+  m_helm_report.setCreateWallTime(create_wall_time);
   m_helm_report.setSolveTime(solve_time);
 
   if(create_time > m_max_create_time)
@@ -520,8 +765,17 @@ bool HelmEngine::part6_FinishHelmReport()
   m_helm_report.setMaxLoopTime(m_max_loop_time);
   m_helm_report.setTotalPcsFormed(m_total_pcs_formed);
   m_helm_report.setTotalPcsCached(m_total_pcs_cached);
+  m_helm_report.setCPACacheHits(m_cpa_cache.getHits());
+  m_helm_report.setCPACacheMisses(m_cpa_cache.getMisses());
+
+  // The iteration is taken to end here, with the functions of the
+  // previous iteration freed, before the report is handed back.
+  unsigned long allocs = IvPBox::getHeapBlocks() + IvPGrid::getNodeBlocks();
+  m_helm_report.setIterAllocs(allocs - m_iter_start_allocs);
+  m_helm_report.setIterWallTime(WorkerPool::wallTime() - m_iter_start_time);
 
   m_total_pcs_formed = 0;
+  m_cpa_cache.resetCounts();
   m_total_pcs_cached = 0;
   
   return(true);
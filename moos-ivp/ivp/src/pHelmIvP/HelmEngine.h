@@ -30,6 +30,8 @@
 #include "IvPDomain.h"
 #include "HelmReport.h"
 #include "MBTimer.h"
+#include "WorkerPool.h"
+#include "CPAEngineCache.h"
 #include "PlatModelGenerator.h"
 #include "PlatModel.h"
 #include "LedgerSnap.h"
@@ -47,6 +49,12 @@ public:
 
   void setBehaviorSet(BehaviorSet *bset) {m_bhv_set=bset;}
   void setPlatModel(const PlatModel& pm) {m_pmodel=pm;}
+  void setIPFThreads(unsigned int v)     {m_ipf_pool.setThreads(v);}
+  void setWarmStart(bool v)              {m_warm_start=v;}
+  void setCaptureSolveTime(double v)     {m_capture_time=v;}
+  void setCapturePrefix(std::string s)   {m_capture_prefix=s;}
+  void setCaptureMax(unsigned int v)     {m_capture_max=v;}
+  void setCPACache(bool v)               {m_use_cpa_cache=v;}
   HelmReport determineNextDecision(BehaviorSet *bset, double curr_time);
   bool addAbleFilterMsg(std::string);
   bool applyAbleFilterMsgs();
@@ -58,11 +66,18 @@ protected:
 
   bool   part1_PreliminaryBehaviorSetHandling();
   bool   part2_GetFunctionsFromBehaviorSet(int filter_level);
+  bool   part2_GetFunctionsInParallel(int filter_level);
+  bool   part2_HandleProducedOF(unsigned int bhv_ix, IvPFunction*,
+				const std::string& bhv_state,
+				bool ipf_reuse, double of_time);
   bool   part3_VerifyFunctionDomains();
   bool   part4_BuildAndSolveIvPProblem(std::string phase="direct");
   bool   part5_FreeMemoryIPFs();
   bool   part6_FinishHelmReport();
 
+  bool   buildWarmStartBox(IvPBox&) const;
+  bool   captureProblem(const std::string& phase, double solve_time);
+
 protected:
   IvPDomain  m_ivp_domain;
   IvPDomain  m_sub_domain;
@@ -89,6 +104,29 @@ protected:
   MBTimer  m_create_timer;
   MBTimer  m_ipf_timer;
   MBTimer  m_solve_timer;
+
+  // Threads building IvP functions, if more than one
+  WorkerPool m_ipf_pool;
+
+  // Previous decision, given to the solver as a starting bound
+  bool  m_warm_start;
+  std::map<std::string, double> m_prev_decision;
+
+  // Problems taking longer than the capture time to solve are
+  // written to file for replay. Zero for none.
+  double       m_capture_time;
+  std::string  m_capture_prefix;
+  unsigned int m_capture_max;
+  unsigned int m_capture_count;
+
+  // CPA engines shared by contact behaviors within an iteration
+  bool           m_use_cpa_cache;
+  CPAEngineCache m_cpa_cache;
+
+  // Wall time of the whole iteration, and the IvPBox and IvPGrid
+  // heap blocks taken in it, counted by the boxes and grids
+  double         m_iter_start_time;
+  unsigned long  m_iter_start_allocs;
 };
 
 #endif
@@ -100,6 +100,8 @@ HelmIvP::HelmIvP()
   m_nav_started = false;
   m_nav_grace = 5;
 
+  m_ipf_threads = 1;
+
   // The refresh vars handle the occasional clearing of the m_outgoing
   // maps. These maps will be cleared when MOOS mail is received for the
   // variable given by m_refresh_var. The user can set minimum interval
@@ -1266,6 +1268,20 @@ bool HelmIvP::OnStartUp()
   
   // default secs to remove stale contact behavior
   double contact_max_age = 45; 
+
+  // by default the previous decision is a starting bound for solving
+  bool warm_start = true;
+
+  // by default contact behaviors share CPA engines each iteration
+  bool cpa_cache = true;
+
+  // by default no slow problems are captured to file
+  double       capture_solve_time = 0;
+  string       capture_prefix = "helm_capture";
+  unsigned int capture_max = 100;
+
+  // by default IvP functions are posted in the H text form
+  string ipf_encoding = "text";
   
   vector<string> behavior_dirs;
 
@@ -1323,6 +1339,24 @@ bool HelmIvP::OnStartUp()
       handled = handleConfigPMGen(value);
     else if(param == "OTHER_OVERRIDE_VAR") 
       handled = setNonWhiteVarOnString(m_additional_override, value);
+    else if(param == "IPF_THREADS") 
+      handled = setPosUIntOnString(m_ipf_threads, value);
+    else if(param == "WARM_START") 
+      handled = setBooleanOnString(warm_start, value);
+    else if(param == "CPA_CACHE") 
+      handled = setBooleanOnString(cpa_cache, value);
+    else if(param == "CAPTURE_SOLVE_TIME") 
+      handled = setNonNegDoubleOnString(capture_solve_time, value);
+    else if(param == "CAPTURE_PREFIX") 
+      handled = setNonWhiteVarOnString(capture_prefix, value);
+    else if(param == "CAPTURE_MAX") 
+      handled = setUIntOnString(capture_max, value);
+    else if(param == "IPF_ENCODING") {
+      value = tolower(value);
+      handled = ((value == "text") || (value == "packed"));
+      if(handled)
+	ipf_encoding = value;
+    }
 
     if(!handled)
       reportUnhandledConfigWarning(orig);
@@ -1343,6 +1377,12 @@ bool HelmIvP::OnStartUp()
   }
 
   m_hengine = new HelmEngine(m_ivp_domain, m_info_buffer, m_ledger_snap);
+  m_hengine->setIPFThreads(m_ipf_threads);
+  m_hengine->setWarmStart(warm_start);
+  m_hengine->setCPACache(cpa_cache);
+  m_hengine->setCaptureSolveTime(capture_solve_time);
+  m_hengine->setCapturePrefix(capture_prefix);
+  m_hengine->setCaptureMax(capture_max);
 
   Populator_BehaviorSet *p_bset;
   p_bset = new Populator_BehaviorSet(m_ivp_domain, m_info_buffer,
@@ -1378,6 +1418,8 @@ bool HelmIvP::OnStartUp()
   else // added nov1724
     m_hengine->setBehaviorSet(m_bhv_set);
 
+  m_bhv_set->setPackIPF(ipf_encoding == "packed");
+
   // Set the "ownship" parameter for all behaviors
   unsigned int i, bsize = m_bhv_set->size();
   for(i=0; i<bsize; i++) {
@@ -208,6 +208,9 @@ protected:
   // Set of apps that ALL must be present before posting start posts
   bool         m_nav_started;
   double       m_nav_grace;
+
+  // Threads building IvP functions, one means sequentially
+  unsigned int m_ipf_threads;
   
   bool         m_seed_random;
   
@@ -130,6 +130,29 @@ void showExampleConfigAndExit()
   blk("  // Name apps to wait on before posting onHelmStart messages.  ");
   blk("  hold_on_apps = pBasicContactMgr, pTaskManager                 ");
   blk("                                                                ");
+  blk("  // Threads on which behaviors build IvP functions. Only for   ");
+  blk("  // behaviors safe to run concurrently. Default is 1.          ");
+  blk("  ipf_threads = 1                                               ");
+  blk("                                                                ");
+  blk("  // Start each solve from the previous decision. Default true. ");
+  blk("  warm_start = true                                             ");
+  blk("                                                                ");
+  blk("  // Let contact behaviors share CPA engines built for the same ");
+  blk("  // contact in one iteration. Default true.                    ");
+  blk("  cpa_cache = true                                              ");
+  blk("                                                                ");
+  blk("  // Write each problem taking at least this many CPU seconds   ");
+  blk("  // to solve to <prefix>_<iteration>.ipp, for replay with      ");
+  blk("  // ivpreplay. Zero, the default, for none. At most            ");
+  blk("  // capture_max problems are written.                          ");
+  blk("  capture_solve_time = 0                                        ");
+  blk("  capture_prefix     = helm_capture                             ");
+  blk("  capture_max        = 100                                      ");
+  blk("                                                                ");
+  blk("  // Form of posted BHV_IPF functions. Packed is smaller and    ");
+  blk("  // faster to write and read. Default is text.                 ");
+  blk("  ipf_encoding = text    // or {packed}                         ");
+  blk("                                                                ");
   blk("  app_logging = true  // {true or file} By default disabled     ");
   blk("}                                                               ");
   blk("                                                                ");
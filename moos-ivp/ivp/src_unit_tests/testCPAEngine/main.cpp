@@ -0,0 +1,105 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testCPAEngine)                             */
+/*    DATE: Oct 17th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "CPAEngine.h"
+#include "CPAEngineV15.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+int main(int argc, char** argv) 
+{
+  double cnx = 0;    bool cnx_set=false;
+  double cny = 0;    bool cny_set=false;
+  double cnh = 0;    bool cnh_set=false;
+  double cnv = 0;    bool cnv_set=false;
+  double osx = 0;    bool osx_set=false;
+  double osy = 0;    bool osy_set=false;
+  double osh = 0;    bool osh_set=false;
+  double osv = 0;    bool osv_set=false;
+  double tol = 60;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "cnx="))
+      cnx_set = setDoubleOnString(cnx, argi.substr(4));
+    else if(strBegins(argi, "cny="))
+      cny_set = setDoubleOnString(cny, argi.substr(4));
+    else if(strBegins(argi, "cnh="))
+      cnh_set = setDoubleOnString(cnh, argi.substr(4));
+    else if(strBegins(argi, "cnv="))
+      cnv_set = setDoubleOnString(cnv, argi.substr(4));
+    else if(strBegins(argi, "osx="))
+      osx_set = setDoubleOnString(osx, argi.substr(4));
+    else if(strBegins(argi, "osy="))
+      osy_set = setDoubleOnString(osy, argi.substr(4));
+    else if(strBegins(argi, "osh="))
+      osh_set = setDoubleOnString(osh, argi.substr(4));
+    else if(strBegins(argi, "osv="))
+      osv_set = setDoubleOnString(osv, argi.substr(4));
+    else if(strBegins(argi, "tol="))
+      setDoubleOnString(tol, argi.substr(4));
+
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testCPAEngine: test CPAEngine against V15       " << endl;
+      cout << "Example:                                       " << endl;
+      cout << "$ testCPAEngine cnx=50 cny=100 cnh=180 cnv=2 osx=0 osy=0 osh=45 osv=2" << endl;
+      cout << "cpa=7.93,tcpa=30.18,v15=7.93,diffs=0           " << endl;
+      cout << "                                               " << endl;
+      cout << "The cpa and tcpa are from evalCPA() and         " << endl;
+      cout << "evalTimeCPA() and v15 is the CPA from           " << endl;
+      cout << "CPAEngineV15. The diffs are the number of       " << endl;
+      cout << "headings and speeds, over all of [0,360) and    " << endl;
+      cout << "[0,5], where the two CPAs differ by over 0.01.  " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!cnx_set) return(cmdLineErr("cnx is not set. Exiting."));
+  if(!cny_set) return(cmdLineErr("cny is not set. Exiting."));
+  if(!cnh_set) return(cmdLineErr("cnh is not set. Exiting."));
+  if(!cnv_set) return(cmdLineErr("cnv is not set. Exiting."));
+  if(!osx_set) return(cmdLineErr("osx is not set. Exiting."));
+  if(!osy_set) return(cmdLineErr("osy is not set. Exiting."));
+  if(!osh_set) return(cmdLineErr("osh is not set. Exiting."));
+  if(!osv_set) return(cmdLineErr("osv is not set. Exiting."));
+
+  CPAEngine    cpa_engine(cny, cnx, cnh, cnv, osy, osx);
+  CPAEngineV15 cpa_engine_v15(cny, cnx, cnh, cnv, osy, osx);
+
+  double cpa  = cpa_engine.evalCPA(osh, osv, tol);
+  double tcpa = cpa_engine.evalTimeCPA(osh, osv, tol);
+  double cpa_v15 = cpa_engine_v15.evalCPA(osh, osv, tol);
+
+  // Count the headings and speeds, over all of [0,360) and [0,5],
+  // where the cached engine and CPAEngineV15 differ
+  unsigned int diffs = 0;
+  for(int h=0; h<360; h++) {
+    for(int v=0; v<=50; v++) {
+      double spd = (double)(v) / 10;
+      double delta = cpa_engine.evalCPA(h, spd, tol) - 
+	cpa_engine_v15.evalCPA(h, spd, tol);
+      if((delta > 0.01) || (delta < -0.01))
+	diffs++;
+    }
+  }
+
+  cout << "cpa=" << doubleToStringX(cpa,2);
+  cout << ",tcpa=" << doubleToStringX(tcpa,2);
+  cout << ",v15=" << doubleToStringX(cpa_v15,2);
+  cout << ",diffs=" << diffs;
+  return(0);
+}